@@ -13,19 +13,49 @@ using namespace std;
 
 /**/
 /*
- void ArrayTable::AddNewArray(string a_arrayName, double a_size)
+ void ArrayTable::SetSlotCount(int a_slotCount)
+ 
+ NAME
+    ArrayTable::SetSlotCount - Makes room for the given number of array slots
+ 
+ SYNOPSIS
+    void ArrayTable::SetSlotCount(int a_slotCount)
+        a_slotCount --> The number of slots (distinct identifiers) in the Duck program
+ 
+ DESCRIPTION
+    This function makes sure that there is an (undeclared) array for every slot from 0 to a_slotCount - 1, so that arrays can be
+    accessed directly by slot
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ArrayTable::SetSlotCount(int a_slotCount)
+{
+    m_arrays.resize(a_slotCount);
+}/**void ArrayTable::SetSlotCount(int a_slotCount)**/
+
+
+
+/**/
+/*
+ void ArrayTable::AddNewArray(int a_arraySlot, double a_size)
  
  NAME
     ArrayTable::AddNewArray - Adds a new array to ArrayTable with all its indexes uninitialized
  
  SYNOPSIS
-    void ArrayTable::AddNewArray(string a_arrayName, double a_size)
-        a_arrayName --> The name of the new array to be added
+    void ArrayTable::AddNewArray(int a_arraySlot, double a_size)
+        a_arraySlot --> The slot of the new array to be added
         a_size --> The size of the array to be added
  
  DESCRIPTION
-    This function adds a new array (with the specified name and size) to the ArrayTable.
-    It throws exceptions if the array size is invalid or if the array name is already taken
+    This function adds a new array (with the specified size) to the ArrayTable. Only the table of its pages is allocated; the pages
+    themselves are allocated as their indexes are assigned. It throws exceptions if the array size is invalid or if the array name is
+    already taken
  
  RETURNS
     void
@@ -34,39 +64,27 @@ using namespace std;
     Biplab Thapa Magar
  */
 /**/
-void ArrayTable::AddNewArray(string a_arrayName, double a_size)
+void ArrayTable::AddNewArray(int a_arraySlot, double a_size)
 {
-    //first, check if the size is valid
-    if(a_size <= 0) {
-        throw DuckInterpreterException("Size of array is invalid.");
-    }
-    
-    //second, check if the size is a whole number
-    int sizeInWholeNum = static_cast<int>(a_size);
-    if(a_size - sizeInWholeNum != 0) {
-        throw DuckInterpreterException("Size of array must be a whole number.");
-    }
-    
-    //check if the array already exists
-    if(m_ArraySizeTable.count(a_arrayName) > 0) {
-        throw DuckInterpreterException("Cannot redeclare an existing array.");
+    //the size must be a positive whole number, and the array must not exist already
+    ArrayStatus status = m_arrays[a_arraySlot].Declare(a_size);
+    if(status != ArrayStatus::Valid) {
+        throw DuckInterpreterException(ArrayErrorMessage(status, "", a_size, 0));
     }
-    
-    //add vector and corresponding size to ArraySizeTable
-    m_ArraySizeTable[a_arrayName] = sizeInWholeNum;
-}/**void ArrayTable::AddNewArray(string a_arrayName, double a_size)**/
+}/**void ArrayTable::AddNewArray(int a_arraySlot, double a_size)**/
 
 
 
 /**/
 /*
- void ArrayTable::AddToArray(string a_arrayName, double a_index, double a_value)
+ void ArrayTable::AddToArray(int a_arraySlot, const string &a_arrayName, double a_index, double a_value)
  
  NAME
     ArrayTable::AddToArray - Assigns the given value to the specified index in the specified array
  
  SYNOPSIS
-    void ArrayTable::AddToArray(string a_arrayName, double a_index, double a_value)        
+    void ArrayTable::AddToArray(int a_arraySlot, const string &a_arrayName, double a_index, double a_value)
+        a_arraySlot --> The slot of the array
         a_arrayName --> The name of the array
         a_index --> The index of the array at which the value is to be assigned
         a_value --> The value to be assigned at the specified index of the array
@@ -82,28 +100,29 @@ void ArrayTable::AddNewArray(string a_arrayName, double a_size)
     Biplab Thapa Magar
  */
 /**/
-void ArrayTable::AddToArray(string a_arrayName, double a_index, double a_value) {
+void ArrayTable::AddToArray(int a_arraySlot, const string &a_arrayName, double a_index, double a_value) {
     //first, verify the array name and index
-    verifyArrayIndex(a_arrayName, a_index);
+    int index = verifyArrayIndex(a_arraySlot, a_arrayName, a_index);
     
-    //add value to the array table
-    //each element in the array is stored as an independent variable in the arrayTable, with the key to obtain the value being <array name>[<index.]
-    string keyVariable = a_arrayName + "[" + to_string(static_cast<int>(a_index)) + "]";
-    m_arrayTable.RecordVariableValue(keyVariable, a_value);
-}/**void ArrayTable::AddToArray(string a_arrayName, double a_index, double a_value)**/
+    //then, store the value, allocating the page of the index if none of its indexes has been assigned yet
+    if(!m_arrays[a_arraySlot].Store(index, a_value)) {
+        throw DuckInterpreterException(ArrayErrorMessage(ArrayStatus::OutOfMemory, a_arrayName, a_index, m_arrays[a_arraySlot].GetSize()));
+    }
+}/**void ArrayTable::AddToArray(int a_arraySlot, const string &a_arrayName, double a_index, double a_value)**/
 
 
 
 
 /**/
 /*
- bool ArrayTable::GetValue(string a_arrayName, double a_index, double &a_value)
+ bool ArrayTable::GetValue(int a_arraySlot, const string &a_arrayName, double a_index, double &a_value)
  
  NAME
     ArrayTable::GetValue - Retrieves the value present at the specified index in the specified array
  
  SYNOPSIS
-    bool ArrayTable::GetValue(string a_arrayName, double a_index, double &a_value)
+    bool ArrayTable::GetValue(int a_arraySlot, const string &a_arrayName, double a_index, double &a_value)
+        a_arraySlot --> The slot of the array
         a_arrayName --> The name of the array
         a_index --> The index of the array at which the value is to be assigned
         a_value --> The value to be retreived from the specified index of the array
@@ -119,33 +138,27 @@ void ArrayTable::AddToArray(string a_arrayName, double a_index, double a_value)
     Biplab Thapa Magar
  */
 /**/
-bool ArrayTable::GetValue(string a_arrayName, double a_index, double &a_value) {
+bool ArrayTable::GetValue(int a_arraySlot, const string &a_arrayName, double a_index, double &a_value) {
     //first, verify the array name and index
-    verifyArrayIndex(a_arrayName, a_index);
-    
-    //calculate the key so that we can retreive the value stored in the arrayTable
-    string keyVariable = a_arrayName + "[" + to_string(static_cast<int>(a_index)) + "]";
+    int index = verifyArrayIndex(a_arraySlot, a_arrayName, a_index);
     
     //next, assign the value at the given index of the array to a_value if the array has been initialized at the given index
-    //if a value at the given index has not been assigned, throw error
-    if(!m_arrayTable.GetVariableValue(keyVariable, a_value)) {
-        return false;
-    }
-    return true;
-}/**bool ArrayTable::GetValue(string a_arrayName, double a_index, double &a_value)**/
+    return m_arrays[a_arraySlot].Load(index, a_value);
+}/**bool ArrayTable::GetValue(int a_arraySlot, const string &a_arrayName, double a_index, double &a_value)**/
 
 
 
 /**/
 /*
- void ArrayTable::verifyArrayIndex(string a_arrayName, double a_index)
+ int ArrayTable::verifyArrayIndex(int a_arraySlot, const string &a_arrayName, double a_index)
  
  NAME
     ArrayTable::verifyArrayIndex - Checks if the given array has been initalized and if the index specified is valid
  
  SYNOPSIS
-    void ArrayTable::verifyArrayIndex(string a_arrayName, double a_index)
-        a_arrayName --> The name of the array to be checked
+    int ArrayTable::verifyArrayIndex(int a_arraySlot, const string &a_arrayName, double a_index)
+        a_arraySlot --> The slot of the array to be checked
+        a_arrayName --> The name of the array to be checked, for the error messages
         a_index --> The index to be checked
  
  DESCRIPTION
@@ -153,36 +166,18 @@ bool ArrayTable::GetValue(string a_arrayName, double a_index, double &a_value) {
     It also checks of the index is out-of-bounds of the array or if the index is not a whole number. Throws an exception in both cases
  
  RETURNS
-    void
+    The index as a whole number
  
  AUTHOR
     Biplab Thapa Magar
  */
 /**/
-void ArrayTable::verifyArrayIndex(string a_arrayName, double a_index) {
-    //first, check if the array has been declared
-    if(m_ArraySizeTable.count(a_arrayName) == 0) {
-        string message = "'" + a_arrayName + "' has not been declared as an array";
-        throw DuckInterpreterException(message);
-    }
-    
-    //next, check to see if the index is valid
-    //check to see if index is a whole number
-    int indexInWholeNum = static_cast<int>(a_index);
-    if(a_index - indexInWholeNum != 0) {
-        string message = "The given array index, " + to_string(a_index) + ", is not a whole number. Index must be a whole number.";
-        throw DuckInterpreterException(message);
-    }
-    //check to see if index is less than zero
-    if(indexInWholeNum < 0) {
-        string message = "The given array index, " + to_string(a_index) + ", is negative. Index must be a positive number.";
-        throw DuckInterpreterException(message);
-    }
-    //check to see if index exceeds size
-    int arraySize = m_ArraySizeTable.find(a_arrayName)->second;
-    if(indexInWholeNum > arraySize - 1) {
-        string message = "Array index '" + to_string(indexInWholeNum) + "' is out of bounds of the array '" + a_arrayName;
-        message = message + "', which is of size " + to_string(arraySize) + ".";
-        throw DuckInterpreterException(message);
+int ArrayTable::verifyArrayIndex(int a_arraySlot, const string &a_arrayName, double a_index) {
+    //check that the array has been declared, and that the index is a whole number that is neither negative nor out of bounds
+    int indexInWholeNum;
+    ArrayStatus status = m_arrays[a_arraySlot].VerifyIndex(a_index, indexInWholeNum);
+    if(status != ArrayStatus::Valid) {
+        throw DuckInterpreterException(ArrayErrorMessage(status, a_arrayName, a_index, m_arrays[a_arraySlot].GetSize()));
     }
-}/**void ArrayTable::verifyArrayIndex(string a_arrayName, double a_index)**/
+    return indexInWholeNum;
+}/**int ArrayTable::verifyArrayIndex(int a_arraySlot, const string &a_arrayName, double a_index)**/
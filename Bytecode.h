@@ -0,0 +1,111 @@
+/* Bytecode.h
+ Bytecode.h contains the instruction set of the Duck virtual machine and the BytecodeProgram struct.
+ A BytecodeProgram is a Duck program that has been compiled by the BytecodeCompiler into one flat array of instructions. The DuckVM
+ runs it with a stack of numbers: instructions push and pop numbers on the stack, and jumps move between instructions directly.
+ Every instruction remembers which Duck statement it was compiled from so that errors can still be reported against the original line.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+//The instructions of the Duck virtual machine
+enum class OpCode : unsigned char
+{
+    //pushes m_numbers[operand]
+    PushNumber,
+    //pushes the value of the variable in slot operand (the variable's identifier id)
+    LoadVariable,
+    //pops a value into the variable in slot operand
+    StoreVariable,
+    //pops an index and pushes the element at that index of the array with identifier id operand
+    LoadArrayElement,
+    //pops a value and then an index and stores the value at that index of the array with identifier id operand
+    StoreArrayElement,
+    //pops an index and then a value and stores the value at that index of the array (used by read, which reads the value first)
+    StoreArrayElementValueFirst,
+    //pops and discards the top of the stack
+    Pop,
+
+    //binary arithmetic and comparison: pop the right operand, then the left operand, and push the result
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Less,
+    Greater,
+    LessEqual,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    //'!' used between two operands: pops both and pushes the logical not of the left one
+    BinaryNot,
+    //unary operators: replace the top of the stack
+    Negate,
+    LogicalNot,
+    //reports that the operator m_strings[operand] cannot be evaluated with the top m_operand2 values of the stack (0 stands in for missing ones)
+    InvalidOperation,
+
+    //continues at instruction operand
+    Jump,
+    //pops a value and continues at instruction operand if the value is 0
+    JumpIfFalse,
+
+    //prints m_strings[operand]
+    PrintString,
+    //pops a value and prints it
+    PrintNumber,
+    //ends the line of output
+    PrintNewline,
+    //reads the next input value and pushes it
+    ReadNumber,
+    //pops a size and declares the array with identifier id operand
+    DeclareArray,
+
+    //ends the program successfully
+    Stop,
+    //an end statement was executed, so executing anything after it is an error
+    End,
+    //execution ran past the last statement of the program
+    NoMoreLines,
+    //reports the error m_strings[operand] against the statement of this instruction
+    RaiseError,
+};
+
+//A single instruction of the Duck virtual machine
+struct Instruction
+{
+    OpCode m_opCode;
+    int m_operand;
+    int m_operand2;
+};
+
+//A Duck program compiled into instructions for the Duck virtual machine
+struct BytecodeProgram
+{
+    //the instructions of the program. Execution starts at the first instruction
+    std::vector<Instruction> m_instructions;
+
+    //the index of the Duck statement that each instruction was compiled from
+    std::vector<int> m_statementOfInstruction;
+
+    //the index of the first instruction of each Duck statement
+    std::vector<int> m_statementStart;
+
+    //the number literals of the program
+    std::vector<double> m_numbers;
+
+    //the strings that are printed by the program, along with error messages and operator names
+    std::vector<std::string> m_strings;
+
+    //the deepest that the stack of numbers ever gets while the program runs
+    int m_maxStackDepth = 0;
+
+    //the number of temporary variable slots, after the slots of the identifiers, that the SsaOptimizer keeps values in
+    int m_temporaryCount = 0;
+
+    //for every variable and temporary slot, true if the SsaOptimizer found that only whole numbers are ever stored into it. Empty if
+    //the program was not optimized
+    std::vector<bool> m_wholeSlots;
+};
@@ -0,0 +1,767 @@
+#include "BytecodeCompiler.h"
+
+using namespace std;
+
+//The instruction that evaluates every binary operator, indexed by the ExpressionOperator (Add through BinaryNot)
+static constexpr OpCode k_binaryOpCodes[] = {
+    OpCode::Add, OpCode::Subtract, OpCode::Multiply, OpCode::Divide,
+    OpCode::Less, OpCode::Greater, OpCode::LessEqual, OpCode::GreaterEqual, OpCode::Equal, OpCode::NotEqual,
+    OpCode::BinaryNot,
+};
+
+
+/**/
+/*
+ BytecodeProgram BytecodeCompiler::Compile()
+
+ NAME
+    Compile - Compiles all the recorded statements of the Duck program into a program for the Duck virtual machine
+
+ SYNOPSIS
+    BytecodeProgram BytecodeCompiler::Compile()
+
+ DESCRIPTION
+    This function compiles the statements one at a time, in order. Once every statement has been compiled, it appends the instruction that is
+    reached when execution runs past the last statement, and then replaces the statement indexes stored in the jump instructions by the index
+    of the first instruction of the statement that they jump to.
+
+ RETURNS
+    The compiled program
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+BytecodeProgram BytecodeCompiler::Compile() {
+    m_program = BytecodeProgram();
+    m_statementJumps.clear();
+
+    int statementCount = m_statements.GetStatementCount();
+    for(int statementNum = 0; statementNum < statementCount; statementNum++) {
+        CompileStatement(statementNum);
+    }
+
+    //running past the last statement is an error. The extra entry in m_statementStart lets jumps to the statement after the last one land here
+    m_program.m_statementStart.push_back(static_cast<int>(m_program.m_instructions.size()));
+    m_currentStatement = statementCount > 0 ? statementCount - 1 : 0;
+    Emit(OpCode::NoMoreLines);
+
+    //now that the first instruction of every statement is known, point the jumps at instructions rather than statements
+    for(int jumpLocation : m_statementJumps) {
+        Instruction &jump = m_program.m_instructions[jumpLocation];
+        jump.m_operand = m_program.m_statementStart[jump.m_operand];
+    }
+
+    return m_program;
+} /* BytecodeProgram BytecodeCompiler::Compile() */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileStatement(int a_statementNum)
+
+ NAME
+    CompileStatement - Compiles the statement with the given index
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileStatement(int a_statementNum)
+        a_statementNum --> The index of the statement to be compiled
+
+ DESCRIPTION
+    This function compiles the given statement according to the type that was determined when it was recorded. If the statement has an error
+    in its syntax, the error is compiled into a RaiseError instruction that follows the instructions that were compiled before the error was
+    found, so the statement fails at run time at the same point (and after the same output) as it would in the DuckInterpreter.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileStatement(int a_statementNum) {
+    const CompiledStatement &statement = m_statements.GetStatement(a_statementNum);
+    m_program.m_statementStart.push_back(static_cast<int>(m_program.m_instructions.size()));
+    m_currentStatement = a_statementNum;
+    m_stackDepth = 0;
+
+    try {
+        switch(statement.m_type) {
+            case StatementType::ArithmeticStat:
+                CompileArithmeticStatement(statement);
+                break;
+            case StatementType::IfStat:
+                CompileIfStatement(statement, a_statementNum);
+                break;
+            case StatementType::gotoStat:
+                CompileGotoStatement(statement, 0);
+                break;
+            case StatementType::StopStat:
+                CompileStopStatement(statement);
+                break;
+            case StatementType::EndStat:
+                CompileEndStatement(statement, a_statementNum);
+                break;
+            case StatementType::PrintStat:
+                CompilePrintStatement(statement);
+                break;
+            case StatementType::ReadStat:
+                CompileReadStatement(statement);
+                break;
+            case StatementType::arrayDeclarationStat:
+                CompileArrayDeclarationStatement(statement);
+                break;
+            case StatementType::Invalid:
+                throw DuckInterpreterException(statement.m_classificationError);
+            case StatementType::Unreachable:
+                //no path reaches the statement, so it needs no instructions
+                break;
+        }
+    } catch(DuckInterpreterException &e) {
+        Emit(OpCode::RaiseError, AddString(e.what()));
+    }
+} /* void BytecodeCompiler::CompileStatement(int a_statementNum) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::Emit(OpCode a_opCode, int a_operand, int a_operand2)
+
+ NAME
+    Emit - Appends an instruction to the program
+
+ SYNOPSIS
+    void BytecodeCompiler::Emit(OpCode a_opCode, int a_operand, int a_operand2)
+        a_opCode --> The instruction to be appended
+        a_operand --> The first operand of the instruction
+        a_operand2 --> The second operand of the instruction
+
+ DESCRIPTION
+    This function appends an instruction to the program, records the statement that it belongs to, and keeps track of how deep the stack of
+    numbers gets so that the DuckVM can allocate the whole stack before it starts running.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::Emit(OpCode a_opCode, int a_operand, int a_operand2) {
+    Instruction instruction;
+    instruction.m_opCode = a_opCode;
+    instruction.m_operand = a_operand;
+    instruction.m_operand2 = a_operand2;
+    m_program.m_instructions.push_back(instruction);
+    m_program.m_statementOfInstruction.push_back(m_currentStatement);
+
+    //the number of values that the instruction pushes on (or pops off) the stack
+    switch(a_opCode) {
+        case OpCode::PushNumber:
+        case OpCode::LoadVariable:
+        case OpCode::ReadNumber:
+            m_stackDepth++;
+            break;
+        case OpCode::StoreVariable:
+        case OpCode::Pop:
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Multiply:
+        case OpCode::Divide:
+        case OpCode::Less:
+        case OpCode::Greater:
+        case OpCode::LessEqual:
+        case OpCode::GreaterEqual:
+        case OpCode::Equal:
+        case OpCode::NotEqual:
+        case OpCode::BinaryNot:
+        case OpCode::JumpIfFalse:
+        case OpCode::PrintNumber:
+        case OpCode::DeclareArray:
+            m_stackDepth--;
+            break;
+        case OpCode::StoreArrayElement:
+        case OpCode::StoreArrayElementValueFirst:
+            m_stackDepth -= 2;
+            break;
+        default:
+            break;
+    }
+    if(m_stackDepth > m_program.m_maxStackDepth) {
+        m_program.m_maxStackDepth = m_stackDepth;
+    }
+} /* void BytecodeCompiler::Emit(OpCode a_opCode, int a_operand, int a_operand2) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::EmitJumpToStatement(OpCode a_opCode, int a_statementNum)
+
+ NAME
+    EmitJumpToStatement - Appends a jump instruction to the first instruction of the given statement
+
+ SYNOPSIS
+    void BytecodeCompiler::EmitJumpToStatement(OpCode a_opCode, int a_statementNum)
+        a_opCode --> The jump instruction (Jump or JumpIfFalse)
+        a_statementNum --> The index of the statement to jump to
+
+ DESCRIPTION
+    The statement that is jumped to may not have been compiled yet, so the jump stores the index of the statement for now. Compile() replaces
+    it by the index of the statement's first instruction once all the statements have been compiled.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::EmitJumpToStatement(OpCode a_opCode, int a_statementNum) {
+    m_statementJumps.push_back(static_cast<int>(m_program.m_instructions.size()));
+    Emit(a_opCode, a_statementNum);
+} /* void BytecodeCompiler::EmitJumpToStatement(OpCode a_opCode, int a_statementNum) */
+
+
+
+/**/
+/*
+ int BytecodeCompiler::AddString(const string &a_string)
+
+ NAME
+    AddString - Adds a string to the strings of the program
+
+ SYNOPSIS
+    int BytecodeCompiler::AddString(const string &a_string)
+        a_string --> The string to be added
+
+ DESCRIPTION
+    This function adds a string (a string to be printed, an error message or the name of an operator) to the program
+
+ RETURNS
+    The index of the string, to be used as the operand of an instruction
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int BytecodeCompiler::AddString(const string &a_string) {
+    m_program.m_strings.push_back(a_string);
+    return static_cast<int>(m_program.m_strings.size()) - 1;
+} /* int BytecodeCompiler::AddString(const string &a_string) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileArithmeticStatement(const CompiledStatement &a_statement)
+
+ NAME
+    CompileArithmeticStatement - Compiles an arithmetic statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileArithmeticStatement(const CompiledStatement &a_statement)
+        a_statement --> The arithmetic statement to be compiled
+
+ DESCRIPTION
+    Compiles the evaluation of the array index (if the value is assigned to an array), the evaluation of the expression to the right of "="
+    and the store of the result into the variable or the array
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileArithmeticStatement(const CompiledStatement &a_statement) {
+    int nextPos = 0;
+    Token variableOrArray;
+    nextPos = a_statement.ParseNextElement(nextPos, variableOrArray);
+
+    //made sure of this when determining the type of statement
+    assert(variableOrArray.m_type == TokenType::Identifier);
+
+    Token nextToken;
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+
+    //check if array
+    bool isAnArray = false;
+    if(nextToken.IsOperator(OperatorCode::OpenBracket)) {
+        CompileArithmeticExpression(a_statement, nextPos);
+        isAnArray = true;
+        nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+        if(!nextToken.IsOperator(OperatorCode::CloseBracket)) {
+            throw DuckInterpreterException("Invalid arithmetic statement.");
+        }
+        nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    }
+
+    //made sure of this when determining the type of statement
+    assert(nextToken.IsOperator(OperatorCode::Assign));
+
+    CompileArithmeticExpression(a_statement, nextPos);
+
+    if(isAnArray) {
+        Emit(OpCode::StoreArrayElement, variableOrArray.m_identifierId);
+    } else {
+        Emit(OpCode::StoreVariable, variableOrArray.m_identifierId);
+    }
+
+    //check for the correctness of syntax of the remaining statement
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    if(nextPos >= 0) {
+        throw DuckInterpreterException("Extraneous elements at the end of arithmetic statement.");
+    }
+} /* void BytecodeCompiler::CompileArithmeticStatement(const CompiledStatement &a_statement) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos)
+
+ NAME
+    CompileArithmeticExpression - Compiles an arithmetic expression in a statement until it encounters a character that denotes
+        the end of an arithmetic expression
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos)
+        a_statement --> The statement containing the expression to be compiled
+        a_nextPos --> The position at which the expression starts
+
+ DESCRIPTION
+    The ExpressionWalker walks the expression exactly as it does for the ExpressionEvaluator, so the syntax errors are found at the same
+    elements. Numbers and variables are compiled into instructions that push their values, and every operator is compiled at the point
+    where the DuckInterpreter would evaluate it, so the resulting instructions leave the value of the expression on the stack. Updates
+    a_nextPos to be the position of the first element after the expression.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos) {
+    m_walker.Walk(a_statement, a_nextPos);
+} /* void BytecodeCompiler::CompileArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount)
+
+ NAME
+    ApplyOperator - Emits the instruction that applies an operator to the values at the top of the stack
+
+ SYNOPSIS
+    void BytecodeCompiler::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount)
+        a_operator --> The operator that the ExpressionWalker popped off its operator stack
+        a_position --> The position of the token of the operator
+        a_numberCount --> The number of values that the expression has on the stack
+
+ DESCRIPTION
+    A unary plus leaves its value as it is. A parenthesis that ends up being applied is compiled into an InvalidOperation instruction,
+    which reports the error with the values of the operands at run time, as the DuckInterpreter does.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount) {
+    switch(a_operator) {
+        //unary operators evaluate only one number
+        case ExpressionOperator::UnaryPlus:
+            return;
+        case ExpressionOperator::UnaryMinus:
+            Emit(OpCode::Negate);
+            return;
+        case ExpressionOperator::UnaryNot:
+            Emit(OpCode::LogicalNot);
+            return;
+        //a parenthesis cannot be evaluated, whatever it is applied to
+        case ExpressionOperator::OpenParenthesis:
+        case ExpressionOperator::CloseParenthesis:
+            Emit(OpCode::InvalidOperation, AddString(OperatorText(a_operator)), a_numberCount < 2 ? a_numberCount : 2);
+            return;
+        default:
+            Emit(k_binaryOpCodes[static_cast<int>(a_operator)]);
+            return;
+    }
+} /* void BytecodeCompiler::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileIfStatement(const CompiledStatement &a_statement, int a_statementNum)
+
+ NAME
+    CompileIfStatement - Compiles an if statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileIfStatement(const CompiledStatement &a_statement, int a_statementNum)
+        a_statement --> The if statement to be compiled
+        a_statementNum --> The index of this statement
+
+ DESCRIPTION
+    Compiles the condition, followed by a jump to the next statement if the condition is 0, followed by the goto part of the statement.
+    Errors in the goto part are therefore only raised if the condition holds, as in the DuckInterpreter.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileIfStatement(const CompiledStatement &a_statement, int a_statementNum) {
+    int nextPos = 0;
+    Token resultToken;
+    nextPos = a_statement.ParseNextElement(nextPos, resultToken);
+    assert(resultToken.IsKeyword(Keyword::If));
+
+    if(nextPos < 0 || !a_statement.m_tokens[nextPos].IsOperator(OperatorCode::OpenParenthesis)) {
+        throw DuckInterpreterException("If statement conditions must be inclosed by parentheses.");
+    }
+
+    CompileArithmeticExpression(a_statement, nextPos);
+    EmitJumpToStatement(OpCode::JumpIfFalse, a_statementNum + 1);
+    CompileGotoStatement(a_statement, nextPos);
+} /* void BytecodeCompiler::CompileIfStatement(const CompiledStatement &a_statement, int a_statementNum) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileGotoStatement(const CompiledStatement &a_statement, int a_nextPos)
+
+ NAME
+    CompileGotoStatement - Compiles a goto statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileGotoStatement(const CompiledStatement &a_statement, int a_nextPos)
+        a_statement --> The goto statement to be compiled
+        a_nextPos --> The index at which the goto statement starts (because goto statments can start in the second half of an if statement)
+
+ DESCRIPTION
+    Compiles a goto statement into a jump to the first instruction of the statement that the label corresponds to
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileGotoStatement(const CompiledStatement &a_statement, int a_nextPos) {
+    //the label of a well formed goto was resolved when the program was recorded
+    if(a_statement.m_gotoPosition >= 0 && a_nextPos == a_statement.m_gotoPosition) {
+        EmitJumpToStatement(OpCode::Jump, a_statement.m_gotoTarget);
+        return;
+    }
+
+    Token resultToken;
+    a_nextPos = a_statement.ParseNextElement(a_nextPos, resultToken);
+    if(!resultToken.IsKeyword(Keyword::Goto)) {
+        throw DuckInterpreterException("Invalid statement. If statement must have a goto.");
+    }
+
+    a_nextPos = a_statement.ParseNextElement(a_nextPos, resultToken);
+    if(resultToken.m_type != TokenType::Identifier) {
+        throw DuckInterpreterException("Goto statement must be followed by a label");
+    }
+
+    int labelLocation = m_statements.GetLabelLocation(m_statements.GetIdentifierName(resultToken.m_identifierId));
+
+    a_nextPos = a_statement.ParseNextElement(a_nextPos, resultToken);
+    if(a_nextPos >= 0) {
+        throw DuckInterpreterException("Extraneous elements at the end of an if statement.");
+    }
+
+    EmitJumpToStatement(OpCode::Jump, labelLocation);
+} /* void BytecodeCompiler::CompileGotoStatement(const CompiledStatement &a_statement, int a_nextPos) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileStopStatement(const CompiledStatement &a_statement)
+
+ NAME
+    CompileStopStatement - Compiles a stop statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileStopStatement(const CompiledStatement &a_statement)
+        a_statement --> The stop statement to be compiled
+
+ DESCRIPTION
+    Checks the syntax of the stop statement and compiles it into a Stop instruction
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileStopStatement(const CompiledStatement &a_statement) {
+    Token nextElement;
+    int nextPos = a_statement.ParseNextElement(0, nextElement);
+    if(!nextElement.IsKeyword(Keyword::Stop)) {
+        string message = a_statement.GetElementString(nextElement) + " is undefined in the context of a stop statement";
+        throw DuckInterpreterException(message);
+    }
+    nextPos = a_statement.ParseNextElement(nextPos, nextElement);
+    if(!nextElement.IsOperator(OperatorCode::Semicolon) || nextPos >= 0) {
+        throw DuckInterpreterException("Invalid stop statement");
+    }
+    Emit(OpCode::Stop);
+} /* void BytecodeCompiler::CompileStopStatement(const CompiledStatement &a_statement) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileEndStatement(const CompiledStatement &a_statement, int a_statementNum)
+
+ NAME
+    CompileEndStatement - Compiles an end statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileEndStatement(const CompiledStatement &a_statement, int a_statementNum)
+        a_statement --> The end statement to be compiled
+        a_statementNum --> The index of this statement
+
+ DESCRIPTION
+    Checks the syntax of the end statement. Since nothing may be executed after an end statement, it is compiled into the error that the
+    DuckInterpreter reports when it reaches the next statement: End if there is a next statement, NoMoreLines otherwise.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileEndStatement(const CompiledStatement &a_statement, int a_statementNum) {
+    Token nextElement;
+    int nextPos = a_statement.ParseNextElement(0, nextElement);
+    if(!nextElement.IsKeyword(Keyword::End)) {
+        string message = a_statement.GetElementString(nextElement) + " is undefined in the context of an end statement";
+        throw DuckInterpreterException(message);
+    }
+    nextPos = a_statement.ParseNextElement(nextPos, nextElement);
+    if(!nextElement.IsOperator(OperatorCode::Semicolon) || nextPos >= 0) {
+        throw DuckInterpreterException("Invalid end statement");
+    }
+    if(a_statementNum + 1 >= m_statements.GetStatementCount()) {
+        Emit(OpCode::NoMoreLines);
+    } else {
+        Emit(OpCode::End);
+    }
+} /* void BytecodeCompiler::CompileEndStatement(const CompiledStatement &a_statement, int a_statementNum) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompilePrintStatement(const CompiledStatement &a_statement)
+
+ NAME
+    CompilePrintStatement - Compiles a print statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompilePrintStatement(const CompiledStatement &a_statement)
+        a_statement --> The print statement to be compiled
+
+ DESCRIPTION
+    Compiles a print statement into instructions that print its strings and the values of its arithmetic expressions one at a time, followed
+    by the end of the line
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompilePrintStatement(const CompiledStatement &a_statement) {
+    int nextPos = 0;
+    Token nextToken;
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    if(!nextToken.IsKeyword(Keyword::Print)) {
+        throw DuckInterpreterException("Invalid print statement.");
+    }
+
+    //nextPos stays one step behind tempNextPos so that we can send nextPos as an argument to CompileArithmeticExpression
+    int tempNextPos = nextPos;
+    do {
+        nextPos = tempNextPos;
+        tempNextPos = a_statement.ParseNextElement(tempNextPos, nextToken);
+
+        if(nextToken.m_type != TokenType::String && nextToken.m_type != TokenType::Identifier && !nextToken.IsArithmeticOperator() && nextToken.m_type != TokenType::Number) {
+            throw DuckInterpreterException("Invalid print statement.");
+        }
+        if(nextToken.m_type == TokenType::String) {
+            Emit(OpCode::PrintString, AddString(string(a_statement.m_text.substr(nextToken.m_start + 1, nextToken.m_length - 2))));
+        } else {
+            CompileArithmeticExpression(a_statement, nextPos);
+            Emit(OpCode::PrintNumber);
+            tempNextPos = nextPos;
+        }
+        tempNextPos = a_statement.ParseNextElement(tempNextPos, nextToken);
+
+    } while(nextToken.IsOperator(OperatorCode::Comma));
+    Emit(OpCode::PrintNewline);
+
+    if(tempNextPos >= 0) {
+        throw DuckInterpreterException("Extraneous elements at the end of print statement.");
+    }
+} /* void BytecodeCompiler::CompilePrintStatement(const CompiledStatement &a_statement) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileReadStatement(const CompiledStatement &a_statement)
+
+ NAME
+    CompileReadStatement - Compiles a read statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileReadStatement(const CompiledStatement &a_statement)
+        a_statement --> The read statement to be compiled
+
+ DESCRIPTION
+    Compiles the prompt of the read statement and, for every variable or array element listed in it, an instruction that reads the next input
+    value followed by the store of the value. The value is read before the array index is evaluated, as in the DuckInterpreter.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileReadStatement(const CompiledStatement &a_statement) {
+    int nextPos = 0;
+    Token nextToken;
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    assert(nextToken.IsKeyword(Keyword::Read));
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+
+    //print prompt
+    if(nextToken.m_type == TokenType::String) {
+        Emit(OpCode::PrintString, AddString(string(a_statement.m_text.substr(nextToken.m_start + 1, nextToken.m_length - 2))));
+        nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+        if(!nextToken.IsOperator(OperatorCode::Comma)) {
+            throw DuckInterpreterException("Need comma separation in read statement");
+        }
+        nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    }
+
+    //go through all the variables
+    while(nextToken.m_type == TokenType::Identifier || nextToken.IsOperator(OperatorCode::Comma)) {
+        Emit(OpCode::ReadNumber);
+
+        Token tempToken;
+        int arrayNextPos = a_statement.ParseNextElement(nextPos, tempToken);
+        if(tempToken.IsOperator(OperatorCode::OpenBracket)) {
+            CompileArithmeticExpression(a_statement, arrayNextPos);
+            if(nextToken.m_type != TokenType::Identifier) {
+                string message = "'" + a_statement.GetElementString(nextToken) + "' has not been declared as an array";
+                throw DuckInterpreterException(message);
+            }
+            Emit(OpCode::StoreArrayElementValueFirst, nextToken.m_identifierId);
+            arrayNextPos = a_statement.ParseNextElement(arrayNextPos, tempToken);
+            nextPos = arrayNextPos;
+        } else if(nextToken.m_type == TokenType::Identifier) {
+            Emit(OpCode::StoreVariable, nextToken.m_identifierId);
+        } else {
+            //a value read into a comma cannot be used by the program
+            Emit(OpCode::Pop);
+        }
+
+        nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+        //skip comma
+        if(nextToken.IsOperator(OperatorCode::Comma)) {
+            nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+        }
+    }
+    if(!nextToken.IsOperator(OperatorCode::Semicolon)) {
+        throw DuckInterpreterException("Invalid syntax for read statement");
+    }
+
+    if(nextPos >= 0) {
+        throw DuckInterpreterException("Extraneous elements at the end of read statement.");
+    }
+} /* void BytecodeCompiler::CompileReadStatement(const CompiledStatement &a_statement) */
+
+
+
+/**/
+/*
+ void BytecodeCompiler::CompileArrayDeclarationStatement(const CompiledStatement &a_statement)
+
+ NAME
+    CompileArrayDeclarationStatement - Compiles an array declaration statement
+
+ SYNOPSIS
+    void BytecodeCompiler::CompileArrayDeclarationStatement(const CompiledStatement &a_statement)
+        a_statement --> The array declaration statement to be compiled
+
+ DESCRIPTION
+    Compiles the size of the array followed by the declaration of the array. The rest of the statement is checked after the declaration,
+    as in the DuckInterpreter.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void BytecodeCompiler::CompileArrayDeclarationStatement(const CompiledStatement &a_statement) {
+    int nextPos = 0;
+    Token nextToken;
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    assert(nextToken.IsKeyword(Keyword::Dim));
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+
+    if(nextToken.m_type != TokenType::Identifier) {
+        string message = "'" + a_statement.GetElementString(nextToken) + "' is an invalid array name.";
+        throw DuckInterpreterException(message);
+    }
+    int arrayId = nextToken.m_identifierId;
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    if(!nextToken.IsOperator(OperatorCode::OpenBracket)) {
+        throw DuckInterpreterException("Array variable name must be of the form: 'dim <array name>[<array size>]'.");
+    }
+
+    CompileArithmeticExpression(a_statement, nextPos);
+    Emit(OpCode::DeclareArray, arrayId);
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    if(!nextToken.IsOperator(OperatorCode::CloseBracket)) {
+        throw DuckInterpreterException("Array variable name must be of the form: 'dim <array name>[<array size>]'.");
+    }
+
+    nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+    if(!nextToken.IsOperator(OperatorCode::Semicolon) || nextPos >= 0) {
+        throw DuckInterpreterException("Incorrect syntax for array declaration statement.");
+    }
+} /* void BytecodeCompiler::CompileArrayDeclarationStatement(const CompiledStatement &a_statement) */
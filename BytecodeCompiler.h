@@ -0,0 +1,114 @@
+/* BytecodeCompiler.h
+ BytecodeCompiler.h contains the BytecodeCompiler class
+ BytecodeCompiler is the class that compiles the recorded statements of a Duck program into a BytecodeProgram for the DuckVM. It walks the
+ tokens of every statement exactly the way the DuckInterpreter does when it executes the statement (the expressions with the same
+ ExpressionWalker), but instead of computing values it emits the instructions that compute them. Errors in the syntax of a statement do not stop the compilation: they are compiled into a
+ RaiseError instruction at the point where the DuckInterpreter would have reported them, so that they are only reported if (and when) the
+ statement is actually executed.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <assert.h>
+#include "Bytecode.h"
+#include "Statement.h"
+#include "Token.h"
+#include "ExpressionOperator.h"
+#include "ExpressionWalker.h"
+#include "DuckInterpreterException.h"
+
+class BytecodeCompiler
+{
+public:
+    BytecodeCompiler(const Statement &a_statements) : m_statements(a_statements), m_walker(*this) {}
+    ~BytecodeCompiler() {}
+
+    //Compiles all the recorded statements into a program for the Duck virtual machine
+    BytecodeProgram Compile();
+
+private:
+    //The walker hands the numbers, the variables and the operators of an expression to the compiler
+    friend class ExpressionWalker<BytecodeCompiler>;
+
+    //The statements being compiled
+    const Statement &m_statements;
+
+    //The program being built
+    BytecodeProgram m_program;
+
+    //The index of the statement that is being compiled
+    int m_currentStatement;
+
+    //The depth of the stack of numbers after the last emitted instruction
+    int m_stackDepth;
+
+    //The positions of the jump instructions whose operand is still a statement index rather than an instruction index
+    std::vector<int> m_statementJumps;
+
+    //Walks the arithmetic expressions
+    ExpressionWalker<BytecodeCompiler> m_walker;
+
+    //Compiles a single statement
+    void CompileStatement(int a_statementNum);
+
+    //Appends an instruction to the program
+    void Emit(OpCode a_opCode, int a_operand = 0, int a_operand2 = 0);
+
+    //Appends a jump instruction to the first instruction of the given statement
+    void EmitJumpToStatement(OpCode a_opCode, int a_statementNum);
+
+    //Adds a string to the program's strings and returns its index
+    int AddString(const std::string &a_string);
+
+    //Compiles an arithmetic (assignment) statement
+    void CompileArithmeticStatement(const CompiledStatement &a_statement);
+
+    //Compiles an arithmetic expression, leaving its value on the stack. a_nextPos becomes the index of the element after the expression
+    void CompileArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos);
+
+    //Retrieves the next element of a statement, for the ExpressionWalker
+    int ParseNextElement(const CompiledStatement &a_statement, int a_nextPos, Token &a_token) {
+        return a_statement.ParseNextElement(a_nextPos, a_token);
+    }
+
+    //Emits the push of a number
+    void WalkNumber(const Token &a_number, int a_position) {
+        m_program.m_numbers.push_back(a_number.m_numValue);
+        Emit(OpCode::PushNumber, static_cast<int>(m_program.m_numbers.size()) - 1);
+    }
+
+    //Emits the load of a variable. Whether it has a value is checked by the DuckVM when the instruction runs
+    void WalkVariable(const Token &a_variable, int a_position) { Emit(OpCode::LoadVariable, a_variable.m_identifierId); }
+
+    //Emits the load of the array element whose index the instructions before it leave on the stack
+    void WalkArrayElement(const Token &a_array, int a_position, int a_closePosition) { Emit(OpCode::LoadArrayElement, a_array.m_identifierId); }
+
+    //Emits the instruction that applies an operator to the values at the top of the stack
+    void ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount);
+
+    //The instructions do not depend on the parentheses around an expression
+    void CloseParentheses(int a_openPosition, int a_closePosition) {}
+
+    //Compiles an if statement
+    void CompileIfStatement(const CompiledStatement &a_statement, int a_statementNum);
+
+    //Compiles the goto (part of a goto or an if) statement starting at the given element
+    void CompileGotoStatement(const CompiledStatement &a_statement, int a_nextPos);
+
+    //Compiles a stop statement
+    void CompileStopStatement(const CompiledStatement &a_statement);
+
+    //Compiles an end statement
+    void CompileEndStatement(const CompiledStatement &a_statement, int a_statementNum);
+
+    //Compiles a print statement
+    void CompilePrintStatement(const CompiledStatement &a_statement);
+
+    //Compiles a read statement
+    void CompileReadStatement(const CompiledStatement &a_statement);
+
+    //Compiles an array declaration statement
+    void CompileArrayDeclarationStatement(const CompiledStatement &a_statement);
+};
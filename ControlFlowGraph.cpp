@@ -0,0 +1,503 @@
+#include "ControlFlowGraph.h"
+#include <algorithm>
+#include <map>
+
+using namespace std;
+
+
+/**/
+/*
+ ControlFlowGraph::ControlFlowGraph(const Statement &a_statements)
+
+ NAME
+    ControlFlowGraph - Builds the control flow graph of a Duck program
+
+ SYNOPSIS
+    ControlFlowGraph::ControlFlowGraph(const Statement &a_statements)
+        a_statements --> The recorded statements of the program
+
+ DESCRIPTION
+    The blocks are built first, then their dominators are found, and then the loops, which are recognized by their dominators.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+ControlFlowGraph::ControlFlowGraph(const Statement &a_statements) : m_statements(a_statements) {
+    BuildBlocks();
+    FindDominators();
+    FindLoops();
+}/** ControlFlowGraph::ControlFlowGraph(const Statement &a_statements) **/
+
+
+
+/**/
+/*
+ vector<int> ControlFlowGraph::GetStatementSuccessors(const Statement &a_statements, int a_statementNum)
+
+ NAME
+    GetStatementSuccessors - Returns the statements that execution can continue with after the given statement
+
+ SYNOPSIS
+    vector<int> ControlFlowGraph::GetStatementSuccessors(const Statement &a_statements, int a_statementNum)
+        a_statements --> The recorded statements of the program
+        a_statementNum --> The index of the statement
+
+ DESCRIPTION
+    Execution continues with the next statement after any statement but a goto, a stop, an end (no statement may follow it), a statement
+    whose type could not be determined (which is always an error) or an unreachable one. An if statement and a goto statement also
+    continue with the statement of every label that follows a goto in them. Looking at every goto, rather than only at the well formed
+    one, errs on the side of more paths: a goto that is not well formed is only an error once the statement has been evaluated up to it.
+
+ RETURNS
+    The indexes of the successors
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+vector<int> ControlFlowGraph::GetStatementSuccessors(const Statement &a_statements, int a_statementNum) {
+    const CompiledStatement &statement = a_statements.GetStatement(a_statementNum);
+    vector<int> successors;
+    switch(statement.m_type) {
+        case StatementType::ArithmeticStat:
+        case StatementType::IfStat:
+        case StatementType::PrintStat:
+        case StatementType::ReadStat:
+        case StatementType::arrayDeclarationStat:
+            successors.push_back(a_statementNum + 1);
+            break;
+        default:
+            break;
+    }
+    if(statement.m_type == StatementType::IfStat || statement.m_type == StatementType::gotoStat) {
+        const TokenList &tokens = statement.m_tokens;
+        const map<string, int> &labels = a_statements.GetLabels();
+        for(size_t position = 0; position + 1 < tokens.size(); position++) {
+            if(tokens[position].IsKeyword(Keyword::Goto) && tokens[position + 1].m_type == TokenType::Identifier) {
+                map<string, int>::const_iterator label = labels.find(a_statements.GetIdentifierName(tokens[position + 1].m_identifierId));
+                if(label != labels.end() && find(successors.begin(), successors.end(), label->second) == successors.end()) {
+                    successors.push_back(label->second);
+                }
+            }
+        }
+    }
+    return successors;
+}/** vector<int> ControlFlowGraph::GetStatementSuccessors(const Statement &a_statements, int a_statementNum) **/
+
+
+
+/**/
+/*
+ void ControlFlowGraph::BuildBlocks()
+
+ NAME
+    BuildBlocks - Divides the statements into basic blocks
+
+ SYNOPSIS
+    void ControlFlowGraph::BuildBlocks()
+
+ DESCRIPTION
+    Only the statements that can be reached from the first statement are put into blocks. A block starts at the first statement, at
+    every statement that is jumped to, and after every statement that does not simply continue with the next one. The successors of a
+    block are the blocks of the successors of its last statement.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ControlFlowGraph::BuildBlocks() {
+    int statementCount = m_statements.GetStatementCount();
+    m_blockOfStatement.assign(statementCount, -1);
+    if(statementCount == 0) {
+        return;
+    }
+
+    //find the statements that can be reached, and the ones that start a block
+    vector<vector<int>> successors(statementCount);
+    vector<bool> reached(statementCount, false);
+    vector<bool> startsBlock(statementCount, false);
+    vector<int> pending(1, 0);
+    reached[0] = true;
+    startsBlock[0] = true;
+    while(!pending.empty()) {
+        int statementNum = pending.back();
+        pending.pop_back();
+        successors[statementNum] = GetStatementSuccessors(m_statements, statementNum);
+        bool continuesWithNext = successors[statementNum].size() == 1 && successors[statementNum][0] == statementNum + 1;
+        for(int successor : successors[statementNum]) {
+            if(successor >= statementCount) {
+                continue;
+            }
+            if(successor != statementNum + 1 || !continuesWithNext) {
+                startsBlock[successor] = true;
+            }
+            if(!reached[successor]) {
+                reached[successor] = true;
+                pending.push_back(successor);
+            }
+        }
+    }
+
+    //a statement that is reached and does not start a block joins the block of the statement before it, which always continues with it
+    for(int statementNum = 0; statementNum < statementCount; statementNum++) {
+        if(!reached[statementNum]) {
+            continue;
+        }
+        if(startsBlock[statementNum]) {
+            BasicBlock block;
+            block.m_firstStatement = statementNum;
+            m_blocks.push_back(block);
+        }
+        m_blocks.back().m_lastStatement = statementNum;
+        m_blockOfStatement[statementNum] = static_cast<int>(m_blocks.size()) - 1;
+    }
+
+    for(int blockNum = 0; blockNum < static_cast<int>(m_blocks.size()); blockNum++) {
+        BasicBlock &block = m_blocks[blockNum];
+        for(int successor : successors[block.m_lastStatement]) {
+            if(successor >= statementCount) {
+                block.m_reachesEnd = true;
+                continue;
+            }
+            int successorBlock = m_blockOfStatement[successor];
+            block.m_successors.push_back(successorBlock);
+            m_blocks[successorBlock].m_predecessors.push_back(blockNum);
+        }
+    }
+}/** void ControlFlowGraph::BuildBlocks() **/
+
+
+
+/**/
+/*
+ void ControlFlowGraph::FindDominators()
+
+ NAME
+    FindDominators - Finds the immediate dominator of every block
+
+ SYNOPSIS
+    void ControlFlowGraph::FindDominators()
+
+ DESCRIPTION
+    Every block can be reached from the first one, since only reachable statements are put into blocks.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ControlFlowGraph::FindDominators() {
+    vector<vector<int>> successors;
+    vector<vector<int>> predecessors;
+    for(const BasicBlock &block : m_blocks) {
+        successors.push_back(block.m_successors);
+        predecessors.push_back(block.m_predecessors);
+    }
+    vector<int> dominators = FindImmediateDominators(successors, predecessors);
+    for(size_t blockNum = 0; blockNum < m_blocks.size(); blockNum++) {
+        m_blocks[blockNum].m_immediateDominator = dominators[blockNum];
+    }
+}/** void ControlFlowGraph::FindDominators() **/
+
+
+
+/**/
+/*
+ vector<int> ControlFlowGraph::FindImmediateDominators(const vector<vector<int>> &a_successors, const vector<vector<int>> &a_predecessors)
+
+ NAME
+    FindImmediateDominators - Finds the immediate dominator of every node of a graph
+
+ SYNOPSIS
+    vector<int> ControlFlowGraph::FindImmediateDominators(const vector<vector<int>> &a_successors, const vector<vector<int>> &a_predecessors)
+        a_successors --> The successors of every node
+        a_predecessors --> The predecessors of every node
+
+ DESCRIPTION
+    This is the iterative algorithm of Cooper, Harvey and Kennedy: the nodes are visited in reverse postorder until no immediate
+    dominator changes, and the immediate dominator of a node is the closest common dominator of its predecessors that have been visited.
+    Node 0 is the entry of the graph. The nodes that cannot be reached from it, and the predecessors that cannot, are left out.
+
+ RETURNS
+    The immediate dominator of every node, -1 for the entry and for the nodes that cannot be reached
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+vector<int> ControlFlowGraph::FindImmediateDominators(const vector<vector<int>> &a_successors, const vector<vector<int>> &a_predecessors) {
+    int nodeCount = static_cast<int>(a_successors.size());
+    vector<int> dominator(nodeCount, -1);
+    if(nodeCount == 0) {
+        return dominator;
+    }
+
+    //the nodes in postorder, found without recursion since a program can have a great many blocks
+    vector<int> postorder;
+    vector<bool> visited(nodeCount, false);
+    vector<pair<int, size_t>> stack(1, make_pair(0, 0));
+    visited[0] = true;
+    while(!stack.empty()) {
+        int node = stack.back().first;
+        size_t &nextSuccessor = stack.back().second;
+        if(nextSuccessor < a_successors[node].size()) {
+            int successor = a_successors[node][nextSuccessor++];
+            if(!visited[successor]) {
+                visited[successor] = true;
+                stack.push_back(make_pair(successor, 0));
+            }
+            continue;
+        }
+        postorder.push_back(node);
+        stack.pop_back();
+    }
+    vector<int> postorderIndex(nodeCount, -1);
+    for(int index = 0; index < static_cast<int>(postorder.size()); index++) {
+        postorderIndex[postorder[index]] = index;
+    }
+
+    //the entry is its own dominator while the algorithm runs
+    dominator[0] = 0;
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(int index = static_cast<int>(postorder.size()) - 2; index >= 0; index--) {
+            int node = postorder[index];
+            int newDominator = -1;
+            for(int predecessor : a_predecessors[node]) {
+                if(dominator[predecessor] < 0) {
+                    continue;
+                }
+                if(newDominator < 0) {
+                    newDominator = predecessor;
+                    continue;
+                }
+                int left = predecessor;
+                int right = newDominator;
+                while(left != right) {
+                    while(postorderIndex[left] < postorderIndex[right]) {
+                        left = dominator[left];
+                    }
+                    while(postorderIndex[right] < postorderIndex[left]) {
+                        right = dominator[right];
+                    }
+                }
+                newDominator = left;
+            }
+            if(dominator[node] != newDominator) {
+                dominator[node] = newDominator;
+                changed = true;
+            }
+        }
+    }
+    dominator[0] = -1;
+    return dominator;
+}/** vector<int> ControlFlowGraph::FindImmediateDominators(const vector<vector<int>> &a_successors, const vector<vector<int>> &a_predecessors) **/
+
+
+
+/**/
+/*
+ bool ControlFlowGraph::Dominates(int a_dominator, int a_block) const
+
+ NAME
+    Dominates - Finds out whether a block dominates another
+
+ SYNOPSIS
+    bool ControlFlowGraph::Dominates(int a_dominator, int a_block) const
+        a_dominator --> The block that may dominate
+        a_block --> The block that may be dominated
+
+ DESCRIPTION
+    A block dominates itself, and every block that it is an immediate dominator of, directly or through other blocks.
+
+ RETURNS
+    True if a_dominator dominates a_block, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool ControlFlowGraph::Dominates(int a_dominator, int a_block) const {
+    for(int blockNum = a_block; blockNum >= 0; blockNum = m_blocks[blockNum].m_immediateDominator) {
+        if(blockNum == a_dominator) {
+            return true;
+        }
+    }
+    return false;
+}/** bool ControlFlowGraph::Dominates(int a_dominator, int a_block) const **/
+
+
+
+/**/
+/*
+ void ControlFlowGraph::FindLoops()
+
+ NAME
+    FindLoops - Finds the natural loops of the program
+
+ SYNOPSIS
+    void ControlFlowGraph::FindLoops()
+
+ DESCRIPTION
+    Every edge from a block to a block that dominates it is a jump back to the header of a loop. The loop is made of the header and of
+    all the blocks that can reach the jump without going through the header. The loops of all the jumps back to the same header are one
+    loop. Jumps back to a block that does not dominate them (into the middle of a loop that can be entered at more than one block) make
+    no natural loop.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ControlFlowGraph::FindLoops() {
+    int blockCount = static_cast<int>(m_blocks.size());
+    map<int, int> loopOfHeader;
+    vector<vector<bool>> inLoop;
+    for(int blockNum = 0; blockNum < blockCount; blockNum++) {
+        for(int header : m_blocks[blockNum].m_successors) {
+            if(!Dominates(header, blockNum)) {
+                continue;
+            }
+            map<int, int>::iterator loopEntry = loopOfHeader.find(header);
+            if(loopEntry == loopOfHeader.end()) {
+                loopEntry = loopOfHeader.insert(make_pair(header, static_cast<int>(m_loops.size()))).first;
+                NaturalLoop loop;
+                loop.m_header = header;
+                m_loops.push_back(loop);
+                inLoop.push_back(vector<bool>(blockCount, false));
+                inLoop.back()[header] = true;
+            }
+            NaturalLoop &loop = m_loops[loopEntry->second];
+            vector<bool> &blocks = inLoop[loopEntry->second];
+            loop.m_latches.push_back(blockNum);
+
+            //walk back from the jump to the header
+            vector<int> pending;
+            if(!blocks[blockNum]) {
+                blocks[blockNum] = true;
+                pending.push_back(blockNum);
+            }
+            while(!pending.empty()) {
+                int current = pending.back();
+                pending.pop_back();
+                for(int predecessor : m_blocks[current].m_predecessors) {
+                    if(!blocks[predecessor]) {
+                        blocks[predecessor] = true;
+                        pending.push_back(predecessor);
+                    }
+                }
+            }
+        }
+    }
+
+    for(size_t loopNum = 0; loopNum < m_loops.size(); loopNum++) {
+        for(int blockNum = 0; blockNum < blockCount; blockNum++) {
+            if(inLoop[loopNum][blockNum]) {
+                m_loops[loopNum].m_blocks.push_back(blockNum);
+            }
+        }
+    }
+    sort(m_loops.begin(), m_loops.end(), [](const NaturalLoop &a_left, const NaturalLoop &a_right) {
+        return a_left.m_header < a_right.m_header;
+    });
+}/** void ControlFlowGraph::FindLoops() **/
+
+
+
+/**/
+/*
+ void ControlFlowGraph::WriteGraphviz(ostream &a_stream, const string &a_title) const
+
+ NAME
+    WriteGraphviz - Writes the graph in the dot language of Graphviz
+
+ SYNOPSIS
+    void ControlFlowGraph::WriteGraphviz(ostream &a_stream, const string &a_title) const
+        a_stream --> The stream to write the graph to
+        a_title --> The name of the graph (the name of the Duck source file)
+
+ DESCRIPTION
+    Every block is a box that lists its statements with their line numbers. The headers of loops are drawn in bold, jumps back to a
+    header are dashed, and the blocks that can run past the last statement are connected to an oval that stands for the end of the
+    program. The immediate dominator of every block and the blocks of every loop are written as comments.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ControlFlowGraph::WriteGraphviz(ostream &a_stream, const string &a_title) const {
+    //the text of a label of the dot language, where quotes and backslashes are escaped and \l ends a left justified line
+    auto escape = [](string_view a_text) {
+        string escaped;
+        for(char character : a_text) {
+            if(character == '"' || character == '\\') {
+                escaped += '\\';
+            }
+            escaped += character;
+        }
+        return escaped;
+    };
+
+    vector<bool> isHeader(m_blocks.size(), false);
+    for(const NaturalLoop &loop : m_loops) {
+        isHeader[loop.m_header] = true;
+    }
+
+    a_stream << "digraph \"" << escape(a_title) << "\" {" << endl;
+    a_stream << "    node [shape=box, fontname=\"Courier\"];" << endl;
+    bool anyReachesEnd = false;
+    for(size_t blockNum = 0; blockNum < m_blocks.size(); blockNum++) {
+        const BasicBlock &block = m_blocks[blockNum];
+        a_stream << "    B" << blockNum << " [label=\"B" << blockNum << "\\l";
+        for(int statementNum = block.m_firstStatement; statementNum <= block.m_lastStatement; statementNum++) {
+            a_stream << statementNum + 1 << ": " << escape(m_statements.GetStatement(statementNum).m_text) << "\\l";
+        }
+        a_stream << "\"" << (isHeader[blockNum] ? ", style=bold" : "") << "];";
+        if(block.m_immediateDominator >= 0) {
+            a_stream << " // immediate dominator B" << block.m_immediateDominator;
+        }
+        a_stream << endl;
+        anyReachesEnd = anyReachesEnd || block.m_reachesEnd;
+    }
+    if(anyReachesEnd) {
+        a_stream << "    end [shape=oval, label=\"no more lines\"];" << endl;
+    }
+
+    for(size_t blockNum = 0; blockNum < m_blocks.size(); blockNum++) {
+        const BasicBlock &block = m_blocks[blockNum];
+        for(int successor : block.m_successors) {
+            a_stream << "    B" << blockNum << " -> B" << successor;
+            if(Dominates(successor, static_cast<int>(blockNum))) {
+                a_stream << " [style=dashed]";
+            }
+            a_stream << ";" << endl;
+        }
+        if(block.m_reachesEnd) {
+            a_stream << "    B" << blockNum << " -> end;" << endl;
+        }
+    }
+
+    for(const NaturalLoop &loop : m_loops) {
+        a_stream << "    // loop with header B" << loop.m_header << ":";
+        for(int blockNum : loop.m_blocks) {
+            a_stream << " B" << blockNum;
+        }
+        a_stream << endl;
+    }
+    a_stream << "}" << endl;
+}/** void ControlFlowGraph::WriteGraphviz(ostream &a_stream, const string &a_title) const **/
@@ -0,0 +1,97 @@
+/* ControlFlowGraph.h
+ ControlFlowGraph.h contains the ControlFlowGraph class and the BasicBlock and NaturalLoop structs
+ ControlFlowGraph is the class that recovers the structure of a Duck program from its gotos. Duck has no loop statements, so the loops of a
+ program are only known from the labels that gotos and if statements jump to. The graph divides the statements that can be reached from
+ the first statement into basic blocks (runs of statements that are always executed one after the other), finds the dominator of every
+ block (the block that every path from the first statement to it goes through last), and finds the natural loops: a jump back to a block
+ that dominates the jump makes a loop of the statements that can reach the jump without going through that block. The graph can be
+ written in the dot language of Graphviz for inspection.
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Statement.h"
+#include "Token.h"
+
+//A run of statements that are always executed one after the other: only the first is jumped to, and only the last jumps
+struct BasicBlock
+{
+    //the indexes of the first and the last statement of the block
+    int m_firstStatement = 0;
+    int m_lastStatement = 0;
+
+    //the blocks that execution can continue with after the block, and the blocks that it can come from
+    std::vector<int> m_successors;
+    std::vector<int> m_predecessors;
+
+    //true if execution can run past the last statement of the program from the block
+    bool m_reachesEnd = false;
+
+    //the block that dominates the block most closely, -1 for the first block
+    int m_immediateDominator = -1;
+};
+
+//A loop of the program: the blocks that can reach a jump back to the header without going through the header
+struct NaturalLoop
+{
+    //the block that every iteration of the loop starts at
+    int m_header = 0;
+
+    //the blocks of the loop (the header included), in the order of their statements
+    std::vector<int> m_blocks;
+
+    //the blocks of the loop that jump back to the header
+    std::vector<int> m_latches;
+};
+
+class ControlFlowGraph
+{
+public:
+    //Builds the graph of the given recorded statements and analyzes it
+    ControlFlowGraph(const Statement &a_statements);
+    ~ControlFlowGraph() {}
+
+    //Returns the basic blocks, in the order of their statements. The first block starts at the first statement
+    const std::vector<BasicBlock>& GetBlocks() const { return m_blocks; }
+
+    //Returns the natural loops, in the order of their headers
+    const std::vector<NaturalLoop>& GetLoops() const { return m_loops; }
+
+    //Returns the block of the given statement, or -1 if no path from the first statement reaches it
+    int GetBlockOfStatement(int a_statementNum) const { return m_blockOfStatement[a_statementNum]; }
+
+    //Returns true if every path from the first statement to block a_block goes through block a_dominator
+    bool Dominates(int a_dominator, int a_block) const;
+
+    //Writes the graph in the dot language of Graphviz
+    void WriteGraphviz(std::ostream &a_stream, const std::string &a_title) const;
+
+    //Returns the statements that execution can continue with after the given statement. The index after the last statement stands for
+    //running past the end of the program
+    static std::vector<int> GetStatementSuccessors(const Statement &a_statements, int a_statementNum);
+
+    //Returns the immediate dominator of every node of a graph whose entry is node 0: -1 for the entry and the nodes it cannot reach
+    static std::vector<int> FindImmediateDominators(const std::vector<std::vector<int>> &a_successors,
+                                                    const std::vector<std::vector<int>> &a_predecessors);
+
+private:
+    //The statements of the program
+    const Statement &m_statements;
+
+    //The blocks, the block of every statement and the loops
+    std::vector<BasicBlock> m_blocks;
+    std::vector<int> m_blockOfStatement;
+    std::vector<NaturalLoop> m_loops;
+
+    //Divides the statements that can be reached into basic blocks and connects them
+    void BuildBlocks();
+
+    //Finds the immediate dominator of every block
+    void FindDominators();
+
+    //Finds the natural loops from the jumps back to dominating blocks
+    void FindLoops();
+};
@@ -0,0 +1,526 @@
+#include "CppTranslator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <set>
+
+using namespace std;
+
+
+/**/
+/*
+ static string CppIdentifier(const string &a_prefix, const string &a_name, int a_identifierId)
+
+ NAME
+    CppIdentifier - Builds a C++ identifier for a name of the Duck program
+
+ SYNOPSIS
+    static string CppIdentifier(const string &a_prefix, const string &a_name, int a_identifierId)
+        a_prefix --> What the identifier stands for (such as "v_" for variables), which also keeps it clear of C++ keywords
+        a_name --> The Duck name
+        a_identifierId --> A number that is unique to the name, used instead of names that are not made of letters and digits
+
+ DESCRIPTION
+    The C++ code reads best when it uses the names of the Duck program, so the Duck name is kept whenever it is made of letters and
+    digits. Other names are replaced by the number followed by an underscore, which no kept name can end with.
+
+ RETURNS
+    The C++ identifier
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static string CppIdentifier(const string &a_prefix, const string &a_name, int a_identifierId) {
+    bool letterOrDigit = !a_name.empty() && all_of(a_name.begin(), a_name.end(), [](char a_character) {
+        return isalnum(static_cast<unsigned char>(a_character)) != 0;
+    });
+    return a_prefix + (letterOrDigit ? a_name : to_string(a_identifierId) + "_");
+}/** static string CppIdentifier(const string &a_prefix, const string &a_name, int a_identifierId) **/
+
+
+
+/**/
+/*
+ string CppTranslator::Translate()
+
+ NAME
+    Translate - Translates the Duck program into a C++ translation unit
+
+ SYNOPSIS
+    string CppTranslator::Translate()
+
+ DESCRIPTION
+    The translation is a main function that creates the DuckRuntime, declares the variables of the Duck program, the names of its
+    arrays and the stack of numbers, and then runs the instructions of the program in order. Every statement starts with a comment
+    holding its line and text, preceded by a C++ label if it is jumped to. The instructions that follow one that never continues (a goto,
+    a stop, or an error) up to the next statement or jump target can never run, so they are left out.
+
+ RETURNS
+    The C++ source code
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+string CppTranslator::Translate() {
+    FindNames();
+
+    ostringstream code;
+    code << "// The Duck program " << m_sourceFileName << ", translated to C++ by duck2cpp." << endl;
+    code << "//" << endl;
+    code << "// Compile with: g++ -std=c++17 -O2 -I<the directory of DuckRuntime.h> <this file>" << endl;
+    code << "// The program takes the --flush and --number-format options of duckInterp, and reads the input of its read statements from" << endl;
+    code << "// the standard input." << endl;
+    code << endl;
+    code << "#include \"DuckRuntime.h\"" << endl;
+    code << endl;
+    code << "using namespace std;" << endl;
+    code << endl;
+    code << "//the text of every statement of the Duck program, for error messages" << endl;
+    code << "static const char *const k_statementTexts[] = {" << endl;
+    int statementCount = m_statements.GetStatementCount();
+    for(int statementNum = 0; statementNum < statementCount; statementNum++) {
+        code << "    " << StringLiteral(m_statements.GetStatement(statementNum).m_text) << "," << endl;
+    }
+    code << "    nullptr" << endl;
+    code << "};" << endl;
+    code << endl;
+    code << "int main(int argc, char *argv[])" << endl;
+    code << "{" << endl;
+    code << "    DuckRuntime runtime(argc, argv, k_statementTexts, " << m_statements.GetIdentifierCount() << ");" << endl;
+    if(!m_variables.empty()) {
+        code << endl;
+        code << "    //the variables of the Duck program, and whether they have been assigned a value" << endl;
+        for(int variable : m_variables) {
+            code << "    double " << VariableName(variable) << " = 0;" << endl;
+            code << "    bool " << VariableName(variable) << "_assigned = false;" << endl;
+        }
+    }
+    if(!m_arrays.empty()) {
+        code << endl;
+        code << "    //the names of the arrays of the Duck program, for error messages" << endl;
+        for(int array : m_arrays) {
+            code << "    const string " << ArrayName(array) << " = " << StringLiteral(m_statements.GetIdentifierName(array)) << ";" << endl;
+        }
+    }
+    if(m_program.m_maxStackDepth > 0) {
+        code << endl;
+        code << "    //the stack of numbers" << endl;
+        code << "    double ";
+        for(int depth = 0; depth < m_program.m_maxStackDepth; depth++) {
+            code << (depth > 0 ? ", " : "") << "s" << depth << " = 0";
+        }
+        code << ";" << endl;
+    }
+
+    int instructionCount = static_cast<int>(m_program.m_instructions.size());
+    int statementNum = -1;
+    int stackDepth = 0;
+    bool reachable = true;
+    for(int instructionNum = 0; instructionNum < instructionCount; instructionNum++) {
+        //a new statement starts with an empty stack of numbers (several statements can only start at the same instruction if all but the
+        //last compiled to nothing)
+        bool statementStarts = false;
+        while(statementNum + 1 < statementCount && m_program.m_statementStart[statementNum + 1] == instructionNum) {
+            statementNum++;
+            statementStarts = true;
+        }
+        map<int, string>::const_iterator jumpLabel = m_jumpLabels.find(instructionNum);
+        if(statementStarts || jumpLabel != m_jumpLabels.end()) {
+            stackDepth = 0;
+            reachable = true;
+        }
+        if(!reachable) {
+            continue;
+        }
+        if(statementStarts) {
+            code << endl;
+        }
+        if(jumpLabel != m_jumpLabels.end()) {
+            code << jumpLabel->second << ":" << endl;
+        }
+        if(statementStarts) {
+            //the text is written as a string literal, so that neither a backslash at its end nor a carriage return or any other
+            //character that is not printable can end the comment early or continue it onto the next line
+            code << "    // Line " << statementNum + 1 << ": " << StringLiteral(m_statements.GetStatement(statementNum).m_text) << endl;
+        }
+        reachable = TranslateInstruction(instructionNum, stackDepth, code);
+    }
+    code << "}" << endl;
+    return code.str();
+}/** string CppTranslator::Translate() **/
+
+
+
+/**/
+/*
+ void CppTranslator::FindNames()
+
+ NAME
+    FindNames - Finds the variables, the arrays and the jump targets of the program
+
+ SYNOPSIS
+    void CppTranslator::FindNames()
+
+ DESCRIPTION
+    Only the identifiers that the instructions use as variables get a C++ variable, and only those that they use as arrays get a name
+    constant. A jump target that is the first instruction of a labeled statement is named after the Duck label; any other statement
+    that is jumped to (the statement after an if) is named after its line, and the instruction that is reached by running past the last
+    statement is named no_more_lines.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void CppTranslator::FindNames() {
+    set<int> variables;
+    set<int> arrays;
+    set<int> jumpTargets;
+    for(const Instruction &instruction : m_program.m_instructions) {
+        switch(instruction.m_opCode) {
+            case OpCode::LoadVariable:
+            case OpCode::StoreVariable:
+                variables.insert(instruction.m_operand);
+                break;
+            case OpCode::LoadArrayElement:
+            case OpCode::StoreArrayElement:
+            case OpCode::StoreArrayElementValueFirst:
+            case OpCode::DeclareArray:
+                arrays.insert(instruction.m_operand);
+                break;
+            case OpCode::Jump:
+            case OpCode::JumpIfFalse:
+                jumpTargets.insert(instruction.m_operand);
+                break;
+            default:
+                break;
+        }
+    }
+    m_variables.assign(variables.begin(), variables.end());
+    m_arrays.assign(arrays.begin(), arrays.end());
+
+    //the Duck label of every labeled statement
+    map<int, string> statementLabels;
+    for(const pair<const string, int> &label : m_statements.GetLabels()) {
+        statementLabels[label.second] = label.first;
+    }
+
+    m_jumpLabels.clear();
+    int statementCount = m_statements.GetStatementCount();
+    for(int target : jumpTargets) {
+        //the first statement that starts at the target (m_statementStart has an extra entry for running past the last statement)
+        int statementNum = static_cast<int>(lower_bound(m_program.m_statementStart.begin(), m_program.m_statementStart.end(), target) -
+            m_program.m_statementStart.begin());
+        string name;
+        for(int labeled = statementNum; labeled < statementCount && m_program.m_statementStart[labeled] == target; labeled++) {
+            map<int, string>::const_iterator label = statementLabels.find(labeled);
+            if(label != statementLabels.end()) {
+                name = CppIdentifier("label_", label->second, labeled);
+                break;
+            }
+        }
+        if(name.empty()) {
+            name = statementNum >= statementCount ? "no_more_lines" : "line_" + to_string(statementNum + 1);
+        }
+        m_jumpLabels[target] = name;
+    }
+}/** void CppTranslator::FindNames() **/
+
+
+
+/**/
+/*
+ bool CppTranslator::TranslateInstruction(int a_instructionNum, int &a_stackDepth, ostringstream &a_code)
+
+ NAME
+    TranslateInstruction - Writes the C++ code of an instruction
+
+ SYNOPSIS
+    bool CppTranslator::TranslateInstruction(int a_instructionNum, int &a_stackDepth, ostringstream &a_code)
+        a_instructionNum --> The index of the instruction
+        a_stackDepth --> The depth of the stack of numbers before the instruction. Updated to the depth after it
+        a_code --> The C++ code being written
+
+ DESCRIPTION
+    The depth of the stack of numbers at every instruction is known when the program is translated, so the stack is a fixed set of
+    local variables (s0 at the bottom), which the C++ compiler keeps in registers. Every instruction does exactly what the DuckVM does
+    with it, in the same order, so the results and the errors are the same.
+
+ RETURNS
+    False if execution never continues to the next instruction, true otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool CppTranslator::TranslateInstruction(int a_instructionNum, int &a_stackDepth, ostringstream &a_code) {
+    const Instruction &instruction = m_program.m_instructions[a_instructionNum];
+    int statementNum = m_program.m_statementOfInstruction[a_instructionNum];
+    //the top of the stack, and the value below it
+    string top = "s" + to_string(a_stackDepth - 1);
+    string below = "s" + to_string(a_stackDepth - 2);
+    string push = "s" + to_string(a_stackDepth);
+
+    //the C++ operator of the binary arithmetic and comparison instructions
+    const char *binaryOperator = nullptr;
+    switch(instruction.m_opCode) {
+        case OpCode::Add: binaryOperator = "+"; break;
+        case OpCode::Subtract: binaryOperator = "-"; break;
+        case OpCode::Multiply: binaryOperator = "*"; break;
+        case OpCode::Divide: binaryOperator = "/"; break;
+        case OpCode::Less: binaryOperator = "<"; break;
+        case OpCode::Greater: binaryOperator = ">"; break;
+        case OpCode::LessEqual: binaryOperator = "<="; break;
+        case OpCode::GreaterEqual: binaryOperator = ">="; break;
+        case OpCode::Equal: binaryOperator = "=="; break;
+        case OpCode::NotEqual: binaryOperator = "!="; break;
+        default: break;
+    }
+    if(binaryOperator != nullptr) {
+        a_code << "    " << below << " = " << below << " " << binaryOperator << " " << top << ";" << endl;
+        a_stackDepth--;
+        return true;
+    }
+
+    switch(instruction.m_opCode) {
+        case OpCode::PushNumber:
+            a_code << "    " << push << " = " << NumberLiteral(m_program.m_numbers[instruction.m_operand]) << ";" << endl;
+            a_stackDepth++;
+            return true;
+        case OpCode::LoadVariable: {
+            string variable = VariableName(instruction.m_operand);
+            string message = "The variable " + m_statements.GetIdentifierName(instruction.m_operand) + " has not been assigned a value.";
+            a_code << "    if(!" << variable << "_assigned) runtime.Fail(" << statementNum << ", " << StringLiteral(message) << ");" << endl;
+            a_code << "    " << push << " = " << variable << ";" << endl;
+            a_stackDepth++;
+            return true;
+        }
+        case OpCode::StoreVariable: {
+            string variable = VariableName(instruction.m_operand);
+            a_code << "    " << variable << " = " << top << ";" << endl;
+            a_code << "    " << variable << "_assigned = true;" << endl;
+            a_stackDepth--;
+            return true;
+        }
+        case OpCode::LoadArrayElement:
+            a_code << "    " << top << " = runtime.GetArrayElement(" << statementNum << ", " << instruction.m_operand << ", "
+                   << ArrayName(instruction.m_operand) << ", " << top << ");" << endl;
+            return true;
+        case OpCode::StoreArrayElement:
+            a_code << "    runtime.SetArrayElement(" << statementNum << ", " << instruction.m_operand << ", " << ArrayName(instruction.m_operand)
+                   << ", " << below << ", " << top << ");" << endl;
+            a_stackDepth -= 2;
+            return true;
+        case OpCode::StoreArrayElementValueFirst:
+            a_code << "    runtime.SetArrayElement(" << statementNum << ", " << instruction.m_operand << ", " << ArrayName(instruction.m_operand)
+                   << ", " << top << ", " << below << ");" << endl;
+            a_stackDepth -= 2;
+            return true;
+        case OpCode::Pop:
+            a_stackDepth--;
+            return true;
+
+        case OpCode::BinaryNot:
+            a_code << "    " << below << " = " << below << " != 0 ? 0 : 1;" << endl;
+            a_stackDepth--;
+            return true;
+        case OpCode::Negate:
+            a_code << "    " << top << " = -1 * " << top << ";" << endl;
+            return true;
+        case OpCode::LogicalNot:
+            a_code << "    " << top << " = " << top << " != 0 ? 0 : 1;" << endl;
+            return true;
+        case OpCode::InvalidOperation:
+            a_code << "    runtime.InvalidOperation(" << statementNum << ", " << StringLiteral(m_program.m_strings[instruction.m_operand]) << ", "
+                   << (instruction.m_operand2 >= 2 ? below : "0") << ", " << (instruction.m_operand2 >= 1 ? top : "0") << ");" << endl;
+            return false;
+
+        case OpCode::Jump:
+            a_code << "    goto " << m_jumpLabels[instruction.m_operand] << ";" << endl;
+            return false;
+        case OpCode::JumpIfFalse:
+            a_code << "    if(" << top << " == 0) goto " << m_jumpLabels[instruction.m_operand] << ";" << endl;
+            a_stackDepth--;
+            return true;
+
+        case OpCode::PrintString: {
+            const string &text = m_program.m_strings[instruction.m_operand];
+            a_code << "    runtime.PrintString(" << StringLiteral(text) << ", " << text.length() << ");" << endl;
+            return true;
+        }
+        case OpCode::PrintNumber:
+            a_code << "    runtime.PrintNumber(" << top << ");" << endl;
+            a_stackDepth--;
+            return true;
+        case OpCode::PrintNewline:
+            a_code << "    runtime.EndLine();" << endl;
+            return true;
+        case OpCode::ReadNumber:
+            a_code << "    " << push << " = runtime.ReadNumber(" << statementNum << ");" << endl;
+            a_stackDepth++;
+            return true;
+        case OpCode::DeclareArray:
+            a_code << "    runtime.DeclareArray(" << statementNum << ", " << instruction.m_operand << ", " << top << ");" << endl;
+            a_stackDepth--;
+            return true;
+
+        case OpCode::Stop:
+            a_code << "    runtime.Stop();" << endl;
+            return false;
+        case OpCode::End:
+            a_code << "    runtime.End();" << endl;
+            return false;
+        case OpCode::NoMoreLines:
+            a_code << "    runtime.NoMoreLines();" << endl;
+            return false;
+        case OpCode::RaiseError:
+            a_code << "    runtime.Fail(" << statementNum << ", " << StringLiteral(m_program.m_strings[instruction.m_operand]) << ");" << endl;
+            return false;
+        default:
+            return true;
+    }
+}/** bool CppTranslator::TranslateInstruction(int a_instructionNum, int &a_stackDepth, ostringstream &a_code) **/
+
+
+
+/**/
+/*
+ string CppTranslator::VariableName(int a_identifierId) const
+
+ NAME
+    VariableName - Returns the name of the C++ variable of a Duck variable
+
+ SYNOPSIS
+    string CppTranslator::VariableName(int a_identifierId) const
+        a_identifierId --> The identifier id of the variable
+
+ DESCRIPTION
+    The flag that records whether the variable has been assigned a value is named after it, with _assigned appended.
+
+ RETURNS
+    The name of the C++ variable
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+string CppTranslator::VariableName(int a_identifierId) const {
+    return CppIdentifier("v_", m_statements.GetIdentifierName(a_identifierId), a_identifierId);
+}/** string CppTranslator::VariableName(int a_identifierId) const **/
+
+
+
+/**/
+/*
+ string CppTranslator::ArrayName(int a_identifierId) const
+
+ NAME
+    ArrayName - Returns the name of the constant that holds the name of a Duck array
+
+ SYNOPSIS
+    string CppTranslator::ArrayName(int a_identifierId) const
+        a_identifierId --> The identifier id of the array
+
+ DESCRIPTION
+    The elements of the array are kept by the DuckRuntime, which only needs the name of the array for its error messages.
+
+ RETURNS
+    The name of the C++ constant
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+string CppTranslator::ArrayName(int a_identifierId) const {
+    return CppIdentifier("name_", m_statements.GetIdentifierName(a_identifierId), a_identifierId);
+}/** string CppTranslator::ArrayName(int a_identifierId) const **/
+
+
+
+/**/
+/*
+ string CppTranslator::StringLiteral(string_view a_text)
+
+ NAME
+    StringLiteral - Returns a C++ string literal with the given text
+
+ SYNOPSIS
+    string CppTranslator::StringLiteral(string_view a_text)
+        a_text --> The text of the literal
+
+ DESCRIPTION
+    Quotes, backslashes and question marks (which could otherwise start a trigraph) are escaped, and every character that is not
+    printable is written as a three digit octal escape, which cannot run into the characters that follow it.
+
+ RETURNS
+    The string literal
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+string CppTranslator::StringLiteral(string_view a_text) {
+    string literal = "\"";
+    for(char character : a_text) {
+        unsigned char code = static_cast<unsigned char>(character);
+        if(character == '\"' || character == '\\' || character == '?') {
+            literal += '\\';
+            literal += character;
+        } else if(code < 0x20 || code >= 0x7f) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\%03o", code);
+            literal += escape;
+        } else {
+            literal += character;
+        }
+    }
+    literal += '\"';
+    return literal;
+}/** string CppTranslator::StringLiteral(string_view a_text) **/
+
+
+
+/**/
+/*
+ string CppTranslator::NumberLiteral(double a_number)
+
+ NAME
+    NumberLiteral - Returns a C++ literal of the given number
+
+ SYNOPSIS
+    string CppTranslator::NumberLiteral(double a_number)
+        a_number --> The number
+
+ DESCRIPTION
+    17 significant digits always read back as exactly the same double. The literal is always a floating point literal, so that large
+    whole numbers are not taken for (overflowing) integer literals. A number literal too large for a double is infinite.
+
+ RETURNS
+    The literal
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+string CppTranslator::NumberLiteral(double a_number) {
+    if(isinf(a_number)) {
+        return a_number > 0 ? "numeric_limits<double>::infinity()" : "-numeric_limits<double>::infinity()";
+    }
+    //a subexpression such as 0 / 0 is folded into a nan, whose sign is printed
+    if(isnan(a_number)) {
+        return signbit(a_number) ? "-numeric_limits<double>::quiet_NaN()" : "numeric_limits<double>::quiet_NaN()";
+    }
+    char literal[64];
+    snprintf(literal, sizeof(literal), "%.17g", a_number);
+    string text = literal;
+    if(text.find_first_of(".e") == string::npos) {
+        text += ".0";
+    }
+    return text;
+}/** string CppTranslator::NumberLiteral(double a_number) **/
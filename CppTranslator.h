@@ -0,0 +1,62 @@
+/* CppTranslator.h
+ CppTranslator.h contains the CppTranslator class
+ CppTranslator is the class that translates a Duck program into a standalone C++ translation unit (it is the heart of the duck2cpp tool).
+ It works from the BytecodeProgram that the BytecodeCompiler compiles the recorded statements into, so the C++ program parses, evaluates
+ and fails exactly as the DuckVM does: every instruction becomes one line of C++. The variables of the Duck program become local variables
+ (each with a flag that records whether it has been assigned a value), the stack of numbers becomes a handful of local variables, the
+ statements that are jumped to get C++ labels (named after their Duck labels) and jumps become gotos. Printing, reading, arrays and
+ errors go through the DuckRuntime, which the translated program includes from DuckRuntime.h.
+*/
+
+#pragma once
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Bytecode.h"
+#include "Statement.h"
+
+class CppTranslator
+{
+public:
+    CppTranslator(const Statement &a_statements, const BytecodeProgram &a_program, const std::string &a_sourceFileName)
+        : m_statements(a_statements), m_program(a_program), m_sourceFileName(a_sourceFileName) {}
+    ~CppTranslator() {}
+
+    //Returns the C++ translation unit of the Duck program
+    std::string Translate();
+
+private:
+    //The statements of the Duck program, and the program that they were compiled into
+    const Statement &m_statements;
+    const BytecodeProgram &m_program;
+
+    //The name of the Duck source file, for the comment at the top of the translation
+    std::string m_sourceFileName;
+
+    //The C++ label of every instruction that is jumped to, by instruction index
+    std::map<int, std::string> m_jumpLabels;
+
+    //The identifiers of the program that are used as variables and as arrays
+    std::vector<int> m_variables;
+    std::vector<int> m_arrays;
+
+    //Finds the variables, the arrays and the jump targets of the program, and names the jump targets
+    void FindNames();
+
+    //Writes the C++ code of the instruction at the given index. a_stackDepth is the depth of the stack of numbers before the instruction,
+    //and is updated to the depth after it. Returns false if execution never continues past the instruction
+    bool TranslateInstruction(int a_instructionNum, int &a_stackDepth, std::ostringstream &a_code);
+
+    //Returns the name of the C++ variable of a Duck variable, or of the constant that holds the name of a Duck array
+    std::string VariableName(int a_identifierId) const;
+    std::string ArrayName(int a_identifierId) const;
+
+    //Returns a C++ string literal with the given text
+    static std::string StringLiteral(std::string_view a_text);
+
+    //Returns a C++ literal of the given number that reads back as exactly the same number
+    static std::string NumberLiteral(double a_number);
+};
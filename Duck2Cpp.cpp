@@ -0,0 +1,49 @@
+// Duck2Cpp.cpp : Defines the entry point for duck2cpp, which translates a Duck program into a standalone C++ program.
+//
+
+#include <fstream>
+#include <iostream>
+#include "Statement.h"
+#include "BytecodeCompiler.h"
+#include "ProgramOptimizer.h"
+#include "CppTranslator.h"
+
+using namespace std;
+
+
+int main( int argc, char *argv[] )
+{
+	const char *usage = "Usage: duck2cpp <Duck program filename> [<C++ output filename>]";
+	if(argc < 2 || argc > 3 || string(argv[1]).substr(0, 2) == "--")
+	{
+		cerr << usage << endl;
+		return 1;
+	}
+	string fileName = argv[1];
+
+	// The statements are recorded, optimized and compiled exactly as duckInterp --engine=vm does, so a program that cannot be recorded
+	// (an invalid or undefined label, for example) is reported here with the same error, and syntax errors in statements are
+	// compiled into the translation to be reported when the statement is executed.
+	Statement statements;
+	statements.RecordStatements(fileName);
+	ProgramOptimizer(statements).Optimize();
+	BytecodeCompiler compiler(statements);
+	BytecodeProgram program = compiler.Compile();
+	CppTranslator translator(statements, program, fileName);
+	string code = translator.Translate();
+
+	// The translation is written to the standard output unless an output file is given.
+	if(argc == 2)
+	{
+		cout << code;
+		return cout ? 0 : 1;
+	}
+	ofstream outputFile(argv[2]);
+	outputFile << code;
+	if(!outputFile)
+	{
+		cerr << "Could not write the file: " << argv[2] << endl;
+		return 1;
+	}
+	return 0;
+}
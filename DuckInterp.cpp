@@ -2,23 +2,185 @@
 //
 
 #include"DuckInterpreter.h"
+#include"SourceScanner.h"
 
 using namespace std;
 
 
 int main( int argc, char *argv[] )
 {
-	if (argc != 2)
+	const char *usage = "Usage: DuckInterp [--engine=interp|vm|jit] [--flush=line|block|never-until-exit] [--number-format=compat|round-trip] [--profile[=<json file>] | --sample-profile=<folded stacks file>] [--opt-report] [--cfg-dot=<dot file>] [--load-threads=<count>] [--scan-instruction-set=avx2|sse2|scalar] <filename>";
+
+	// The Duck program is either interpreted statement by statement (the default) or compiled to bytecode
+	// and run on the Duck virtual machine, which can also compile hot loops to machine code.
+	bool useVirtualMachine = false;
+	bool useJit = false;
+	// The output of the Duck program is buffered. By default it is flushed after every line when the standard output is
+	// a terminal, and only when the buffer is full (or the program reads input or exits) otherwise.
+	bool flushPolicyGiven = false;
+	FlushPolicy flushPolicy = FlushPolicy::Block;
+	// Numbers are printed with 6 significant digits unless exact (round trip) output is asked for.
+	NumberFormat numberFormat = NumberFormat::Compatible;
+	// With --profile, every statement is counted and timed, and the profile is reported when the program exits. It can also be
+	// written to a file as JSON with --profile=<json file>. Only the interpreter can be profiled.
+	bool profile = false;
+	string profileFileName;
+	// With --sample-profile, the running program is sampled every millisecond instead, and the samples are written as folded stacks.
+	string sampleFileName;
+	// With --opt-report, the statements that the optimizer pruned, the subexpressions that it folded and the loop invariant assignments that it found are reported before the program runs.
+	bool optimizationReport = false;
+	// With --cfg-dot, the control flow graph of the program, with its loops, is written in the dot language of Graphviz.
+	string controlFlowGraphFileName;
+	// A large source file is recorded on one thread per processor, unless --load-threads gives another number of threads.
+	unsigned loadThreadCount = 0;
+	string fileName;
+	for(int i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+		if(argument == "--engine=vm")
+		{
+			useVirtualMachine = true;
+			useJit = false;
+		}
+		else if(argument == "--engine=jit")
+		{
+			useVirtualMachine = true;
+			useJit = true;
+		}
+		else if(argument == "--engine=interp")
+		{
+			useVirtualMachine = false;
+			useJit = false;
+		}
+		else if(argument == "--flush=line" || argument == "--flush=block" || argument == "--flush=never-until-exit")
+		{
+			flushPolicyGiven = true;
+			if(argument == "--flush=line")
+			{
+				flushPolicy = FlushPolicy::Line;
+			}
+			else if(argument == "--flush=block")
+			{
+				flushPolicy = FlushPolicy::Block;
+			}
+			else
+			{
+				flushPolicy = FlushPolicy::NeverUntilExit;
+			}
+		}
+		else if(argument == "--number-format=compat")
+		{
+			numberFormat = NumberFormat::Compatible;
+		}
+		else if(argument == "--number-format=round-trip")
+		{
+			numberFormat = NumberFormat::RoundTrip;
+		}
+		else if(argument == "--profile")
+		{
+			profile = true;
+		}
+		else if(argument.substr(0, 10) == "--profile=" && argument.length() > 10)
+		{
+			profile = true;
+			profileFileName = argument.substr(10);
+		}
+		else if(argument.substr(0, 17) == "--sample-profile=" && argument.length() > 17)
+		{
+			sampleFileName = argument.substr(17);
+		}
+		else if(argument == "--opt-report")
+		{
+			optimizationReport = true;
+		}
+		else if(argument.substr(0, 10) == "--cfg-dot=" && argument.length() > 10)
+		{
+			controlFlowGraphFileName = argument.substr(10);
+		}
+		else if(argument.substr(0, 15) == "--load-threads=" && argument.length() > 15)
+		{
+			string count = argument.substr(15);
+			if(count.find_first_not_of("0123456789") != string::npos || count.length() > 4 || stoi(count) == 0)
+			{
+				cerr << usage << endl;
+				return 1;
+			}
+			loadThreadCount = stoi(count);
+		}
+		else if(argument.substr(0, 23) == "--scan-instruction-set=" && argument.length() > 23)
+		{
+			// The source is scanned with the best instruction set of the processor unless another one is chosen (to test them all).
+			if(!SourceScanner::SetInstructionSet(argument.substr(23)))
+			{
+				cerr << "The instruction set " << argument.substr(23) << " is not supported (the source is scanned with " << SourceScanner::GetInstructionSet() << ")" << endl;
+				return 1;
+			}
+		}
+		else if(argument.substr(0, 2) == "--" || !fileName.empty())
+		{
+			cerr << usage << endl;
+			return 1;
+		}
+		else
+		{
+			fileName = argument;
+		}
+	}
+	if (fileName.empty())
 	{
-		cerr << "Usage: DuckInterp <filename>" << endl;
+		cerr << usage << endl;
+		return 1;
+	}
+	if(profile && !sampleFileName.empty())
+	{
+		cerr << usage << endl;
+		return 1;
+	}
+	if(profile && useVirtualMachine)
+	{
+		cerr << "--profile can only be used with --engine=interp" << endl;
+		return 1;
+	}
+	if(!sampleFileName.empty() && useVirtualMachine)
+	{
+		cerr << "--sample-profile can only be used with --engine=interp" << endl;
 		return 1;
 	}
 	// Create the interpreter object and use it to record the statements and
 	// execute them.
 	DuckInterpreter duckInt;
+	if(flushPolicyGiven)
+	{
+		duckInt.SetFlushPolicy(flushPolicy);
+	}
+	duckInt.SetNumberFormat(numberFormat);
+	if(optimizationReport)
+	{
+		duckInt.EnableOptimizationReport();
+	}
+	if(!controlFlowGraphFileName.empty())
+	{
+		duckInt.SetControlFlowGraphFile(controlFlowGraphFileName);
+	}
+	duckInt.SetLoadThreadCount(loadThreadCount);
 
-	duckInt.RecordStatements(argv[1]);
-	duckInt.RunInterpreter();
+	duckInt.RecordStatements(fileName);
+	if(profile)
+	{
+		duckInt.EnableProfiler(profileFileName);
+	}
+	if(!sampleFileName.empty())
+	{
+		duckInt.EnableSampler(sampleFileName);
+	}
+	if(useVirtualMachine)
+	{
+		duckInt.RunVirtualMachine(useJit);
+	}
+	else
+	{
+		duckInt.RunInterpreter();
+	}
 
     return 0;
 }
@@ -14,7 +14,10 @@ using namespace std;
     void DuckInterpreter::RunInterpreter()
  
  DESCRIPTION
-    This function starts the interpreter and executes all the statements in the Duck program until an error occurs or a stop statement is encountered
+    This function starts the interpreter and executes all the statements in the Duck program until an error occurs or a stop statement is encountered.
+    Every statement is executed by DispatchStatement, in its fused form if the StatementFuser recognized it when the program was recorded.
+    The profiling and sampling loops below call DispatchStatement as well, but have it execute a fused pair of statements one statement at
+    a time, so that every statement is counted and sampled.
  
  RETURNS
     void
@@ -24,49 +27,299 @@ using namespace std;
  */
 /**/
 void DuckInterpreter::RunInterpreter() {
+    if(m_profiler) {
+        RunInterpreterWithProfiler();
+        return;
+    }
+    if(m_sampler) {
+        RunInterpreterWithSampler();
+        return;
+    }
     m_endFlag = false;
 	int nextStatement = 0;
-    string statement;
+    bool branchTaken;
 	while (true)
     {    
+        VerifyStatementCanRun(nextStatement);
         try {
-            statement = m_statements.GetStatement(nextStatement);
-        } catch(string e) {
-            //stop statement should have arrived before the end of a file
-            cerr << "Error: No more lines to execute. " << endl;
-            exit(1);
+            nextStatement = DispatchStatement(nextStatement, false, branchTaken);
+        } catch(DuckInterpreterException& e) {
+            //a fused pair of statements that failed in its second statement has moved nextStatement on to it
+            ReportStatementError(nextStatement, e);
         }
-        if(m_endFlag) {
-            cerr << "Error: There can be no statements after the end statement." << endl;
-            exit(1);
+		
+	}
+}/** void DuckInterpreter::RunInterpreter() **/
+
+
+/**/
+/*
+ void DuckInterpreter::RunInterpreterWithProfiler()
+ 
+ NAME
+    RunInterpreterWithProfiler - Executes all the statements of the Duck program one at a time, profiling every statement
+ 
+ SYNOPSIS
+    void DuckInterpreter::RunInterpreterWithProfiler()
+ 
+ DESCRIPTION
+    This function is the instrumented version of the loop of RunInterpreter, used when profiling is enabled. Every statement is counted
+    and timed by the profiler, and the outcome of every if statement is counted. Keeping the instrumentation in its own loop means that
+    the loop of RunInterpreter pays nothing for it. The output and the errors of the program are the same as with RunInterpreter, and the
+    profile is reported when the program exits.
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void DuckInterpreter::RunInterpreterWithProfiler() {
+    m_endFlag = false;
+	int nextStatement = 0;
+    bool branchTaken;
+    m_profiler->Start();
+	while (true)
+    {    
+        VerifyStatementCanRun(nextStatement);
+        try {
+            int statementNum = nextStatement;
+            m_profiler->StartStatement(statementNum);
+            nextStatement = DispatchStatement(nextStatement, true, branchTaken);
+            if(m_statements.GetStatement(statementNum).m_type == StatementType::IfStat) {
+                m_profiler->CountIfOutcome(statementNum, branchTaken);
+            }
+            m_profiler->EndStatement();
+        } catch(DuckInterpreterException& e) {
+            ReportStatementError(nextStatement, e);
         }
+		
+	}
+}/** void DuckInterpreter::RunInterpreterWithProfiler() **/
+
+
+/**/
+/*
+ void DuckInterpreter::RunInterpreterWithSampler()
+ 
+ NAME
+    RunInterpreterWithSampler - Executes all the statements of the Duck program one at a time, while the sampling profiler samples them
+ 
+ SYNOPSIS
+    void DuckInterpreter::RunInterpreterWithSampler()
+ 
+ DESCRIPTION
+    This function is the version of the loop of RunInterpreter that is used when sampling is enabled. The only addition is that the number
+    of every statement is stored for the sampling profiler before the statement is executed. The output and the errors of the program
+    are the same as with RunInterpreter, and the samples are written when the program exits.
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void DuckInterpreter::RunInterpreterWithSampler() {
+    m_endFlag = false;
+	int nextStatement = 0;
+    bool branchTaken;
+    m_sampler->Start();
+	while (true)
+    {    
+        VerifyStatementCanRun(nextStatement);
         try {
-            nextStatement = ExecuteStatement(statement, nextStatement);
+            SamplingProfiler::SetCurrentStatement(nextStatement);
+            nextStatement = DispatchStatement(nextStatement, true, branchTaken);
         } catch(DuckInterpreterException& e) {
-            cerr << endl;
-            cerr << "Error: Line " << nextStatement + 1 << ": \"" << statement << "\": " << endl;
-            cerr << "      " << e.what() << endl << endl;
-            exit(1);
+            ReportStatementError(nextStatement, e);
         }
 		
 	}
-}/** void DuckInterpreter::RunInterpreter() **/
+}/** void DuckInterpreter::RunInterpreterWithSampler() **/
 
 
 /**/
 /*
- int DuckInterpreter::ExecuteStatement(const string& a_statement, int a_nextStatement)
+ void DuckInterpreter::VerifyStatementCanRun(int a_statementNum)
+ 
+ NAME
+    VerifyStatementCanRun - Checks that the interpreter can go on to the given statement
+ 
+ SYNOPSIS
+    void DuckInterpreter::VerifyStatementCanRun(int a_statementNum)
+        a_statementNum --> The line number of the statement to be executed next
+ 
+ DESCRIPTION
+    A Duck program must end with a stop statement: running past the last statement, or on from an end statement, is an error. The
+    output printed so far is written before the error is reported.
+ 
+ RETURNS
+    void. Exits with 1 if the statement cannot be executed
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void DuckInterpreter::VerifyStatementCanRun(int a_statementNum) {
+    if(a_statementNum >= m_statements.GetStatementCount()) {
+        //stop statement should have arrived before the end of a file
+        m_output.Flush();
+        cerr << "Error: No more lines to execute. " << endl;
+        exit(1);
+    }
+    if(m_endFlag) {
+        m_output.Flush();
+        cerr << "Error: There can be no statements after the end statement." << endl;
+        exit(1);
+    }
+}/** void DuckInterpreter::VerifyStatementCanRun(int a_statementNum) **/
+
+
+/**/
+/*
+ void DuckInterpreter::ReportStatementError(int a_statementNum, DuckInterpreterException &a_exception)
+ 
+ NAME
+    ReportStatementError - Reports the error that a statement failed with, and exits
+ 
+ SYNOPSIS
+    void DuckInterpreter::ReportStatementError(int a_statementNum, DuckInterpreterException &a_exception)
+        a_statementNum --> The line number of the statement that failed
+        a_exception --> The error
+ 
+ DESCRIPTION
+    Whatever the statement printed before the error comes out before the error, which is reported with the line and the text of the
+    statement.
+ 
+ RETURNS
+    Does not return. The program exits with 1
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void DuckInterpreter::ReportStatementError(int a_statementNum, DuckInterpreterException &a_exception) {
+    m_output.Flush();
+    cerr << endl;
+    cerr << "Error: Line " << a_statementNum + 1 << ": \"" << m_statements.GetStatement(a_statementNum).m_text << "\": " << endl;
+    cerr << "      " << a_exception.what() << endl << endl;
+    exit(1);
+}/** void DuckInterpreter::ReportStatementError(int a_statementNum, DuckInterpreterException &a_exception) **/
+
+
+/**/
+/*
+ int DuckInterpreter::DispatchStatement(int &a_statementNum, bool a_singleStatement, bool &a_branchTaken)
+ 
+ NAME
+    DispatchStatement - Executes the statement at the given line the fastest way it can be executed
+ 
+ SYNOPSIS
+    int DuckInterpreter::DispatchStatement(int &a_statementNum, bool a_singleStatement, bool &a_branchTaken)
+        a_statementNum --> The line number of the statement. Moved on to the second statement of a fused pair once it is executed
+        a_singleStatement --> True if a fused pair of statements is to be executed as its first statement only
+        a_branchTaken --> Set to whether the goto was taken, if the statement is an if statement
+ 
+ DESCRIPTION
+    This is the per-statement step of the loops of RunInterpreter, RunInterpreterWithProfiler and RunInterpreterWithSampler. A statement
+    that the StatementFuser recognized is executed by ExecuteFusedStatement (which skips a loop invariant assignment whose values have
+    not changed), and any other statement by ExecuteStatement. The profiling and sampling loops pass a_singleStatement so that the
+    assignment and the if statement of a fused pair are executed, counted and sampled as the separate statements that they are.
+ 
+ RETURNS
+    The line number of the next statement to execute
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int DuckInterpreter::DispatchStatement(int &a_statementNum, bool a_singleStatement, bool &a_branchTaken) {
+    const FusedStatement &fused = m_fusedStatements[a_statementNum];
+    switch(fused.m_kind)
+    {
+    case FusedKind::None:
+        break;
+    case FusedKind::Branch:
+        a_branchTaken = EvaluateFusedValue(fused.m_condition) != 0;
+        return a_branchTaken ? fused.m_gotoTarget : a_statementNum + 1;
+    case FusedKind::AssignAndBranch:
+        if(a_singleStatement) {
+            double value = EvaluateFusedValue(fused.m_value);
+            ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+            m_symbolTable.RecordVariableValue(fused.m_slot, value);
+            return a_statementNum + 1;
+        }
+        return ExecuteFusedStatement(fused, a_statementNum);
+    default:
+        return ExecuteFusedStatement(fused, a_statementNum);
+    }
+
+    const CompiledStatement &statement = m_statements.GetStatement(a_statementNum);
+    if(statement.m_type == StatementType::IfStat) {
+        //the if statement is executed here rather than by ExecuteStatement, so that its outcome is known
+        int nextPos = 0;
+        a_branchTaken = EvaluateIfCondition(statement, nextPos);
+        return a_branchTaken ? EvaluateGotoStatement(statement, nextPos) : a_statementNum + 1;
+    }
+    return ExecuteStatement(statement, a_statementNum);
+}/** int DuckInterpreter::DispatchStatement(int &a_statementNum, bool a_singleStatement, bool &a_branchTaken) **/
+
+
+/**/
+/*
+ void DuckInterpreter::RunVirtualMachine(bool a_useJit)
+ 
+ NAME
+    RunVirtualMachine - Compiles the Duck program to bytecode and runs it on the Duck virtual machine
+ 
+ SYNOPSIS
+    void DuckInterpreter::RunVirtualMachine(bool a_useJit)
+        a_useJit --> True if the hot loops of the program are to be compiled to machine code by the DuckJit
+ 
+ DESCRIPTION
+    This function is the alternative to RunInterpreter. It compiles all the recorded statements once with the BytecodeCompiler, optimizes
+    the bytecode with the SsaOptimizer and runs the resulting program with the DuckVM, which hands its hot loops to the DuckJit if a_useJit
+    is set. The symbol table is given room for the temporary slots of the optimized program. The output and the errors of the program are
+    the same as with RunInterpreter.
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void DuckInterpreter::RunVirtualMachine(bool a_useJit) {
+    BytecodeCompiler compiler(m_statements);
+    BytecodeProgram program = compiler.Compile();
+    program = SsaOptimizer(program, m_statements.GetIdentifierCount()).Optimize();
+    m_symbolTable.SetSlotCount(m_statements.GetIdentifierCount() + program.m_temporaryCount);
+    DuckVM virtualMachine(program, m_statements, m_symbolTable, m_arrayTable, m_output, m_input);
+    unique_ptr<DuckJit> jit;
+    if(a_useJit) {
+        jit.reset(new DuckJit(program, m_statements, m_symbolTable, m_arrayTable, m_output, m_input));
+        virtualMachine.SetJit(jit.get());
+    }
+    virtualMachine.Run();
+}/** void DuckInterpreter::RunVirtualMachine(bool a_useJit) **/
+
+
+/**/
+/*
+ int DuckInterpreter::ExecuteStatement(const CompiledStatement& a_statement, int a_nextStatement)
  
  NAME
     ExecuteStatement - Executes the given statement
  
  SYNOPSIS
-    int DuckInterpreter::ExecuteStatement(const string& a_statement, int a_nextStatement)
+    int DuckInterpreter::ExecuteStatement(const CompiledStatement& a_statement, int a_nextStatement)
         a_statement --> The statement to be executed
         a_nextStatement --> The line number of the current statement
  
  DESCRIPTION
-    This function first figures out the type of the given statement and then executes it according to the type. It also returns the 
+    This function executes the given statement according to the type that was determined when it was recorded. It also returns the 
     the next line to be executed
  
  RETURNS
@@ -76,17 +329,10 @@ void DuckInterpreter::RunInterpreter() {
     Biplab Thapa Magar
  */
 /**/
-int DuckInterpreter::ExecuteStatement(const string& a_statement, int a_nextStatement)
+int DuckInterpreter::ExecuteStatement(const CompiledStatement& a_statement, int a_nextStatement)
 {
-    
-    //check if the statement ends with a semi-colon
-    if(a_statement[a_statement.length() - 1] != ';') {
-        throw DuckInterpreterException("';' is missing from end of statement");
-    }
-    StatementType type = GetStatementType(a_statement );
-
-	// Based on the type, execute the statement
-	switch (type)
+	// Based on the type that was determined when the statement was recorded, execute the statement
+	switch (a_statement.m_type)
 	{
 	case StatementType::ArithmeticStat:
         EvaluateArithmeticStatement(a_statement);
@@ -116,832 +362,483 @@ int DuckInterpreter::ExecuteStatement(const string& a_statement, int a_nextState
         EvaluateArrayDeclarationStatement(a_statement);
         return a_nextStatement + 1;
         break;
+    case StatementType::Invalid:
+        //the statement is missing its semi-colon or its type could not be determined
+        throw DuckInterpreterException(a_statement.m_classificationError);
 	default:
-		cerr << "Line " << a_statement << ": BUGBUG - program terminate: invalid return value from GetStatementType for the statement: " << a_statement << endl;
+		m_output.Flush();
+		cerr << "Line " << a_statement.m_text << ": BUGBUG - program terminate: invalid statement type for the statement: " << a_statement.m_text << endl;
 		exit(1);
 	}
     return a_nextStatement + 1;
-} /** int DuckInterpreter::ExecuteStatement(const string& a_statement, int a_nextStatement) **/
+} /** int DuckInterpreter::ExecuteStatement(const CompiledStatement& a_statement, int a_nextStatement) **/
 
 
 /**/
 /*
- int DuckInterpreter::ParseNextElement(const string &a_statement, int a_nextPos, string &a_stringValue, double &a_numValue)
+ int DuckInterpreter::ExecuteFusedStatement(const FusedStatement &a_fused, int &a_statementNum)
  
  NAME
-    ParseNextElement - Retrieves the next element in a statement (whether it be a number or a word) 
-        and returns the index of the starting position of the next element
+    ExecuteFusedStatement - Executes a fused statement, or a fused pair of statements
  
  SYNOPSIS
-    int DuckInterpreter::ParseNextElement(const string &a_statement, int a_nextPos, string &a_stringValue, double &a_numValue)
-        a_statement --> The statement whose element is to be parsed
-        a_nextPos --> The index of the starting position of the element to be parsed
-        a_stringValue --> The element that has been parsed 
-        a_numValue --> The number that has been parsed
+    int DuckInterpreter::ExecuteFusedStatement(const FusedStatement &a_fused, int &a_statementNum)
+        a_fused --> How the statement is to be executed
+        a_statementNum --> The line number of the statement. Moved on to the second statement of a pair once it is executed
+ 
  DESCRIPTION
-    This function retrieves the next element in the statement starting at the given index. It stores the element in either a_stringValue (it is not a number)
-    or in a_numValue (if it is a number).
+    This function does what ExecuteStatement does for the statements of the shapes that the StatementFuser recognizes, without walking
+    their tokens: variables are read straight from their slots and numbers are already known. The operands are read (and fail) in the
+    same order as when the statement is evaluated with the shunting yard algorithm. For a pair, the assignment is executed as the
+    statement at a_statementNum, and the branch as the statement after it. A loop invariant assignment is skipped as long as nothing has
+    changed the values that it last left its variable and its operands with, and executed as usual otherwise. It stays in its loop:
+    every iteration still compares the values against its snapshot, and only the evaluation of its expression is saved, so it fails where and when it would fail anyway.
+    The variables, array elements and operators are read, stored and evaluated in the same phases as with ExecuteStatement, so that the
+    SamplingProfiler tells them apart in fused statements too.
  
  RETURNS
-    The starting position of the next element in the statement. If there are no elements left, then it return -1.
+    The line number of the next statement to execute
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-int DuckInterpreter::ParseNextElement(const string &a_statement, int a_nextPos, string &a_stringValue, double &a_numValue) {
-    if(a_nextPos < 0) {
-        return -1;
-    }
-    int indexOfStartOfElement = a_nextPos;
-    //skip any white space starting from the index to the beginning of the closest element
-    while((a_statement.substr(indexOfStartOfElement)).length() != 0 && (a_statement[indexOfStartOfElement] == ' ' || a_statement[indexOfStartOfElement] == '\t')){
-        indexOfStartOfElement++;
-    }
-    
-    //If no element is left in the statement after removing white space
-    // Note: This case should not occur because:
-    //      i)in a previous call to ParseNextElement, a_nextPos must have been set to -1 and the user of this function should not
-    //              be calling ParseNextElement if a_nextPos is -1.
-    //      ii)No statement stored in m_statements is entirely empty. So even the first call to ParseNextElement must contain at least 1 non-white-space character
-    if((a_statement.substr(indexOfStartOfElement)).length() == 0) {
-        return -2;
-    }
-    
-    //since we calculated the index of where the element starts, let's calculate the length of the element
-    //length of the element is at least 1 by default since we have guaranteed that it is not white space
-    unsigned long lengthOfElement = GetLengthOfElement(a_statement, indexOfStartOfElement);
-    
-    
-    //now, check to see if string, digit, variable, or syntactic character
-    if(a_statement[indexOfStartOfElement] == '\"') {
-        a_stringValue = a_statement.substr(indexOfStartOfElement, lengthOfElement);
-    }
-    else if(IsAValidNumber(a_statement.substr(indexOfStartOfElement, lengthOfElement))) {
-        a_stringValue = "";
-        a_numValue = stod(a_statement.substr(indexOfStartOfElement, lengthOfElement));
-    }
-    else if(IsAReservedKeyword(a_statement.substr(indexOfStartOfElement, lengthOfElement))) {
-        a_stringValue = a_statement.substr(indexOfStartOfElement, lengthOfElement);
-    }
-    else if (IsAValidVariableName(a_statement.substr(indexOfStartOfElement, lengthOfElement))) {
-        a_stringValue = a_statement.substr(indexOfStartOfElement, lengthOfElement);
-    }
-    else if (IsASyntacticCharacter(a_statement.substr(indexOfStartOfElement, lengthOfElement))) {
-        a_stringValue = a_statement.substr(indexOfStartOfElement, lengthOfElement);
-    }
-    else {
-        string message = "'" + a_statement.substr(indexOfStartOfElement, lengthOfElement) + "' is an unrecognized expression.";
-        throw DuckInterpreterException(message);
-    }
-    
-    int newNextPos = indexOfStartOfElement + static_cast<int>(lengthOfElement);
-    
-    //Skip all white space to get the index to the next element in the statement
-    while((a_statement.substr(newNextPos)).length() > 0 && (a_statement[newNextPos] == ' ' || a_statement[newNextPos] == '\t')) {
-        newNextPos++;
+int DuckInterpreter::ExecuteFusedStatement(const FusedStatement &a_fused, int &a_statementNum)
+{
+    switch(a_fused.m_kind)
+    {
+    case FusedKind::AssignVariable: {
+        double value = EvaluateFusedValue(a_fused.m_value);
+        ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+        m_symbolTable.RecordVariableValue(a_fused.m_slot, value);
+        return a_statementNum + 1;
+    }
+    case FusedKind::StoreArrayElement: {
+        double index = GetFusedOperand(a_fused.m_index);
+        if(a_fused.m_valuePosition < 0) {
+            double value = EvaluateFusedValue(a_fused.m_value);
+            ExecutionPhaseScope phase(ExecutionPhase::ArrayAccess);
+            m_arrayTable.AddToArray(a_fused.m_slot, m_statements.GetIdentifierName(a_fused.m_slot), index, value);
+            return a_statementNum + 1;
+        }
+        //the value is evaluated and checked exactly as EvaluateArithmeticStatement does
+        const CompiledStatement &statement = m_statements.GetStatement(a_statementNum);
+        int nextPos = a_fused.m_valuePosition;
+        double value = EvaluateArithmeticExpression(statement, nextPos);
+        {
+            ExecutionPhaseScope phase(ExecutionPhase::ArrayAccess);
+            m_arrayTable.AddToArray(a_fused.m_slot, m_statements.GetIdentifierName(a_fused.m_slot), index, value);
+        }
+        Token nextToken;
+        nextPos = ParseNextElement(statement, nextPos, nextToken);
+        if(nextPos >= 0) {
+            throw DuckInterpreterException("Extraneous elements at the end of arithmetic statement.");
+        }
+        return a_statementNum + 1;
+    }
+    case FusedKind::Branch:
+        return EvaluateFusedValue(a_fused.m_condition) != 0 ? a_fused.m_gotoTarget : a_statementNum + 1;
+    case FusedKind::AssignAndBranch: {
+        double value = EvaluateFusedValue(a_fused.m_value);
+        {
+            ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+            m_symbolTable.RecordVariableValue(a_fused.m_slot, value);
+        }
+        a_statementNum++;
+        return EvaluateFusedValue(a_fused.m_condition) != 0 ? a_fused.m_gotoTarget : a_statementNum + 1;
+    }
+    case FusedKind::InvariantAssignment: {
+        //executing the assignment again would assign the value that the variable already holds
+        InvariantSnapshot &snapshot = m_invariantSnapshots[a_fused.m_snapshot];
+        bool isCurrent;
+        {
+            ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+            isCurrent = snapshot.m_isTaken && IsInvariantSnapshotCurrent(a_fused, snapshot);
+        }
+        if(isCurrent) {
+            return a_statementNum + 1;
+        }
+        EvaluateArithmeticStatement(m_statements.GetStatement(a_statementNum));
+        TakeInvariantSnapshot(a_fused, snapshot);
+        return a_statementNum + 1;
     }
-    
-    //If there is nothing after the current element
-    if((a_statement.substr(newNextPos)).length() == 0) {
-        newNextPos = -1;
+    default:
+        return ExecuteStatement(m_statements.GetStatement(a_statementNum), a_statementNum);
     }
-    
-    return newNextPos;
-} /** int DuckInterpreter::ParseNextElement(const string &a_statement, int a_nextPos, string &a_stringValue, double &a_numValue) **/
-
+} /** int DuckInterpreter::ExecuteFusedStatement(const FusedStatement &a_fused, int &a_statementNum) **/
 
 
 /**/
 /*
- unsigned long DuckInterpreter::GetLengthOfElement(const string& a_statement, int a_indexOfStartOfElement)
+ double DuckInterpreter::GetFusedOperand(const FusedOperand &a_operand)
  
  NAME
-    GetLengthOfElement - Returns the length of an element starting at the given index from the given statement
+    GetFusedOperand - Returns the value of an operand of a fused statement
  
  SYNOPSIS
-    unsigned long DuckInterpreter::GetLengthOfElement(const string& a_statement, int a_indexOfStartOfElement)
-        a_statement --> The statement from which the element's length is to be calculated
-        a_indexOfStartOfElement --> The index from which the element starts
-        
+    double DuckInterpreter::GetFusedOperand(const FusedOperand &a_operand)
+        a_operand --> The operand, a variable or a number
+ 
  DESCRIPTION
-    Calculates the length of the element starting at a_indexOfStartOfElement from the given statement.
+    Reads the variable from the symbol table, failing as ExpressionEvaluator::WalkVariable does if it has not been assigned a value.
  
  RETURNS
-    The length of the next element
+    The value of the operand
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-unsigned long DuckInterpreter::GetLengthOfElement(const string& a_statement, int a_indexOfStartOfElement) {
-    
-    //if no element starting at index, return 0;
-    if(a_statement.substr(a_indexOfStartOfElement).length() == 0) {
-        return 0;
-    }
-    
-    //now, length of element is one by default
-    unsigned long lengthOfElement = 1;
-    
-    //First, check if the element is a string
-    if(a_statement[a_indexOfStartOfElement] == '\"') {
-        //find the second '"' character marking the end of the string
-        size_t indexOfEndOfString = a_statement.find('\"', a_indexOfStartOfElement + 1);
-        //if not found, throw error
-        if(indexOfEndOfString == string::npos) {
-            throw DuckInterpreterException("Bad Syntax. End of string not defined. '\"' character is missing.");
-        } else {
-            //if found, adjust length of string accordingly
-            lengthOfElement = (indexOfEndOfString - a_indexOfStartOfElement) + 1;
-        }
-        
-        //If not a string, check if the element is a syntactic operator (like +, -, ;, ==, etc)
-    } else if(IsASyntacticCharacter(a_statement.substr(a_indexOfStartOfElement, 1))) {
-        //make sure the current element is not the final element in the statement
-        if((a_statement.substr(a_indexOfStartOfElement + 1)).length() > 0) {
-            //if it is a single character operator (like (, - , +, =, etc.), then length of element stays one
-            //if it is two character long operator (like ==, <=, etc), then increase length by one
-            if(IsASyntacticCharacter(a_statement.substr(a_indexOfStartOfElement, 2))) {
-                lengthOfElement++;
-            }
-        }
-    }
-    
-    //If not a syntactic operator or a string, the element must either be a variable, a number, or a keyword (like goto, read, print, etc)
-    else {
-        //extract the length of the element by looping through and looking to see if the next character is a space or an operator, which would mark the end of the element
-        for(int i = a_indexOfStartOfElement; i < a_statement.length(); i++) {
-            
-            //check if the current element is the final element in the statement
-            if((a_statement.substr(i + 1)).length() == 0) {
-                break;
-            }
-            //Now, check for operators that mark the end of an element
-            //f we find a match, it means that we have arrived at the end of the element
-            if(IsASyntacticCharacter(a_statement.substr(i + 1, 1))) {
-                break;
-            }
-            lengthOfElement++;
-        }
+double DuckInterpreter::GetFusedOperand(const FusedOperand &a_operand) {
+    if(a_operand.m_slot < 0) {
+        return a_operand.m_number;
+    }
+    ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+    double value;
+    if(!m_symbolTable.GetVariableValue(a_operand.m_slot, value)) {
+        string message = "The variable " + m_statements.GetIdentifierName(a_operand.m_slot) + " has not been assigned a value.";
+        throw DuckInterpreterException(message);
     }
-    
-    return lengthOfElement;
-}/** unsigned long DuckInterpreter::GetLengthOfElement(const string& a_statement, int indexOfStartOfElement) **/
-
+    return value;
+} /** double DuckInterpreter::GetFusedOperand(const FusedOperand &a_operand) **/
 
 
 /**/
 /*
- void DuckInterpreter::EvaluateArithmeticStatement(const string &a_statement)
+ double DuckInterpreter::EvaluateFusedValue(const FusedValue &a_value)
  
  NAME
-    EvaluateArithmeticStatement - Executes the given arithmetic statement, assigning the result of the expression to 
-        the right side of "=" to the variable/array at the left side of "="
+    EvaluateFusedValue - Returns the value of a value of a fused statement
  
  SYNOPSIS
-    void DuckInterpreter::EvaluateArithmeticStatement(const string &a_statement)
-        a_statement --> The arithmetic statement to be evaluated
+    double DuckInterpreter::EvaluateFusedValue(const FusedValue &a_value)
+        a_value --> An operand, or a binary operator applied to two operands
  
  DESCRIPTION
-    Executes the arithmetic statement by evaluating the arithmetic expression and assigning the resultant value to the variable/array to the left of "="
+    The left operand is read before the right one, and the operator is evaluated by EvaluateOperation, as in an arithmetic expression;
+        an operator that cannot be evaluated is reported as ExpressionEvaluator::ApplyOperator reports it.
  
  RETURNS
-    void
+    The value
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-void DuckInterpreter::EvaluateArithmeticStatement(const string &a_statement)
-{
-    // Record the variable that we will be assignning a value.
-    int nextPos = 0;
-    string variableOrArrayName;
-    double placeHolder;
-    nextPos = ParseNextElement(a_statement, nextPos, variableOrArrayName, placeHolder);
-    
-    //made sure of this when determining the type of statement
-    assert(!variableOrArrayName.empty());
-    
-    string nextString;
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, placeHolder);
-    
-    //check if array
-    bool isAnArray = false;
-    double index = -1;
-    if(nextString == "[") {
-        index = EvaluateArithmeticExpression(a_statement, nextPos);
-        isAnArray = true;
-        nextPos = ParseNextElement(a_statement, nextPos, nextString, placeHolder);
-        assert(nextString == "]");
-        nextPos = ParseNextElement(a_statement, nextPos, nextString, placeHolder);
+double DuckInterpreter::EvaluateFusedValue(const FusedValue &a_value) {
+    ExecutionPhaseScope phase(ExecutionPhase::Evaluation);
+    double left = GetFusedOperand(a_value.m_left);
+    if(!a_value.m_isBinary) {
+        return left;
     }
-    
-    //made sure of this when determining the type of statement
-    assert(nextString == "=");
+    double right = GetFusedOperand(a_value.m_right);
     double result;
-    
-    //now, evaluate everything to the right of the assignment operator to get the result
-    result = EvaluateArithmeticExpression(a_statement, nextPos);
-    
-    // Record the result into the variable or the array
-    if(isAnArray) {
-        m_arrayTable.AddToArray(variableOrArrayName, index, result);
-    } else {
-        m_symbolTable.RecordVariableValue(variableOrArrayName, result);
-    }
-    
-    //check for the correctness of syntax of the remaining statement
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, placeHolder);
-    if(nextPos >= 0) {
-        throw DuckInterpreterException("Extraneous elements at the end of arithmetic statement.");
+    if(!EvaluateOperation(a_value.m_operator, result, left, right)) {
+        string message = "Could not evaluate the operator '" + string(OperatorText(a_value.m_operator)) + "' with the operands " + to_string(left) + " and " + to_string(right);
+        throw DuckInterpreterException(message);
     }
-    
-} /** void DuckInterpreter::EvaluateArithmeticStatement(const string &a_statement) **/
+    return result;
+} /** double DuckInterpreter::EvaluateFusedValue(const FusedValue &a_value) **/
 
 
 /**/
 /*
- double DuckInterpreter::EvaluateArithmeticExpression(const string &a_statement, int &a_nextPos)
+ bool DuckInterpreter::IsInvariantSnapshotCurrent(const FusedStatement &a_fused, const InvariantSnapshot &a_snapshot) const
  
  NAME
-    EvaluateArithmeticExpression - Evaluates an arithmetic expression in a statement until it encounters a character that denotes
-        the end of an arithmetic expression. 
+    IsInvariantSnapshotCurrent - Finds out whether a loop invariant assignment would assign the value its variable already holds
  
  SYNOPSIS
-    double DuckInterpreter::EvaluateArithmeticExpression(const string &a_statement, int &a_nextPos)
-        a_statement --> The statement containing the expression to be evaluated
-        a_nextPos --> The position at which the expression starts
+    bool DuckInterpreter::IsInvariantSnapshotCurrent(const FusedStatement &a_fused, const InvariantSnapshot &a_snapshot) const
+        a_fused --> The loop invariant assignment
+        a_snapshot --> The values that the assignment last left its variable and its operands with
  
  DESCRIPTION
-    Evaluates the arithmetic expression starting at the given index and ending at a character that denotes the end of an arithmetic expression 
-    (namely: ',' ';' 'goto' and ']'). Returns the result of the expression. Also, updates the value of a_nextPos to be the position of the first
-    element after the end of the expression
+    The values are compared bit for bit, so that a nan matches itself and 0 does not match -0. If the operands hold the values that
+    the assignment last read, it would compute the same value, and if the variable still holds that value, nothing would change.
  
  RETURNS
-    The result of the arithmetic expression
+    True if the variable and every operand hold the values of the snapshot, false otherwise
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-double DuckInterpreter::EvaluateArithmeticExpression(const string &a_statement, int &a_nextPos) {
-    vector<string> operatorStack;
-    vector<double> numberStack;
-    string operatorOrVariable;
-    double numericOperand;
-    double result;
-    
-    //we want a temporaryNextPos so that a_nextPos can trail behind one step so that we don't lose the index of a comma or a semicolon when we return to the calling
-    //function. This is done in case the calling function wants to continue from where this function left off
-    int tempNextPos = a_nextPos;
-    tempNextPos = ParseNextElement(a_statement, tempNextPos, operatorOrVariable, numericOperand);
-    
-    result = numericOperand;
-    //if, at the beginning, the algorithmic expression is empty, then throw error because no value can be reasonably assigned to the receiving variable
-    if(tempNextPos < 0) {
-        throw DuckInterpreterException("Arithmetic expression missing.");
-    }
-    
-    //To accomodate for unary operators, we need to keep track of whether the last element in the expression was a number or another operator
-    //If the current element is an operator and the last element was also an operator, then the current element is a unary operator (unless the current operator is
-    //a ')' character). We use this variable to keep track of this
-    string lastElementInExpression = "";
-    
-    //shunting yard algorithm to determine final value of expression
-    //loop until end of arithmetic expression: the conditions in the while loop all mark the end of an arithmetic expression in various types of statements
-    while(tempNextPos >= 0 && operatorOrVariable != "," && operatorOrVariable != ";" && operatorOrVariable != "goto" && operatorOrVariable != "]") {
-        
-        //if the next element is not a number
-        if(operatorOrVariable.length() != 0  ) {
-            
-            //if not an arithmetic operator, check if it is a variable
-            if(!IsAnArithmeticOperation(operatorOrVariable)) {
-                
-                //check to see if variable is valid
-                if(!IsAValidVariableName(operatorOrVariable)) {
-                    //if the string variable is not a valid variable name, then error
-                    throw DuckInterpreterException("Invalid syntax for arithmetic expression.");
-                }
-                
-                //extract value from the variable/array
-                numericOperand = ExtractValueFromVariableOrArray(a_statement, tempNextPos, operatorOrVariable);
-                
-                if(lastElementInExpression == "number") {
-                    throw DuckInterpreterException ("Invalid arithmetic expression. Numbers must have an operand between them.");
-                }
-                //push value to numberStack
-                numberStack.push_back(numericOperand);
-                lastElementInExpression = "number";
-            //if the string is an operator
-            } else {
-                //handles the operators and the stack for us, as well as updating all the arguments sent to it
-                HandleOperator(operatorOrVariable, lastElementInExpression, operatorStack, numberStack);
-            }
-        //if next element in the expression is a number
-        } else {
-            if(lastElementInExpression == "number") {
-                throw DuckInterpreterException ("Invalid arithmetic expression. Numbers must have an operand between them.");
-            }
-            numberStack.push_back(numericOperand);
-            lastElementInExpression = "number";
-        }
-        
-        a_nextPos = tempNextPos;
-        tempNextPos = ParseNextElement(a_statement, tempNextPos, operatorOrVariable, numericOperand);
-    }
-    
-    //finished iterating through the entire arithmetic expression
-    //check for possible error
-    if(lastElementInExpression == "operator") {
-        throw DuckInterpreterException("Invalid arithmetic expression. Arithmetic expressions cannot end with operators.");
+bool DuckInterpreter::IsInvariantSnapshotCurrent(const FusedStatement &a_fused, const InvariantSnapshot &a_snapshot) const {
+    double value;
+    if(!m_symbolTable.GetVariableValue(a_fused.m_slot, value) || memcmp(&value, &a_snapshot.m_values[0], sizeof(double)) != 0) {
+        return false;
     }
-    
-    //evaluate the rest of the results left in the stack
-    while(!operatorStack.empty() && !numberStack.empty()) {
-        if(operatorStack.back() == "(") {
-            throw DuckInterpreterException("Invalid Arithmetic Expression. Ending parenthesis missing.");
+    for(size_t operand = 0; operand < a_fused.m_operandSlots.size(); operand++) {
+        if(!m_symbolTable.GetVariableValue(a_fused.m_operandSlots[operand], value) ||
+           memcmp(&value, &a_snapshot.m_values[operand + 1], sizeof(double)) != 0) {
+            return false;
         }
-        EvaluateTopOfStack(operatorStack, numberStack);
-    }
-    
-    
-    //if there are elements (operands or operator) still left, throw error
-    if(numberStack.size() > 1 || !operatorStack.empty()) {
-        throw DuckInterpreterException("Invalid Arithmetic Expression");
     }
-    
-    result = numberStack.back();
-    return result;
-} /* double DuckInterpreter::EvaluateArithmeticExpression(const string &a_statement, int &a_nextPos) */
-
+    return true;
+} /** bool DuckInterpreter::IsInvariantSnapshotCurrent(const FusedStatement &a_fused, const InvariantSnapshot &a_snapshot) const **/
 
 
 /**/
 /*
- void DuckInterpreter::HandleOperator(string& a_operator, string& a_lastElement, vector<string>& a_operatorStack, vector<double>& a_numberStack)
+ void DuckInterpreter::TakeInvariantSnapshot(const FusedStatement &a_fused, InvariantSnapshot &a_snapshot) const
  
  NAME
-    HandleOperator - Depending on the given operator, this function evaluates the numbers and operators in the stacks, and updates the
-        operator stack and number stack accordingly.
+    TakeInvariantSnapshot - Records the values of the variable and the operands of a loop invariant assignment
  
  SYNOPSIS
-    void DuckInterpreter::HandleOperator(string& a_operator, string& a_lastElement, vector<string>& a_operatorStack, vector<double>& a_numberStack)
-        a_operator --> The next operator in the arithmetic expression
-        a_lastElement --> String to inform whether the last element in the arithmetic expression was a number or operator
-        a_operatorStack --> The operator stack being used to evaluate the arithmetic expression
-        a_numberStack --> The number stack being used to evaluate the arithmetic expression
+    void DuckInterpreter::TakeInvariantSnapshot(const FusedStatement &a_fused, InvariantSnapshot &a_snapshot) const
+        a_fused --> The loop invariant assignment, which has just been executed
+        a_snapshot --> Set to the values
  
  DESCRIPTION
-    When the ArithmeticExpression function comes across an operator, it call this function to handle the evaluation of the operators and the two stacks
-    depending on the type of the operator and the last element in the arithmetic expression. This function also updates the a_lastElement value and the
-    two stacks to reflect the effect of the operator
+    The assignment has just been executed without error, so its variable and all of its operands have been assigned values. The
+    operands are not the variable, so they still hold the values that the assignment read.
  
  RETURNS
     void
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-void DuckInterpreter::HandleOperator(string& a_operator, string& a_lastElement, vector<string>& a_operatorStack, vector<double>& a_numberStack) {
-    //shunting yard algorithm
-    if(a_operator == "(") {
-        
-        //check for possible syntax error
-        if(a_lastElement == "number") {
-            throw DuckInterpreterException("Invalid arithmetic expression.");
-        }
-        
-        //push into stack
-        a_operatorStack.push_back("(");
-        a_lastElement = "operator";
-    } else if (a_operator == ")") {
-        //check for possible syntax error
-        if(a_operatorStack.back() == "(") {
-            throw DuckInterpreterException("Invalid arithmetic expression. There must be an arithmetic expression inside parentheses.");
-        }
-        if(a_lastElement != "number") {
-            throw DuckInterpreterException("Invalid arithmetic expression.");
-        }
-        
-        //now, pop operator and number stack to evaluate the elements at the top of the stack
-        //push evaluated number back into number stack
-        //do this until we find the opening bracket
-        while(!a_operatorStack.empty() && !a_numberStack.empty() && a_operatorStack.back() != "(") {
-            EvaluateTopOfStack(a_operatorStack, a_numberStack);
-        }
-        //if the opening bracket is not found, throw error
-        if(a_operatorStack.empty()) {
-            throw DuckInterpreterException("Invalid arithmetic expression. Opening parenthesis missing.");
-        }
-        //pop opening bracket
-        a_operatorStack.pop_back();
-        //a pair of parentheses resolve into a number
-        a_lastElement = "number";
-    } else {
-        //check if the current operator is a unary operator by checking if the last element was an operator  or by checking if this is the first element in the
-        //arithmetic expression
-        if(a_lastElement == "operator" || a_lastElement == "") {
-            //if previous operator was also unary, then throw error
-            if(!a_operatorStack.empty() && (a_operatorStack.back()).substr(0, 1) == "u") {
-                string message = (a_operatorStack.back()).substr(5) + a_operator + " is an invalid operation";
-                throw DuckInterpreterException(message);
-            }
-            
-            //check if this operator is +, -, or !. If not, then it is an error
-            if(a_operator == "+" || a_operator == "-" || a_operator == "!") {
-                //mark as unary
-                a_operator = "unary" + a_operator;
-            } else {
-                throw DuckInterpreterException("Invalid Arithmetic Expression");
-            }
-        }
-        
-        //now, pop and evaluate all operators with a precedence greater than or equal to the current operator
-        while(!a_operatorStack.empty() && !a_numberStack.empty() && FindPrecedence(a_operator) <= FindPrecedence(a_operatorStack.back())) {
-            EvaluateTopOfStack(a_operatorStack, a_numberStack);
-        }
-        a_operatorStack.push_back(a_operator);
-        a_lastElement = "operator";
-    }
-} /* void DuckInterpreter::HandleOperator(string& a_operator, string& a_lastElement, vector<string>& a_operatorStack, vector<double>& a_numberStack) */
+void DuckInterpreter::TakeInvariantSnapshot(const FusedStatement &a_fused, InvariantSnapshot &a_snapshot) const {
+    a_snapshot.m_values.resize(a_fused.m_operandSlots.size() + 1);
+    m_symbolTable.GetVariableValue(a_fused.m_slot, a_snapshot.m_values[0]);
+    for(size_t operand = 0; operand < a_fused.m_operandSlots.size(); operand++) {
+        m_symbolTable.GetVariableValue(a_fused.m_operandSlots[operand], a_snapshot.m_values[operand + 1]);
+    }
+    a_snapshot.m_isTaken = true;
+} /** void DuckInterpreter::TakeInvariantSnapshot(const FusedStatement &a_fused, InvariantSnapshot &a_snapshot) const **/
 
 
 /**/
 /*
- double DuckInterpreter::ExtractValueFromVariableOrArray(const string& a_statement, int &a_nextPos, string& arrayOrVariableName)
+ void DuckInterpreter::WriteControlFlowGraph(const string &a_sourceFileName)
  
  NAME
-    ExtractValueFromVariableOrArray - Takes in a statement, the index of the location of the variable/array, and the variable/array name and
-        returns the value found in the variable/array
+    WriteControlFlowGraph - Writes the control flow graph of the recorded statements
  
  SYNOPSIS
-    double DuckInterpreter::ExtractValueFromVariableOrArray(const string& a_statement, int &a_nextPos, string& arrayOrVariableName)
-        a_statement --> The statement containing the variable or the array
-        a_nextPos --> The position of element right after the name of the variable (so, in case of an array, it denotes the position of the '[' character)
-        arrayOrVariableName --> The name of the variable/array
+    void DuckInterpreter::WriteControlFlowGraph(const string &a_sourceFileName)
+        a_sourceFileName --> The name of the Duck source file, which names the graph
  
  DESCRIPTION
-    This array figures out whether a string denotes a variable or an array and retrieves the value stored in the variable or array. It takes in the statement
-    containing the variable, the position at which the name of the variable or array ends, and the name of the variable or array to retrieve the variable/array
+    The graph is written in the dot language of Graphviz to the file that was set with SetControlFlowGraphFile. The program exits if
+    the file cannot be written.
  
  RETURNS
-    The value stored in the variable or array
+    void
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-double DuckInterpreter::ExtractValueFromVariableOrArray(const string& a_statement, int &a_nextPos, string& arrayOrVariableName) {
-    
-    //the value to be extracted from the variable or array
-    double returnValue;
-    
-    //first, check if the arrayOrVariableName denotes an array by reading the next element in the statement and seeing if it is a "[" character
-    string arrayIndexString;
-    double placeHolder;
-    int tempNextPosForArray = ParseNextElement(a_statement, a_nextPos, arrayIndexString, placeHolder);
-    if(arrayIndexString == "[") {
-        //evaluate the index
-        double index = EvaluateArithmeticExpression(a_statement, tempNextPosForArray);
-        //now, get the ']' character
-        tempNextPosForArray  = ParseNextElement(a_statement, tempNextPosForArray, arrayIndexString, placeHolder);
-        if(arrayIndexString!= "]") {
-            throw DuckInterpreterException("Invalid syntax for using arrays. ']' character is missing. ");
-        }
-        a_nextPos = tempNextPosForArray;
-        if(!m_arrayTable.GetValue(arrayOrVariableName, index, returnValue)) {
-            //if array value not specified, throw error
-            string message = "The value at index " + to_string(static_cast<int>(index)) + " of the array " + arrayOrVariableName + " has not been initialized.";
-            throw DuckInterpreterException(message);
-        }
-        
-    }
-    //if not an array, it must be a variable
-    //if variable has not been assigned a value, then throw error
-    else if(!(m_symbolTable.GetVariableValue(arrayOrVariableName, returnValue))) {
-        string message = "The variable " + arrayOrVariableName + " has not been assigned a value.";
-        throw DuckInterpreterException(message);
-    }
-    
-    return returnValue;
-}/* double DuckInterpreter::ExtractValueFromVariableOrArray(const string& a_statement, int &a_nextPos, string& arrayOrVariableName) */
+void DuckInterpreter::WriteControlFlowGraph(const string &a_sourceFileName) {
+    ofstream file(m_controlFlowGraphFileName);
+    ControlFlowGraph(m_statements).WriteGraphviz(file, a_sourceFileName);
+    if(!file) {
+        cerr << "Could not write the control flow graph to the file: " << m_controlFlowGraphFileName << endl;
+        exit(1);
+    }
+} /** void DuckInterpreter::WriteControlFlowGraph(const string &a_sourceFileName) **/
 
 
 /**/
 /*
- int DuckInterpreter::FindPrecedence(string a_op)
+ void DuckInterpreter::EvaluateArithmeticStatement(const CompiledStatement &a_statement)
  
  NAME
-    FindPrecedence - Returns the precedence value of an operator
+    EvaluateArithmeticStatement - Executes the given arithmetic statement, assigning the result of the expression to 
+        the right side of "=" to the variable/array at the left side of "="
  
  SYNOPSIS
-    int DuckInterpreter::FindPrecedence(string a_op)
-        a_op --> The operator whose precedence is to be calculated
+    void DuckInterpreter::EvaluateArithmeticStatement(const CompiledStatement &a_statement)
+        a_statement --> The arithmetic statement to be evaluated
  
  DESCRIPTION
-    Returns the precedence of an operator. If the operator is invalid, throws an exception
+    Executes the arithmetic statement by evaluating the arithmetic expression and assigning the resultant value to the variable/array to the left of "="
  
  RETURNS
-    The value stored in the variable or array
+    void
  
  AUTHOR
     Biplab Thapa Magar
  */
 /**/
-int DuckInterpreter::FindPrecedence(string a_op) {
-    if(a_op.length() >= 2) {
-        if(a_op.substr(0, 2) == "==") {
-            return 2;
-        }
-        if(a_op.substr(0, 2) == ">=") {
-            return 2;
-        }
-        if(a_op.substr(0, 2) == "<=") {
-            return 2;
-        }
-        if(a_op.substr(0, 2) == "!=") {
-            return 2;
-        }
-        if(a_op.substr(0, 6) == "unary+") {
-            return 5;
-        }
-        if(a_op.substr(0, 6) == "unary-") {
-            return 5;
-        }
-        if(a_op.substr(0, 6) == "unary!") {
-            return 5;
-        }
-        
+void DuckInterpreter::EvaluateArithmeticStatement(const CompiledStatement &a_statement)
+{
+    // Record the variable that we will be assignning a value.
+    int nextPos = 0;
+    Token variableOrArray;
+    nextPos = ParseNextElement(a_statement, nextPos, variableOrArray);
+    
+    //made sure of this when determining the type of statement
+    assert(variableOrArray.m_type == TokenType::Identifier);
+    
+    Token nextToken;
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+    
+    //check if array
+    bool isAnArray = false;
+    double index = -1;
+    if(nextToken.IsOperator(OperatorCode::OpenBracket)) {
+        index = EvaluateArithmeticExpression(a_statement, nextPos);
+        isAnArray = true;
+        nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+        assert(nextToken.IsOperator(OperatorCode::CloseBracket));
+        nextPos = ParseNextElement(a_statement, nextPos, nextToken);
     }
     
-    if(a_op.length() == 1) {
-        switch(a_op[0]) {
-            case '<':
-                return 2;
-                break;
-            case '>':
-                return 2;
-                break;
-            case ')':
-                return 1;
-                break;
-            case '(':
-                return 1;
-                break;
-            case '+':
-                return 3;
-                break;
-            case '-':
-                return 3;
-                break;
-            case '/':
-                return 4;
-                break;
-            case '*':
-                return 4;
-                break;
-            case '[':
-                return 0;
-                break;
-            case ']':
-                return 0;
-                break;
-            default:
-                return -1;
-                break;
-        }
+    //made sure of this when determining the type of statement
+    assert(nextToken.IsOperator(OperatorCode::Assign));
+    double result;
+    
+    //now, evaluate everything to the right of the assignment operator to get the result
+    result = EvaluateArithmeticExpression(a_statement, nextPos);
+    
+    // Record the result into the variable or the array
+    if(isAnArray) {
+        ExecutionPhaseScope phase(ExecutionPhase::ArrayAccess);
+        m_arrayTable.AddToArray(variableOrArray.m_identifierId, m_statements.GetIdentifierName(variableOrArray.m_identifierId), index, result);
+    } else {
+        ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+        m_symbolTable.RecordVariableValue(variableOrArray.m_identifierId, result);
+    }
+    
+    //check for the correctness of syntax of the remaining statement
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+    if(nextPos >= 0) {
+        throw DuckInterpreterException("Extraneous elements at the end of arithmetic statement.");
     }
     
-    //if the operator is not recognized, throw error
-    throw DuckInterpreterException("Invalid operator");
-    return -1;
-} /* int DuckInterpreter::FindPrecedence(string a_op) */
+} /** void DuckInterpreter::EvaluateArithmeticStatement(const CompiledStatement &a_statement) **/
 
 
 /**/
 /*
- void DuckInterpreter::EvaluateTopOfStack(vector<string>& a_operatorStack, vector<double>& a_numberStack)
+ bool DuckInterpreter::EvaluateOperation(ExpressionOperator a_operation, double& a_result, double a_leftOperand, double a_rightOperand)
  
  NAME
-    EvaluateTopOfStack - Evaluates the numbers at the top of the number stack with respect to the operator at 
-        the top of the operator stack and pushes the result back into the number stack
+    EvaluateOperation - Evaluates the result of two (or one, in the case of unary operators) numbers with respect to the given operator. 
  
  SYNOPSIS
-    void DuckInterpreter::EvaluateTopOfStack(vector<string>& a_operatorStack, vector<double>& a_numberStack)
-        a_operatorStack --> The stack containing the operators 
-        a_numberStack --> The stack containing the operands
+    bool DuckInterpreter::EvaluateOperation(ExpressionOperator a_operation, double& a_result, double a_leftOperand, double a_rightOperand)
+        a_operation --> The operation with respect to which the operands are evaluated
+        a_result --> The result of the operation
+        a_leftOperand --> The operand at the left of the operation
+        a_rightOperand --> The operand at the right of the operation. In the case of unary operations, this parameter is defaulted to 0
  
  DESCRIPTION
-    This function evaluates the numbers at the top of the number stack using the operator at the top of the 
-        operator stack. Then, it pushes the resulting number back into the number stack.
+    Evaluates the operation on the given operand/s with EvaluateExpressionOperator, which the ProgramOptimizer folds constant
+    subexpressions with as well. Returns true if the operation was successful, false otherwise
  
  RETURNS
-    void
+    Returns true if the operation was successful. False otherwise (parentheses cannot be evaluated).
  
  AUTHOR
     Biplab Thapa Magar
  */
 /**/
-void DuckInterpreter::EvaluateTopOfStack(vector<string>& a_operatorStack, vector<double>& a_numberStack) {
-    double result;
-    if(a_operatorStack.back().substr(0, 5) == "unary") {
-        
-        //if unary, evaluate only one number per operator
-        //throw error if could not evaluate
-        if(!EvaluateOperation(a_operatorStack.back(), result, a_numberStack.back())) {
-            string message = "Could not evaluate the operator '" + a_operatorStack.back() + "' with the operand " + to_string(a_numberStack.back());
-            throw DuckInterpreterException(message);
-        }
-        a_operatorStack.pop_back();
-        a_numberStack.pop_back();
-        a_numberStack.push_back(result);
-    } else {
-        //if binary, evaluate two numbers per operator
-        if(!EvaluateOperation(a_operatorStack.back(), result, a_numberStack[a_numberStack.size() - 2], a_numberStack[a_numberStack.size() - 1])){
-            string message = "Could not evaluate the operator '" + a_operatorStack.back() + "' with the operands " + to_string(a_numberStack[a_numberStack.size() - 2])+ " and " + to_string(a_numberStack[a_numberStack.size() - 1]);
-            throw DuckInterpreterException(message);
-        }
-        a_operatorStack.pop_back();
-        a_numberStack.pop_back();
-        a_numberStack.pop_back();
-        a_numberStack.push_back(result);
-    }
-} /* void DuckInterpreter::EvaluateTopOfStack(vector<string>& a_operatorStack, vector<double>& a_numberStack) */
+bool DuckInterpreter::EvaluateOperation(ExpressionOperator a_operation, double& a_result, double a_leftOperand, double a_rightOperand) {
+    return EvaluateExpressionOperator(a_operation, a_result, a_leftOperand, a_rightOperand);
+} /* bool DuckInterpreter::EvaluateOperation(ExpressionOperator a_operation, double& a_result, double a_leftOperand, double a_rightOperand) */
 
 
 /**/
 /*
- bool DuckInterpreter::EvaluateOperation(string a_operation, double& a_result, double a_leftOperand, double a_rightOperand)
+ int DuckInterpreter::EvaluateIfStatement(const CompiledStatement& a_statement, int a_nextStatement)
  
  NAME
-    EvaluateOperation - Evaluates the result of two (or one, in the case of unary operators) numbers with respect to the given operator. 
+    EvaluateIfStatement - Evaluate an if statement
  
  SYNOPSIS
-    bool DuckInterpreter::EvaluateOperation(string a_operation, double& a_result, double a_leftOperand, double a_rightOperand)
-        a_operation --> The operation with respect to which the operands are evaluated
-        a_result --> The result of the operation
-        a_leftOperand --> The operand at the left of the operation
-        a_rightOperand --> The operand at the right of the operation. In the case of unary operations, this parameter is defaulted to 0
+    int DuckInterpreter::EvaluateIfStatement(const CompiledStatement& a_statement, int a_nextStatement)
+        a_statement --> The if statement to be evaluated
+        a_nextStatement --> The line number of this statement
  
  DESCRIPTION
-    Evaluates the operation on the given operand/s. Returns true if the operation was successful, false otherwise
+    Evaluated an if statement by seeing if the condition was met (see EvaluateIfCondition). If it was met, then the goto statement is evaluated and the number of the next
+        line is calculated. If the condition has not been met, the function returns the value a_nextStatement + 1 (i.e. the number of the line that comes
+        right after this line
  
  RETURNS
-    Returns true if the operation was successful. False otherwise.
+    The number of the next line to execute/evaluate
  
  AUTHOR
     Biplab Thapa Magar
  */
 /**/
-bool DuckInterpreter::EvaluateOperation(string a_operation, double& a_result, double a_leftOperand, double a_rightOperand) {
-    assert(IsAnArithmeticOperation(a_operation));
-    //deal with two-character long operations
-    if(a_operation.length() >= 2) {
-        if(a_operation.substr(0, 2) == "==") {
-            a_result = (a_leftOperand == a_rightOperand);
-            return true;
-        }
-        else if(a_operation.substr(0, 2) == ">=") {
-            a_result = (a_leftOperand >= a_rightOperand);
-            return true;
-        }
-        else if(a_operation.substr(0, 2) == "<=") {
-            a_result = (a_leftOperand <= a_rightOperand);
-            return true;
-        }
-        else if(a_operation.substr(0, 2) == "!=") {
-            a_result = (a_leftOperand != a_rightOperand);
-            return true;
-        } else if(a_operation.substr(0, 6) == "unary-") {
-            a_result = -1 * a_leftOperand;
-            return true;
-        } else if(a_operation.substr(0, 6) == "unary+") {
-            a_result = a_leftOperand;
-            return true;
-        }else if(a_operation.substr(0, 6) == "unary!") {
-            if(a_leftOperand != 0) {
-                a_result = 0;
-            } else {
-                a_result = 1;
-            }
-            return true;
-        }else {
-            return false;
-        }
-        
+int DuckInterpreter::EvaluateIfStatement(const CompiledStatement& a_statement, int a_nextStatement) {
+    int nextPos = 0;
+    if(!EvaluateIfCondition(a_statement, nextPos))
+    {
+        return a_nextStatement + 1;
     }
     
-    if(a_operation.length() == 1) {
-        switch(a_operation[0]) {
-            case '!':
-                if(a_leftOperand != 0) {
-                    a_result = 0;
-                } else {
-                    a_result = 1;
-                }
-                return true;
-            case '<':
-                a_result = (a_leftOperand < a_rightOperand);
-                return true;
-                break;
-            case '>':
-                a_result = (a_leftOperand > a_rightOperand);
-                return true;
-                break;
-            case '+':
-                a_result = (a_leftOperand + a_rightOperand);
-                return true;
-                break;
-            case '-':
-                a_result = (a_leftOperand - a_rightOperand);
-                return true;
-                break;
-            case '/':
-                a_result = (a_leftOperand / a_rightOperand);
-                return true;
-                break;
-            case '*':
-                a_result = (a_leftOperand * a_rightOperand);
-                return true;
-                break;
-            default:
-                return false;
-                break;
-        }
-    }
-    return false;
-} /* bool DuckInterpreter::EvaluateOperation(string a_operation, double& a_result, double a_leftOperand, double a_rightOperand) */
+    int labelLocation = EvaluateGotoStatement(a_statement, nextPos);
+    
+    return labelLocation;
+} /* int DuckInterpreter::EvaluateIfStatement(const CompiledStatement& a_statement, int a_nextStatement) */
 
 
 /**/
 /*
- int DuckInterpreter::EvaluateIfStatement(const string& a_statement, int a_nextStatement)
+ bool DuckInterpreter::EvaluateIfCondition(const CompiledStatement& a_statement, int &a_nextPos)
  
  NAME
-    EvaluateIfStatement - Evaluate an if statement
+    EvaluateIfCondition - Evaluates the condition of an if statement
  
  SYNOPSIS
-    int DuckInterpreter::EvaluateIfStatement(const string& a_statement, int a_nextStatement)
-        a_statement --> The if statement to be evaluated
-        a_nextStatement --> The line number of this statement
+    bool DuckInterpreter::EvaluateIfCondition(const CompiledStatement& a_statement, int &a_nextPos)
+        a_statement --> The if statement whose condition is to be evaluated
+        a_nextPos --> Set to the index of the element after the condition (where the goto part of the statement starts)
  
  DESCRIPTION
-    Evaluated an if statement by seeing if the condition was met. If it was met, then the goto statement is evaluated and the number of the next
-        line is calculated. If the condition has not been met, the function returns the value a_nextStatement + 1 (i.e. the number of the line that comes
-        right after this line
+    Checks that the condition of the if statement is enclosed by parentheses and evaluates it.
  
  RETURNS
-    The number of the next line to execute/evaluate
+    True if the condition was met (it is not 0), false otherwise
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-int DuckInterpreter::EvaluateIfStatement(const string& a_statement, int a_nextStatement) {
+bool DuckInterpreter::EvaluateIfCondition(const CompiledStatement& a_statement, int &a_nextPos) {
     // Get past of the "if" in the if statement.
-    int nextPos = 0;
-    string resultString;
-    double placeHolder;
-    nextPos = ParseNextElement(a_statement, nextPos, resultString, placeHolder);
-    assert(resultString == "if" );
+    Token resultToken;
+    a_nextPos = ParseNextElement(a_statement, 0, resultToken);
+    assert(resultToken.IsKeyword(Keyword::If));
     
-    if(a_statement[nextPos] != '(') {
+    if(a_nextPos < 0 || !a_statement.m_tokens[a_nextPos].IsOperator(OperatorCode::OpenParenthesis)) {
         throw DuckInterpreterException("If statement conditions must be inclosed by parentheses.");
     }
     
     //get result
-    double result = EvaluateArithmeticExpression(a_statement, nextPos);
+    double result = EvaluateArithmeticExpression(a_statement, a_nextPos);
     
-    if (result == 0)
-    {
-        return a_nextStatement + 1;
-    }
-    
-    int labelLocation = EvaluateGotoStatement(a_statement, nextPos);
-    
-    return labelLocation;
-} /* int DuckInterpreter::EvaluateIfStatement(const string& a_statement, int a_nextStatement) */
+    return result != 0;
+} /* bool DuckInterpreter::EvaluateIfCondition(const CompiledStatement& a_statement, int &a_nextPos) */
 
 
 
 /**/
 /*
- int DuckInterpreter::EvaluateGotoStatement(const string& a_statement, int a_nextStatement, int a_nextPos)
+ int DuckInterpreter::EvaluateGotoStatement(const CompiledStatement& a_statement, int a_nextStatement, int a_nextPos)
  
  NAME
     EvaluateGotoStatement - Evaluate a goto statement
  
  SYNOPSIS
-    int DuckInterpreter::EvaluateGotoStatement(const string& a_statement, int a_nextStatement, int a_nextPos)
+    int DuckInterpreter::EvaluateGotoStatement(const CompiledStatement& a_statement, int a_nextStatement, int a_nextPos)
         a_statement --> The goto statement to be evaluated
         a_nextPos --> The index at which the goto statement starts (because goto statments can start in the second half of an if statement). a_nextPos has a
             default value of 0
  
  DESCRIPTION
-    Evaluates a goto statement and returns the line number of the line that the label in the goto statement corresponds to.
+    Evaluates a goto statement and returns the line number of the line that the label in the goto statement corresponds to. If the goto
+    is the well formed one that was found when the program was recorded, the line it jumps to is already known. Otherwise, the goto is
+    parsed so that its syntax error can be reported.
  
  RETURNS
     The line number to jump to
@@ -950,46 +847,50 @@ int DuckInterpreter::EvaluateIfStatement(const string& a_statement, int a_nextSt
     Biplab Thapa Magar
  */
 /**/
-int DuckInterpreter::EvaluateGotoStatement(const string& a_statement, int a_nextPos) {
-    string resultString;
-    double placeHolder;
-    a_nextPos = ParseNextElement(a_statement, a_nextPos, resultString, placeHolder);
-    if(resultString != "goto") {
+int DuckInterpreter::EvaluateGotoStatement(const CompiledStatement& a_statement, int a_nextPos) {
+    //the label of a well formed goto was resolved when the program was recorded
+    if(a_statement.m_gotoPosition >= 0 && a_nextPos == a_statement.m_gotoPosition) {
+        return a_statement.m_gotoTarget;
+    }
+    
+    Token resultToken;
+    a_nextPos = ParseNextElement(a_statement, a_nextPos, resultToken);
+    if(!resultToken.IsKeyword(Keyword::Goto)) {
         throw DuckInterpreterException("Invalid statement. If statement must have a goto.");
     }
     
     //extract label
-    a_nextPos = ParseNextElement(a_statement, a_nextPos, resultString, placeHolder);
+    a_nextPos = ParseNextElement(a_statement, a_nextPos, resultToken);
     
     //verify it is a variable name
-    if(!IsAValidVariableName(resultString)) {
+    if(resultToken.m_type != TokenType::Identifier) {
         throw DuckInterpreterException("Goto statement must be followed by a label");
     }
     
     int labelLocation;
     
     //throw an error if label does not exist
-    labelLocation = m_statements.GetLabelLocation(resultString);
+    labelLocation = m_statements.GetLabelLocation(m_statements.GetIdentifierName(resultToken.m_identifierId));
     
     //check the rest of the statement for errors
-    a_nextPos = ParseNextElement(a_statement, a_nextPos, resultString, placeHolder);
+    a_nextPos = ParseNextElement(a_statement, a_nextPos, resultToken);
     if(a_nextPos >= 0) {
         throw DuckInterpreterException("Extraneous elements at the end of an if statement.");
     }
     
     return labelLocation;
-} /* int DuckInterpreter::EvaluateGotoStatement(const string& a_statement, int a_nextStatement, int a_nextPos) */
+} /* int DuckInterpreter::EvaluateGotoStatement(const CompiledStatement& a_statement, int a_nextPos) */
 
 
 /**/
 /*
- void DuckInterpreter::ExecuteStopStatement(const string& a_statement)
+ void DuckInterpreter::ExecuteStopStatement(const CompiledStatement& a_statement)
  
  NAME
  ExecuteStopStatement - Evaluates a stop statement
  
  SYNOPSIS
-    void DuckInterpreter::ExecuteStopStatement(const string& a_statement)
+    void DuckInterpreter::ExecuteStopStatement(const CompiledStatement& a_statement)
         a_statement --> The stop statement to be evaluated
  
  DESCRIPTION
@@ -1003,32 +904,32 @@ int DuckInterpreter::EvaluateGotoStatement(const string& a_statement, int a_next
     Biplab Thapa Magar
  */
 /**/
-void DuckInterpreter::ExecuteStopStatement(const string& a_statement) {
+void DuckInterpreter::ExecuteStopStatement(const CompiledStatement& a_statement) {
     //make sure that "stop;" is the only thing written in the statement
-    double placeHolder;
-    string nextElement;
-    int nextPos = ParseNextElement(a_statement, 0, nextElement, placeHolder);
-    if(nextElement != "stop") {
-        string message = nextElement + " is undefined in the context of a stop statement";
+    Token nextElement;
+    int nextPos = ParseNextElement(a_statement, 0, nextElement);
+    if(!nextElement.IsKeyword(Keyword::Stop)) {
+        string message = a_statement.GetElementString(nextElement) + " is undefined in the context of a stop statement";
         throw DuckInterpreterException(message);
     }
-    nextPos = ParseNextElement(a_statement, nextPos, nextElement, placeHolder);
-    if(nextElement != ";" || nextPos >= 0) {
+    nextPos = ParseNextElement(a_statement, nextPos, nextElement);
+    if(!nextElement.IsOperator(OperatorCode::Semicolon) || nextPos >= 0) {
         throw DuckInterpreterException("Invalid stop statement");
     }
+    m_output.Flush();
     exit(0);
-} /* void DuckInterpreter::ExecuteStopStatement(const string& a_statement) */
+} /* void DuckInterpreter::ExecuteStopStatement(const CompiledStatement& a_statement) */
 
 
 /**/
 /*
- void DuckInterpreter::EvaluateEndStatement(const string& a_statement)
+ void DuckInterpreter::EvaluateEndStatement(const CompiledStatement& a_statement)
  
  NAME
     EvaluateEndStatement - Evaluates a stop statement
  
  SYNOPSIS
-    void DuckInterpreter::EvaluateEndStatement(const string& a_statement)
+    void DuckInterpreter::EvaluateEndStatement(const CompiledStatement& a_statement)
         a_statement --> The end statement to be evaluated
  
  DESCRIPTION
@@ -1042,33 +943,32 @@ void DuckInterpreter::ExecuteStopStatement(const string& a_statement) {
     Biplab Thapa Magar
  */
 /**/
-void DuckInterpreter::EvaluateEndStatement(const string& a_statement) {
+void DuckInterpreter::EvaluateEndStatement(const CompiledStatement& a_statement) {
     //make sure that "end;" is the only thing written in the statement
-    double placeHolder;
-    string nextElement;
-    int nextPos = ParseNextElement(a_statement, 0, nextElement, placeHolder);
-    if(nextElement != "end") {
-        string message = nextElement + " is undefined in the context of an end statement";
+    Token nextElement;
+    int nextPos = ParseNextElement(a_statement, 0, nextElement);
+    if(!nextElement.IsKeyword(Keyword::End)) {
+        string message = a_statement.GetElementString(nextElement) + " is undefined in the context of an end statement";
         throw DuckInterpreterException(message);
     }
-    nextPos = ParseNextElement(a_statement, nextPos, nextElement, placeHolder);
-    if(nextElement != ";" || nextPos >= 0) {
+    nextPos = ParseNextElement(a_statement, nextPos, nextElement);
+    if(!nextElement.IsOperator(OperatorCode::Semicolon) || nextPos >= 0) {
         throw DuckInterpreterException("Invalid end statement");
     }
     m_endFlag = true;
-} /* void DuckInterpreter::EvaluateEndStatement(const string& a_statement) */
+} /* void DuckInterpreter::EvaluateEndStatement(const CompiledStatement& a_statement) */
 
 
 
 /**/
 /*
- void DuckInterpreter::ExecutePrintStatement(const string &a_statement)
+ void DuckInterpreter::ExecutePrintStatement(const CompiledStatement &a_statement)
  
  NAME
     EvaluateEndStatement - Evaluates a print statement
  
  SYNOPSIS
-    void DuckInterpreter::ExecutePrintStatement(const string &a_statement)
+    void DuckInterpreter::ExecutePrintStatement(const CompiledStatement &a_statement)
         a_statement --> The print statement to be evaluated and executed
  
  DESCRIPTION
@@ -1082,15 +982,15 @@ void DuckInterpreter::EvaluateEndStatement(const string& a_statement) {
     Biplab Thapa Magar
  */
 /**/
-void DuckInterpreter::ExecutePrintStatement(const string &a_statement) {
+void DuckInterpreter::ExecutePrintStatement(const CompiledStatement &a_statement) {
+    ExecutionPhaseScope phase(ExecutionPhase::InputOutput);
     int nextPos = 0;
-    string nextString;
-    double nextNumber;
+    Token nextToken;
     
     
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
     //make sure first element is print
-    if(nextString != "print") {
+    if(!nextToken.IsKeyword(Keyword::Print)) {
         throw DuckInterpreterException("Invalid print statement.");
     }
     
@@ -1098,41 +998,41 @@ void DuckInterpreter::ExecutePrintStatement(const string &a_statement) {
     int tempNextPos = nextPos;
     do {
         nextPos = tempNextPos;
-        tempNextPos = ParseNextElement(a_statement, tempNextPos, nextString, nextNumber);
+        tempNextPos = ParseNextElement(a_statement, tempNextPos, nextToken);
         
         //if what follows after the print statement (or a comma) is not a string, variable, operator, or number, then throw error
-        if(nextString[0] != '\"' && !IsAValidVariableName(nextString) && !IsAnArithmeticOperation(nextString) && nextString != "") {
+        if(nextToken.m_type != TokenType::String && nextToken.m_type != TokenType::Identifier && !nextToken.IsArithmeticOperator() && nextToken.m_type != TokenType::Number) {
             throw DuckInterpreterException("Invalid print statement.");
         }
         //if string, remove quotation marks and print
-        if(nextString[0] == '\"') {
-            cout << nextString.substr(1, nextString.length() - 2);
+        if(nextToken.m_type == TokenType::String) {
+            m_output.Write(a_statement.m_text.substr(nextToken.m_start + 1, nextToken.m_length - 2));
         }
         //if number, variable, or array, evaluate till the end of arithmetic expression
         else {
-            cout << EvaluateArithmeticExpression(a_statement, nextPos);
+            m_output.WriteNumber(EvaluateArithmeticExpression(a_statement, nextPos));
             tempNextPos = nextPos;
         }
-        tempNextPos = ParseNextElement(a_statement, tempNextPos, nextString, nextNumber);
+        tempNextPos = ParseNextElement(a_statement, tempNextPos, nextToken);
         
-    } while(nextString == ",");
-    cout << endl;
+    } while(nextToken.IsOperator(OperatorCode::Comma));
+    m_output.EndLine();
     
     if(tempNextPos >= 0) {
         throw DuckInterpreterException("Extraneous elements at the end of print statement.");
     }
-} /* void DuckInterpreter::ExecutePrintStatement(const string &a_statement) */
+} /* void DuckInterpreter::ExecutePrintStatement(const CompiledStatement &a_statement) */
 
 
 /**/
 /*
- void DuckInterpreter::ExecuteReadStatement(const string& a_statement)
+ void DuckInterpreter::ExecuteReadStatement(const CompiledStatement& a_statement)
  
  NAME
     ExecuteReadStatement - Evaluates a read statement
  
  SYNOPSIS
-    void DuckInterpreter::ExecuteReadStatement(const string& a_statement)
+    void DuckInterpreter::ExecuteReadStatement(const CompiledStatement& a_statement)
         a_statement --> The print statement to be evaluated and executed
  
  DESCRIPTION
@@ -1145,84 +1045,85 @@ void DuckInterpreter::ExecutePrintStatement(const string &a_statement) {
     Biplab Thapa Magar
  */
 /**/
-void DuckInterpreter::ExecuteReadStatement(const string& a_statement) {
+void DuckInterpreter::ExecuteReadStatement(const CompiledStatement& a_statement) {
+    ExecutionPhaseScope phase(ExecutionPhase::InputOutput);
     int nextPos = 0;
-    string nextString;
-    double nextNumber;
+    Token nextToken;
     
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
     //make sure its a read statement
     
-    assert(nextString == "read");
+    assert(nextToken.IsKeyword(Keyword::Read));
     
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
     
     //print prompt
-    if(nextString[0] == '\"') {
-        cout << nextString.substr(1, nextString.length() - 2);
-        nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-        if(nextString != ",") {
+    if(nextToken.m_type == TokenType::String) {
+        m_output.Write(a_statement.m_text.substr(nextToken.m_start + 1, nextToken.m_length - 2));
+        nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+        if(!nextToken.IsOperator(OperatorCode::Comma)) {
             throw DuckInterpreterException("Need comma separation in read statement");
         }
-        nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
+        nextPos = ParseNextElement(a_statement, nextPos, nextToken);
     }
-    string inputValue;
     //go through all the variables
-    while(IsAValidVariableName(nextString) || nextString == ",") {
-        getline(cin, inputValue);
-        //remove white space from beginning and end of input
-        RemoveExtraneousWhiteSpace(inputValue);
-        if(inputValue.length() == 0) {
-            continue;
-        }
-        if(!IsAValidNumber(inputValue)) {
-            throw DuckInterpreterException("Input value is not a valid number");
-        }
+    while(nextToken.m_type == TokenType::Identifier || nextToken.IsOperator(OperatorCode::Comma)) {
+        double inputValue = m_input.ReadNumber();
         
         //check if variable is an array
-        string tempString;
-        int arrayNextPos = ParseNextElement(a_statement, nextPos, tempString, nextNumber);
-        if(tempString == "[") {
+        Token tempToken;
+        string variableOrArrayName = a_statement.GetElementString(nextToken);
+        int arrayNextPos = ParseNextElement(a_statement, nextPos, tempToken);
+        if(tempToken.IsOperator(OperatorCode::OpenBracket)) {
             double index = EvaluateArithmeticExpression(a_statement, arrayNextPos);
             //add to input value to array
-            m_arrayTable.AddToArray(nextString, index, stof(inputValue));
+            //only an identifier can name an array
+            if(nextToken.m_type != TokenType::Identifier) {
+                string message = "'" + variableOrArrayName + "' has not been declared as an array";
+                throw DuckInterpreterException(message);
+            }
+            {
+                ExecutionPhaseScope phase(ExecutionPhase::ArrayAccess);
+                m_arrayTable.AddToArray(nextToken.m_identifierId, variableOrArrayName, index, inputValue);
+            }
             //now, point nextPos to first the element after the array
-            arrayNextPos = ParseNextElement(a_statement, arrayNextPos, tempString, nextNumber);
+            arrayNextPos = ParseNextElement(a_statement, arrayNextPos, tempToken);
             nextPos = arrayNextPos;
         }
-        //if not an array, it must be a variable
-        else {
-            m_symbolTable.RecordVariableValue(nextString, stof(inputValue));
+        //if not an array, it must be a variable. A value read into a comma cannot be used by the program, so it is not recorded
+        else if(nextToken.m_type == TokenType::Identifier) {
+            ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+            m_symbolTable.RecordVariableValue(nextToken.m_identifierId, inputValue);
         }
         
         
-        nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
+        nextPos = ParseNextElement(a_statement, nextPos, nextToken);
         //skip comma
-        if(nextString == ",") {
-            nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
+        if(nextToken.IsOperator(OperatorCode::Comma)) {
+            nextPos = ParseNextElement(a_statement, nextPos, nextToken);
         }
     }
     //if the final element is not a semicolon or if there are extraneous elements at the end of the read statement, then throw eror
-    if(nextString != ";") {
+    if(!nextToken.IsOperator(OperatorCode::Semicolon)) {
         throw DuckInterpreterException("Invalid syntax for read statement");
     }
     
     if(nextPos >= 0) {
         throw DuckInterpreterException("Extraneous elements at the end of read statement.");
     }
-} /* void DuckInterpreter::ExecuteReadStatement(const string& a_statement) */
+} /* void DuckInterpreter::ExecuteReadStatement(const CompiledStatement& a_statement) */
 
 
 
 /**/
 /*
- void DuckInterpreter::EvaluateArrayDeclarationStatement(const string& a_statement)
+ void DuckInterpreter::EvaluateArrayDeclarationStatement(const CompiledStatement& a_statement)
  
  NAME
     EvaluateArrayDeclarationStatement - Evaluates an array declaration statement
  
  SYNOPSIS
-    void DuckInterpreter::EvaluateArrayDeclarationStatement(const string& a_statement)
+    void DuckInterpreter::EvaluateArrayDeclarationStatement(const CompiledStatement& a_statement)
         a_statement --> The array declaration statement to be evaluated
  
  DESCRIPTION
@@ -1235,481 +1136,46 @@ void DuckInterpreter::ExecuteReadStatement(const string& a_statement) {
     Biplab Thapa Magar
  */
 /**/
-void DuckInterpreter::EvaluateArrayDeclarationStatement(const string& a_statement) {
+void DuckInterpreter::EvaluateArrayDeclarationStatement(const CompiledStatement& a_statement) {
     int nextPos = 0;
-    string nextString;
-    double nextNumber;
+    Token nextToken;
     
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-    assert(nextString == "dim");
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+    assert(nextToken.IsKeyword(Keyword::Dim));
     
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
     
     //check if the array name is valid
-    if(!IsAValidVariableName(nextString)) {
-        string message = "'" + nextString + "' is an invalid array name.";
+    if(nextToken.m_type != TokenType::Identifier) {
+        string message = "'" + a_statement.GetElementString(nextToken) + "' is an invalid array name.";
         throw DuckInterpreterException(message);
     }
-    //record arrayName
-    string arrayName = nextString;
+    //record the slot of the array name
+    int arraySlot = nextToken.m_identifierId;
     
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-    if(nextString != "[") {
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+    if(!nextToken.IsOperator(OperatorCode::OpenBracket)) {
         throw DuckInterpreterException("Array variable name must be of the form: 'dim <array name>[<array size>]'.");
     }
     
     int arraySize = EvaluateArithmeticExpression(a_statement, nextPos);
     
-    m_arrayTable.AddNewArray(arrayName, arraySize);
+    {
+        ExecutionPhaseScope phase(ExecutionPhase::ArrayAccess);
+        m_arrayTable.AddNewArray(arraySlot, arraySize);
+    }
    
     //check for the correctness of the syntax of the rest of the statement
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-    if(nextString != "]") {
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+    if(!nextToken.IsOperator(OperatorCode::CloseBracket)) {
         throw DuckInterpreterException("Array variable name must be of the form: 'dim <array name>[<array size>]'.");
     }
     
-    nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-    if(nextString != ";" || nextPos >= 0) {
+    nextPos = ParseNextElement(a_statement, nextPos, nextToken);
+    if(!nextToken.IsOperator(OperatorCode::Semicolon) || nextPos >= 0) {
         throw DuckInterpreterException("Incorrect syntax for array declaration statement.");
     }
-} /* void DuckInterpreter::EvaluateArrayDeclarationStatement(const string& a_statement) */
-
-
-
-
-/**/
-/*
- DuckInterpreter::StatementType DuckInterpreter::GetStatementType(const string &a_statement)
- 
- NAME
-    GetStatementType - Evaluates the type of the given statement
- 
- SYNOPSIS
-    DuckInterpreter::StatementType DuckInterpreter::GetStatementType(const string &a_statement)
-        a_statement --> The statement whose type is to be evaluated
- 
- DESCRIPTION
-    It evaluates the type of the given statement and returns a StatementType value accordingly
- 
- RETURNS
-    The type of the given statement
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-DuckInterpreter::StatementType DuckInterpreter::GetStatementType(const string &a_statement) {
-    
-    //checking for read statement
-    if(a_statement.substr(0, 4) == "read") {
-        return StatementType::ReadStat;
-    }
-    if(a_statement.substr(0, 2) == "if") {
-        return StatementType::IfStat;
-    }
-    
-    if(a_statement.substr(0, 5) == "print") {
-        return StatementType::PrintStat;
-    }
-    
-    if(a_statement.substr(0, 4) == "stop") {
-        return StatementType::StopStat;
-    }
-    
-    if(a_statement.substr(0, 3) == "end") {
-        return StatementType::EndStat;
-    }
-    
-    if(a_statement.substr(0, 4) == "goto") {
-        return StatementType::gotoStat;
-    }
-    
-    if(a_statement.substr(0, 3) == "dim") {
-        return StatementType::arrayDeclarationStat;
-    }
-    
-    //checking for arithmetic statement
-    
-    //first, check for presence of '=' character
-    size_t positionOfEqualOperator = a_statement.find("=");
-    if(positionOfEqualOperator != string::npos) {
-        string variableName = a_statement.substr(0, positionOfEqualOperator);
-        //check to see if the assignment operator is preceded by quotations.
-        if(variableName.find('\"') != string::npos) {
-            //It doesn't make sense for a non-Print statement and a non-Read statement to have a string
-            //It must be a statement with bad syntax
-            throw DuckInterpreterException("Invalid syntax.");
-        }
-        int nextPos = 0;
-        string nextString;
-        double nextNumber;
-        nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-        
-        if(!IsAValidVariableName(nextString)) {
-            throw DuckInterpreterException("Invalid arithmetic statement. No proper variable or array to assign value to.");
-        }
-        
-        nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-        
-        //check to see if the variable is an array
-        if(nextString == "[") {
-            nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-            //if there is nothing in between [], throw error
-            if(nextString == "]") {
-                throw DuckInterpreterException("Array index unspecified");
-            }
-            //search for closing bracket
-            while(nextString != "]" && nextPos != -1) {
-                nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-            }
-            if(nextPos < 0) {
-                if(nextString != "]") {
-                    throw DuckInterpreterException("Missing ']' character to end array expression.");
-                }
-                throw DuckInterpreterException("Invalid arithmetic statement.");
-            }
-            nextPos = ParseNextElement(a_statement, nextPos, nextString, nextNumber);
-        }
-        
-        //if there are more characters after the variable or array but before the '=' operator, throw error
-        if(nextString != "=") {
-            string message = a_statement.substr(0, positionOfEqualOperator) + " is an invalid expression to which to assign a value.";
-            throw DuckInterpreterException(message);
-        }
-        return StatementType::ArithmeticStat;
-    }
-    throw DuckInterpreterException("Unable to determine statement type");
-} /* DuckInterpreter::StatementType DuckInterpreter::GetStatementType(const string &a_statement) */
-
-
-
-/**/
-/*
- bool DuckInterpreter::IsAValidVariableName(string a_variableName)
- 
- NAME
-    IsAValidVariableName - Checks whether the given string is a valid variable name
- 
- SYNOPSIS
-    bool DuckInterpreter::IsAValidVariableName(string a_variableName)
-        a_variableName --> The string to be checked for validity
- 
- DESCRIPTION
-    This function checks whether the given string is a valid variable name according the variable naming rules of the Duck language. It checks whether the
-        first character of the string is a an alphabet, or an underscore, and whether the remaining characters are alphabets, digits, or underscores
- 
- RETURNS
-    True if the string is a valid variable name. False if not
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-bool DuckInterpreter::IsAValidVariableName(string a_variableName) {
-    //return if empty variable name
-    if(a_variableName.length() == 0) {
-        return false;
-    }
-    
-    
-    //reserved keywords are not allowed to be variable names
-    if(IsAReservedKeyword(a_variableName)) {
-        return false;
-    }
-    
-    //now, check to see if the first character of the label is not an "_" or a letter
-    if(a_variableName[0] != '_') {
-        if(a_variableName[0] < 'a' || a_variableName[0] > 'z') {
-            if(a_variableName[0] < 'A' || a_variableName[0] > 'Z') {
-                return false;
-            }
-        }
-    }
-    
-    //now, check to see if the rest of the characters of the label is not an "_", a letter, or a number
-    for(int i = 1; i < a_variableName.length(); i++) {
-        if(a_variableName[i] != '_') {
-            if(a_variableName[i] < 'a' || a_variableName[i] > 'z') {
-                if(a_variableName[i] < 'A' || a_variableName[i] > 'Z') {
-                    if(a_variableName[i] < '0' || a_variableName[i] > '9') {
-                        return false;
-                    }
-                }
-            }
-        }
-    }
-    
-    return true;
-} /* bool DuckInterpreter::IsAValidVariableName(string a_variableName) */
-
-
-/**/
-/*
- bool DuckInterpreter::IsAValidNumber(string a_number)
- 
- NAME
-    IsAValidNumber - Checks whether the given string is a valid number
- 
- SYNOPSIS
-    bool DuckInterpreter::IsAValidNumber(string a_number)
-        a_number --> The string to be checked for validity
- 
- DESCRIPTION
-    This function checks whether the given string is a valid number.
- 
- RETURNS
-    True if the string is a valid number. False if not
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-bool DuckInterpreter::IsAValidNumber(string a_number) {
-    if(a_number.length() == 0) {
-        return false;
-    }
-    
-    //used to count number of decimal points. If more than one, then invalid number
-    int dotCounter = 0;
-    
-    
-    //now, check whether the first character in the number is a digit or a sign (+ or -)
-    if((a_number[0] < '0' || a_number[0] > '9') && a_number[0] != '-' && a_number[0] != '+') {
-        if(a_number[0] == '.') {
-            dotCounter++;
-        } else {
-            return false;
-        }
-    }
-    
-    //if the first digit of the string is a + or - character, but if there are no digits following them, then it is not a number
-    if((a_number[0] == '-' || a_number[0] == '+') && (a_number.length() == 1)) {
-        return false;
-    }
-    
-    //now, check to see if the rest of the characters are digits
-    for(int i = 1; i < a_number.length(); i++) {
-        if(a_number[i] < '0' || a_number[i] > '9') {
-            //allow one decimal dot
-            if(a_number[i] == '.' && dotCounter == 0) {
-                dotCounter++;
-            } else {
-                return false;
-            }
-            
-        }
-    }
-    return true;
-} /* bool DuckInterpreter::IsAValidNumber(string a_number) */
-
-
-
-/**/
-/*
- bool DuckInterpreter::IsAnArithmeticOperation(string a_stringToCheck)
- 
- NAME
-    IsAnArithmeticOperation - Checks whether the given string is an arithmetic operation
- 
- SYNOPSIS
-    bool DuckInterpreter::IsAnArithmeticOperation(string a_stringToCheck)
-        a_stringToCheck --> The string to be checked for being an arithmetic operation
- 
- DESCRIPTION
-    This function checks whether the given string is an arithmetic operation (such as ==, -, +, /, !, !=, <, etc)
- 
- RETURNS
-    True if the string is a valid arithmetic operation. False if not
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-bool DuckInterpreter::IsAnArithmeticOperation(string a_stringToCheck) {
-    
-    //First, check for >=, <=, ==, != (i.e. all operators that are 2 characters long
-    if(a_stringToCheck.length() >= 2) {
-        if(a_stringToCheck.substr(0, 2) == "==") {
-            return true;
-        }
-        if(a_stringToCheck.substr(0, 2) == ">=") {
-            return true;
-        }
-        if(a_stringToCheck.substr(0, 2) == "<=") {
-            return true;
-        }
-        if(a_stringToCheck.substr(0, 2) == "!=") {
-            return true;
-        }
-        if(a_stringToCheck.substr(0, 6) == "unary+") {
-            return true;
-        }
-        if(a_stringToCheck.substr(0, 6) == "unary-") {
-            return true;
-        }
-        if(a_stringToCheck.substr(0, 6) == "unary!") {
-            return true;
-        }
-    }
-    
-    //Now, check for 1 character long operators that mark the end of an element (namely: ' ', '=', '!', '<', '>', '"', ',', ';', '(', ')',
-    // '+', '-', '*', '/', '[' , and ']')
-    if(a_stringToCheck.length() == 1) {
-        switch(a_stringToCheck[0]) {
-            case '<':
-            case '>':
-            case '!':
-            case ')':
-            case '(':
-            case '+':
-            case '-':
-            case '/':
-            case '*':
-            
-                return true;
-                break;
-            default:
-                return false;
-                break;
-        }
-    }
-
-    return false;
-    
-} /* bool DuckInterpreter::IsAnArithmeticOperation(string a_stringToCheck)  */
-
-
-/**/
-/*
- bool DuckInterpreter::IsASyntacticCharacter(const string& a_stringToCheck)
- 
- NAME
-    IsASyntacticCharacter - Checks whether the given string is a syntactic character
- 
- SYNOPSIS
-    bool DuckInterpreter::IsASyntacticCharacter(const string& a_stringToCheck)
-        a_stringToCheck --> The string to be checked for being a syntactic character
- 
- DESCRIPTION
-    This function checks whether the given string is an syntactic character (such as ' ', ';', '+', '=', etc)
- 
- RETURNS
-    True if the string is a valid syntactic character. False if not
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-bool DuckInterpreter::IsASyntacticCharacter(const string& a_stringToCheck) {
-    
-    ////First, check if it is an arithmetic operator
-    if(IsAnArithmeticOperation(a_stringToCheck)) {
-        return true;
-    }
-    
-    //Now, check for other 1 character long characters that mark the end of an element (namely: ' ', '=', '"', ',', ';')
-    if(a_stringToCheck.length() == 1) {
-        switch(a_stringToCheck[0]) {
-            case ' ':
-            case '=':
-            case ';':
-            case ',':
-            case '\"':
-            case '[':
-            case ']':
-            case '\t':
-                return true;
-                break;
-            default:
-                return false;
-                break;
-        }
-    }
-    return false;
-} /* bool DuckInterpreter::IsASyntacticCharacter(const string& a_stringToCheck) */
-
-/**/
-/*
- bool DuckInterpreter::IsAReservedKeyword(string a_stringToCheck)
- 
- NAME
-    IsAReservedKeyword - Checks whether the given string is a reserved keyword
- 
- SYNOPSIS
-    bool DuckInterpreter::IsAReservedKeyword(string a_stringToCheck)
-        a_stringToCheck --> The string to be checked for being a reserved keyword
- 
- DESCRIPTION
-    This function checks whether the given string is a reserved keyword (such as "goto", "print", "read", "dim", etc)
- 
- RETURNS
-    True if the string is a reserved keyword. False if not.
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-bool DuckInterpreter::IsAReservedKeyword(string a_stringToCheck) {
-    if(a_stringToCheck == "dim") {
-        return true;
-    }
-    if(a_stringToCheck == "read") {
-        return true;
-    }
-    
-    if(a_stringToCheck == "goto") {
-        return true;
-    }
-    
-    if(a_stringToCheck == "if") {
-        return true;
-    }
-    
-    if(a_stringToCheck == "print") {
-        return true;
-    }
-    
-    if(a_stringToCheck == "stop") {
-        return true;
-    }
-    
-    if(a_stringToCheck == "end") {
-        return true;
-    }
-    
-    return false;
-} /* bool DuckInterpreter::IsAReservedKeyword(string a_stringToCheck) */
+} /* void DuckInterpreter::EvaluateArrayDeclarationStatement(const CompiledStatement& a_statement) */
 
 
-/**/
-/*
- void DuckInterpreter::RemoveExtraneousWhiteSpace(string& a_string)
- 
- NAME
-    RemoveExtraneousWhiteSpace - removes extraneous white space from the beginning and the end of a string
- 
- SYNOPSIS
-    void DuckInterpreter::RemoveExtraneousWhiteSpace(string& a_string)
-        a_string --> The string from which the white space is to be removed
- 
- DESCRIPTION
-    This function removes extraneous white space from the beginning and the end of a string
- 
- RETURNS
-    void
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-void DuckInterpreter::RemoveExtraneousWhiteSpace(string& a_string) {
-    //now, remove extraneous white space from the beginning of a_string
-    while(a_string.length() != 0 && ((a_string[0] == ' ') || a_string[0] == '\t')) {
-        a_string = a_string.substr(1);
-    }
-    //now, remove extraneous white space from the end of a_string
-    while(a_string.length() != 0 && (a_string[a_string.length() - 1] == ' ' || a_string[a_string.length() - 1] == '\t')) {
-        a_string = a_string.substr(0, a_string.length() - 1);
-    }
-} /* void DuckInterpreter::RemoveExtraneousWhiteSpace(string& a_string) */
 
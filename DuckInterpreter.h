@@ -14,11 +14,31 @@
 #include <assert.h>
 #include <vector>
 #include "DuckInterpreterException.h"
+#include "Lexer.h"
+#include "Token.h"
+#include "ExpressionOperator.h"
+#include "ExpressionEvaluator.h"
+#include "Bytecode.h"
+#include "BytecodeCompiler.h"
+#include "DuckVM.h"
+#include "DuckJit.h"
+#include "DuckRuntimeCore.h"
+#include "InputReader.h"
+#include "StatementProfiler.h"
+#include "SamplingProfiler.h"
+#include "ExecutionPhase.h"
+#include "StatementFuser.h"
+#include "ProgramOptimizer.h"
+#include "ControlFlowGraph.h"
+#include "SsaOptimizer.h"
+#include <memory>
+#include <cstring>
+#include <fstream>
 
 class DuckInterpreter
 {
 public:
-    DuckInterpreter() {}
+    DuckInterpreter() : m_evaluator(m_statements, m_symbolTable, m_arrayTable), m_input(m_output) {}
     ~DuckInterpreter(){}
 
     /**/
@@ -33,7 +53,9 @@ public:
             a_filename --> The name of the Duck program source file 
      
     DESCRIPTION
-        This function stores all the statements in the Duck language source file using a Statement object.
+        This function stores all the statements in the Duck language source file using a Statement object, optimizes
+        them, and makes room in the symbol table and in the array table for every variable and array of the program.
+        The control flow graph of the optimized statements is written if it was asked for.
      
     RETURNS 
         void
@@ -44,6 +66,27 @@ public:
     /**/
     void RecordStatements(std::string a_fileName) {
 		m_statements.RecordStatements(a_fileName);
+        //unreachable statements are pruned and constant subexpressions folded before any engine sees the statements
+        ProgramOptimizer optimizer(m_statements);
+        optimizer.Optimize();
+        if(m_writeOptimizationReport) {
+            optimizer.WriteReport(std::cerr);
+        }
+        //every identifier of the program gets its own variable slot and array slot
+        m_symbolTable.SetSlotCount(m_statements.GetIdentifierCount());
+        m_arrayTable.SetSlotCount(m_statements.GetIdentifierCount());
+        if(!m_controlFlowGraphFileName.empty()) {
+            WriteControlFlowGraph(a_fileName);
+        }
+        //the statements of the common simple shapes are executed by handlers of their own
+        m_fusedStatements = StatementFuser(m_statements).Fuse();
+        m_invariantSnapshots.clear();
+        for(FusedStatement &fused : m_fusedStatements) {
+            if(fused.m_kind == FusedKind::InvariantAssignment) {
+                fused.m_snapshot = static_cast<int>(m_invariantSnapshots.size());
+                m_invariantSnapshots.push_back(InvariantSnapshot());
+            }
+        }
 	}/*void RecordStatements(std::string a_filename)*/
     
     
@@ -51,6 +94,28 @@ public:
 	// Runs the interpreter on the recorded statements.
 	void RunInterpreter();
 
+    // Compiles the recorded statements to bytecode and runs them on the Duck virtual machine. With a_useJit, hot loops are compiled
+    // to machine code as well.
+    void RunVirtualMachine(bool a_useJit = false);
+
+    // Sets when the output of the Duck program is written to the standard output.
+    void SetFlushPolicy(FlushPolicy a_flushPolicy) { m_output.SetFlushPolicy(a_flushPolicy); }
+
+    // Sets how the numbers printed by the Duck program are formatted.
+    void SetNumberFormat(NumberFormat a_numberFormat) { m_output.SetNumberFormat(a_numberFormat); }
+    // Sets the most threads that record a large source file. 0, the default, uses one thread per processor.
+    void SetLoadThreadCount(unsigned a_threadCount) { m_statements.SetLoadThreadCount(a_threadCount); }
+    // Writes what the optimizer pruned, folded and found to the standard error when the statements are recorded.
+    void EnableOptimizationReport() { m_writeOptimizationReport = true; }
+    // Writes the control flow graph of the program to the given file, in the dot language of Graphviz, when the statements are recorded.
+    void SetControlFlowGraphFile(const std::string &a_fileName) { m_controlFlowGraphFileName = a_fileName; }
+    // Profiles every statement that RunInterpreter executes. The profile is reported when the program exits, and is also written to the
+    // given file as JSON unless the file name is empty. The statements must have been recorded.
+    void EnableProfiler(const std::string &a_jsonFileName) { m_profiler.reset(new StatementProfiler(m_statements, a_jsonFileName)); }
+    // Samples the statements that RunInterpreter executes, and the phase of the interpreter, every millisecond of processor time. The
+    // samples are written to the given file as folded stacks when the program exits. The statements must have been recorded.
+    void EnableSampler(const std::string &a_fileName) { m_sampler.reset(new SamplingProfiler(m_statements, a_fileName)); }
+
 private:
 
 	// The statement object that holds the recorded statements.
@@ -62,98 +127,101 @@ private:
     //The array table object that holds all the arrays and the values they contain
     ArrayTable m_arrayTable;
 
-	// Stacks for the operators and numbers.  These will be used in evaluating statements.
-    
+    //The evaluator of the arithmetic expressions of the statements, which reads the values of the two tables above
+    ExpressionEvaluator m_evaluator;
+
+    //The buffer that holds the output of print and read statements until it is written to the standard output
+    OutputBuffer m_output;
+
+    //The reader of the input values of read statements
+    InputReader m_input;
+    //The profiler of the statements, if profiling is enabled
+    std::unique_ptr<StatementProfiler> m_profiler;
+    //The sampling profiler, if sampling is enabled
+    std::unique_ptr<SamplingProfiler> m_sampler;
+    //True if the optimization report is written when the statements are recorded
+    bool m_writeOptimizationReport = false;
+    //The file that the control flow graph is written to when the statements are recorded, if any
+    std::string m_controlFlowGraphFileName;
+    //How every statement is executed by RunInterpreter, by statement index (see StatementFuser)
+    std::vector<FusedStatement> m_fusedStatements;
+    //The values that every loop invariant assignment last left its variable and its operands with (see FusedStatement::m_snapshot)
+    std::vector<InvariantSnapshot> m_invariantSnapshots;
+
     //this is set to true if the end of the program (marked by the end statement) is reached
     bool m_endFlag;
 
-    //enum class that is used to communicate the type of a statement and to evaluate/execute the statement accordingly
-	enum class StatementType
-	{
-		ArithmeticStat,
-		IfStat,
-		ReadStat,
-		PrintStat,
-		StopStat,
-		EndStat,
-		gotoStat,
-        arrayDeclarationStat,
-	};
-	
+    // Runs the interpreter on the recorded statements, profiling every statement.
+    void RunInterpreterWithProfiler();
+    // Runs the interpreter on the recorded statements, telling the sampling profiler which statement is being executed.
+    void RunInterpreterWithSampler();
+    // Exits with an error if the program ran past its last statement or on from an end statement
+    void VerifyStatementCanRun(int a_statementNum);
+    // Reports the error that the statement at the given line failed with, and exits
+    [[noreturn]] void ReportStatementError(int a_statementNum, DuckInterpreterException &a_exception);
+    // Executes the statement at the given line, in its fused form if it has one, and returns the line of the next statement. With
+    // a_singleStatement, a fused pair is executed as its first statement only. a_branchTaken is set to the outcome of an if statement
+    int DispatchStatement(int &a_statementNum, bool a_singleStatement, bool &a_branchTaken);
 	// Executes the statement at the specified location.  Returns the location of the next statement to be executed.
-	int ExecuteStatement(const std::string &a_statement, int a_StatementLoc);
-
-	// Returns the next element in the statement.  Returns the next location to be accessed.
-	int ParseNextElement(const std::string &a_statement, int a_nextPos, std::string &a_stringValue, double &a_numValue);
-    
-    //Gets the length of an element in a statement starting from the given index
-    unsigned long GetLengthOfElement(const std::string& a_statement, int a_indexOfStartOfElement) ;
+	int ExecuteStatement(const CompiledStatement &a_statement, int a_StatementLoc);
+
+    // Executes a fused statement (or pair of statements) that starts at the given line. Returns the location of the next statement to be
+    // executed. If the second statement of a pair fails, a_statementNum is the line of the second statement when the error is thrown
+    int ExecuteFusedStatement(const FusedStatement &a_fused, int &a_statementNum);
+    // Returns the value of an operand of a fused statement
+    double GetFusedOperand(const FusedOperand &a_operand);
+    // Returns the value of a value of a fused statement
+    double EvaluateFusedValue(const FusedValue &a_value);
+    // Returns true if the variable and the operands of a loop invariant assignment still hold the values of its snapshot
+    bool IsInvariantSnapshotCurrent(const FusedStatement &a_fused, const InvariantSnapshot &a_snapshot) const;
+    // Records the values of the variable and the operands of a loop invariant assignment that has just been executed
+    void TakeInvariantSnapshot(const FusedStatement &a_fused, InvariantSnapshot &a_snapshot) const;
+
+    // Writes the control flow graph of the recorded statements to the file that was set with SetControlFlowGraphFile
+    void WriteControlFlowGraph(const std::string &a_sourceFileName);
+
+    // Retrieves the next element of a statement (see CompiledStatement::ParseNextElement) in the Lexing phase. The phase is set here
+    // rather than in CompiledStatement, which the statements are also walked with while they are loaded, on several threads at once
+    int ParseNextElement(const CompiledStatement &a_statement, int a_nextPos, Token &a_token) {
+        ExecutionPhaseScope phase(ExecutionPhase::Lexing);
+        return a_statement.ParseNextElement(a_nextPos, a_token);
+    }
 
 	// Evaluate an arithmetic statement.
-	void EvaluateArithmeticStatement(const std::string &a_statement );
+	void EvaluateArithmeticStatement(const CompiledStatement &a_statement );
     
     // Evaluate an arithmetic expression.  Return the value.  The variable a_nextPos is index to the element after the end of the expression
-    double EvaluateArithmeticExpression(const std::string &a_statement, int &a_nextPos);
-
-    //Sees what operator is found in an arithmetic expression, then evaluates the numbers and operators in the stacks, and adjusts the
-    //operator stack and number stack accordingly.
-    void HandleOperator(std::string& a_operator, std::string& a_lastElement, std::vector<std::string>& a_operatorStack, std::vector<double>& a_numberStack);
-
-    //Takes in a statement, the index of the location of the variable/array, and the variable/array name and
-    //returns the value found in the variable/array
-    double ExtractValueFromVariableOrArray(const std::string& a_statement, int &a_nextPos, std::string& arrayOrVariableName);
-    
-    // Returns the precedence of an operator.
-    int FindPrecedence(std::string a_op);
-
-    //Evaluates the numbers at the top of the number stack with respect to the operator at the top of the operator stack and pushes the result back into the number stack
-    void EvaluateTopOfStack(std::vector<std::string>& a_operatorStack, std::vector<double>& a_numberStack);
+    double EvaluateArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos) {
+        return m_evaluator.EvaluateArithmeticExpression(a_statement, a_nextPos);
+    }
 
     //Evaluates the result of two (or one, in the case of unary operators) numbers with respect to the given operator
     //returns true if the operation is defined, false otherwise
-    bool EvaluateOperation(std::string a_operation, double& a_result, double a_leftOperand, double a_rightOperand = 0);
+    bool EvaluateOperation(ExpressionOperator a_operation, double& a_result, double a_leftOperand, double a_rightOperand = 0);
 
     //Evaluate an if statement. Return the next line to execute depending on the result of the if condition
-    int EvaluateIfStatement(const std::string& a_statement, int a_nextStatement);
+    int EvaluateIfStatement(const CompiledStatement& a_statement, int a_nextStatement);
+    //Evaluates the condition of an if statement. Returns true if it is met. a_nextPos is set to the index of the element after the condition
+    bool EvaluateIfCondition(const CompiledStatement& a_statement, int &a_nextPos);
 
     //Evaluate a goto statement. Returns the next line to execute
-    int EvaluateGotoStatement(const std::string& a_statement, int a_nextPos = 0);
+    int EvaluateGotoStatement(const CompiledStatement& a_statement, int a_nextPos = 0);
 
     //Execute the stop statement, causing the program to terminate
-    void ExecuteStopStatement(const std::string& a_statement);
+    void ExecuteStopStatement(const CompiledStatement& a_statement);
 
     //Evaluates the end statmenet.
-    void EvaluateEndStatement(const std::string& a_statement);
+    void EvaluateEndStatement(const CompiledStatement& a_statement);
 
     //Executes a print statement
-    void ExecutePrintStatement(const std::string &a_statement);
+    void ExecutePrintStatement(const CompiledStatement &a_statement);
     
     //Execute a read statement and stores input into given variables/arrays
-    void ExecuteReadStatement(const std::string& a_statement);
+    void ExecuteReadStatement(const CompiledStatement& a_statement);
     
     //Evaluates the declaration of an array.
-    void EvaluateArrayDeclarationStatement(const std::string& a_statement);
-
-    // Determines the type of the next statement.
-    StatementType GetStatementType(const std::string &a_string);
-
-    //Returns true if the given string is a legal variable name. Returns false otherwise
-    bool IsAValidVariableName(std::string a_variableName);
-    
-    //Returns true if the given string contains a valid number. Returns false otherwise
-    bool IsAValidNumber(std::string a_number);
-    
-    //Returns true if the given string contains an arithmetic operator like +, -, ==, <=, !, etc.
-    bool IsAnArithmeticOperation(std::string a_stringToCheck);
-    
-    //Returns true if the given string contains a syntactic character like ;, =, +, *, -, [, ], etc
-    bool IsASyntacticCharacter(const std::string &a_stringToCheck);
-    
-    //Returns true if the given string contains a reserved keyword that cannot taken as variable names, like goto, stop, end, etc.
-    bool IsAReservedKeyword(std::string a_stringToCheck);
+    void EvaluateArrayDeclarationStatement(const CompiledStatement& a_statement);
 
-    //Removes the white space from the beginning and end of the given string
-    void RemoveExtraneousWhiteSpace(std::string& a_line);
     
    
 
@@ -0,0 +1,1541 @@
+#include "DuckJit.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+//The deepest stack of numbers that a compiled loop can hold in registers (xmm0 to xmm6. xmm7 is a scratch register)
+static const int k_maxStackDepth = 7;
+
+//The number of variables that a compiled loop can keep in registers (xmm8 to xmm15)
+static const int k_maxRegisterVariables = 8;
+
+//The register that holds the first variable kept in a register
+static const int k_firstVariableRegister = 8;
+
+//The SSE register that instructions use for intermediate values
+static const int k_scratchRegister = 7;
+
+//A whole number is kept in a general purpose register only while it is within these bounds, where every whole number is a double too
+static const int64_t k_maxExactInteger = int64_t(1) << 53;
+
+//The general purpose registers, numbered as instructions encode them
+enum GeneralRegister
+{
+    Rax = 0,
+    Rcx = 1,
+    Rdx = 2,
+    Rbx = 3,
+    Rsp = 4,
+    Rbp = 5,
+    Rsi = 6,
+    Rdi = 7,
+    R8 = 8,
+    R9 = 9,
+    R10 = 10,
+    R11 = 11,
+    R12 = 12,
+    R13 = 13,
+    R14 = 14,
+};
+
+//The positions at the bottom of the stack of numbers that can hold a whole number in a general purpose register, and those registers
+static const int k_maxIntegerStackDepth = 4;
+static const int k_integerStackRegisters[k_maxIntegerStackDepth] = {Rsi, Rdi, R8, R9};
+
+//The number of variables that only ever hold whole numbers that a compiled loop can keep in general purpose registers, and those registers
+static const int k_maxIntegerRegisterVariables = 4;
+static const int k_integerVariableRegisters[k_maxIntegerRegisterVariables] = {R10, R11, R14, Rbp};
+
+//The conditions of conditional jumps, numbered as instructions encode them
+enum JumpCondition
+{
+    Equal = 0x4,
+    NotEqual = 0x5,
+    Above = 0x7,
+    Parity = 0xA,
+    Less = 0xC,
+    GreaterEqual = 0xD,
+    LessEqual = 0xE,
+    Greater = 0xF,
+};
+
+//The predicates of cmpsd
+enum ComparePredicate
+{
+    CompareEqual = 0,
+    CompareLess = 1,
+    CompareLessEqual = 2,
+    CompareNotEqual = 4,
+};
+
+//Returns the bits of a double, as an instruction stores it
+static uint64_t DoubleBits(double a_value) {
+    uint64_t bits;
+    memcpy(&bits, &a_value, sizeof(bits));
+    return bits;
+}
+
+//Returns true if a double is a whole number within k_maxExactInteger that a general purpose register can hold in its place: converting
+//it to an integer and back gives the same bits (which -0 does not)
+static bool IsExactInteger(double a_value) {
+    if(!(a_value >= -k_maxExactInteger && a_value <= k_maxExactInteger)) {
+        return false;
+    }
+    return DoubleBits(static_cast<double>(static_cast<int64_t>(a_value))) == DoubleBits(a_value);
+}
+
+
+
+//Appends x86-64 instructions to a buffer of machine code. Only the instructions that compiled loops use are provided. Jumps go to
+//labels, which are created by NewLabel, placed by Bind and resolved by Finish
+class X86Assembler
+{
+public:
+    //Creates a label that has not been placed yet
+    int NewLabel() {
+        m_labelPositions.push_back(-1);
+        return static_cast<int>(m_labelPositions.size()) - 1;
+    }
+
+    //Places the label at the next instruction
+    void Bind(int a_label) { m_labelPositions[a_label] = static_cast<long>(m_code.size()); }
+
+    //Resolves the jumps to labels and returns the machine code
+    const vector<uint8_t>& Finish() {
+        for(const pair<size_t, int> &fixup : m_fixups) {
+            int32_t displacement = static_cast<int32_t>(m_labelPositions[fixup.second] - static_cast<long>(fixup.first + 4));
+            memcpy(&m_code[fixup.first], &displacement, sizeof(displacement));
+        }
+        return m_code;
+    }
+
+    //push and pop of a 64 bit register, and ret
+    void Push(int a_register) { OptionalRex(false, 0, a_register); Byte(0x50 + (a_register & 7)); }
+    void Pop(int a_register) { OptionalRex(false, 0, a_register); Byte(0x58 + (a_register & 7)); }
+    void Return() { Byte(0xC3); }
+
+    //mov r64, r64
+    void MoveRegister(int a_destination, int a_source) {
+        OptionalRex(true, a_source, a_destination);
+        Byte(0x89);
+        RegisterOperands(a_source, a_destination);
+    }
+
+    //mov r32, imm32 (which clears the upper half of the register)
+    void MoveImmediate32(int a_register, uint32_t a_value) {
+        OptionalRex(false, 0, a_register);
+        Byte(0xB8 + (a_register & 7));
+        Int32(a_value);
+    }
+
+    //mov r64, imm64
+    void MoveImmediate64(int a_register, uint64_t a_value) {
+        OptionalRex(true, 0, a_register);
+        Byte(0xB8 + (a_register & 7));
+        for(int i = 0; i < 8; i++) {
+            Byte(static_cast<uint8_t>(a_value >> (i * 8)));
+        }
+    }
+
+    //mov r64, [base + displacement]
+    void LoadRegister(int a_register, int a_base, int32_t a_displacement) {
+        OptionalRex(true, a_register, a_base);
+        Byte(0x8B);
+        MemoryOperand(a_register, a_base, a_displacement);
+    }
+
+    //mov dword [base + displacement], imm32
+    void StoreImmediate32(int a_base, int32_t a_displacement, uint32_t a_value) {
+        OptionalRex(false, 0, a_base);
+        Byte(0xC7);
+        MemoryOperand(0, a_base, a_displacement);
+        Int32(a_value);
+    }
+
+    //and, add and sub r64, r64
+    void AndRegister(int a_destination, int a_source) { GeneralRegisters(0x21, a_destination, a_source); }
+    void AddRegister(int a_destination, int a_source) { GeneralRegisters(0x01, a_destination, a_source); }
+    void SubtractRegister(int a_destination, int a_source) { GeneralRegisters(0x29, a_destination, a_source); }
+
+    //cmp r64, r64 (setting the flags to those of a_left - a_right) and test r64, r64
+    void CompareRegister(int a_left, int a_right) { GeneralRegisters(0x39, a_left, a_right); }
+    void TestRegister(int a_register) { GeneralRegisters(0x85, a_register, a_register); }
+
+    //setcc al followed by movzx eax, al: rax is 1 if the condition holds, 0 otherwise
+    void SetRaxIf(JumpCondition a_condition) {
+        Byte(0x0F);
+        Byte(0x90 + a_condition);
+        Byte(0xC0);
+        Byte(0x0F);
+        Byte(0xB6);
+        Byte(0xC0);
+    }
+
+    //test r8, r8 on the low byte of one of the first four registers
+    void TestLowByte(int a_register) {
+        Byte(0x84);
+        RegisterOperands(a_register, a_register);
+    }
+
+    //call r64
+    void CallRegister(int a_register) {
+        OptionalRex(false, 0, a_register);
+        Byte(0xFF);
+        Byte(0xD0 | (a_register & 7));
+    }
+
+    //jmp and jcc to a label
+    void Jump(int a_label) {
+        Byte(0xE9);
+        Fixup(a_label);
+    }
+    void JumpIf(JumpCondition a_condition, int a_label) {
+        Byte(0x0F);
+        Byte(0x80 + a_condition);
+        Fixup(a_label);
+    }
+
+    //cvtsi2sd xmm, r64 and cvttsd2si r64, xmm
+    void ConvertToDouble(int a_register, int a_generalRegister) { WideSseRegister(0x2A, a_register, a_generalRegister); }
+    void ConvertToInteger(int a_generalRegister, int a_register) { WideSseRegister(0x2C, a_generalRegister, a_register); }
+
+    //movsd xmm, [base + displacement] and movsd [base + displacement], xmm
+    void LoadDouble(int a_register, int a_base, int32_t a_displacement) { SseMemory(0xF2, 0x10, a_register, a_base, a_displacement); }
+    void StoreDouble(int a_base, int32_t a_displacement, int a_register) { SseMemory(0xF2, 0x11, a_register, a_base, a_displacement); }
+
+    //movapd xmm, xmm
+    void MoveDouble(int a_destination, int a_source) { SseRegister(0x66, 0x28, a_destination, a_source); }
+
+    //addsd, subsd, mulsd and divsd xmm, xmm
+    void AddDouble(int a_destination, int a_source) { SseRegister(0xF2, 0x58, a_destination, a_source); }
+    void SubtractDouble(int a_destination, int a_source) { SseRegister(0xF2, 0x5C, a_destination, a_source); }
+    void MultiplyDouble(int a_destination, int a_source) { SseRegister(0xF2, 0x59, a_destination, a_source); }
+    void DivideDouble(int a_destination, int a_source) { SseRegister(0xF2, 0x5E, a_destination, a_source); }
+
+    //cmpsd xmm, xmm, predicate: sets the destination to all ones if the predicate holds, to all zeros otherwise
+    void CompareDouble(int a_destination, int a_source, ComparePredicate a_predicate) {
+        SseRegister(0xF2, 0xC2, a_destination, a_source);
+        Byte(a_predicate);
+    }
+
+    //xorpd xmm, xmm
+    void XorDouble(int a_destination, int a_source) { SseRegister(0x66, 0x57, a_destination, a_source); }
+
+    //ucomisd xmm, xmm
+    void UnorderedCompareDouble(int a_left, int a_right) { SseRegister(0x66, 0x2E, a_left, a_right); }
+
+    //movq xmm, r64 and movq r64, xmm
+    void MoveToDouble(int a_register, int a_generalRegister) {
+        Byte(0x66);
+        OptionalRex(true, a_register, a_generalRegister);
+        Byte(0x0F);
+        Byte(0x6E);
+        RegisterOperands(a_register, a_generalRegister);
+    }
+    void MoveFromDouble(int a_generalRegister, int a_register) {
+        Byte(0x66);
+        OptionalRex(true, a_register, a_generalRegister);
+        Byte(0x0F);
+        Byte(0x7E);
+        RegisterOperands(a_register, a_generalRegister);
+    }
+
+private:
+    //the machine code
+    vector<uint8_t> m_code;
+
+    //the position of every label in the machine code, or -1 if it has not been placed
+    vector<long> m_labelPositions;
+
+    //the positions of the 32 bit displacements of jumps, each with the label it jumps to
+    vector<pair<size_t, int>> m_fixups;
+
+    void Byte(uint8_t a_byte) { m_code.push_back(a_byte); }
+
+    void Int32(uint32_t a_value) {
+        for(int i = 0; i < 4; i++) {
+            Byte(static_cast<uint8_t>(a_value >> (i * 8)));
+        }
+    }
+
+    void Fixup(int a_label) {
+        m_fixups.push_back(make_pair(m_code.size(), a_label));
+        Int32(0);
+    }
+
+    //Appends a REX prefix for the given operands, unless it would be empty
+    void OptionalRex(bool a_wide, int a_register, int a_registerOrBase) {
+        uint8_t rex = 0x40 | (a_wide ? 0x08 : 0) | (a_register >= 8 ? 0x04 : 0) | (a_registerOrBase >= 8 ? 0x01 : 0);
+        if(rex != 0x40) {
+            Byte(rex);
+        }
+    }
+
+    //Appends the ModRM byte of two register operands
+    void RegisterOperands(int a_register, int a_registerOrBase) {
+        Byte(0xC0 | ((a_register & 7) << 3) | (a_registerOrBase & 7));
+    }
+
+    //Appends the ModRM byte (and SIB byte, for rsp and r12) of a [base + disp32] operand
+    void MemoryOperand(int a_register, int a_base, int32_t a_displacement) {
+        Byte(0x80 | ((a_register & 7) << 3) | (a_base & 7));
+        if((a_base & 7) == Rsp) {
+            Byte(0x24);
+        }
+        Int32(static_cast<uint32_t>(a_displacement));
+    }
+
+    //An instruction with two 64 bit general purpose register operands
+    void GeneralRegisters(uint8_t a_opCode, int a_registerOrBase, int a_register) {
+        OptionalRex(true, a_register, a_registerOrBase);
+        Byte(a_opCode);
+        RegisterOperands(a_register, a_registerOrBase);
+    }
+
+    //An SSE conversion between a 64 bit general purpose register and an SSE register
+    void WideSseRegister(uint8_t a_opCode, int a_register, int a_registerOrBase) {
+        Byte(0xF2);
+        OptionalRex(true, a_register, a_registerOrBase);
+        Byte(0x0F);
+        Byte(a_opCode);
+        RegisterOperands(a_register, a_registerOrBase);
+    }
+
+    void SseRegister(uint8_t a_prefix, uint8_t a_opCode, int a_register, int a_registerOrBase) {
+        Byte(a_prefix);
+        OptionalRex(false, a_register, a_registerOrBase);
+        Byte(0x0F);
+        Byte(a_opCode);
+        RegisterOperands(a_register, a_registerOrBase);
+    }
+
+    void SseMemory(uint8_t a_prefix, uint8_t a_opCode, int a_register, int a_base, int32_t a_displacement) {
+        Byte(a_prefix);
+        OptionalRex(false, a_register, a_base);
+        Byte(0x0F);
+        Byte(a_opCode);
+        MemoryOperand(a_register, a_base, a_displacement);
+    }
+};
+
+
+
+//The runtime functions that the machine code calls for the instructions that it does not carry out itself. They all take the context
+//and an int (the slot or string of the instruction, or 0), followed by the numbers that they work with, and return false if the
+//instruction failed. An error that executing the instruction again would raise again (array accesses check everything before they
+//change anything) is left to the DuckVM; otherwise (read consumes its input, print its output) the error is passed on in the context
+
+static bool LoadArrayElementAtRuntime(JitContext *a_context, int a_arraySlot, double a_index) {
+    try {
+        const string &arrayName = a_context->m_statements->GetIdentifierName(a_arraySlot);
+        return a_context->m_arrayTable->GetValue(a_arraySlot, arrayName, a_index, a_context->m_result);
+    } catch(DuckInterpreterException&) {
+        return false;
+    }
+}
+
+static bool StoreArrayElementAtRuntime(JitContext *a_context, int a_arraySlot, double a_index, double a_value) {
+    try {
+        a_context->m_arrayTable->AddToArray(a_arraySlot, a_context->m_statements->GetIdentifierName(a_arraySlot), a_index, a_value);
+        return true;
+    } catch(DuckInterpreterException&) {
+        return false;
+    }
+}
+
+static bool FailAtRuntime(JitContext *a_context, DuckInterpreterException &a_exception) {
+    *a_context->m_errorMessage = a_exception.what();
+    a_context->m_errorPending = true;
+    return false;
+}
+
+static bool PrintStringAtRuntime(JitContext *a_context, int a_stringIndex) {
+    try {
+        a_context->m_output->Write(a_context->m_program->m_strings[a_stringIndex]);
+        return true;
+    } catch(DuckInterpreterException &e) {
+        return FailAtRuntime(a_context, e);
+    }
+}
+
+static bool PrintNumberAtRuntime(JitContext *a_context, int, double a_value) {
+    try {
+        a_context->m_output->WriteNumber(a_value);
+        return true;
+    } catch(DuckInterpreterException &e) {
+        return FailAtRuntime(a_context, e);
+    }
+}
+
+static bool PrintNewlineAtRuntime(JitContext *a_context, int) {
+    try {
+        a_context->m_output->EndLine();
+        return true;
+    } catch(DuckInterpreterException &e) {
+        return FailAtRuntime(a_context, e);
+    }
+}
+
+static bool ReadNumberAtRuntime(JitContext *a_context, int) {
+    try {
+        a_context->m_result = a_context->m_input->ReadNumber();
+        return true;
+    } catch(DuckInterpreterException &e) {
+        return FailAtRuntime(a_context, e);
+    }
+}
+
+
+
+//Generates the machine code of one loop of a BytecodeProgram: the instructions from the first instruction of the loop (the target of
+//its backward jump) to the backward jump
+class LoopCodeGenerator
+{
+public:
+    LoopCodeGenerator(const BytecodeProgram &a_program, int a_firstInstruction, int a_lastInstruction) :
+        m_program(a_program), m_firstInstruction(a_firstInstruction), m_lastInstruction(a_lastInstruction) {}
+
+    //Generates the machine code, and lists the variables that the loop uses and the ones of them that it keeps in general purpose
+    //registers. Returns false if the loop cannot be compiled
+    bool Generate(vector<uint8_t> &a_code, vector<int> &a_variables, vector<int> &a_integerVariables);
+
+private:
+    //A place where the machine code returns to the DuckVM: the instruction to continue at, the depth of the stack of numbers there,
+    //whether the registers still have to be written back (they do not after a runtime function failed), and the positions of the
+    //stack that hold whole numbers in general purpose registers
+    typedef tuple<int, int, bool, unsigned> Exit;
+
+    const BytecodeProgram &m_program;
+    int m_firstInstruction;
+    int m_lastInstruction;
+    X86Assembler m_assembler;
+
+    //the depth of the stack of numbers before every instruction of the loop, or -1 if the instruction cannot be reached
+    vector<int> m_depths;
+
+    //the label of every instruction of the loop
+    vector<int> m_instructionLabels;
+
+    //the register that every variable kept in a register is kept in
+    map<int, int> m_variableRegisters;
+
+    //the general purpose register that every variable kept as a whole number is kept in
+    map<int, int> m_integerRegisters;
+
+    //the positions of the stack of numbers that hold whole numbers in general purpose registers before every instruction of the loop,
+    //one bit for each position
+    vector<unsigned> m_integerMasks;
+
+    //the label of every place where the machine code returns
+    map<Exit, int> m_exits;
+
+    //the label of the code that returns from the machine code
+    int m_returnLabel;
+
+    //Works out the depth of the stack of numbers before every instruction. Returns false if it is too deep or is not consistent
+    bool ComputeDepths();
+
+    //Works out the positions of the stack of numbers that hold whole numbers before every instruction. Returns false if a variable
+    //kept as a whole number is stored a number that is not one, after taking the variable out of m_integerRegisters
+    bool ComputeIntegerMasks();
+
+    //Returns the positions of the stack of numbers that hold whole numbers after an instruction, given the ones before it
+    unsigned IntegerMaskAfter(int a_instruction, int a_depth, unsigned a_mask) const;
+
+    //Returns true if the given instruction is the first instruction of its statement
+    bool IsStatementStart(int a_instruction) const {
+        return m_program.m_statementStart[m_program.m_statementOfInstruction[a_instruction]] == a_instruction;
+    }
+
+    //Returns true if the given instruction is part of the loop
+    bool IsInLoop(int a_instruction) const { return a_instruction >= m_firstInstruction && a_instruction <= m_lastInstruction; }
+
+    //Returns the label of a place where the machine code returns
+    int ExitLabel(int a_instruction, int a_depth, bool a_writeBack, unsigned a_integerMask);
+
+    //Generates the machine code of a single instruction. Returns false if it cannot be compiled
+    bool GenerateInstruction(int a_instruction, int a_depth);
+
+    //Moves the mask that cmpsd left in the scratch register into the given register as 1 or 0
+    void GenerateMaskToNumber(int a_register);
+
+    //Moves the whole number at a position of the stack of numbers into its SSE register, if it is in a general purpose register
+    void GenerateToDouble(int a_position, unsigned a_integerMask);
+
+    //Generates a call to a runtime function, which takes the context, an int and the given numbers of the stack of numbers, and
+    //removes a_popCount numbers from the stack
+    void GenerateRuntimeCall(int a_instruction, int a_depth, const void *a_function, int a_operand, const vector<int> &a_arguments,
+                             int a_popCount);
+
+    //Writes the numbers on the stack and the variables kept in registers back to memory, and reads them back
+    void WriteBackRegisters(int a_depth, unsigned a_integerMask);
+    void ReloadRegisters(int a_depth, unsigned a_integerMask);
+};
+
+
+
+/**/
+/*
+ bool LoopCodeGenerator::ComputeDepths()
+
+ NAME
+    LoopCodeGenerator::ComputeDepths - Works out the depth of the stack of numbers before every instruction of the loop
+
+ SYNOPSIS
+    bool LoopCodeGenerator::ComputeDepths()
+
+ DESCRIPTION
+    The stack of numbers is empty at the start of every statement. Within a statement, the depth follows from the instructions. The
+    instructions after one that always leaves the loop (a jump, an error, or an instruction that the DuckVM executes itself) cannot
+    be reached until the next statement starts.
+
+ RETURNS
+    False if the stack gets deeper than the registers that hold it, if an instruction pops more numbers than are on the stack, or if a
+    jump within the loop leaves numbers on the stack
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool LoopCodeGenerator::ComputeDepths() {
+    m_depths.assign(m_lastInstruction - m_firstInstruction + 1, -1);
+    int depth = 0;
+    bool reachable = true;
+    for(int instructionNum = m_firstInstruction; instructionNum <= m_lastInstruction; instructionNum++) {
+        if(IsStatementStart(instructionNum)) {
+            if(reachable && depth != 0) {
+                return false;
+            }
+            depth = 0;
+            reachable = true;
+        }
+        if(!reachable) {
+            continue;
+        }
+        m_depths[instructionNum - m_firstInstruction] = depth;
+
+        //the numbers that the instruction needs on the stack, and how it changes the depth
+        int needed = 0;
+        int change = 0;
+        const Instruction &instruction = m_program.m_instructions[instructionNum];
+        switch(instruction.m_opCode) {
+            case OpCode::PushNumber:
+            case OpCode::LoadVariable:
+            case OpCode::ReadNumber:
+                change = 1;
+                break;
+            case OpCode::StoreVariable:
+            case OpCode::Pop:
+            case OpCode::PrintNumber:
+                needed = 1;
+                change = -1;
+                break;
+            case OpCode::LoadArrayElement:
+            case OpCode::Negate:
+            case OpCode::LogicalNot:
+                needed = 1;
+                break;
+            case OpCode::StoreArrayElement:
+            case OpCode::StoreArrayElementValueFirst:
+                needed = 2;
+                change = -2;
+                break;
+            case OpCode::Add:
+            case OpCode::Subtract:
+            case OpCode::Multiply:
+            case OpCode::Divide:
+            case OpCode::Less:
+            case OpCode::Greater:
+            case OpCode::LessEqual:
+            case OpCode::GreaterEqual:
+            case OpCode::Equal:
+            case OpCode::NotEqual:
+            case OpCode::BinaryNot:
+                needed = 2;
+                change = -1;
+                break;
+            case OpCode::JumpIfFalse:
+                needed = 1;
+                change = -1;
+                if(depth - 1 != 0 && IsInLoop(instruction.m_operand)) {
+                    return false;
+                }
+                break;
+            case OpCode::Jump:
+                if(depth != 0) {
+                    return false;
+                }
+                reachable = false;
+                break;
+            case OpCode::PrintString:
+            case OpCode::PrintNewline:
+                break;
+            case OpCode::InvalidOperation:
+            case OpCode::DeclareArray:
+            case OpCode::Stop:
+            case OpCode::End:
+            case OpCode::NoMoreLines:
+            case OpCode::RaiseError:
+                reachable = false;
+                break;
+        }
+        if(depth < needed || depth + change > k_maxStackDepth) {
+            return false;
+        }
+        depth += change;
+    }
+    return true;
+}/** bool LoopCodeGenerator::ComputeDepths() **/
+
+
+
+/**/
+/*
+ bool LoopCodeGenerator::ComputeIntegerMasks()
+
+ NAME
+    LoopCodeGenerator::ComputeIntegerMasks - Works out which numbers on the stack are whole numbers in general purpose registers
+
+ SYNOPSIS
+    bool LoopCodeGenerator::ComputeIntegerMasks()
+
+ DESCRIPTION
+    Follows the instructions of every statement as ComputeDepths does, starting from an empty stack. A variable in m_integerRegisters
+    must only be stored numbers that are in general purpose registers; one that is stored another number (the SsaOptimizer knows it is
+    a whole number, but the machine code computes it as a double) is taken out of m_integerRegisters.
+
+ RETURNS
+    True if every variable kept as a whole number is only stored whole numbers, false if one was taken out of m_integerRegisters
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool LoopCodeGenerator::ComputeIntegerMasks() {
+    m_integerMasks.assign(m_depths.size(), 0);
+    bool isConsistent = true;
+    unsigned mask = 0;
+    for(int instructionNum = m_firstInstruction; instructionNum <= m_lastInstruction; instructionNum++) {
+        int depth = m_depths[instructionNum - m_firstInstruction];
+        if(depth < 0) {
+            continue;
+        }
+        //only the numbers below the depth are on the stack, which is empty at the start of a statement and wherever a jump lands
+        mask &= (1u << depth) - 1;
+        m_integerMasks[instructionNum - m_firstInstruction] = mask;
+        const Instruction &instruction = m_program.m_instructions[instructionNum];
+        if(instruction.m_opCode == OpCode::StoreVariable && (mask & (1u << (depth - 1))) == 0 &&
+           m_integerRegisters.erase(instruction.m_operand) > 0) {
+            isConsistent = false;
+        }
+        mask = IntegerMaskAfter(instructionNum, depth, mask);
+    }
+    return isConsistent;
+}/** bool LoopCodeGenerator::ComputeIntegerMasks() **/
+
+
+
+/**/
+/*
+ unsigned LoopCodeGenerator::IntegerMaskAfter(int a_instruction, int a_depth, unsigned a_mask) const
+
+ NAME
+    LoopCodeGenerator::IntegerMaskAfter - Works out which numbers on the stack are whole numbers after an instruction
+
+ SYNOPSIS
+    unsigned LoopCodeGenerator::IntegerMaskAfter(int a_instruction, int a_depth, unsigned a_mask) const
+        a_instruction --> The instruction
+        a_depth --> The depth of the stack of numbers before the instruction
+        a_mask --> The positions of the stack that hold whole numbers in general purpose registers before the instruction
+
+ DESCRIPTION
+    A number that is within k_maxExactInteger, a variable kept as a whole number, and the sum, the difference and the comparison of two
+    whole numbers in general purpose registers are whole numbers in general purpose registers, provided that their position is one of
+    the first k_maxIntegerStackDepth. Every other number that an instruction pushes is a double.
+
+ RETURNS
+    The positions of the stack that hold whole numbers in general purpose registers after the instruction, one bit for each
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+unsigned LoopCodeGenerator::IntegerMaskAfter(int a_instruction, int a_depth, unsigned a_mask) const {
+    const Instruction &instruction = m_program.m_instructions[a_instruction];
+
+    //the lowest position of the stack that the instruction changes, and whether the number it leaves there is a whole number
+    int resultPosition = a_depth;
+    bool isInteger = false;
+    switch(instruction.m_opCode) {
+        case OpCode::PushNumber:
+            isInteger = IsExactInteger(m_program.m_numbers[instruction.m_operand]);
+            break;
+        case OpCode::LoadVariable:
+            isInteger = m_integerRegisters.count(instruction.m_operand) > 0;
+            break;
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Less:
+        case OpCode::Greater:
+        case OpCode::LessEqual:
+        case OpCode::GreaterEqual:
+        case OpCode::Equal:
+        case OpCode::NotEqual:
+            resultPosition = a_depth - 2;
+            isInteger = (a_mask >> resultPosition) == 3;
+            break;
+        case OpCode::StoreVariable:
+        case OpCode::Pop:
+        case OpCode::PrintNumber:
+        case OpCode::JumpIfFalse:
+        case OpCode::LoadArrayElement:
+        case OpCode::Negate:
+        case OpCode::LogicalNot:
+            resultPosition = a_depth - 1;
+            break;
+        case OpCode::StoreArrayElement:
+        case OpCode::StoreArrayElementValueFirst:
+        case OpCode::Multiply:
+        case OpCode::Divide:
+        case OpCode::BinaryNot:
+            resultPosition = a_depth - 2;
+            break;
+        default:
+            break;
+    }
+    a_mask &= (1u << resultPosition) - 1;
+    if(isInteger && resultPosition < k_maxIntegerStackDepth) {
+        a_mask |= 1u << resultPosition;
+    }
+    return a_mask;
+}/** unsigned LoopCodeGenerator::IntegerMaskAfter(int a_instruction, int a_depth, unsigned a_mask) const **/
+
+
+
+/**/
+/*
+ bool LoopCodeGenerator::Generate(vector<uint8_t> &a_code, vector<int> &a_variables, vector<int> &a_integerVariables)
+
+ NAME
+    LoopCodeGenerator::Generate - Generates the machine code of the loop
+
+ SYNOPSIS
+    bool LoopCodeGenerator::Generate(vector<uint8_t> &a_code, vector<int> &a_variables, vector<int> &a_integerVariables)
+        a_code --> Set to the machine code
+        a_variables --> Set to the variables that the loop reads or writes
+        a_integerVariables --> Set to the variables that the machine code keeps as whole numbers in general purpose registers
+
+ DESCRIPTION
+    The machine code is a function that takes a JitContext (System V calling convention) and returns the instruction that the DuckVM
+    is to continue at. While it runs, rbx holds the context, r12 the values of the variables and r13 the stack of numbers of the DuckVM.
+    The numbers on the stack are kept in xmm0 upwards, and the variables that the loop uses most are kept in xmm8 upwards for the whole
+    loop. The variables that the SsaOptimizer found only ever hold whole numbers are kept in general purpose registers instead (r10, r11,
+    r14 and rbp) as 64 bit integers, and so are the whole numbers at the bottom of the stack (in rsi, rdi, r8 and r9), so that counters
+    are added and compared with integer instructions. Every place where the machine code returns is generated once, after the
+    instructions of the loop.
+
+ RETURNS
+    False if the loop cannot be compiled
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool LoopCodeGenerator::Generate(vector<uint8_t> &a_code, vector<int> &a_variables, vector<int> &a_integerVariables) {
+    if(!ComputeDepths()) {
+        return false;
+    }
+
+    //the variables that are used the most get the registers
+    map<int, int> useCounts;
+    for(int instructionNum = m_firstInstruction; instructionNum <= m_lastInstruction; instructionNum++) {
+        const Instruction &instruction = m_program.m_instructions[instructionNum];
+        if(m_depths[instructionNum - m_firstInstruction] >= 0 &&
+           (instruction.m_opCode == OpCode::LoadVariable || instruction.m_opCode == OpCode::StoreVariable)) {
+            useCounts[instruction.m_operand]++;
+        }
+    }
+    vector<pair<int, int>> byUseCount;
+    a_variables.clear();
+    for(map<int, int>::const_iterator it = useCounts.begin(); it != useCounts.end(); it++) {
+        a_variables.push_back(it->first);
+        byUseCount.push_back(make_pair(-it->second, it->first));
+    }
+    sort(byUseCount.begin(), byUseCount.end());
+
+    //the variables that only ever hold whole numbers get the general purpose registers first, unless the loop stores a number into
+    //one that it does not compute as a whole number (a product, for example), and the others get the SSE registers
+    const vector<bool> &wholeSlots = m_program.m_wholeSlots;
+    for(size_t i = 0; i < byUseCount.size() && m_integerRegisters.size() < static_cast<size_t>(k_maxIntegerRegisterVariables); i++) {
+        int variable = byUseCount[i].second;
+        if(variable < static_cast<int>(wholeSlots.size()) && wholeSlots[variable]) {
+            m_integerRegisters[variable] = k_integerVariableRegisters[m_integerRegisters.size()];
+        }
+    }
+    //taking a variable out of the general purpose registers can make the number that is stored into another one not a whole number
+    bool isConsistent = false;
+    while(!isConsistent) {
+        isConsistent = ComputeIntegerMasks();
+    }
+    a_integerVariables.clear();
+    for(map<int, int>::const_iterator it = m_integerRegisters.begin(); it != m_integerRegisters.end(); it++) {
+        a_integerVariables.push_back(it->first);
+    }
+    for(size_t i = 0; i < byUseCount.size() && m_variableRegisters.size() < static_cast<size_t>(k_maxRegisterVariables); i++) {
+        if(m_integerRegisters.count(byUseCount[i].second) == 0) {
+            m_variableRegisters[byUseCount[i].second] = k_firstVariableRegister + static_cast<int>(m_variableRegisters.size());
+        }
+    }
+
+    //prologue. Five pushes keep the stack aligned to 16 bytes for calls to the runtime
+    m_returnLabel = m_assembler.NewLabel();
+    m_assembler.Push(Rbp);
+    m_assembler.Push(Rbx);
+    m_assembler.Push(R12);
+    m_assembler.Push(R13);
+    m_assembler.Push(R14);
+    m_assembler.MoveRegister(Rbx, Rdi);
+    m_assembler.LoadRegister(R12, Rbx, offsetof(JitContext, m_values));
+    m_assembler.LoadRegister(R13, Rbx, offsetof(JitContext, m_stack));
+    ReloadRegisters(0, 0);
+
+    for(int instructionNum = m_firstInstruction; instructionNum <= m_lastInstruction; instructionNum++) {
+        m_instructionLabels.push_back(m_assembler.NewLabel());
+    }
+    int depth = -1;
+    for(int instructionNum = m_firstInstruction; instructionNum <= m_lastInstruction; instructionNum++) {
+        m_assembler.Bind(m_instructionLabels[instructionNum - m_firstInstruction]);
+        depth = m_depths[instructionNum - m_firstInstruction];
+        if(depth >= 0 && !GenerateInstruction(instructionNum, depth)) {
+            return false;
+        }
+    }
+    //the last instruction is the backward jump, so this is only reached if the loop was compiled from a jump into a statement
+    m_assembler.Jump(ExitLabel(m_lastInstruction + 1, 0, true, 0));
+
+    //the places where the machine code returns. New ones are not added while they are generated
+    for(map<Exit, int>::const_iterator it = m_exits.begin(); it != m_exits.end(); it++) {
+        int exitInstruction = get<0>(it->first);
+        int exitDepth = get<1>(it->first);
+        m_assembler.Bind(it->second);
+        if(get<2>(it->first)) {
+            WriteBackRegisters(exitDepth, get<3>(it->first));
+        }
+        m_assembler.StoreImmediate32(Rbx, offsetof(JitContext, m_exitDepth), exitDepth);
+        m_assembler.MoveImmediate32(Rax, exitInstruction);
+        m_assembler.Jump(m_returnLabel);
+    }
+
+    m_assembler.Bind(m_returnLabel);
+    m_assembler.Pop(R14);
+    m_assembler.Pop(R13);
+    m_assembler.Pop(R12);
+    m_assembler.Pop(Rbx);
+    m_assembler.Pop(Rbp);
+    m_assembler.Return();
+
+    a_code = m_assembler.Finish();
+    return true;
+}/** bool LoopCodeGenerator::Generate(vector<uint8_t> &a_code, vector<int> &a_variables, vector<int> &a_integerVariables) **/
+
+
+
+/**/
+/*
+ int LoopCodeGenerator::ExitLabel(int a_instruction, int a_depth, bool a_writeBack, unsigned a_integerMask)
+
+ NAME
+    LoopCodeGenerator::ExitLabel - Returns the label of a place where the machine code returns to the DuckVM
+
+ SYNOPSIS
+    int LoopCodeGenerator::ExitLabel(int a_instruction, int a_depth, bool a_writeBack, unsigned a_integerMask)
+        a_instruction --> The instruction that the DuckVM is to continue at
+        a_depth --> The depth of the stack of numbers at that instruction
+        a_writeBack --> True if the registers still hold the numbers on the stack and the variables
+        a_integerMask --> The positions of the stack that hold whole numbers in general purpose registers
+
+ DESCRIPTION
+    Creates the label the first time that the place is asked for.
+
+ RETURNS
+    The label
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int LoopCodeGenerator::ExitLabel(int a_instruction, int a_depth, bool a_writeBack, unsigned a_integerMask) {
+    Exit exit(a_instruction, a_depth, a_writeBack, a_integerMask);
+    map<Exit, int>::const_iterator it = m_exits.find(exit);
+    if(it != m_exits.end()) {
+        return it->second;
+    }
+    int label = m_assembler.NewLabel();
+    m_exits[exit] = label;
+    return label;
+}/** int LoopCodeGenerator::ExitLabel(int a_instruction, int a_depth, bool a_writeBack, unsigned a_integerMask) **/
+
+
+
+/**/
+/*
+ bool LoopCodeGenerator::GenerateInstruction(int a_instruction, int a_depth)
+
+ NAME
+    LoopCodeGenerator::GenerateInstruction - Generates the machine code of a single instruction
+
+ SYNOPSIS
+    bool LoopCodeGenerator::GenerateInstruction(int a_instruction, int a_depth)
+        a_instruction --> The instruction
+        a_depth --> The depth of the stack of numbers before the instruction
+
+ DESCRIPTION
+    Arithmetic, comparisons, variables and jumps within the loop are carried out in registers, with the same double precision
+    operations, in the same order, as the DuckVM carries them out, so they give the same results. Whole numbers within
+    k_maxExactInteger are added, subtracted and compared with integer instructions instead, which give the same results as long as
+    the result stays within k_maxExactInteger too; otherwise the DuckVM carries out the instruction. Comparisons yield 1 or 0. Array
+    accesses, print and read call the runtime. Jumps out of the loop return to the DuckVM at the instruction they jump to, and the
+    instructions that the DuckVM executes itself (errors, array declarations, stop and end) return to the DuckVM at the instruction.
+
+ RETURNS
+    False if the instruction cannot be compiled
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool LoopCodeGenerator::GenerateInstruction(int a_instruction, int a_depth) {
+    const Instruction &instruction = m_program.m_instructions[a_instruction];
+    int top = a_depth - 1;
+    int belowTop = a_depth - 2;
+    map<int, int>::const_iterator variableRegister = m_variableRegisters.find(instruction.m_operand);
+    bool inRegister = variableRegister != m_variableRegisters.end();
+    map<int, int>::const_iterator integerRegister = m_integerRegisters.find(instruction.m_operand);
+    bool inIntegerRegister = integerRegister != m_integerRegisters.end();
+
+    //the positions of the stack that hold whole numbers in general purpose registers, before and after the instruction
+    unsigned integerMask = m_integerMasks[a_instruction - m_firstInstruction];
+    unsigned integerMaskAfter = IntegerMaskAfter(a_instruction, a_depth, integerMask);
+    bool isIntegerOperation = a_depth >= 2 && (integerMask >> belowTop) == 3;
+
+    switch(instruction.m_opCode) {
+        case OpCode::PushNumber:
+            if((integerMaskAfter >> a_depth & 1) != 0) {
+                m_assembler.MoveImmediate64(k_integerStackRegisters[a_depth],
+                                            static_cast<uint64_t>(static_cast<int64_t>(m_program.m_numbers[instruction.m_operand])));
+                break;
+            }
+            m_assembler.MoveImmediate64(Rax, DoubleBits(m_program.m_numbers[instruction.m_operand]));
+            m_assembler.MoveToDouble(a_depth, Rax);
+            break;
+        case OpCode::LoadVariable:
+            if(inIntegerRegister && (integerMaskAfter >> a_depth & 1) != 0) {
+                m_assembler.MoveRegister(k_integerStackRegisters[a_depth], integerRegister->second);
+            } else if(inIntegerRegister) {
+                m_assembler.ConvertToDouble(a_depth, integerRegister->second);
+            } else if(inRegister) {
+                m_assembler.MoveDouble(a_depth, variableRegister->second);
+            } else {
+                m_assembler.LoadDouble(a_depth, R12, instruction.m_operand * sizeof(double));
+            }
+            break;
+        case OpCode::StoreVariable:
+            //ComputeIntegerMasks made sure that a variable kept as a whole number is stored a whole number
+            if(inIntegerRegister) {
+                m_assembler.MoveRegister(integerRegister->second, k_integerStackRegisters[top]);
+                break;
+            }
+            GenerateToDouble(top, integerMask);
+            if(inRegister) {
+                m_assembler.MoveDouble(variableRegister->second, top);
+            } else {
+                m_assembler.StoreDouble(R12, instruction.m_operand * sizeof(double), top);
+            }
+            break;
+        case OpCode::LoadArrayElement:
+            GenerateRuntimeCall(a_instruction, a_depth, reinterpret_cast<const void*>(&LoadArrayElementAtRuntime), instruction.m_operand,
+                                {top}, 1);
+            m_assembler.LoadDouble(top, Rbx, offsetof(JitContext, m_result));
+            break;
+        case OpCode::StoreArrayElement:
+            GenerateRuntimeCall(a_instruction, a_depth, reinterpret_cast<const void*>(&StoreArrayElementAtRuntime), instruction.m_operand,
+                                {belowTop, top}, 2);
+            break;
+        case OpCode::StoreArrayElementValueFirst:
+            GenerateRuntimeCall(a_instruction, a_depth, reinterpret_cast<const void*>(&StoreArrayElementAtRuntime), instruction.m_operand,
+                                {top, belowTop}, 2);
+            break;
+        case OpCode::Pop:
+            break;
+
+        //the sum or the difference of two whole numbers in general purpose registers is worked out with integer instructions. If it is
+        //not within k_maxExactInteger, the DuckVM works it out as a double instead
+        case OpCode::Add:
+        case OpCode::Subtract:
+            if(isIntegerOperation) {
+                m_assembler.MoveRegister(Rax, k_integerStackRegisters[belowTop]);
+                if(instruction.m_opCode == OpCode::Add) {
+                    m_assembler.AddRegister(Rax, k_integerStackRegisters[top]);
+                } else {
+                    m_assembler.SubtractRegister(Rax, k_integerStackRegisters[top]);
+                }
+                m_assembler.MoveImmediate64(Rcx, static_cast<uint64_t>(k_maxExactInteger));
+                m_assembler.AddRegister(Rcx, Rax);
+                m_assembler.MoveImmediate64(Rdx, static_cast<uint64_t>(2 * k_maxExactInteger));
+                m_assembler.CompareRegister(Rcx, Rdx);
+                m_assembler.JumpIf(Above, ExitLabel(a_instruction, a_depth, true, integerMask));
+                m_assembler.MoveRegister(k_integerStackRegisters[belowTop], Rax);
+                break;
+            }
+            GenerateToDouble(belowTop, integerMask);
+            GenerateToDouble(top, integerMask);
+            if(instruction.m_opCode == OpCode::Add) {
+                m_assembler.AddDouble(belowTop, top);
+            } else {
+                m_assembler.SubtractDouble(belowTop, top);
+            }
+            break;
+        case OpCode::Multiply:
+            GenerateToDouble(belowTop, integerMask);
+            GenerateToDouble(top, integerMask);
+            m_assembler.MultiplyDouble(belowTop, top);
+            break;
+        case OpCode::Divide:
+            GenerateToDouble(belowTop, integerMask);
+            GenerateToDouble(top, integerMask);
+            m_assembler.DivideDouble(belowTop, top);
+            break;
+        //a > b and a >= b are worked out as b < a and b <= a. Comparisons with NaN are false, except for !=, as in the DuckVM. Two whole
+        //numbers in general purpose registers are compared with integer instructions
+        case OpCode::Less:
+        case OpCode::LessEqual:
+        case OpCode::Equal:
+        case OpCode::NotEqual:
+        case OpCode::Greater:
+        case OpCode::GreaterEqual:
+            if(isIntegerOperation) {
+                m_assembler.CompareRegister(k_integerStackRegisters[belowTop], k_integerStackRegisters[top]);
+                m_assembler.SetRaxIf(instruction.m_opCode == OpCode::Less ? Less : instruction.m_opCode == OpCode::LessEqual ? LessEqual :
+                                     instruction.m_opCode == OpCode::Equal ? Equal : instruction.m_opCode == OpCode::NotEqual ? NotEqual :
+                                     instruction.m_opCode == OpCode::Greater ? Greater : GreaterEqual);
+                m_assembler.MoveRegister(k_integerStackRegisters[belowTop], Rax);
+                break;
+            }
+            GenerateToDouble(belowTop, integerMask);
+            GenerateToDouble(top, integerMask);
+            if(instruction.m_opCode == OpCode::Greater || instruction.m_opCode == OpCode::GreaterEqual) {
+                m_assembler.MoveDouble(k_scratchRegister, top);
+                m_assembler.CompareDouble(k_scratchRegister, belowTop, instruction.m_opCode == OpCode::Greater ? CompareLess : CompareLessEqual);
+            } else {
+                m_assembler.MoveDouble(k_scratchRegister, belowTop);
+                m_assembler.CompareDouble(k_scratchRegister, top, instruction.m_opCode == OpCode::Less ? CompareLess :
+                                          instruction.m_opCode == OpCode::LessEqual ? CompareLessEqual :
+                                          instruction.m_opCode == OpCode::Equal ? CompareEqual : CompareNotEqual);
+            }
+            GenerateMaskToNumber(belowTop);
+            break;
+        //x != 0 ? 0 : 1 is worked out as 0 == x
+        case OpCode::BinaryNot:
+            GenerateToDouble(belowTop, integerMask);
+            m_assembler.XorDouble(k_scratchRegister, k_scratchRegister);
+            m_assembler.CompareDouble(k_scratchRegister, belowTop, CompareEqual);
+            GenerateMaskToNumber(belowTop);
+            break;
+        case OpCode::LogicalNot:
+            GenerateToDouble(top, integerMask);
+            m_assembler.XorDouble(k_scratchRegister, k_scratchRegister);
+            m_assembler.CompareDouble(k_scratchRegister, top, CompareEqual);
+            GenerateMaskToNumber(top);
+            break;
+        case OpCode::Negate:
+            GenerateToDouble(top, integerMask);
+            m_assembler.MoveImmediate64(Rax, DoubleBits(-1));
+            m_assembler.MoveToDouble(k_scratchRegister, Rax);
+            m_assembler.MultiplyDouble(top, k_scratchRegister);
+            break;
+
+        case OpCode::Jump:
+            m_assembler.Jump(IsInLoop(instruction.m_operand) ? m_instructionLabels[instruction.m_operand - m_firstInstruction]
+                             : ExitLabel(instruction.m_operand, 0, true, 0));
+            break;
+        //jumps if the number is 0 (or -0), but not if it is NaN
+        case OpCode::JumpIfFalse: {
+            int taken = IsInLoop(instruction.m_operand) ? m_instructionLabels[instruction.m_operand - m_firstInstruction]
+                        : ExitLabel(instruction.m_operand, top, true, integerMaskAfter);
+            if((integerMask >> top & 1) != 0) {
+                m_assembler.TestRegister(k_integerStackRegisters[top]);
+                m_assembler.JumpIf(Equal, taken);
+                break;
+            }
+            int notTaken = m_assembler.NewLabel();
+            m_assembler.XorDouble(k_scratchRegister, k_scratchRegister);
+            m_assembler.UnorderedCompareDouble(top, k_scratchRegister);
+            m_assembler.JumpIf(Parity, notTaken);
+            m_assembler.JumpIf(Equal, taken);
+            m_assembler.Bind(notTaken);
+            break;
+        }
+
+        case OpCode::PrintString:
+            GenerateRuntimeCall(a_instruction, a_depth, reinterpret_cast<const void*>(&PrintStringAtRuntime), instruction.m_operand, {}, 0);
+            break;
+        case OpCode::PrintNumber:
+            GenerateRuntimeCall(a_instruction, a_depth, reinterpret_cast<const void*>(&PrintNumberAtRuntime), 0, {top}, 1);
+            break;
+        case OpCode::PrintNewline:
+            GenerateRuntimeCall(a_instruction, a_depth, reinterpret_cast<const void*>(&PrintNewlineAtRuntime), 0, {}, 0);
+            break;
+        case OpCode::ReadNumber:
+            GenerateRuntimeCall(a_instruction, a_depth, reinterpret_cast<const void*>(&ReadNumberAtRuntime), 0, {}, 0);
+            m_assembler.LoadDouble(a_depth, Rbx, offsetof(JitContext, m_result));
+            break;
+
+        case OpCode::InvalidOperation:
+        case OpCode::DeclareArray:
+        case OpCode::Stop:
+        case OpCode::End:
+        case OpCode::NoMoreLines:
+        case OpCode::RaiseError:
+            m_assembler.Jump(ExitLabel(a_instruction, a_depth, true, integerMask));
+            break;
+
+        default:
+            return false;
+    }
+    return true;
+}/** bool LoopCodeGenerator::GenerateInstruction(int a_instruction, int a_depth) **/
+
+
+
+/**/
+/*
+ void LoopCodeGenerator::GenerateMaskToNumber(int a_register)
+
+ NAME
+    LoopCodeGenerator::GenerateMaskToNumber - Turns the result of a comparison into 1 or 0
+
+ SYNOPSIS
+    void LoopCodeGenerator::GenerateMaskToNumber(int a_register)
+        a_register --> The register that receives the number
+
+ DESCRIPTION
+    cmpsd leaves all ones in the scratch register if the comparison held and all zeros if not. Masking the bits of 1.0 with it gives
+    1.0 or 0.0.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void LoopCodeGenerator::GenerateMaskToNumber(int a_register) {
+    m_assembler.MoveFromDouble(Rax, k_scratchRegister);
+    m_assembler.MoveImmediate64(Rcx, DoubleBits(1));
+    m_assembler.AndRegister(Rax, Rcx);
+    m_assembler.MoveToDouble(a_register, Rax);
+}/** void LoopCodeGenerator::GenerateMaskToNumber(int a_register) **/
+
+
+
+/**/
+/*
+ void LoopCodeGenerator::GenerateToDouble(int a_position, unsigned a_integerMask)
+
+ NAME
+    LoopCodeGenerator::GenerateToDouble - Converts a whole number on the stack into a double
+
+ SYNOPSIS
+    void LoopCodeGenerator::GenerateToDouble(int a_position, unsigned a_integerMask)
+        a_position --> The position of the number on the stack
+        a_integerMask --> The positions on the stack that hold whole numbers in general purpose registers
+
+ DESCRIPTION
+    Instructions that work on doubles find their operands in the SSE registers of their positions. If the number at the position is
+    a whole number in a general purpose register, it is converted into the SSE register of the position, which is exact within
+    k_maxExactInteger.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void LoopCodeGenerator::GenerateToDouble(int a_position, unsigned a_integerMask) {
+    if((a_integerMask >> a_position & 1) != 0) {
+        m_assembler.ConvertToDouble(a_position, k_integerStackRegisters[a_position]);
+    }
+}/** void LoopCodeGenerator::GenerateToDouble(int a_position, unsigned a_integerMask) **/
+
+
+
+/**/
+/*
+ void LoopCodeGenerator::GenerateRuntimeCall(int a_instruction, int a_depth, const void *a_function, int a_operand,
+                                             const vector<int> &a_arguments, int a_popCount)
+
+ NAME
+    LoopCodeGenerator::GenerateRuntimeCall - Generates a call to a runtime function
+
+ SYNOPSIS
+    void LoopCodeGenerator::GenerateRuntimeCall(int a_instruction, int a_depth, const void *a_function, int a_operand,
+                                                const vector<int> &a_arguments, int a_popCount)
+        a_instruction --> The instruction that the call carries out
+        a_depth --> The depth of the stack of numbers before the instruction
+        a_function --> The runtime function
+        a_operand --> The int that is passed to the function after the context
+        a_arguments --> The positions on the stack of the numbers that are passed to the function, in order
+        a_popCount --> The number of numbers that the instruction removes from the stack
+
+ DESCRIPTION
+    Every SSE register and every general purpose register that holds a whole number may be changed by the call, so the numbers on
+    the stack and the variables kept in registers are written back to memory first, and the ones that are still needed are read back
+    afterwards. If the function fails, the machine code returns to
+    the DuckVM at the instruction, with everything already in memory.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void LoopCodeGenerator::GenerateRuntimeCall(int a_instruction, int a_depth, const void *a_function, int a_operand,
+                                            const vector<int> &a_arguments, int a_popCount) {
+    unsigned integerMask = m_integerMasks[a_instruction - m_firstInstruction];
+    WriteBackRegisters(a_depth, integerMask);
+    for(size_t i = 0; i < a_arguments.size(); i++) {
+        m_assembler.LoadDouble(static_cast<int>(i), R13, a_arguments[i] * sizeof(double));
+    }
+    m_assembler.MoveRegister(Rdi, Rbx);
+    m_assembler.MoveImmediate32(Rsi, a_operand);
+    m_assembler.MoveImmediate64(Rax, reinterpret_cast<uintptr_t>(a_function));
+    m_assembler.CallRegister(Rax);
+    m_assembler.TestLowByte(Rax);
+    m_assembler.JumpIf(Equal, ExitLabel(a_instruction, a_depth, false, 0));
+    ReloadRegisters(a_depth - a_popCount, integerMask);
+}/** void LoopCodeGenerator::GenerateRuntimeCall(int a_instruction, int a_depth, const void *a_function, int a_operand, const vector<int> &a_arguments, int a_popCount) **/
+
+
+
+/**/
+/*
+ void LoopCodeGenerator::WriteBackRegisters(int a_depth, unsigned a_integerMask)
+
+ NAME
+    LoopCodeGenerator::WriteBackRegisters - Writes the registers back to memory
+
+ SYNOPSIS
+    void LoopCodeGenerator::WriteBackRegisters(int a_depth, unsigned a_integerMask)
+        a_depth --> The depth of the stack of numbers
+        a_integerMask --> The positions on the stack that hold whole numbers in general purpose registers
+
+ DESCRIPTION
+    Writes the numbers on the stack to the stack of numbers of the DuckVM and the variables kept in registers to the symbol table.
+    The whole numbers kept in general purpose registers are written as the doubles that they stand for.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void LoopCodeGenerator::WriteBackRegisters(int a_depth, unsigned a_integerMask) {
+    for(int i = 0; i < a_depth; i++) {
+        if((a_integerMask >> i & 1) != 0) {
+            m_assembler.ConvertToDouble(k_scratchRegister, k_integerStackRegisters[i]);
+            m_assembler.StoreDouble(R13, i * sizeof(double), k_scratchRegister);
+        } else {
+            m_assembler.StoreDouble(R13, i * sizeof(double), i);
+        }
+    }
+    for(map<int, int>::const_iterator it = m_variableRegisters.begin(); it != m_variableRegisters.end(); it++) {
+        m_assembler.StoreDouble(R12, it->first * sizeof(double), it->second);
+    }
+    for(map<int, int>::const_iterator it = m_integerRegisters.begin(); it != m_integerRegisters.end(); it++) {
+        m_assembler.ConvertToDouble(k_scratchRegister, it->second);
+        m_assembler.StoreDouble(R12, it->first * sizeof(double), k_scratchRegister);
+    }
+}/** void LoopCodeGenerator::WriteBackRegisters(int a_depth, unsigned a_integerMask) **/
+
+
+
+/**/
+/*
+ void LoopCodeGenerator::ReloadRegisters(int a_depth, unsigned a_integerMask)
+
+ NAME
+    LoopCodeGenerator::ReloadRegisters - Reads the registers back from memory
+
+ SYNOPSIS
+    void LoopCodeGenerator::ReloadRegisters(int a_depth, unsigned a_integerMask)
+        a_depth --> The number of numbers on the stack to be read back
+        a_integerMask --> The positions on the stack that hold whole numbers in general purpose registers
+
+ DESCRIPTION
+    Reads the numbers on the stack back from the stack of numbers of the DuckVM and the variables kept in registers back from the
+    symbol table. What was written back from a general purpose register is a whole number within k_maxExactInteger, so it converts
+    back to the same integer.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void LoopCodeGenerator::ReloadRegisters(int a_depth, unsigned a_integerMask) {
+    for(int i = 0; i < a_depth; i++) {
+        if((a_integerMask >> i & 1) != 0) {
+            m_assembler.LoadDouble(k_scratchRegister, R13, i * sizeof(double));
+            m_assembler.ConvertToInteger(k_integerStackRegisters[i], k_scratchRegister);
+        } else {
+            m_assembler.LoadDouble(i, R13, i * sizeof(double));
+        }
+    }
+    for(map<int, int>::const_iterator it = m_variableRegisters.begin(); it != m_variableRegisters.end(); it++) {
+        m_assembler.LoadDouble(it->second, R12, it->first * sizeof(double));
+    }
+    for(map<int, int>::const_iterator it = m_integerRegisters.begin(); it != m_integerRegisters.end(); it++) {
+        m_assembler.LoadDouble(k_scratchRegister, R12, it->first * sizeof(double));
+        m_assembler.ConvertToInteger(it->second, k_scratchRegister);
+    }
+}/** void LoopCodeGenerator::ReloadRegisters(int a_depth, unsigned a_integerMask) **/
+
+
+
+/**/
+/*
+ DuckJit::DuckJit(const BytecodeProgram &a_program, const Statement &a_statements, SymbolTable &a_symbolTable, ArrayTable &a_arrayTable,
+                  OutputBuffer &a_output, InputReader &a_input)
+
+ NAME
+    DuckJit::DuckJit - Creates the just-in-time compiler of a program
+
+ SYNOPSIS
+    DuckJit::DuckJit(const BytecodeProgram &a_program, const Statement &a_statements, SymbolTable &a_symbolTable, ArrayTable &a_arrayTable,
+                     OutputBuffer &a_output, InputReader &a_input)
+        a_program --> The program that the DuckVM runs
+        a_statements --> The statements that the program was compiled from
+        a_symbolTable --> The variables of the program
+        a_arrayTable --> The arrays of the program
+        a_output --> The buffer that the output of the program is written to
+        a_input --> The reader of the input values of read statements
+
+ DESCRIPTION
+    Makes room for an entry count and a compiled loop for every instruction.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+DuckJit::DuckJit(const BytecodeProgram &a_program, const Statement &a_statements, SymbolTable &a_symbolTable, ArrayTable &a_arrayTable,
+                 OutputBuffer &a_output, InputReader &a_input) :
+    m_program(a_program), m_statements(a_statements), m_symbolTable(a_symbolTable), m_arrayTable(a_arrayTable), m_output(a_output),
+    m_input(a_input), m_entryCounts(a_program.m_instructions.size()), m_loops(a_program.m_instructions.size()) {
+}/** DuckJit::DuckJit(const BytecodeProgram &a_program, const Statement &a_statements, SymbolTable &a_symbolTable, ArrayTable &a_arrayTable, OutputBuffer &a_output, InputReader &a_input) **/
+
+
+
+/**/
+/*
+ DuckJit::~DuckJit()
+
+ NAME
+    DuckJit::~DuckJit - Frees the machine code of the compiled loops
+
+ SYNOPSIS
+    DuckJit::~DuckJit()
+
+ DESCRIPTION
+    Unmaps the executable memory of every loop that was compiled.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+DuckJit::~DuckJit() {
+#if defined(__x86_64__) && defined(__linux__)
+    for(size_t i = 0; i < m_loops.size(); i++) {
+        if(m_loops[i] != nullptr && m_loops[i]->m_memory != nullptr) {
+            munmap(m_loops[i]->m_memory, m_loops[i]->m_memorySize);
+        }
+    }
+#endif
+}/** DuckJit::~DuckJit() **/
+
+
+
+/**/
+/*
+ bool DuckJit::RunLoop(int a_jumpInstruction, double *a_stack, int &a_programCounter, int &a_stackDepth)
+
+ NAME
+    DuckJit::RunLoop - Runs a hot loop as machine code
+
+ SYNOPSIS
+    bool DuckJit::RunLoop(int a_jumpInstruction, double *a_stack, int &a_programCounter, int &a_stackDepth)
+        a_jumpInstruction --> The backward jump that enters the loop
+        a_stack --> The bottom of the stack of numbers of the DuckVM, which is empty
+        a_programCounter --> Set to the instruction that the DuckVM is to continue at
+        a_stackDepth --> Set to the depth of the stack of numbers at that instruction
+
+ DESCRIPTION
+    Counts the entry into the loop. The loop is compiled once it has been entered k_hotLoopThreshold times. The machine code reads
+    and writes the variables of the loop without checking whether they have been assigned, so it is only run if all of them have
+    been; otherwise the DuckVM runs this pass of the loop, and reports the error if a variable is read before it is assigned. The
+    variables that the machine code keeps in general purpose registers must also hold whole numbers within k_maxExactInteger (and
+    not -0), since the SsaOptimizer only proves that they are whole, not how large they grow; otherwise the DuckVM runs this pass of
+    the loop with doubles.
+
+ RETURNS
+    True if the loop was run as machine code, false if the DuckVM is to run it
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool DuckJit::RunLoop(int a_jumpInstruction, double *a_stack, int &a_programCounter, int &a_stackDepth) {
+    int loopStart = m_program.m_instructions[a_jumpInstruction].m_operand;
+    unique_ptr<CompiledLoop> &loop = m_loops[loopStart];
+    if(loop == nullptr) {
+        if(m_disabled || ++m_entryCounts[loopStart] < k_hotLoopThreshold) {
+            return false;
+        }
+        loop = CompileLoop(loopStart, a_jumpInstruction);
+    }
+    if(loop->m_function == nullptr) {
+        return false;
+    }
+    for(size_t i = 0; i < loop->m_variables.size(); i++) {
+        if(!m_symbolTable.IsAssigned(loop->m_variables[i])) {
+            return false;
+        }
+    }
+    const double *values = m_symbolTable.GetValueArray();
+    for(size_t i = 0; i < loop->m_integerVariables.size(); i++) {
+        if(!IsExactInteger(values[loop->m_integerVariables[i]])) {
+            return false;
+        }
+    }
+
+    JitContext context;
+    context.m_values = m_symbolTable.GetValueArray();
+    context.m_stack = a_stack;
+    context.m_program = &m_program;
+    context.m_statements = &m_statements;
+    context.m_arrayTable = &m_arrayTable;
+    context.m_output = &m_output;
+    context.m_input = &m_input;
+    context.m_errorMessage = &m_errorMessage;
+    context.m_result = 0;
+    context.m_exitDepth = 0;
+    context.m_errorPending = false;
+
+    a_programCounter = loop->m_function(&context);
+    a_stackDepth = context.m_exitDepth;
+    if(context.m_errorPending) {
+        throw DuckInterpreterException(m_errorMessage);
+    }
+    return true;
+}/** bool DuckJit::RunLoop(int a_jumpInstruction, double *a_stack, int &a_programCounter, int &a_stackDepth) **/
+
+
+
+/**/
+/*
+ unique_ptr<DuckJit::CompiledLoop> DuckJit::CompileLoop(int a_firstInstruction, int a_lastInstruction)
+
+ NAME
+    DuckJit::CompileLoop - Compiles a loop into machine code
+
+ SYNOPSIS
+    unique_ptr<DuckJit::CompiledLoop> DuckJit::CompileLoop(int a_firstInstruction, int a_lastInstruction)
+        a_firstInstruction --> The first instruction of the loop, which the backward jump jumps to
+        a_lastInstruction --> The backward jump
+
+ DESCRIPTION
+    Generates the machine code of the loop and copies it into executable memory. If executable memory cannot be allocated, no more
+    loops are compiled.
+
+ RETURNS
+    The compiled loop. Its function is nullptr if it could not be compiled
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+unique_ptr<DuckJit::CompiledLoop> DuckJit::CompileLoop(int a_firstInstruction, int a_lastInstruction) {
+    unique_ptr<CompiledLoop> loop(new CompiledLoop());
+    LoopCodeGenerator generator(m_program, a_firstInstruction, a_lastInstruction);
+    vector<uint8_t> code;
+    if(generator.Generate(code, loop->m_variables, loop->m_integerVariables) && !InstallCode(*loop, code)) {
+        m_disabled = true;
+    }
+    return loop;
+}/** unique_ptr<DuckJit::CompiledLoop> DuckJit::CompileLoop(int a_firstInstruction, int a_lastInstruction) **/
+
+
+
+/**/
+/*
+ bool DuckJit::InstallCode(CompiledLoop &a_loop, const vector<uint8_t> &a_code)
+
+ NAME
+    DuckJit::InstallCode - Copies machine code into executable memory
+
+ SYNOPSIS
+    bool DuckJit::InstallCode(CompiledLoop &a_loop, const vector<uint8_t> &a_code)
+        a_loop --> The loop that the machine code belongs to
+        a_code --> The machine code
+
+ DESCRIPTION
+    Maps memory that can be written, copies the machine code into it, and then makes it executable instead of writable, so that the
+    memory is never writable and executable at once.
+
+ RETURNS
+    True if the loop's function is ready to run. False if executable memory cannot be allocated (or machine code is not supported)
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool DuckJit::InstallCode(CompiledLoop &a_loop, const vector<uint8_t> &a_code) {
+#if defined(__x86_64__) && defined(__linux__)
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t memorySize = (a_code.size() + pageSize - 1) / pageSize * pageSize;
+    void *memory = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory == MAP_FAILED) {
+        return false;
+    }
+    memcpy(memory, a_code.data(), a_code.size());
+    if(mprotect(memory, memorySize, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, memorySize);
+        return false;
+    }
+    a_loop.m_memory = memory;
+    a_loop.m_memorySize = memorySize;
+    a_loop.m_function = reinterpret_cast<LoopFunction>(memory);
+    return true;
+#else
+    return false;
+#endif
+}/** bool DuckJit::InstallCode(CompiledLoop &a_loop, const vector<uint8_t> &a_code) **/
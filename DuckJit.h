@@ -0,0 +1,127 @@
+/* DuckJit.h
+ DuckJit.h contains the DuckJit class
+ DuckJit is the just-in-time compiler of the Duck virtual machine (with the --engine=jit option). The DuckVM counts how many times
+ every loop is entered by a backward jump (a goto to a label above it), and once a loop is hot, the DuckJit compiles the instructions
+ from the label to the jump into x86-64 machine code in executable memory. The machine code keeps the most used variables of the loop
+ in SSE registers and the stack of numbers in SSE registers, and calls back into the runtime for print, read and array accesses.
+ The variables that the SsaOptimizer proved only ever hold whole numbers, such as loop counters, are kept as 64 bit integers in
+ general purpose registers instead, and are added, subtracted and compared with integer instructions. Within 2^53 every whole number
+ is also a double, so the results are the same; a sum or difference beyond it leaves the machine code, and the DuckVM works it out
+ as a double.
+ Whenever the loop leaves the compiled instructions, reaches an instruction that it does not compile, or fails, the machine code
+ writes its registers back and returns the instruction that the DuckVM is to continue at. The DuckVM then executes that instruction
+ itself, so errors are reported exactly as without the JIT, against the original line of the Duck program.
+ Machine code is only generated on Linux x86-64. Elsewhere, or if executable memory cannot be allocated, every loop stays interpreted.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bytecode.h"
+#include "Statement.h"
+#include "SymbolTable.h"
+#include "ArrayTable.h"
+#include "DuckRuntimeCore.h"
+#include "InputReader.h"
+#include "DuckInterpreterException.h"
+
+//What the machine code of a loop is given when it is run, and what it leaves behind when it returns. The machine code accesses the
+//members by their offsets, so this is kept a plain struct
+struct JitContext
+{
+    //the values of the variables, indexed by slot
+    double *m_values;
+
+    //the bottom of the stack of numbers of the DuckVM. The machine code writes the numbers on its stack here when it returns
+    double *m_stack;
+
+    //what the runtime functions that the machine code calls work with
+    const BytecodeProgram *m_program;
+    const Statement *m_statements;
+    ArrayTable *m_arrayTable;
+    OutputBuffer *m_output;
+    InputReader *m_input;
+
+    //the error of the runtime function that failed, if m_errorPending is set
+    std::string *m_errorMessage;
+
+    //the value returned by the last runtime function that produces one (read and array loads)
+    double m_result;
+
+    //the depth of the stack of numbers at the instruction that the machine code returned
+    int m_exitDepth;
+
+    //set if a runtime function failed with an error that the DuckVM cannot reproduce by executing the instruction again
+    bool m_errorPending;
+};
+
+class DuckJit
+{
+public:
+    DuckJit(const BytecodeProgram &a_program, const Statement &a_statements, SymbolTable &a_symbolTable, ArrayTable &a_arrayTable,
+        OutputBuffer &a_output, InputReader &a_input);
+    ~DuckJit();
+    DuckJit(const DuckJit&) = delete;
+    DuckJit& operator=(const DuckJit&) = delete;
+
+    //Counts an entry into the loop that the backward jump at the given instruction jumps to, and runs the loop as machine code if it
+    //is hot. Returns true if it did, with the instruction to continue at and the depth of the stack of numbers (whose values are in
+    //a_stack). Throws the error of the instruction to continue at if the machine code failed in the middle of it
+    bool RunLoop(int a_jumpInstruction, double *a_stack, int &a_programCounter, int &a_stackDepth);
+
+private:
+    //The machine code of a loop
+    typedef int (*LoopFunction)(JitContext *a_context);
+
+    //A compiled loop
+    struct CompiledLoop
+    {
+        //the machine code, or nullptr if the loop could not be compiled
+        LoopFunction m_function = nullptr;
+
+        //the executable memory that holds the machine code, and its size
+        void *m_memory = nullptr;
+        size_t m_memorySize = 0;
+
+        //the variables that the loop reads or writes. They must all have been assigned a value before the machine code is run
+        std::vector<int> m_variables;
+
+        //the variables that the machine code keeps as whole numbers in general purpose registers. They must hold whole numbers
+        //within 2^53 before the machine code is run
+        std::vector<int> m_integerVariables;
+    };
+
+    //The number of entries after which a loop is compiled
+    static const int k_hotLoopThreshold = 50;
+
+    //The program being run, and the statements that it was compiled from
+    const BytecodeProgram &m_program;
+    const Statement &m_statements;
+
+    //The variables, arrays, output and input of the program
+    SymbolTable &m_symbolTable;
+    ArrayTable &m_arrayTable;
+    OutputBuffer &m_output;
+    InputReader &m_input;
+
+    //The number of times every instruction has been entered by a backward jump
+    std::vector<int> m_entryCounts;
+
+    //The loop compiled for every instruction that a backward jump enters, or nullptr if it has not been compiled yet
+    std::vector<std::unique_ptr<CompiledLoop>> m_loops;
+
+    //Set once executable memory cannot be allocated, so that no more loops are compiled
+    bool m_disabled = false;
+
+    //The error of the runtime function that failed while a loop was running
+    std::string m_errorMessage;
+
+    //Compiles the loop from the given instruction to the given backward jump
+    std::unique_ptr<CompiledLoop> CompileLoop(int a_firstInstruction, int a_lastInstruction);
+
+    //Copies machine code into executable memory. Returns false if executable memory cannot be allocated
+    bool InstallCode(CompiledLoop &a_loop, const std::vector<uint8_t> &a_code);
+};
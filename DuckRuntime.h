@@ -0,0 +1,444 @@
+/* DuckRuntime.h
+ DuckRuntime.h contains the DuckRuntime class
+ DuckRuntime is the runtime of the C++ programs that duck2cpp translates Duck programs into. A translated program keeps the variables of
+ the Duck program in local variables and its control flow in C++ labels and gotos, and calls the DuckRuntime for everything else:
+ printing, reading, arrays and errors. The DuckRuntime prints, reads and stores array elements with the OutputBuffer, StandardInput and
+ PagedArray of DuckRuntimeCore.h, the same code that the interpreter runs, so a translated program prints, reads and fails exactly as
+ duckInterp does, with the same messages and exit codes.
+ This header and DuckRuntimeCore.h depend on nothing but the standard library and POSIX, so a translated program is a single
+ translation unit that is compiled with only these two headers on its include path. It must only be included by the translated program
+ itself.
+*/
+
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "DuckRuntimeCore.h"
+
+class DuckRuntime
+{
+public:
+    //Reads the options of the translated program (the --flush and --number-format options of duckInterp). a_statementTexts holds the
+    //text of every statement of the Duck program, for error messages, and a_identifierCount is the number of identifiers of the program
+    DuckRuntime(int argc, char *argv[], const char *const *a_statementTexts, int a_identifierCount);
+    ~DuckRuntime() {}
+    DuckRuntime(const DuckRuntime&) = delete;
+    DuckRuntime& operator=(const DuckRuntime&) = delete;
+
+    //Reports an error against the given statement and exits with 1
+    [[noreturn]] void Fail(int a_statementNum, const std::string &a_message);
+
+    //Reports that an operator could not be evaluated with the given operands, and exits with 1
+    [[noreturn]] void InvalidOperation(int a_statementNum, const char *a_operator, double a_leftOperand, double a_rightOperand);
+
+    //Returns the element at the given index of an array. Fails if the index is invalid or the element has not been initialized
+    double GetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index);
+
+    //Stores a value at the given index of an array. Fails if the index is invalid
+    void SetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index, double a_value);
+
+    //Declares an array of the given size. Fails if the size is invalid or the array has already been declared
+    void DeclareArray(int a_statementNum, int a_arraySlot, double a_size);
+
+    //Reads the next input value. Fails if it is not a valid number or if there is no more input
+    double ReadNumber(int a_statementNum);
+
+    //Prints text, a number, or the end of a line
+    void PrintString(const char *a_text, size_t a_length) { m_output.Write(std::string_view(a_text, a_length)); }
+    void PrintNumber(double a_number) { m_output.WriteNumber(a_number); }
+    void EndLine() { m_output.EndLine(); }
+
+    //Ends the program: successfully on a stop statement, and with an error when an end statement is executed or when execution runs
+    //past the last statement
+    [[noreturn]] void Stop();
+    [[noreturn]] void End();
+    [[noreturn]] void NoMoreLines();
+
+private:
+    //The output of the program, and its input, which flushes the output before it waits for more
+    OutputBuffer m_output;
+    StandardInput m_input;
+
+    //The arrays of the program, by slot (the identifier id of their name)
+    std::vector<PagedArray> m_arrays;
+
+    //The text of every statement of the Duck program
+    const char *const *m_statementTexts;
+
+    //Checks that an array has been declared and that the index is a whole number within its bounds, and returns the index
+    int VerifyArrayIndex(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index);
+};
+
+
+
+/**/
+/*
+ DuckRuntime::DuckRuntime(int argc, char *argv[], const char *const *a_statementTexts, int a_identifierCount)
+
+ NAME
+    DuckRuntime - Creates the runtime of a translated Duck program
+
+ SYNOPSIS
+    DuckRuntime::DuckRuntime(int argc, char *argv[], const char *const *a_statementTexts, int a_identifierCount)
+        argc --> The number of arguments of the translated program
+        argv --> The arguments of the translated program
+        a_statementTexts --> The text of every statement of the Duck program
+        a_identifierCount --> The number of identifiers of the Duck program
+
+ DESCRIPTION
+    The translated program takes the output options of duckInterp (--flush=line|block|never-until-exit and
+    --number-format=compat|round-trip). Any other argument is a usage error, which exits with 1. As in duckInterp, the output is
+    flushed after every line by default when the standard output is a terminal, and in blocks otherwise.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline DuckRuntime::DuckRuntime(int argc, char *argv[], const char *const *a_statementTexts, int a_identifierCount)
+    : m_input(m_output), m_arrays(a_identifierCount), m_statementTexts(a_statementTexts) {
+    for(int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if(argument == "--flush=line") {
+            m_output.SetFlushPolicy(FlushPolicy::Line);
+        } else if(argument == "--flush=block") {
+            m_output.SetFlushPolicy(FlushPolicy::Block);
+        } else if(argument == "--flush=never-until-exit") {
+            m_output.SetFlushPolicy(FlushPolicy::NeverUntilExit);
+        } else if(argument == "--number-format=compat") {
+            m_output.SetNumberFormat(NumberFormat::Compatible);
+        } else if(argument == "--number-format=round-trip") {
+            m_output.SetNumberFormat(NumberFormat::RoundTrip);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--flush=line|block|never-until-exit] [--number-format=compat|round-trip]" << std::endl;
+            exit(1);
+        }
+    }
+}/** DuckRuntime::DuckRuntime(int argc, char *argv[], const char *const *a_statementTexts, int a_identifierCount) **/
+
+
+
+/**/
+/*
+ void DuckRuntime::Fail(int a_statementNum, const std::string &a_message)
+
+ NAME
+    Fail - Reports an error against a statement of the Duck program and exits
+
+ SYNOPSIS
+    void DuckRuntime::Fail(int a_statementNum, const std::string &a_message)
+        a_statementNum --> The index of the statement that failed
+        a_message --> The description of the error
+
+ DESCRIPTION
+    The output printed so far is written first, and the error is then reported exactly as the DuckVM reports it.
+
+ RETURNS
+    Does not return. The program exits with 1
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void DuckRuntime::Fail(int a_statementNum, const std::string &a_message) {
+    m_output.Flush();
+    std::cerr << std::endl;
+    std::cerr << "Error: Line " << a_statementNum + 1 << ": \"" << m_statementTexts[a_statementNum] << "\": " << std::endl;
+    std::cerr << "      " << a_message << std::endl << std::endl;
+    exit(1);
+}/** void DuckRuntime::Fail(int a_statementNum, const std::string &a_message) **/
+
+
+
+/**/
+/*
+ void DuckRuntime::InvalidOperation(int a_statementNum, const char *a_operator, double a_leftOperand, double a_rightOperand)
+
+ NAME
+    InvalidOperation - Reports that an operator could not be evaluated
+
+ SYNOPSIS
+    void DuckRuntime::InvalidOperation(int a_statementNum, const char *a_operator, double a_leftOperand, double a_rightOperand)
+        a_statementNum --> The index of the statement that failed
+        a_operator --> The operator that could not be evaluated
+        a_leftOperand --> The left operand of the operator, or 0 if it is missing
+        a_rightOperand --> The right operand of the operator, or 0 if it is missing
+
+ DESCRIPTION
+    Builds the same message as the InvalidOperation instruction of the DuckVM and fails with it.
+
+ RETURNS
+    Does not return. The program exits with 1
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void DuckRuntime::InvalidOperation(int a_statementNum, const char *a_operator, double a_leftOperand, double a_rightOperand) {
+    std::string message = std::string("Could not evaluate the operator '") + a_operator + "' with the operands " + std::to_string(a_leftOperand) +
+        " and " + std::to_string(a_rightOperand);
+    Fail(a_statementNum, message);
+}/** void DuckRuntime::InvalidOperation(int a_statementNum, const char *a_operator, double a_leftOperand, double a_rightOperand) **/
+
+
+
+/**/
+/*
+ double DuckRuntime::GetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index)
+
+ NAME
+    GetArrayElement - Returns an element of an array
+
+ SYNOPSIS
+    double DuckRuntime::GetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index)
+        a_statementNum --> The index of the statement that reads the element
+        a_arraySlot --> The slot of the array
+        a_arrayName --> The name of the array, for error messages
+        a_index --> The index of the element
+
+ DESCRIPTION
+    Checks that the array has been declared and that the index is a whole number within its bounds. An element of a page that has
+    not been allocated has not been initialized.
+
+ RETURNS
+    The value of the element. Does not return if the element cannot be read
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline double DuckRuntime::GetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index) {
+    int index = VerifyArrayIndex(a_statementNum, a_arraySlot, a_arrayName, a_index);
+    double value;
+    if(!m_arrays[a_arraySlot].Load(index, value)) {
+        Fail(a_statementNum, ArrayErrorMessage(ArrayStatus::UninitializedElement, a_arrayName, index, 0));
+    }
+    return value;
+}/** double DuckRuntime::GetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index) **/
+
+
+
+/**/
+/*
+ void DuckRuntime::SetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index, double a_value)
+
+ NAME
+    SetArrayElement - Stores a value in an element of an array
+
+ SYNOPSIS
+    void DuckRuntime::SetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index, double a_value)
+        a_statementNum --> The index of the statement that stores the element
+        a_arraySlot --> The slot of the array
+        a_arrayName --> The name of the array, for error messages
+        a_index --> The index of the element
+        a_value --> The value to be stored
+
+ DESCRIPTION
+    Checks that the array has been declared and that the index is a whole number within its bounds. The page of the element is
+    allocated first if none of its elements has been assigned yet.
+
+ RETURNS
+    void. Does not return if the element cannot be stored
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void DuckRuntime::SetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index, double a_value) {
+    int index = VerifyArrayIndex(a_statementNum, a_arraySlot, a_arrayName, a_index);
+    if(!m_arrays[a_arraySlot].Store(index, a_value)) {
+        Fail(a_statementNum, ArrayErrorMessage(ArrayStatus::OutOfMemory, a_arrayName, index, m_arrays[a_arraySlot].GetSize()));
+    }
+}/** void DuckRuntime::SetArrayElement(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index, double a_value) **/
+
+
+
+/**/
+/*
+ void DuckRuntime::DeclareArray(int a_statementNum, int a_arraySlot, double a_size)
+
+ NAME
+    DeclareArray - Declares an array
+
+ SYNOPSIS
+    void DuckRuntime::DeclareArray(int a_statementNum, int a_arraySlot, double a_size)
+        a_statementNum --> The index of the dim statement
+        a_arraySlot --> The slot of the array
+        a_size --> The size of the array
+
+ DESCRIPTION
+    Like the DuckVM, the size is truncated to a whole number before the array is declared. Only the table of the pages of the array
+    is allocated.
+
+ RETURNS
+    void. Does not return if the array cannot be declared
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void DuckRuntime::DeclareArray(int a_statementNum, int a_arraySlot, double a_size) {
+    int size = static_cast<int>(a_size);
+    ArrayStatus status = m_arrays[a_arraySlot].Declare(size);
+    if(status != ArrayStatus::Valid) {
+        Fail(a_statementNum, ArrayErrorMessage(status, "", size, 0));
+    }
+}/** void DuckRuntime::DeclareArray(int a_statementNum, int a_arraySlot, double a_size) **/
+
+
+
+/**/
+/*
+ double DuckRuntime::ReadNumber(int a_statementNum)
+
+ NAME
+    ReadNumber - Reads the next input value
+
+ SYNOPSIS
+    double DuckRuntime::ReadNumber(int a_statementNum)
+        a_statementNum --> The index of the read statement
+
+ DESCRIPTION
+    Reads the next white space separated field of the input with the StandardInput that the InputReader of the interpreter uses. The
+    field must be a valid number (digits with at most one decimal point and an optional sign) that fits in a double.
+
+ RETURNS
+    The value read. Does not return if there is no valid value to read
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline double DuckRuntime::ReadNumber(int a_statementNum) {
+    double value;
+    InputStatus status = m_input.ReadNumber(value);
+    if(status != InputStatus::Read) {
+        Fail(a_statementNum, InputErrorMessage(status));
+    }
+    return value;
+}/** double DuckRuntime::ReadNumber(int a_statementNum) **/
+
+
+
+/**/
+/*
+ void DuckRuntime::Stop()
+
+ NAME
+    Stop - Ends the program on a stop statement
+
+ SYNOPSIS
+    void DuckRuntime::Stop()
+
+ DESCRIPTION
+    Writes the output and exits successfully.
+
+ RETURNS
+    Does not return. The program exits with 0
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void DuckRuntime::Stop() {
+    m_output.Flush();
+    exit(0);
+}/** void DuckRuntime::Stop() **/
+
+
+
+/**/
+/*
+ void DuckRuntime::End()
+
+ NAME
+    End - Ends the program when an end statement is executed
+
+ SYNOPSIS
+    void DuckRuntime::End()
+
+ DESCRIPTION
+    Nothing may be executed after the end statement, which marks the end of the program, so reaching it is an error.
+
+ RETURNS
+    Does not return. The program exits with 1
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void DuckRuntime::End() {
+    m_output.Flush();
+    std::cerr << "Error: There can be no statements after the end statement." << std::endl;
+    exit(1);
+}/** void DuckRuntime::End() **/
+
+
+
+/**/
+/*
+ void DuckRuntime::NoMoreLines()
+
+ NAME
+    NoMoreLines - Ends the program when execution runs past the last statement
+
+ SYNOPSIS
+    void DuckRuntime::NoMoreLines()
+
+ DESCRIPTION
+    A Duck program must stop with a stop statement, so running past the last statement is an error.
+
+ RETURNS
+    Does not return. The program exits with 1
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void DuckRuntime::NoMoreLines() {
+    m_output.Flush();
+    std::cerr << "Error: No more lines to execute. " << std::endl;
+    exit(1);
+}/** void DuckRuntime::NoMoreLines() **/
+
+
+
+/**/
+/*
+ int DuckRuntime::VerifyArrayIndex(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index)
+
+ NAME
+    VerifyArrayIndex - Checks an array and an index into it
+
+ SYNOPSIS
+    int DuckRuntime::VerifyArrayIndex(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index)
+        a_statementNum --> The index of the statement that accesses the array
+        a_arraySlot --> The slot of the array
+        a_arrayName --> The name of the array, for error messages
+        a_index --> The index to be checked
+
+ DESCRIPTION
+    Fails with the same ArrayErrorMessage text as ArrayTable if the array has not been declared, or if the index is not a whole number, is negative or
+    is out of the bounds of the array.
+
+ RETURNS
+    The index as a whole number. Does not return if the array or the index is invalid
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline int DuckRuntime::VerifyArrayIndex(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index) {
+    const PagedArray &array = m_arrays[a_arraySlot];
+    int index = 0;
+    ArrayStatus status = array.VerifyIndex(a_index, index);
+    if(status != ArrayStatus::Valid) {
+        Fail(a_statementNum, ArrayErrorMessage(status, a_arrayName, a_index, array.GetSize()));
+    }
+    return index;
+}/** int DuckRuntime::VerifyArrayIndex(int a_statementNum, int a_arraySlot, const std::string &a_arrayName, double a_index) **/
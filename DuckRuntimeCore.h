@@ -0,0 +1,876 @@
+/* DuckRuntimeCore.h
+ DuckRuntimeCore.h contains the OutputBuffer, StandardInput and PagedArray classes, and the checks and error messages that go with them
+ These are the parts of running a Duck program that the interpreter and the C++ programs that duck2cpp translates Duck programs into
+ share, so that both print, read and store array elements in exactly the same way, with the same error messages:
+ - OutputBuffer collects everything a Duck program prints, formats numbers with std::to_chars straight into its buffer (with 6
+   significant digits, or with the shortest text that reads back as exactly the same number, whole numbers below 2^53 written out in
+   full), and writes the buffer with a single write system call when its flush policy says so.
+ - StandardInput reads the standard input in large blocks and returns its white space separated fields as numbers, converted with
+   std::from_chars. It flushes the output before it waits for input, so that a user sees the prompt.
+ - PagedArray keeps the values of an array in pages of k_pageSize values, each allocated when one of its indexes is first assigned.
+ Errors are returned as status codes rather than thrown, since the interpreter reports them with a DuckInterpreterException and a
+ translated program with the DuckRuntime; InputErrorMessage and ArrayErrorMessage give the message of every status.
+ This header depends on nothing but the standard library and POSIX, so that a translated program can be compiled with only this header
+ and DuckRuntime.h on its include path.
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+
+//When the output buffer is written to the standard output
+enum class FlushPolicy : unsigned char
+{
+    //after every line (the default when the standard output is a terminal)
+    Line,
+    //when the buffer is full and before the program reads input (the default otherwise)
+    Block,
+    //only when the buffer is full and when the program exits
+    NeverUntilExit,
+};
+
+//How printed numbers are formatted
+enum class NumberFormat : unsigned char
+{
+    //6 significant digits, exactly as the standard output stream prints a double (the default)
+    Compatible,
+    //the shortest text that reads back as exactly the same number
+    RoundTrip,
+};
+
+//What became of reading an input value
+enum class InputStatus : unsigned char
+{
+    Read,
+    NoMoreInput,
+    InvalidNumber,
+};
+
+//What became of declaring an array, or of checking an index into one
+enum class ArrayStatus : unsigned char
+{
+    Valid,
+    //errors of the size of a new array
+    InvalidSize,
+    FractionalSize,
+    SizeTooLarge,
+    AlreadyDeclared,
+    //errors of an index
+    NotDeclared,
+    FractionalIndex,
+    NegativeIndex,
+    IndexOutOfBounds,
+    //errors of an element
+    UninitializedElement,
+    OutOfMemory,
+};
+
+class OutputBuffer
+{
+public:
+    //Creates an empty buffer. The flush policy is Line if the standard output is a terminal, Block otherwise
+    OutputBuffer();
+    ~OutputBuffer() { Flush(); }
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    //Sets when the buffer is written to the standard output
+    void SetFlushPolicy(FlushPolicy a_flushPolicy) { m_flushPolicy = a_flushPolicy; }
+
+    //Returns the flush policy of the buffer
+    FlushPolicy GetFlushPolicy() const { return m_flushPolicy; }
+
+    //Sets how printed numbers are formatted
+    void SetNumberFormat(NumberFormat a_numberFormat) { m_numberFormat = a_numberFormat; }
+
+    //Appends text to the output
+    void Write(std::string_view a_text);
+
+    //Appends a number to the output, formatted according to the number format
+    void WriteNumber(double a_number);
+
+    //Ends the current line, flushing the buffer if the flush policy is Line
+    void EndLine() {
+        Write("\n");
+        if(m_flushPolicy == FlushPolicy::Line) {
+            Flush();
+        }
+    }
+
+    //Flushes the buffer before the program waits for input, unless the flush policy is NeverUntilExit
+    void FlushBeforeRead() {
+        if(m_flushPolicy != FlushPolicy::NeverUntilExit) {
+            Flush();
+        }
+    }
+
+    //Writes everything in the buffer to the standard output
+    void Flush();
+
+private:
+    //The size of the buffer
+    static const size_t k_bufferSize = 64 * 1024;
+
+    //The most characters a formatted number can take (the shortest round trip text of a double is at most 24 characters long)
+    static const size_t k_maxNumberLength = 32;
+
+    //Whole numbers smaller in magnitude than this (2^53) are printed in full, without an exponent, by the RoundTrip number format
+    static constexpr double k_largestFixedWholeNumber = 9007199254740992.0;
+
+    //The text that has been printed but not yet written to the standard output
+    std::vector<char> m_buffer;
+
+    //The number of characters of the buffer in use
+    size_t m_used;
+
+    //When the buffer is written to the standard output
+    FlushPolicy m_flushPolicy;
+
+    //How printed numbers are formatted
+    NumberFormat m_numberFormat;
+
+    //Writes text that does not fit in what is left of the buffer
+    void WriteLarge(std::string_view a_text);
+
+    //Writes the given characters to the standard output
+    static void WriteToStandardOutput(const char *a_text, size_t a_length);
+};
+
+class StandardInput
+{
+public:
+    StandardInput(OutputBuffer &a_output);
+    StandardInput(const StandardInput&) = delete;
+    StandardInput& operator=(const StandardInput&) = delete;
+
+    //Reads the next input value into a_value. Returns InputStatus::Read, or why no value could be read
+    InputStatus ReadNumber(double &a_value);
+
+private:
+    //The size of the blocks that the standard input is read in
+    static const size_t k_blockSize = 64 * 1024;
+
+    //The output of the program, flushed before the input waits for more
+    OutputBuffer &m_output;
+
+    //The input that has been read from the standard input
+    std::vector<char> m_buffer;
+
+    //The index of the first character of the buffer that has not been used yet
+    size_t m_start;
+
+    //The index one past the last character that has been read into the buffer
+    size_t m_end;
+
+    //Set to true when the end of the standard input has been reached
+    bool m_endOfInput;
+
+    //Returns the next white space separated field of the input, or an empty field if there is no more input
+    std::string_view NextField();
+
+    //Reads the next block of the standard input into the buffer, keeping the characters that have not been used yet.
+    //Returns false if there is no more input
+    bool Refill();
+
+    //Returns true if the given character separates two input values
+    static bool IsWhiteSpace(char a_character) {
+        return a_character == ' ' || a_character == '\t' || a_character == '\n' || a_character == '\r' || a_character == '\v' || a_character == '\f';
+    }
+};
+
+class PagedArray
+{
+public:
+    //The number of values in a page of an array (a power of 2), and the shift that turns an index into the number of its page
+    static const int k_pageShift = 12;
+    static const int k_pageSize = 1 << k_pageShift;
+
+    //Returns the size of the array. 0 if the array has not been declared
+    int GetSize() const { return m_size; }
+
+    //Declares the array with the given size (with all indexes uninitialized). Returns ArrayStatus::Valid, or why it cannot be declared
+    ArrayStatus Declare(double a_size);
+
+    //Checks that the array has been declared and that the index is a whole number within its bounds, and sets a_wholeIndex to it.
+    //Returns ArrayStatus::Valid, or why the index is invalid
+    ArrayStatus VerifyIndex(double a_index, int &a_wholeIndex) const {
+        if(m_size == 0) {
+            return ArrayStatus::NotDeclared;
+        }
+        a_wholeIndex = static_cast<int>(a_index);
+        if(a_index - a_wholeIndex != 0) {
+            return ArrayStatus::FractionalIndex;
+        }
+        if(a_wholeIndex < 0) {
+            return ArrayStatus::NegativeIndex;
+        }
+        if(a_wholeIndex > m_size - 1) {
+            return ArrayStatus::IndexOutOfBounds;
+        }
+        return ArrayStatus::Valid;
+    }
+
+    //Retrieves the value at a verified index. Returns false if the index has not been initialized
+    bool Load(int a_index, double &a_value) const {
+        const Page *page = m_pages[a_index >> k_pageShift].get();
+        if(page == nullptr || !page->m_initialized[a_index & (k_pageSize - 1)]) {
+            return false;
+        }
+        a_value = page->m_values[a_index & (k_pageSize - 1)];
+        return true;
+    }
+
+    //Stores a value at a verified index, allocating the page of the index if none of its indexes has been assigned yet. Returns false if
+    //there is not enough memory for the page
+    bool Store(int a_index, double a_value) {
+        std::unique_ptr<Page> &page = m_pages[a_index >> k_pageShift];
+        if(page == nullptr && !AllocatePage(page)) {
+            return false;
+        }
+        page->m_values[a_index & (k_pageSize - 1)] = a_value;
+        page->m_initialized[a_index & (k_pageSize - 1)] = true;
+        return true;
+    }
+
+private:
+    //The values of k_pageSize consecutive indexes of an array
+    struct Page
+    {
+        double m_values[k_pageSize];
+
+        //whether each index of the page has been initialized
+        bool m_initialized[k_pageSize];
+    };
+
+    //The size of the array. 0 if the array has not been declared
+    int m_size = 0;
+
+    //The pages of the array, in order. A page in which no index has been assigned yet is not allocated (nullptr)
+    std::vector<std::unique_ptr<Page>> m_pages;
+
+    //Allocates a page with all its indexes uninitialized. Returns false if there is not enough memory for it
+    static bool AllocatePage(std::unique_ptr<Page> &a_page);
+};
+
+//Returns true if the given text is a number as Duck writes one
+bool IsAValidDuckNumber(std::string_view a_text);
+
+//Returns the message of an input status other than InputStatus::Read
+const char *InputErrorMessage(InputStatus a_status);
+
+//Returns the message of an array status other than ArrayStatus::Valid
+std::string ArrayErrorMessage(ArrayStatus a_status, const std::string &a_arrayName, double a_indexOrSize, int a_arraySize);
+
+
+
+/**/
+/*
+ OutputBuffer::OutputBuffer()
+
+ NAME
+    OutputBuffer::OutputBuffer - Creates an empty output buffer
+
+ SYNOPSIS
+    OutputBuffer::OutputBuffer()
+
+ DESCRIPTION
+    Allocates the buffer and chooses the default flush policy: Line if the standard output is a terminal, so that a user sees every
+    line as soon as it is printed, and Block otherwise.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline OutputBuffer::OutputBuffer() : m_buffer(k_bufferSize), m_used(0), m_numberFormat(NumberFormat::Compatible) {
+    m_flushPolicy = isatty(STDOUT_FILENO) ? FlushPolicy::Line : FlushPolicy::Block;
+}/** OutputBuffer::OutputBuffer() **/
+
+
+
+/**/
+/*
+ void OutputBuffer::Write(std::string_view a_text)
+
+ NAME
+    OutputBuffer::Write - Appends text to the output
+
+ SYNOPSIS
+    void OutputBuffer::Write(std::string_view a_text)
+        a_text --> The text to be printed
+
+ DESCRIPTION
+    This function copies the text into the buffer, flushing the buffer first if the text does not fit in it. Text that is larger than
+    the whole buffer is written directly.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void OutputBuffer::Write(std::string_view a_text) {
+    if(a_text.length() > m_buffer.size() - m_used) {
+        WriteLarge(a_text);
+        return;
+    }
+    a_text.copy(m_buffer.data() + m_used, a_text.length());
+    m_used += a_text.length();
+}/** void OutputBuffer::Write(std::string_view a_text) **/
+
+
+
+/**/
+/*
+ void OutputBuffer::WriteNumber(double a_number)
+
+ NAME
+    OutputBuffer::WriteNumber - Appends a number to the output
+
+ SYNOPSIS
+    void OutputBuffer::WriteNumber(double a_number)
+        a_number --> The number to be printed
+
+ DESCRIPTION
+    Formats the number directly into the buffer with std::to_chars. With the Compatible number format, the number is printed with 6
+    significant digits, exactly as the standard output stream prints a double by default (and as printf's %g does). With the RoundTrip
+    number format, it is printed in the same style, but with the fewest significant digits that read back as the same double, except
+    that a whole number smaller in magnitude than 2^53 is always written out in full (123456789 rather than 1.23456789e+08).
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void OutputBuffer::WriteNumber(double a_number) {
+    if(m_buffer.size() - m_used < k_maxNumberLength) {
+        Flush();
+    }
+    char *first = m_buffer.data() + m_used;
+    char *last = first + k_maxNumberLength;
+    std::to_chars_result result;
+    if(m_numberFormat == NumberFormat::Compatible) {
+        result = std::to_chars(first, last, a_number, std::chars_format::general, 6);
+    } else if(a_number == std::trunc(a_number) && std::fabs(a_number) < k_largestFixedWholeNumber) {
+        result = std::to_chars(first, last, a_number, std::chars_format::fixed);
+    } else {
+        result = std::to_chars(first, last, a_number, std::chars_format::general);
+    }
+    m_used += result.ptr - first;
+}/** void OutputBuffer::WriteNumber(double a_number) **/
+
+
+
+/**/
+/*
+ void OutputBuffer::Flush()
+
+ NAME
+    OutputBuffer::Flush - Writes everything in the buffer to the standard output
+
+ SYNOPSIS
+    void OutputBuffer::Flush()
+
+ DESCRIPTION
+    Writes the contents of the buffer to the standard output and empties the buffer.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void OutputBuffer::Flush() {
+    if(m_used == 0) {
+        return;
+    }
+    WriteToStandardOutput(m_buffer.data(), m_used);
+    m_used = 0;
+}/** void OutputBuffer::Flush() **/
+
+
+
+/**/
+/*
+ void OutputBuffer::WriteLarge(std::string_view a_text)
+
+ NAME
+    OutputBuffer::WriteLarge - Writes text that does not fit in what is left of the buffer
+
+ SYNOPSIS
+    void OutputBuffer::WriteLarge(std::string_view a_text)
+        a_text --> The text to be printed
+
+ DESCRIPTION
+    Flushes the buffer, then copies the text into the now empty buffer. If the text is larger than the whole buffer, it is written
+    directly to the standard output instead.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void OutputBuffer::WriteLarge(std::string_view a_text) {
+    Flush();
+    if(a_text.length() >= m_buffer.size()) {
+        WriteToStandardOutput(a_text.data(), a_text.length());
+        return;
+    }
+    a_text.copy(m_buffer.data(), a_text.length());
+    m_used = a_text.length();
+}/** void OutputBuffer::WriteLarge(std::string_view a_text) **/
+
+
+
+/**/
+/*
+ void OutputBuffer::WriteToStandardOutput(const char *a_text, size_t a_length)
+
+ NAME
+    OutputBuffer::WriteToStandardOutput - Writes the given characters to the standard output
+
+ SYNOPSIS
+    void OutputBuffer::WriteToStandardOutput(const char *a_text, size_t a_length)
+        a_text --> The characters to be written
+        a_length --> The number of characters to be written
+
+ DESCRIPTION
+    Writes the characters with as few write system calls as possible, retrying after partial writes and interruptions. If the standard
+    output cannot be written to (for example, it was closed), the characters are dropped, as the standard output stream would do.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline void OutputBuffer::WriteToStandardOutput(const char *a_text, size_t a_length) {
+    while(a_length > 0) {
+        ssize_t written = write(STDOUT_FILENO, a_text, a_length);
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        a_text += written;
+        a_length -= written;
+    }
+}/** void OutputBuffer::WriteToStandardOutput(const char *a_text, size_t a_length) **/
+
+
+
+/**/
+/*
+ StandardInput::StandardInput(OutputBuffer &a_output)
+
+ NAME
+    StandardInput::StandardInput - Creates a reader of the standard input
+
+ SYNOPSIS
+    StandardInput::StandardInput(OutputBuffer &a_output)
+        a_output --> The output of the program, which is flushed before the reader waits for input
+
+ DESCRIPTION
+    Allocates the buffer that the standard input is read into. Nothing is read until the first value is needed.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline StandardInput::StandardInput(OutputBuffer &a_output) : m_output(a_output), m_buffer(k_blockSize), m_start(0), m_end(0), m_endOfInput(false) {
+}/** StandardInput::StandardInput(OutputBuffer &a_output) **/
+
+
+
+/**/
+/*
+ InputStatus StandardInput::ReadNumber(double &a_value)
+
+ NAME
+    StandardInput::ReadNumber - Reads the next input value
+
+ SYNOPSIS
+    InputStatus StandardInput::ReadNumber(double &a_value)
+        a_value --> Set to the value that was read
+
+ DESCRIPTION
+    Takes the next white space separated field of the input and converts it to a double. The field must be a valid number as Duck
+    writes one (digits with at most one decimal point and an optional sign), and it must fit in a double. Empty lines are skipped.
+
+ RETURNS
+    InputStatus::Read if a value was read, InputStatus::NoMoreInput if the input has run out, and InputStatus::InvalidNumber if the field
+    is not a valid number
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline InputStatus StandardInput::ReadNumber(double &a_value) {
+    std::string_view field = NextField();
+    if(field.empty()) {
+        return InputStatus::NoMoreInput;
+    }
+    if(!IsAValidDuckNumber(field)) {
+        return InputStatus::InvalidNumber;
+    }
+
+    //from_chars does not accept a leading '+'
+    const char *first = field.data();
+    const char *last = field.data() + field.length();
+    if(*first == '+') {
+        first++;
+    }
+    std::from_chars_result result = std::from_chars(first, last, a_value);
+    //a value such as "." or "-." has no digits, and a value can be too large for a double
+    if(result.ec != std::errc() || result.ptr != last) {
+        return InputStatus::InvalidNumber;
+    }
+    return InputStatus::Read;
+}/** InputStatus StandardInput::ReadNumber(double &a_value) **/
+
+
+
+/**/
+/*
+ std::string_view StandardInput::NextField()
+
+ NAME
+    StandardInput::NextField - Returns the next white space separated field of the input
+
+ SYNOPSIS
+    std::string_view StandardInput::NextField()
+
+ DESCRIPTION
+    Skips the white space (including line breaks) before the next field and returns the field. Reads more of the standard input
+    whenever the buffer runs out before the end of the field is found. The field stays valid until the next call.
+
+ RETURNS
+    The next field, or an empty field if there is no more input
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline std::string_view StandardInput::NextField() {
+    //skip the white space before the field
+    while(true) {
+        while(m_start < m_end && IsWhiteSpace(m_buffer[m_start])) {
+            m_start++;
+        }
+        if(m_start < m_end) {
+            break;
+        }
+        if(!Refill()) {
+            return std::string_view();
+        }
+    }
+
+    //find the end of the field, reading more input if the field runs past the end of the buffer
+    size_t fieldEnd = m_start;
+    while(true) {
+        while(fieldEnd < m_end && !IsWhiteSpace(m_buffer[fieldEnd])) {
+            fieldEnd++;
+        }
+        if(fieldEnd < m_end || m_endOfInput) {
+            break;
+        }
+        //Refill moves the field to the start of the buffer
+        size_t fieldLength = fieldEnd - m_start;
+        bool moreInput = Refill();
+        fieldEnd = m_start + fieldLength;
+        if(!moreInput) {
+            break;
+        }
+    }
+
+    std::string_view field(m_buffer.data() + m_start, fieldEnd - m_start);
+    m_start = fieldEnd;
+    return field;
+}/** std::string_view StandardInput::NextField() **/
+
+
+
+/**/
+/*
+ bool StandardInput::Refill()
+
+ NAME
+    StandardInput::Refill - Reads the next block of the standard input
+
+ SYNOPSIS
+    bool StandardInput::Refill()
+
+ DESCRIPTION
+    Moves the characters that have not been used yet to the start of the buffer (growing the buffer if they fill it), flushes the
+    output of the program unless its flush policy says otherwise, and reads as much of the standard input as is available into the
+    rest of the buffer.
+
+ RETURNS
+    True if more input was read, false if the end of the standard input was reached
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline bool StandardInput::Refill() {
+    if(m_endOfInput) {
+        return false;
+    }
+    size_t unusedLength = m_end - m_start;
+    if(m_start > 0) {
+        memmove(m_buffer.data(), m_buffer.data() + m_start, unusedLength);
+        m_start = 0;
+        m_end = unusedLength;
+    }
+    if(m_end == m_buffer.size()) {
+        m_buffer.resize(m_buffer.size() * 2);
+    }
+
+    //the user must see everything printed so far before the program waits for input
+    m_output.FlushBeforeRead();
+    while(true) {
+        ssize_t bytesRead = read(STDIN_FILENO, m_buffer.data() + m_end, m_buffer.size() - m_end);
+        if(bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if(bytesRead <= 0) {
+            m_endOfInput = true;
+            return false;
+        }
+        m_end += bytesRead;
+        return true;
+    }
+}/** bool StandardInput::Refill() **/
+
+
+
+/**/
+/*
+ ArrayStatus PagedArray::Declare(double a_size)
+
+ NAME
+    PagedArray::Declare - Declares the array with all its indexes uninitialized
+
+ SYNOPSIS
+    ArrayStatus PagedArray::Declare(double a_size)
+        a_size --> The size of the array
+
+ DESCRIPTION
+    Only the table of the pages of the array is allocated; the pages themselves are allocated as their indexes are assigned. The size
+    must be a positive whole number, and the array must not have been declared already.
+
+ RETURNS
+    ArrayStatus::Valid if the array was declared, or why it could not be
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline ArrayStatus PagedArray::Declare(double a_size) {
+    if(a_size <= 0) {
+        return ArrayStatus::InvalidSize;
+    }
+    int size = static_cast<int>(a_size);
+    if(a_size - size != 0) {
+        return ArrayStatus::FractionalSize;
+    }
+    if(m_size > 0) {
+        return ArrayStatus::AlreadyDeclared;
+    }
+    try {
+        m_pages.resize((static_cast<size_t>(size) + k_pageSize - 1) >> k_pageShift);
+    } catch(std::bad_alloc&) {
+        m_pages.clear();
+        return ArrayStatus::SizeTooLarge;
+    }
+    m_size = size;
+    return ArrayStatus::Valid;
+}/** ArrayStatus PagedArray::Declare(double a_size) **/
+
+
+
+/**/
+/*
+ bool PagedArray::AllocatePage(std::unique_ptr<Page> &a_page)
+
+ NAME
+    PagedArray::AllocatePage - Allocates a page of an array
+
+ SYNOPSIS
+    bool PagedArray::AllocatePage(std::unique_ptr<Page> &a_page)
+        a_page --> Set to the new page, with all its indexes uninitialized
+
+ DESCRIPTION
+    Kept out of Store, which is inlined into every array store, since a page is only allocated once.
+
+ RETURNS
+    True if the page was allocated, false if there is not enough memory for it
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline bool PagedArray::AllocatePage(std::unique_ptr<Page> &a_page) {
+    try {
+        a_page.reset(new Page());
+    } catch(std::bad_alloc&) {
+        return false;
+    }
+    return true;
+}/** bool PagedArray::AllocatePage(std::unique_ptr<Page> &a_page) **/
+
+
+
+/**/
+/*
+ bool IsAValidDuckNumber(std::string_view a_text)
+
+ NAME
+    IsAValidDuckNumber - Checks whether the given text is a valid number
+
+ SYNOPSIS
+    bool IsAValidDuckNumber(std::string_view a_text)
+        a_text --> The text to be checked
+
+ DESCRIPTION
+    A number is made of digits with at most one decimal point, optionally preceded by a sign. The lexer checks the numbers of a Duck
+    program with it, and StandardInput the values that are read.
+
+ RETURNS
+    True if the text is a valid number. False if not
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline bool IsAValidDuckNumber(std::string_view a_text) {
+    if(a_text.empty()) {
+        return false;
+    }
+    size_t start = 0;
+    if(a_text[0] == '-' || a_text[0] == '+') {
+        //a sign that no digits follow is not a number
+        if(a_text.length() == 1) {
+            return false;
+        }
+        start = 1;
+    }
+    //used to count number of decimal points. If more than one, then invalid number
+    int dotCounter = 0;
+    for(size_t i = start; i < a_text.length(); i++) {
+        if(a_text[i] >= '0' && a_text[i] <= '9') {
+            continue;
+        }
+        if(a_text[i] != '.' || dotCounter > 0) {
+            return false;
+        }
+        dotCounter++;
+    }
+    return true;
+}/** bool IsAValidDuckNumber(std::string_view a_text) **/
+
+
+
+/**/
+/*
+ const char *InputErrorMessage(InputStatus a_status)
+
+ NAME
+    InputErrorMessage - Returns the message of an error of reading an input value
+
+ SYNOPSIS
+    const char *InputErrorMessage(InputStatus a_status)
+        a_status --> What became of reading the value
+
+ DESCRIPTION
+    Gives the messages that the interpreter and the translated programs report the errors of read statements with.
+
+ RETURNS
+    The message
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline const char *InputErrorMessage(InputStatus a_status) {
+    if(a_status == InputStatus::NoMoreInput) {
+        return "There are no more input values to read";
+    }
+    return "Input value is not a valid number";
+}/** const char *InputErrorMessage(InputStatus a_status) **/
+
+
+
+/**/
+/*
+ std::string ArrayErrorMessage(ArrayStatus a_status, const std::string &a_arrayName, double a_indexOrSize, int a_arraySize)
+
+ NAME
+    ArrayErrorMessage - Returns the message of an error of declaring or accessing an array
+
+ SYNOPSIS
+    std::string ArrayErrorMessage(ArrayStatus a_status, const std::string &a_arrayName, double a_indexOrSize, int a_arraySize)
+        a_status --> The error
+        a_arrayName --> The name of the array
+        a_indexOrSize --> The index that was accessed, or the size the array was declared with
+        a_arraySize --> The size of the array
+
+ DESCRIPTION
+    Gives the messages that the interpreter and the translated programs report the errors of arrays with.
+
+ RETURNS
+    The message
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+inline std::string ArrayErrorMessage(ArrayStatus a_status, const std::string &a_arrayName, double a_indexOrSize, int a_arraySize) {
+    switch(a_status) {
+        case ArrayStatus::InvalidSize:
+            return "Size of array is invalid.";
+        case ArrayStatus::FractionalSize:
+            return "Size of array must be a whole number.";
+        case ArrayStatus::SizeTooLarge:
+            return "Size of array is too large.";
+        case ArrayStatus::AlreadyDeclared:
+            return "Cannot redeclare an existing array.";
+        case ArrayStatus::NotDeclared:
+            return "'" + a_arrayName + "' has not been declared as an array";
+        case ArrayStatus::FractionalIndex:
+            return "The given array index, " + std::to_string(a_indexOrSize) + ", is not a whole number. Index must be a whole number.";
+        case ArrayStatus::NegativeIndex:
+            return "The given array index, " + std::to_string(a_indexOrSize) + ", is negative. Index must be a positive number.";
+        case ArrayStatus::IndexOutOfBounds:
+            return "Array index '" + std::to_string(static_cast<int>(a_indexOrSize)) + "' is out of bounds of the array '" + a_arrayName +
+                "', which is of size " + std::to_string(a_arraySize) + ".";
+        case ArrayStatus::UninitializedElement:
+            return "The value at index " + std::to_string(static_cast<int>(a_indexOrSize)) + " of the array " + a_arrayName + " has not been initialized.";
+        case ArrayStatus::OutOfMemory:
+            return "There is not enough memory for the values of the array '" + a_arrayName + "'.";
+        default:
+            return "";
+    }
+}/** std::string ArrayErrorMessage(ArrayStatus a_status, const std::string &a_arrayName, double a_indexOrSize, int a_arraySize) **/
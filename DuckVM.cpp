@@ -0,0 +1,192 @@
+#include "DuckVM.h"
+
+using namespace std;
+
+
+/**/
+/*
+ void DuckVM::Run()
+
+ NAME
+    Run - Runs the compiled Duck program
+
+ SYNOPSIS
+    void DuckVM::Run()
+
+ DESCRIPTION
+    This function executes the instructions of the program one at a time, starting with the first one, until a Stop instruction is reached
+    or an error occurs. The stack of numbers is allocated once, with the maximum depth computed by the compiler. When an instruction fails,
+    the error is reported with the line number and the text of the statement that the instruction was compiled from.
+
+ RETURNS
+    Does not return. The program exits with 0 on a stop statement and with 1 on an error
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void DuckVM::Run() {
+    const Instruction *instructions = m_program.m_instructions.data();
+    vector<double> stack(m_program.m_maxStackDepth + 1);
+
+    //the stack pointer points to the slot above the top of the stack
+    double *stackPointer = stack.data();
+    int programCounter = 0;
+
+    try {
+        while(true) {
+            const Instruction &instruction = instructions[programCounter];
+            switch(instruction.m_opCode) {
+                case OpCode::PushNumber:
+                    *stackPointer++ = m_program.m_numbers[instruction.m_operand];
+                    break;
+                case OpCode::LoadVariable:
+                    if(!m_symbolTable.GetVariableValue(instruction.m_operand, *stackPointer)) {
+                        string message = "The variable " + m_statements.GetIdentifierName(instruction.m_operand) + " has not been assigned a value.";
+                        throw DuckInterpreterException(message);
+                    }
+                    stackPointer++;
+                    break;
+                case OpCode::StoreVariable:
+                    m_symbolTable.RecordVariableValue(instruction.m_operand, *--stackPointer);
+                    break;
+                case OpCode::LoadArrayElement: {
+                    const string &arrayName = m_statements.GetIdentifierName(instruction.m_operand);
+                    double index = stackPointer[-1];
+                    if(!m_arrayTable.GetValue(instruction.m_operand, arrayName, index, stackPointer[-1])) {
+                        throw DuckInterpreterException(ArrayErrorMessage(ArrayStatus::UninitializedElement, arrayName, index, 0));
+                    }
+                    break;
+                }
+                case OpCode::StoreArrayElement:
+                    stackPointer -= 2;
+                    m_arrayTable.AddToArray(instruction.m_operand, m_statements.GetIdentifierName(instruction.m_operand), stackPointer[0], stackPointer[1]);
+                    break;
+                case OpCode::StoreArrayElementValueFirst:
+                    stackPointer -= 2;
+                    m_arrayTable.AddToArray(instruction.m_operand, m_statements.GetIdentifierName(instruction.m_operand), stackPointer[1], stackPointer[0]);
+                    break;
+                case OpCode::Pop:
+                    stackPointer--;
+                    break;
+
+                case OpCode::Add:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] + stackPointer[0];
+                    break;
+                case OpCode::Subtract:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] - stackPointer[0];
+                    break;
+                case OpCode::Multiply:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] * stackPointer[0];
+                    break;
+                case OpCode::Divide:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] / stackPointer[0];
+                    break;
+                case OpCode::Less:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] < stackPointer[0];
+                    break;
+                case OpCode::Greater:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] > stackPointer[0];
+                    break;
+                case OpCode::LessEqual:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] <= stackPointer[0];
+                    break;
+                case OpCode::GreaterEqual:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] >= stackPointer[0];
+                    break;
+                case OpCode::Equal:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] == stackPointer[0];
+                    break;
+                case OpCode::NotEqual:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] != stackPointer[0];
+                    break;
+                case OpCode::BinaryNot:
+                    stackPointer--;
+                    stackPointer[-1] = stackPointer[-1] != 0 ? 0 : 1;
+                    break;
+                case OpCode::Negate:
+                    stackPointer[-1] = -1 * stackPointer[-1];
+                    break;
+                case OpCode::LogicalNot:
+                    stackPointer[-1] = stackPointer[-1] != 0 ? 0 : 1;
+                    break;
+                case OpCode::InvalidOperation: {
+                    double leftOperand = instruction.m_operand2 >= 2 ? stackPointer[-2] : 0;
+                    double rightOperand = instruction.m_operand2 >= 1 ? stackPointer[-1] : 0;
+                    string message = "Could not evaluate the operator '" + m_program.m_strings[instruction.m_operand] + "' with the operands " + to_string(leftOperand) + " and " + to_string(rightOperand);
+                    throw DuckInterpreterException(message);
+                }
+
+                case OpCode::Jump:
+                    //a backward jump enters a loop, which the JIT runs as machine code once it is hot
+                    if(m_jit != nullptr && instruction.m_operand <= programCounter) {
+                        int stackDepth;
+                        if(m_jit->RunLoop(programCounter, stack.data(), programCounter, stackDepth)) {
+                            stackPointer = stack.data() + stackDepth;
+                            continue;
+                        }
+                    }
+                    programCounter = instruction.m_operand;
+                    continue;
+                case OpCode::JumpIfFalse:
+                    if(*--stackPointer == 0) {
+                        programCounter = instruction.m_operand;
+                        continue;
+                    }
+                    break;
+
+                case OpCode::PrintString:
+                    m_output.Write(m_program.m_strings[instruction.m_operand]);
+                    break;
+                case OpCode::PrintNumber:
+                    m_output.WriteNumber(*--stackPointer);
+                    break;
+                case OpCode::PrintNewline:
+                    m_output.EndLine();
+                    break;
+                case OpCode::ReadNumber:
+                    *stackPointer++ = m_input.ReadNumber();
+                    break;
+                case OpCode::DeclareArray: {
+                    int arraySize = static_cast<int>(*--stackPointer);
+                    m_arrayTable.AddNewArray(instruction.m_operand, arraySize);
+                    break;
+                }
+
+                case OpCode::Stop:
+                    m_output.Flush();
+                    exit(0);
+                case OpCode::End:
+                    m_output.Flush();
+                    cerr << "Error: There can be no statements after the end statement." << endl;
+                    exit(1);
+                case OpCode::NoMoreLines:
+                    m_output.Flush();
+                    cerr << "Error: No more lines to execute. " << endl;
+                    exit(1);
+                case OpCode::RaiseError:
+                    throw DuckInterpreterException(m_program.m_strings[instruction.m_operand]);
+            }
+            programCounter++;
+        }
+    } catch(DuckInterpreterException& e) {
+        int statementNum = m_program.m_statementOfInstruction[programCounter];
+        m_output.Flush();
+        cerr << endl;
+        cerr << "Error: Line " << statementNum + 1 << ": \"" << m_statements.GetStatement(statementNum).m_text << "\": " << endl;
+        cerr << "      " << e.what() << endl << endl;
+        exit(1);
+    }
+} /* void DuckVM::Run() */
+
+
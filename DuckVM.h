@@ -0,0 +1,59 @@
+/* DuckVM.h
+ DuckVM.h contains the DuckVM class
+ DuckVM is the Duck virtual machine. It runs a BytecodeProgram that was compiled by the BytecodeCompiler, using a stack of numbers for the
+ values of arithmetic expressions and the same symbol table and array table as the DuckInterpreter. Errors are reported against the line
+ and the text of the Duck statement that the failing instruction was compiled from, exactly as the DuckInterpreter reports them.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "Bytecode.h"
+#include "Statement.h"
+#include "SymbolTable.h"
+#include "ArrayTable.h"
+#include "DuckRuntimeCore.h"
+#include "InputReader.h"
+#include "Lexer.h"
+#include "DuckInterpreterException.h"
+#include "DuckJit.h"
+
+class DuckVM
+{
+public:
+    DuckVM(const BytecodeProgram &a_program, const Statement &a_statements, SymbolTable &a_symbolTable, ArrayTable &a_arrayTable, OutputBuffer &a_output,
+        InputReader &a_input) :
+        m_program(a_program), m_statements(a_statements), m_symbolTable(a_symbolTable), m_arrayTable(a_arrayTable), m_output(a_output),
+        m_input(a_input) {}
+    ~DuckVM() {}
+
+    //Runs the program until it stops or an error occurs. Does not return
+    void Run();
+
+    //Runs the hot loops of the program as machine code compiled by the given JIT
+    void SetJit(DuckJit *a_jit) { m_jit = a_jit; }
+
+private:
+    //The program being run
+    const BytecodeProgram &m_program;
+
+    //The statements that the program was compiled from, used to report errors and to look up identifier names
+    const Statement &m_statements;
+
+    //The symbol table that holds all the variable names and their values
+    SymbolTable &m_symbolTable;
+
+    //The array table that holds all the arrays and the values they contain
+    ArrayTable &m_arrayTable;
+
+    //The buffer that the output of the program is written to
+    OutputBuffer &m_output;
+
+    //The reader of the input values of read statements
+    InputReader &m_input;
+
+    //The JIT that runs the hot loops of the program, or nullptr if every instruction is interpreted
+    DuckJit *m_jit = nullptr;
+};
@@ -0,0 +1,49 @@
+/* ExecutionPhase.h
+ ExecutionPhase.h contains the ExecutionPhase enum and the ExecutionPhaseScope class
+ The interpreter marks what it is doing (walking the tokens of a statement, evaluating an expression, looking up a variable, accessing
+ an array, or reading and printing) with an ExecutionPhaseScope, which sets the current phase for as long as the scope lasts and
+ then restores the phase it replaced. The SamplingProfiler reads the current phase from its signal handler, so the phase is kept in
+ a volatile sig_atomic_t, and setting it is no more than two stores.
+*/
+
+#pragma once
+
+#include <csignal>
+
+//What the interpreter is doing. Interpreter stands for the work of the interpreter's loop that is not in any other phase
+enum class ExecutionPhase : unsigned char
+{
+    Interpreter,
+    Lexing,
+    Evaluation,
+    SymbolLookup,
+    ArrayAccess,
+    InputOutput,
+};
+
+//The number of phases
+const int k_executionPhaseCount = 6;
+
+class ExecutionPhaseScope
+{
+public:
+    //Sets the current phase until the scope ends
+    __attribute__((always_inline)) ExecutionPhaseScope(ExecutionPhase a_phase) : m_previousPhase(s_currentPhase) {
+        s_currentPhase = static_cast<std::sig_atomic_t>(a_phase);
+    }
+
+    //Restores the phase that was current when the scope started
+    __attribute__((always_inline)) ~ExecutionPhaseScope() {
+        s_currentPhase = m_previousPhase;
+    }
+
+    //Returns the current phase. Safe to call from a signal handler
+    static ExecutionPhase GetCurrentPhase() { return static_cast<ExecutionPhase>(s_currentPhase); }
+
+private:
+    //The phase that the interpreter is in
+    static inline volatile std::sig_atomic_t s_currentPhase = 0;
+
+    //The phase that was current when the scope started
+    std::sig_atomic_t m_previousPhase;
+};
@@ -0,0 +1,127 @@
+#include "ExpressionEvaluator.h"
+
+using namespace std;
+
+
+/**/
+/*
+ double ExpressionEvaluator::EvaluateArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos)
+ 
+ NAME
+    EvaluateArithmeticExpression - Evaluates an arithmetic expression in a statement until it encounters a character that denotes
+        the end of an arithmetic expression. 
+ 
+ SYNOPSIS
+    double ExpressionEvaluator::EvaluateArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos)
+        a_statement --> The statement containing the expression to be evaluated
+        a_nextPos --> The position at which the expression starts
+ 
+ DESCRIPTION
+    Evaluates the arithmetic expression starting at the given index and ending at a character that denotes the end of an arithmetic expression 
+    (namely: ',' ';' 'goto' and ']'). Returns the result of the expression. Also, updates the value of a_nextPos to be the position of the first
+    element after the end of the expression. The ExpressionWalker walks the expression and checks its syntax, and this class evaluates
+    the numbers, variables and operators that it hands over
+ 
+ RETURNS
+    The result of the arithmetic expression
+ 
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+double ExpressionEvaluator::EvaluateArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos) {
+    ExecutionPhaseScope phase(ExecutionPhase::Evaluation);
+    //the expression is evaluated above whatever the expression that contains it has on the number stack, and leaves it as it found it
+    NumberStackScope numbers(m_numberStack);
+    m_walker.Walk(a_statement, a_nextPos);
+    return m_numberStack.back();
+} /* double ExpressionEvaluator::EvaluateArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos) */
+
+
+
+/**/
+/*
+ void ExpressionEvaluator::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition)
+ 
+ NAME
+    WalkArrayElement - Replaces the index at the top of the number stack with the value of the array element it indexes
+ 
+ SYNOPSIS
+    void ExpressionEvaluator::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition)
+        a_array --> The token of the name of the array
+        a_position --> The position of the name of the array
+        a_closePosition --> The position of the ']' character after the index
+ 
+ DESCRIPTION
+    The ExpressionWalker has evaluated the index (the expression between '[' and ']'), which is at the top of the number stack. The
+        value stored at that index of the array replaces it
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+void ExpressionEvaluator::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition) {
+    const string &arrayName = m_statements.GetIdentifierName(a_array.m_identifierId);
+    double index = m_numberStack.back();
+    ExecutionPhaseScope phase(ExecutionPhase::ArrayAccess);
+    if(!m_arrayTable.GetValue(a_array.m_identifierId, arrayName, index, m_numberStack.back())) {
+        //if array value not specified, throw error
+        throw DuckInterpreterException(ArrayErrorMessage(ArrayStatus::UninitializedElement, arrayName, index, 0));
+    }
+} /* void ExpressionEvaluator::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition) */
+
+
+
+/**/
+/*
+ void ExpressionEvaluator::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount)
+ 
+ NAME
+    ApplyOperator - Evaluates the numbers at the top of the number stack with respect to the given operator
+        and pushes the result back into the number stack
+ 
+ SYNOPSIS
+    void ExpressionEvaluator::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount)
+        a_operator --> The operator that the ExpressionWalker popped off its operator stack
+        a_position --> The position of the token of the operator
+        a_numberCount --> The number of numbers that the arithmetic expression has pushed
+ 
+ DESCRIPTION
+    This function evaluates the numbers at the top of the number stack using the given operator. Then, it pushes the resulting
+        number back into the number stack. The ExpressionWalker has made sure that a binary operator other than a parenthesis has
+        its two numbers; a parenthesis cannot be evaluated, and is reported with the numbers there are (a missing one is shown as 0).
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+void ExpressionEvaluator::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount) {
+    double result;
+    if(OperatorArity(a_operator) == 1) {
+        
+        //if unary, evaluate only one number per operator
+        //throw error if could not evaluate
+        if(!EvaluateExpressionOperator(a_operator, result, m_numberStack.back())) {
+            string message = "Could not evaluate the operator '" + string(OperatorText(a_operator)) + "' with the operand " + to_string(m_numberStack.back());
+            throw DuckInterpreterException(message);
+        }
+        m_numberStack.back() = result;
+    } else {
+        //if binary, evaluate two numbers per operator
+        //throw error if could not evaluate. An operand that is missing is shown as 0
+        double leftOperand = a_numberCount >= 2 ? m_numberStack[m_numberStack.size() - 2] : 0;
+        double rightOperand = m_numberStack.back();
+        if(!EvaluateExpressionOperator(a_operator, result, leftOperand, rightOperand)){
+            string message = "Could not evaluate the operator '" + string(OperatorText(a_operator)) + "' with the operands " + to_string(leftOperand) + " and " + to_string(rightOperand);
+            throw DuckInterpreterException(message);
+        }
+        m_numberStack.pop_back();
+        m_numberStack.back() = result;
+    }
+} /* void ExpressionEvaluator::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount) */
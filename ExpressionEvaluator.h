@@ -0,0 +1,95 @@
+/* ExpressionEvaluator.h
+ ExpressionEvaluator.h contains the ExpressionEvaluator class
+ ExpressionEvaluator is the class that evaluates the arithmetic expressions of the recorded statements of a Duck program, reading the
+ values of the variables and array elements from a SymbolTable and an ArrayTable. An ExpressionWalker walks the expressions and checks
+ their syntax; the evaluator computes the values of what it walks. The DuckInterpreter evaluates the expressions of the statements that
+ it executes with it, and the component micro-benchmarks time it on its own. The walker's operator stack and the evaluator's number
+ stack are kept from one expression to the next, so that evaluating allocates nothing once they have grown.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <assert.h>
+#include "Statement.h"
+#include "SymbolTable.h"
+#include "ArrayTable.h"
+#include "Token.h"
+#include "ExpressionOperator.h"
+#include "ExpressionWalker.h"
+#include "ExecutionPhase.h"
+#include "DuckInterpreterException.h"
+
+class ExpressionEvaluator
+{
+public:
+    ExpressionEvaluator(const Statement &a_statements, SymbolTable &a_symbolTable, ArrayTable &a_arrayTable)
+        : m_statements(a_statements), m_symbolTable(a_symbolTable), m_arrayTable(a_arrayTable), m_walker(*this) {}
+    ~ExpressionEvaluator() {}
+
+    // Evaluate an arithmetic expression.  Return the value.  The variable a_nextPos is index to the element after the end of the expression
+    double EvaluateArithmeticExpression(const CompiledStatement &a_statement, int &a_nextPos);
+
+private:
+    // The walker hands the numbers, the variables and the operators of an expression to the evaluator
+    friend class ExpressionWalker<ExpressionEvaluator>;
+
+    // The statements whose expressions are evaluated, for the names of their variables and arrays
+    const Statement &m_statements;
+
+    // The values of the variables, and the arrays and the values they contain
+    SymbolTable &m_symbolTable;
+    ArrayTable &m_arrayTable;
+
+    // Walks the expressions and keeps their operators
+    ExpressionWalker<ExpressionEvaluator> m_walker;
+
+	// Stack for the numbers.  It will be used in evaluating statements. An expression is evaluated on top of what the expression that
+	// contains it (the index of an array element) left on it, and it keeps its capacity between statements
+	std::vector<double> m_numberStack;
+
+    // Truncates the number stack back to the size it had when an expression started being evaluated, once it has been evaluated or has
+    // failed, so that a failed expression leaves nothing behind
+    class NumberStackScope
+    {
+    public:
+        NumberStackScope(std::vector<double> &a_numberStack) : m_numberStack(a_numberStack), m_base(a_numberStack.size()) {}
+        ~NumberStackScope() { m_numberStack.resize(m_base); }
+        NumberStackScope(const NumberStackScope&) = delete;
+        NumberStackScope& operator=(const NumberStackScope&) = delete;
+
+    private:
+        std::vector<double> &m_numberStack;
+        size_t m_base;
+    };
+
+    // Retrieves the next element of a statement (see CompiledStatement::ParseNextElement) in the Lexing phase, as the DuckInterpreter does
+    int ParseNextElement(const CompiledStatement &a_statement, int a_nextPos, Token &a_token) {
+        ExecutionPhaseScope phase(ExecutionPhase::Lexing);
+        return a_statement.ParseNextElement(a_nextPos, a_token);
+    }
+
+    // Pushes a number
+    void WalkNumber(const Token &a_number, int a_position) { m_numberStack.push_back(a_number.m_numValue); }
+
+    // Pushes the value of a variable, which must have been assigned one
+    void WalkVariable(const Token &a_variable, int a_position) {
+        ExecutionPhaseScope phase(ExecutionPhase::SymbolLookup);
+        double value;
+        if(!m_symbolTable.GetVariableValue(a_variable.m_identifierId, value)) {
+            throw DuckInterpreterException("The variable " + m_statements.GetIdentifierName(a_variable.m_identifierId) + " has not been assigned a value.");
+        }
+        m_numberStack.push_back(value);
+    }
+
+    // Replaces the index at the top of the number stack with the value of the array element it indexes
+    void WalkArrayElement(const Token &a_array, int a_position, int a_closePosition);
+
+    // Evaluates the numbers at the top of the number stack with respect to an operator and pushes the result back into the number stack.
+    // a_numberCount is the number of numbers that the expression being evaluated has pushed
+    void ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount);
+
+    // The value of an expression does not depend on the parentheses around it
+    void CloseParentheses(int a_openPosition, int a_closePosition) {}
+};
@@ -0,0 +1,198 @@
+/* ExpressionOperator.h
+ ExpressionOperator.h contains the ExpressionOperator enum and the tables that describe every operator of an arithmetic expression.
+ The ExpressionWalker walks arithmetic expressions with the shunting yard algorithm for the ExpressionEvaluator, the BytecodeCompiler
+ and the ProgramOptimizer. The operators that wait on its operator stack are ExpressionOperator values, and their precedence, arity
+ and text are looked up in the constant tables below, indexed by the operator.
+*/
+
+#pragma once
+
+#include "Token.h"
+
+//An operator of an arithmetic expression, once it is known whether it is unary or binary
+enum class ExpressionOperator : unsigned char
+{
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Less,
+    Greater,
+    LessEqual,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    //'!' used between two operands. It evaluates to the logical not of the left operand
+    BinaryNot,
+    OpenParenthesis,
+    CloseParenthesis,
+    UnaryPlus,
+    UnaryMinus,
+    UnaryNot,
+};
+
+//Whether the last element seen in an arithmetic expression was a number or an operator. An operator that does not follow a number
+//is a unary operator
+enum class ExpressionElement : unsigned char
+{
+    None,
+    Number,
+    Operator,
+};
+
+//The precedence of every operator. An operator is evaluated before the next one if its precedence is greater or equal
+constexpr int k_operatorPrecedence[] = {
+    3, 3, 4, 4,         // + - * /
+    2, 2, 2, 2, 2, 2,   // < > <= >= == !=
+    -1,                 // binary !
+    1, 1,               // ( )
+    5, 5, 5,            // unary + - !
+};
+
+//The number of operands of every operator. Parentheses are never evaluated as operators, but they are treated as binary ones
+constexpr int k_operatorArity[] = {
+    2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2,
+    2,
+    2, 2,
+    1, 1, 1,
+};
+
+//The text of every operator as it appears in a Duck program and in error messages
+constexpr const char *k_operatorText[] = {
+    "+", "-", "*", "/",
+    "<", ">", "<=", ">=", "==", "!=",
+    "!",
+    "(", ")",
+    "+", "-", "!",
+};
+
+//Returns the precedence of the given operator
+constexpr int OperatorPrecedence(ExpressionOperator a_operator) { return k_operatorPrecedence[static_cast<int>(a_operator)]; }
+
+//Returns the number of operands of the given operator
+constexpr int OperatorArity(ExpressionOperator a_operator) { return k_operatorArity[static_cast<int>(a_operator)]; }
+
+//Returns the text of the given operator
+constexpr const char *OperatorText(ExpressionOperator a_operator) { return k_operatorText[static_cast<int>(a_operator)]; }
+
+/**/
+/*
+inline ExpressionOperator ToExpressionOperator(OperatorCode a_operator, bool a_isUnary)
+
+NAME
+    ToExpressionOperator - Returns the expression operator for an arithmetic operator token
+
+SYNOPSIS
+    inline ExpressionOperator ToExpressionOperator(OperatorCode a_operator, bool a_isUnary)
+        a_operator --> The arithmetic operator of the token (one of the operators up to and including CloseParenthesis)
+        a_isUnary --> True if the operator is used as a unary operator (only +, - and ! can be)
+
+DESCRIPTION
+    Converts the operator of a token into the operator that is pushed on the operator stack of the shunting yard algorithm
+
+RETURNS
+    The expression operator
+
+AUTHOR
+    Duck interpreter contributors
+*/
+/**/
+inline ExpressionOperator ToExpressionOperator(OperatorCode a_operator, bool a_isUnary) {
+    if(a_isUnary) {
+        switch(a_operator) {
+            case OperatorCode::Plus: return ExpressionOperator::UnaryPlus;
+            case OperatorCode::Minus: return ExpressionOperator::UnaryMinus;
+            default: return ExpressionOperator::UnaryNot;
+        }
+    }
+    switch(a_operator) {
+        case OperatorCode::Plus: return ExpressionOperator::Add;
+        case OperatorCode::Minus: return ExpressionOperator::Subtract;
+        case OperatorCode::Multiply: return ExpressionOperator::Multiply;
+        case OperatorCode::Divide: return ExpressionOperator::Divide;
+        case OperatorCode::Not: return ExpressionOperator::BinaryNot;
+        case OperatorCode::Less: return ExpressionOperator::Less;
+        case OperatorCode::Greater: return ExpressionOperator::Greater;
+        case OperatorCode::LessEqual: return ExpressionOperator::LessEqual;
+        case OperatorCode::GreaterEqual: return ExpressionOperator::GreaterEqual;
+        case OperatorCode::Equal: return ExpressionOperator::Equal;
+        case OperatorCode::NotEqual: return ExpressionOperator::NotEqual;
+        case OperatorCode::OpenParenthesis: return ExpressionOperator::OpenParenthesis;
+        default: return ExpressionOperator::CloseParenthesis;
+    }
+}/*inline ExpressionOperator ToExpressionOperator(OperatorCode a_operator, bool a_isUnary)*/
+
+
+
+/**/
+/*
+inline bool EvaluateExpressionOperator(ExpressionOperator a_operation, double &a_result, double a_leftOperand, double a_rightOperand)
+
+NAME
+    EvaluateExpressionOperator - Applies an operator to its operands
+
+SYNOPSIS
+    inline bool EvaluateExpressionOperator(ExpressionOperator a_operation, double &a_result, double a_leftOperand, double a_rightOperand)
+        a_operation --> The operator to be applied
+        a_result --> The result of the operation
+        a_leftOperand --> The operand at the left of the operator (the only operand of a unary operator)
+        a_rightOperand --> The operand at the right of the operator. In the case of unary operators, this parameter is defaulted to 0
+
+DESCRIPTION
+    This is the arithmetic of the Duck language: the DuckInterpreter evaluates expressions with it, and the ProgramOptimizer folds constant
+    subexpressions with it, so a folded number is exactly the number that the expression evaluates to (division by zero gives inf or nan)
+
+RETURNS
+    True if the operation was successful. False otherwise (parentheses cannot be evaluated).
+
+AUTHOR
+    Duck interpreter contributors
+*/
+/**/
+inline bool EvaluateExpressionOperator(ExpressionOperator a_operation, double &a_result, double a_leftOperand, double a_rightOperand = 0) {
+    switch(a_operation) {
+        case ExpressionOperator::Add:
+            a_result = (a_leftOperand + a_rightOperand);
+            return true;
+        case ExpressionOperator::Subtract:
+            a_result = (a_leftOperand - a_rightOperand);
+            return true;
+        case ExpressionOperator::Multiply:
+            a_result = (a_leftOperand * a_rightOperand);
+            return true;
+        case ExpressionOperator::Divide:
+            a_result = (a_leftOperand / a_rightOperand);
+            return true;
+        case ExpressionOperator::Less:
+            a_result = (a_leftOperand < a_rightOperand);
+            return true;
+        case ExpressionOperator::Greater:
+            a_result = (a_leftOperand > a_rightOperand);
+            return true;
+        case ExpressionOperator::LessEqual:
+            a_result = (a_leftOperand <= a_rightOperand);
+            return true;
+        case ExpressionOperator::GreaterEqual:
+            a_result = (a_leftOperand >= a_rightOperand);
+            return true;
+        case ExpressionOperator::Equal:
+            a_result = (a_leftOperand == a_rightOperand);
+            return true;
+        case ExpressionOperator::NotEqual:
+            a_result = (a_leftOperand != a_rightOperand);
+            return true;
+        case ExpressionOperator::BinaryNot:
+        case ExpressionOperator::UnaryNot:
+            a_result = (a_leftOperand != 0) ? 0 : 1;
+            return true;
+        case ExpressionOperator::UnaryMinus:
+            a_result = -1 * a_leftOperand;
+            return true;
+        case ExpressionOperator::UnaryPlus:
+            a_result = a_leftOperand;
+            return true;
+        default:
+            return false;
+    }
+}/*inline bool EvaluateExpressionOperator(ExpressionOperator a_operation, double &a_result, double a_leftOperand, double a_rightOperand)*/
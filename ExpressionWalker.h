@@ -0,0 +1,358 @@
+/* ExpressionWalker.h
+ ExpressionWalker.h contains the ExpressionWalker class template and the WalkedOperator struct
+ ExpressionWalker is the one implementation of the grammar of the arithmetic expressions of the Duck language: it walks the tokens of an
+ expression with the shunting yard algorithm, keeps the operator stack, makes every check on the syntax of the expression and throws
+ every syntax error, with its message. What the numbers, the variables and the operators stand for is left to its handler: the
+ ExpressionEvaluator computes their values, the BytecodeCompiler emits the instructions that compute them, and the ProgramOptimizer
+ finds the constant subexpressions among them. All three therefore accept the same expressions, and fail on the others at the same
+ token with the same error.
+ The handler is a class that gives the walker these members (it makes the walker a friend to keep them private):
+    int ParseNextElement(const CompiledStatement &a_statement, int a_nextPos, Token &a_token)
+        retrieves the next element of the statement, as CompiledStatement::ParseNextElement does
+    void WalkNumber(const Token &a_number, int a_position)
+        pushes a number
+    void WalkVariable(const Token &a_variable, int a_position)
+        pushes the value of a variable
+    void WalkArrayElement(const Token &a_array, int a_position, int a_closePosition)
+        replaces the index on top, which has just been walked as an expression of its own, with the value of the element of the array
+        whose name is at a_position. a_closePosition is the position of the ']'
+    void ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount)
+        applies an operator to the a_numberCount numbers that the expression has pushed, or throws. A parenthesis cannot be applied
+    void CloseParentheses(int a_openPosition, int a_closePosition)
+        marks the number on top as enclosed in the parentheses at the given positions
+ The operator stack is kept from one expression to the next, and an expression that is walked within another (the index of an array
+ element) is walked above what the outer one has left on it, so walking allocates nothing once the stack has grown.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Statement.h"
+#include "Token.h"
+#include "ExpressionOperator.h"
+#include "DuckInterpreterException.h"
+
+//An operator on the operator stack of an ExpressionWalker, with the position of its token
+struct WalkedOperator
+{
+    ExpressionOperator m_operator;
+    int m_position;
+};
+
+template<class Handler>
+class ExpressionWalker
+{
+public:
+    ExpressionWalker(Handler &a_handler) : m_handler(a_handler) {}
+    ~ExpressionWalker() {}
+
+    //Walks the arithmetic expression that starts at a_nextPos, which is set to the position of the element after it
+    void Walk(const CompiledStatement &a_statement, int &a_nextPos);
+
+private:
+    //The handler that the numbers, the variables and the operators of the expression are handed to
+    Handler &m_handler;
+
+    //The operators that are waiting for their operands
+    std::vector<WalkedOperator> m_operatorStack;
+
+    //Truncates the operator stack back to the size it had when an expression started being walked, once it has been walked or has
+    //failed, so that a failed expression leaves nothing behind
+    class OperatorStackScope
+    {
+    public:
+        OperatorStackScope(std::vector<WalkedOperator> &a_operatorStack) : m_operatorStack(a_operatorStack), m_base(a_operatorStack.size()) {}
+        ~OperatorStackScope() { m_operatorStack.resize(m_base); }
+        OperatorStackScope(const OperatorStackScope&) = delete;
+        OperatorStackScope& operator=(const OperatorStackScope&) = delete;
+
+        //Returns the size of the stack when the expression started being walked
+        size_t GetBase() const { return m_base; }
+
+    private:
+        std::vector<WalkedOperator> &m_operatorStack;
+        size_t m_base;
+    };
+
+    //Walks a variable, or an array element and its index. a_nextPos is the position after the name, and is set to the position after
+    //the ']' of an array element
+    void WalkVariableOrArrayElement(const CompiledStatement &a_statement, int &a_nextPos, const Token &a_name, int a_position);
+
+    //Handles an operator of the expression, applying the operators on the stack that it completes
+    void WalkOperator(const Token &a_operator, int a_position, ExpressionElement &a_lastElement, size_t a_operatorBase, int &a_numberCount);
+
+    //Pops the operator at the top of the operator stack and has the handler apply it
+    void ApplyTopOfStack(int &a_numberCount);
+};
+
+
+
+/**/
+/*
+ template<class Handler> void ExpressionWalker<Handler>::Walk(const CompiledStatement &a_statement, int &a_nextPos)
+
+ NAME
+    Walk - Walks an arithmetic expression in a statement until it encounters a character that denotes the end of an arithmetic expression
+
+ SYNOPSIS
+    template<class Handler> void ExpressionWalker<Handler>::Walk(const CompiledStatement &a_statement, int &a_nextPos)
+        a_statement --> The statement containing the expression
+        a_nextPos --> The position at which the expression starts
+
+ DESCRIPTION
+    Walks the expression starting at the given position and ending at a character that denotes the end of an arithmetic expression
+    (namely: ',' ';' 'goto' and ']'), handing its numbers, variables and operators to the handler in the order of the shunting yard
+    algorithm, so that the handler has pushed exactly one number, the value of the expression, once it returns. The value of a variable
+    or an array element is pushed before the syntax around it is checked any further. Also, updates the value of a_nextPos to be the
+    position of the first element after the end of the expression.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+template<class Handler>
+void ExpressionWalker<Handler>::Walk(const CompiledStatement &a_statement, int &a_nextPos) {
+    OperatorStackScope operators(m_operatorStack);
+    const size_t operatorBase = operators.GetBase();
+    int numberCount = 0;
+    Token element;
+
+    //tempNextPos runs one element ahead of a_nextPos, so that a_nextPos is left at the element that ends the expression
+    int tempNextPos = m_handler.ParseNextElement(a_statement, a_nextPos, element);
+    if(tempNextPos < 0) {
+        throw DuckInterpreterException("Arithmetic expression missing.");
+    }
+
+    //an operator that does not follow a number is a unary operator (unless it is a ')')
+    ExpressionElement lastElementInExpression = ExpressionElement::None;
+    while(tempNextPos >= 0 && !element.IsOperator(OperatorCode::Comma) && !element.IsOperator(OperatorCode::Semicolon) &&
+          !element.IsKeyword(Keyword::Goto) && !element.IsOperator(OperatorCode::CloseBracket)) {
+        //the element is at a_nextPos
+        int position = a_nextPos;
+        if(element.m_type == TokenType::Number) {
+            if(lastElementInExpression == ExpressionElement::Number) {
+                throw DuckInterpreterException("Invalid arithmetic expression. Numbers must have an operand between them.");
+            }
+            m_handler.WalkNumber(element, position);
+            numberCount++;
+            lastElementInExpression = ExpressionElement::Number;
+        } else if(element.IsArithmeticOperator()) {
+            WalkOperator(element, position, lastElementInExpression, operatorBase, numberCount);
+        } else {
+            if(element.m_type != TokenType::Identifier) {
+                throw DuckInterpreterException("Invalid syntax for arithmetic expression.");
+            }
+            WalkVariableOrArrayElement(a_statement, tempNextPos, element, position);
+            if(lastElementInExpression == ExpressionElement::Number) {
+                throw DuckInterpreterException("Invalid arithmetic expression. Numbers must have an operand between them.");
+            }
+            numberCount++;
+            lastElementInExpression = ExpressionElement::Number;
+        }
+
+        a_nextPos = tempNextPos;
+        tempNextPos = m_handler.ParseNextElement(a_statement, tempNextPos, element);
+    }
+
+    if(lastElementInExpression == ExpressionElement::Operator) {
+        throw DuckInterpreterException("Invalid arithmetic expression. Arithmetic expressions cannot end with operators.");
+    }
+
+    //apply the rest of the operators left in the stack
+    while(m_operatorStack.size() > operatorBase && numberCount > 0) {
+        if(m_operatorStack.back().m_operator == ExpressionOperator::OpenParenthesis) {
+            throw DuckInterpreterException("Invalid Arithmetic Expression. Ending parenthesis missing.");
+        }
+        ApplyTopOfStack(numberCount);
+    }
+
+    //if there are elements (operands or operator) still left, or if there was no expression at all, throw error
+    if(numberCount != 1 || m_operatorStack.size() != operatorBase) {
+        throw DuckInterpreterException("Invalid Arithmetic Expression");
+    }
+}/** template<class Handler> void ExpressionWalker<Handler>::Walk(const CompiledStatement &a_statement, int &a_nextPos) **/
+
+
+
+/**/
+/*
+ template<class Handler> void ExpressionWalker<Handler>::WalkVariableOrArrayElement(const CompiledStatement &a_statement, int &a_nextPos,
+                                                                                    const Token &a_name, int a_position)
+
+ NAME
+    WalkVariableOrArrayElement - Walks a variable or an array element
+
+ SYNOPSIS
+    template<class Handler> void ExpressionWalker<Handler>::WalkVariableOrArrayElement(const CompiledStatement &a_statement, int &a_nextPos,
+                                                                                       const Token &a_name, int a_position)
+        a_statement --> The statement containing the variable or the array
+        a_nextPos --> The position of the element right after the name (in case of an array, the position of the '[' character). Set
+            to the position after the ']' of an array element
+        a_name --> The token of the name of the variable or the array
+        a_position --> The position of the name
+
+ DESCRIPTION
+    A name followed by '[' is an array element: its index is walked as an expression of its own, which must be followed by ']', and the
+    handler then replaces it with the element. Any other name is a variable.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+template<class Handler>
+void ExpressionWalker<Handler>::WalkVariableOrArrayElement(const CompiledStatement &a_statement, int &a_nextPos, const Token &a_name,
+                                                           int a_position) {
+    Token arrayIndexToken;
+    int tempNextPosForArray = m_handler.ParseNextElement(a_statement, a_nextPos, arrayIndexToken);
+    if(!arrayIndexToken.IsOperator(OperatorCode::OpenBracket)) {
+        m_handler.WalkVariable(a_name, a_position);
+        return;
+    }
+    Walk(a_statement, tempNextPosForArray);
+    int closePosition = tempNextPosForArray;
+    tempNextPosForArray = m_handler.ParseNextElement(a_statement, tempNextPosForArray, arrayIndexToken);
+    if(!arrayIndexToken.IsOperator(OperatorCode::CloseBracket)) {
+        throw DuckInterpreterException("Invalid syntax for using arrays. ']' character is missing. ");
+    }
+    a_nextPos = tempNextPosForArray;
+    m_handler.WalkArrayElement(a_name, a_position, closePosition);
+}/** template<class Handler> void ExpressionWalker<Handler>::WalkVariableOrArrayElement(const CompiledStatement &a_statement, int &a_nextPos,
+                                                                                      const Token &a_name, int a_position) **/
+
+
+
+/**/
+/*
+ template<class Handler> void ExpressionWalker<Handler>::WalkOperator(const Token &a_operator, int a_position, ExpressionElement &a_lastElement,
+                                                                      size_t a_operatorBase, int &a_numberCount)
+
+ NAME
+    WalkOperator - Handles an operator of the expression being walked
+
+ SYNOPSIS
+    template<class Handler> void ExpressionWalker<Handler>::WalkOperator(const Token &a_operator, int a_position, ExpressionElement &a_lastElement,
+                                                                         size_t a_operatorBase, int &a_numberCount)
+        a_operator --> The token of the operator
+        a_position --> The position of the token
+        a_lastElement --> Whether the last element in the expression was a number or an operator
+        a_operatorBase --> The size that the operator stack had when the expression started being walked
+        a_numberCount --> The number of numbers that the expression has pushed
+
+ DESCRIPTION
+    A '(' waits on the operator stack. A ')' has the operators back to its '(' applied, and the number they leave is enclosed in the
+    parentheses. Any other operator is unary if it does not follow a number (only +, - and ! can be, and never right after another
+    unary operator), and has the operators on the stack whose precedence is greater or equal applied before it waits on the stack.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+template<class Handler>
+void ExpressionWalker<Handler>::WalkOperator(const Token &a_operator, int a_position, ExpressionElement &a_lastElement, size_t a_operatorBase,
+                                             int &a_numberCount) {
+    if(a_operator.m_operator == OperatorCode::OpenParenthesis) {
+        if(a_lastElement == ExpressionElement::Number) {
+            throw DuckInterpreterException("Invalid arithmetic expression.");
+        }
+        m_operatorStack.push_back({ExpressionOperator::OpenParenthesis, a_position});
+        a_lastElement = ExpressionElement::Operator;
+    } else if(a_operator.m_operator == OperatorCode::CloseParenthesis) {
+        if(m_operatorStack.size() == a_operatorBase) {
+            throw DuckInterpreterException("Invalid arithmetic expression. Opening parenthesis missing.");
+        }
+        if(m_operatorStack.back().m_operator == ExpressionOperator::OpenParenthesis) {
+            throw DuckInterpreterException("Invalid arithmetic expression. There must be an arithmetic expression inside parentheses.");
+        }
+        if(a_lastElement != ExpressionElement::Number) {
+            throw DuckInterpreterException("Invalid arithmetic expression.");
+        }
+
+        //apply the operators until we find the opening parenthesis
+        while(m_operatorStack.size() > a_operatorBase && a_numberCount > 0 && m_operatorStack.back().m_operator != ExpressionOperator::OpenParenthesis) {
+            ApplyTopOfStack(a_numberCount);
+        }
+        if(m_operatorStack.size() == a_operatorBase) {
+            throw DuckInterpreterException("Invalid arithmetic expression. Opening parenthesis missing.");
+        }
+        int openPosition = m_operatorStack.back().m_position;
+        m_operatorStack.pop_back();
+        m_handler.CloseParentheses(openPosition, a_position);
+        //a pair of parentheses resolve into a number
+        a_lastElement = ExpressionElement::Number;
+    } else {
+        ExpressionOperator expressionOperator = ToExpressionOperator(a_operator.m_operator, false);
+        if(a_lastElement == ExpressionElement::Operator || a_lastElement == ExpressionElement::None) {
+            if(m_operatorStack.size() > a_operatorBase && OperatorArity(m_operatorStack.back().m_operator) == 1) {
+                std::string message = std::string(OperatorText(m_operatorStack.back().m_operator)) + OperatorText(expressionOperator) +
+                                      " is an invalid operation";
+                throw DuckInterpreterException(message);
+            }
+            if(a_operator.m_operator != OperatorCode::Plus && a_operator.m_operator != OperatorCode::Minus &&
+               a_operator.m_operator != OperatorCode::Not) {
+                throw DuckInterpreterException("Invalid Arithmetic Expression");
+            }
+            expressionOperator = ToExpressionOperator(a_operator.m_operator, true);
+        }
+
+        //apply all the operators with a precedence greater than or equal to the current operator
+        while(m_operatorStack.size() > a_operatorBase && a_numberCount > 0 &&
+              OperatorPrecedence(expressionOperator) <= OperatorPrecedence(m_operatorStack.back().m_operator)) {
+            ApplyTopOfStack(a_numberCount);
+        }
+        m_operatorStack.push_back({expressionOperator, a_position});
+        a_lastElement = ExpressionElement::Operator;
+    }
+}/** template<class Handler> void ExpressionWalker<Handler>::WalkOperator(const Token &a_operator, int a_position, ExpressionElement &a_lastElement,
+                                                                        size_t a_operatorBase, int &a_numberCount) **/
+
+
+
+/**/
+/*
+ template<class Handler> void ExpressionWalker<Handler>::ApplyTopOfStack(int &a_numberCount)
+
+ NAME
+    ApplyTopOfStack - Pops the operator at the top of the operator stack and has the handler apply it
+
+ SYNOPSIS
+    template<class Handler> void ExpressionWalker<Handler>::ApplyTopOfStack(int &a_numberCount)
+        a_numberCount --> The number of numbers that the expression has pushed
+
+ DESCRIPTION
+    A unary operator replaces the number on top with its result. A binary operator needs two numbers, and replaces them with its
+    result. A parenthesis that ends up being applied (by a binary ! after it) is handed to the handler with the numbers there are,
+    which fails; the BytecodeCompiler leaves the error to the run time, when it is reported with the values of the numbers, and the one
+    number that the parenthesis is then taken to leave is never used.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+template<class Handler>
+void ExpressionWalker<Handler>::ApplyTopOfStack(int &a_numberCount) {
+    WalkedOperator top = m_operatorStack.back();
+    m_operatorStack.pop_back();
+    if(top.m_operator == ExpressionOperator::OpenParenthesis || top.m_operator == ExpressionOperator::CloseParenthesis) {
+        m_handler.ApplyOperator(top.m_operator, top.m_position, a_numberCount);
+        a_numberCount = 1;
+        return;
+    }
+    if(OperatorArity(top.m_operator) == 2 && a_numberCount < 2) {
+        throw DuckInterpreterException("Invalid Arithmetic Expression");
+    }
+    m_handler.ApplyOperator(top.m_operator, top.m_position, a_numberCount);
+    a_numberCount -= OperatorArity(top.m_operator) - 1;
+}/** template<class Handler> void ExpressionWalker<Handler>::ApplyTopOfStack(int &a_numberCount) **/
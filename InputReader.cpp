@@ -0,0 +1,35 @@
+#include "InputReader.h"
+
+using namespace std;
+
+
+/**/
+/*
+ double InputReader::ReadNumber()
+
+ NAME
+    InputReader::ReadNumber - Reads the next input value
+
+ SYNOPSIS
+    double InputReader::ReadNumber()
+
+ DESCRIPTION
+    Takes the next white space separated field of the input and converts it to a double. The field must be a valid number as the
+    lexer defines it (digits with at most one decimal point and an optional sign), and it must fit in a double. Empty lines are skipped.
+    Throws an exception if the field is not a valid number or if the input has run out.
+
+ RETURNS
+    The value that was read
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+double InputReader::ReadNumber() {
+    double value;
+    InputStatus status = m_input.ReadNumber(value);
+    if(status != InputStatus::Read) {
+        throw DuckInterpreterException(InputErrorMessage(status));
+    }
+    return value;
+}/** double InputReader::ReadNumber() **/
@@ -0,0 +1,27 @@
+/* InputReader.h
+ InputReader.h contains the InputReader class
+ InputReader is the class that reads the input values of read statements from the standard input. It is owned by the DuckInterpreter
+ and shared with the DuckVM. The values are read by a StandardInput (see DuckRuntimeCore.h, which the translated programs of duck2cpp
+ share): the standard input is read in large blocks, and the values are the white space separated fields of the input, so that a line
+ can hold several values (for example, all the values of a read statement with several variables). Before the reader waits for more
+ input, it flushes the output of the program so that a user sees the prompt.
+*/
+
+#pragma once
+
+#include "DuckRuntimeCore.h"
+#include "DuckInterpreterException.h"
+
+class InputReader
+{
+public:
+    InputReader(OutputBuffer &a_output) : m_input(a_output) {}
+    ~InputReader() {}
+
+    //Reads the next input value. Throws an exception if the value is not a valid number or if there is no more input
+    double ReadNumber();
+
+private:
+    //The standard input, and the values that have been read from it but not used yet
+    StandardInput m_input;
+};
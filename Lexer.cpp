@@ -0,0 +1,557 @@
+#include "Lexer.h"
+#include "DuckRuntimeCore.h"
+
+#include <array>
+#include <charconv>
+#include <cfloat>
+
+using namespace std;
+
+//The classes a character of a statement can belong to. A character can belong to several classes
+enum CharacterClass : unsigned char
+{
+    //ends the element before it (white space, operators, brackets, ';', ',' and '"')
+    k_syntacticCharacter = 1,
+    //can start a variable name (letters and '_')
+    k_identifierStart = 2,
+    //can appear in a variable name after its first character (letters, digits and '_')
+    k_identifierCharacter = 4,
+    k_digit = 8,
+    k_whiteSpace = 16,
+};
+
+/**/
+/*
+ static constexpr array<unsigned char, 256> BuildCharacterClasses()
+
+ NAME
+    BuildCharacterClasses - Builds the table of the classes of every character
+
+ SYNOPSIS
+    static constexpr array<unsigned char, 256> BuildCharacterClasses()
+
+ DESCRIPTION
+    This function builds the lookup table used by the lexer to classify the characters of a statement. It is evaluated at compile time.
+
+ RETURNS
+    The classes of every character, indexed by the character (as an unsigned char)
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static constexpr array<unsigned char, 256> BuildCharacterClasses() {
+    array<unsigned char, 256> classes = {};
+    for(const char *c = "<>!()+-/* =;,\"[]\t"; *c != '\0'; c++) {
+        classes[static_cast<unsigned char>(*c)] |= k_syntacticCharacter;
+    }
+    for(int c = 'a'; c <= 'z'; c++) {
+        classes[c] |= k_identifierStart | k_identifierCharacter;
+    }
+    for(int c = 'A'; c <= 'Z'; c++) {
+        classes[c] |= k_identifierStart | k_identifierCharacter;
+    }
+    classes['_'] |= k_identifierStart | k_identifierCharacter;
+    for(int c = '0'; c <= '9'; c++) {
+        classes[c] |= k_identifierCharacter | k_digit;
+    }
+    classes[' '] |= k_whiteSpace;
+    classes['\t'] |= k_whiteSpace;
+    return classes;
+}/** static constexpr array<unsigned char, 256> BuildCharacterClasses() **/
+
+//The classes of every character
+static constexpr array<unsigned char, 256> k_characterClasses = BuildCharacterClasses();
+
+//Returns true if the given character belongs to the given class
+static inline bool IsOfClass(char a_character, CharacterClass a_class) {
+    return (k_characterClasses[static_cast<unsigned char>(a_character)] & a_class) != 0;
+}
+
+//Returns true if the two given characters form one of the two character operators (==, >=, <= and !=)
+static inline bool IsATwoCharacterOperator(char a_first, char a_second) {
+    return a_second == '=' && (a_first == '=' || a_first == '>' || a_first == '<' || a_first == '!');
+}
+
+
+/**/
+/*
+ void Lexer::Tokenize(string_view a_statement, TokenList &a_tokens, string &a_errorMessage)
+
+ NAME
+    Lexer::Tokenize - Breaks the given statement into tokens
+
+ SYNOPSIS
+    void Lexer::Tokenize(string_view a_statement, TokenList &a_tokens, string &a_errorMessage)
+        a_statement --> The statement to be broken into tokens
+        a_tokens --> The tokens of the statement, in the order they appear in the statement
+        a_errorMessage --> The description of the error that stopped the tokenization (empty if there was none)
+
+ DESCRIPTION
+    This function walks through the statement one element at a time (skipping white space) and records a token for every element.
+    If an element cannot be recognized, an Error token is recorded in its place and the tokenization stops. The error is not thrown
+    here because a statement is only in error once the interpreter reaches the faulty element while executing the statement.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void Lexer::Tokenize(string_view a_statement, TokenList &a_tokens, string &a_errorMessage) {
+    a_tokens.clear();
+    a_errorMessage.clear();
+
+    int statementLength = static_cast<int>(a_statement.length());
+    int indexOfStartOfElement = 0;
+    while(true) {
+        //skip any white space before the next element
+        while(indexOfStartOfElement < statementLength && IsOfClass(a_statement[indexOfStartOfElement], k_whiteSpace)) {
+            indexOfStartOfElement++;
+        }
+        if(indexOfStartOfElement >= statementLength) {
+            return;
+        }
+
+        try {
+            int lengthOfElement = GetLengthOfElement(a_statement, indexOfStartOfElement);
+            a_tokens.push_back(MakeToken(a_statement.substr(indexOfStartOfElement, lengthOfElement), indexOfStartOfElement));
+            indexOfStartOfElement += lengthOfElement;
+        } catch(DuckInterpreterException& e) {
+            //record where the statement stopped making sense, along with the reason
+            Token errorToken;
+            errorToken.m_type = TokenType::Error;
+            errorToken.m_start = indexOfStartOfElement;
+            errorToken.m_length = statementLength - indexOfStartOfElement;
+            a_tokens.push_back(errorToken);
+            a_errorMessage = e.what();
+            return;
+        }
+    }
+}/** void Lexer::Tokenize(string_view a_statement, TokenList &a_tokens, string &a_errorMessage) **/
+
+
+
+/**/
+/*
+ Token Lexer::MakeToken(string_view a_element, int a_indexOfStartOfElement)
+
+ NAME
+    Lexer::MakeToken - Builds the token for a single element of a statement
+
+ SYNOPSIS
+    Token Lexer::MakeToken(string_view a_element, int a_indexOfStartOfElement)
+        a_element --> The text of the element
+        a_indexOfStartOfElement --> The index at which the element starts in its statement
+
+ DESCRIPTION
+    This function checks whether the element is a string, a number, a reserved keyword, a variable name or a syntactic character
+    (in that order) and builds the corresponding token. Numbers are converted to their value and identifiers are interned.
+    A number that is out of the range of a double (including a number so small that it can only be stored with a loss of precision)
+    is not recognized, as with stod. Throws an exception if the element is none of these.
+
+ RETURNS
+    The token for the element
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+Token Lexer::MakeToken(string_view a_element, int a_indexOfStartOfElement) {
+    Token token;
+    token.m_start = a_indexOfStartOfElement;
+    token.m_length = static_cast<int>(a_element.length());
+
+    //now, check to see if string, digit, variable, or syntactic character
+    if(a_element[0] == '\"') {
+        token.m_type = TokenType::String;
+        return token;
+    }
+    if(IsAValidNumber(a_element)) {
+        double value;
+        from_chars_result result = from_chars(a_element.data(), a_element.data() + a_element.length(), value);
+        //a lone '.' passes as a number but has no value; it is reported as unrecognized below
+        if(result.ec == errc() && (value == 0 || value >= DBL_MIN)) {
+            token.m_numValue = value;
+            token.m_type = TokenType::Number;
+            return token;
+        }
+    }
+    else if(Keyword keyword = FindKeyword(a_element); keyword != Keyword::None) {
+        token.m_type = TokenType::Keyword;
+        token.m_keyword = keyword;
+        return token;
+    }
+    else if(IsAValidVariableName(a_element)) {
+        token.m_type = TokenType::Identifier;
+        token.m_identifierId = InternIdentifier(a_element);
+        return token;
+    }
+    else if(IsASyntacticCharacter(a_element)) {
+        token.m_type = TokenType::Operator;
+        if(a_element.length() == 2) {
+            switch(a_element[0]) {
+                case '=': token.m_operator = OperatorCode::Equal; break;
+                case '>': token.m_operator = OperatorCode::GreaterEqual; break;
+                case '<': token.m_operator = OperatorCode::LessEqual; break;
+                default: token.m_operator = OperatorCode::NotEqual; break;
+            }
+            return token;
+        }
+        switch(a_element[0]) {
+            case '+': token.m_operator = OperatorCode::Plus; break;
+            case '-': token.m_operator = OperatorCode::Minus; break;
+            case '*': token.m_operator = OperatorCode::Multiply; break;
+            case '/': token.m_operator = OperatorCode::Divide; break;
+            case '!': token.m_operator = OperatorCode::Not; break;
+            case '<': token.m_operator = OperatorCode::Less; break;
+            case '>': token.m_operator = OperatorCode::Greater; break;
+            case '(': token.m_operator = OperatorCode::OpenParenthesis; break;
+            case ')': token.m_operator = OperatorCode::CloseParenthesis; break;
+            case '[': token.m_operator = OperatorCode::OpenBracket; break;
+            case ']': token.m_operator = OperatorCode::CloseBracket; break;
+            case '=': token.m_operator = OperatorCode::Assign; break;
+            case ';': token.m_operator = OperatorCode::Semicolon; break;
+            default: token.m_operator = OperatorCode::Comma; break;
+        }
+        return token;
+    }
+
+    string message = "'" + string(a_element) + "' is an unrecognized expression.";
+    throw DuckInterpreterException(message);
+}/** Token Lexer::MakeToken(string_view a_element, int a_indexOfStartOfElement) **/
+
+
+
+/**/
+/*
+ Keyword Lexer::FindKeyword(string_view a_element)
+
+ NAME
+    Lexer::FindKeyword - Returns the keyword that the given element spells
+
+ SYNOPSIS
+    Keyword Lexer::FindKeyword(string_view a_element)
+        a_element --> The element to be checked for being a reserved keyword
+
+ DESCRIPTION
+    This function compares the element against the reserved keywords of the Duck language ("dim", "read", "goto", "if", "print",
+    "stop" and "end")
+
+ RETURNS
+    The keyword, or Keyword::None if the element is not a reserved keyword
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+Keyword Lexer::FindKeyword(string_view a_element) {
+    switch(a_element.length()) {
+        case 2:
+            if(a_element == "if") return Keyword::If;
+            break;
+        case 3:
+            if(a_element == "dim") return Keyword::Dim;
+            if(a_element == "end") return Keyword::End;
+            break;
+        case 4:
+            if(a_element == "read") return Keyword::Read;
+            if(a_element == "goto") return Keyword::Goto;
+            if(a_element == "stop") return Keyword::Stop;
+            break;
+        case 5:
+            if(a_element == "print") return Keyword::Print;
+            break;
+    }
+    return Keyword::None;
+}/** Keyword Lexer::FindKeyword(string_view a_element) **/
+
+
+
+/**/
+/*
+ int Lexer::InternIdentifier(string_view a_name)
+
+ NAME
+    Lexer::InternIdentifier - Returns the id of the given identifier name
+
+ SYNOPSIS
+    int Lexer::InternIdentifier(string_view a_name)
+        a_name --> The variable, array or label name to be interned
+
+ DESCRIPTION
+    Every distinct identifier name in the Duck program is given a small integer id the first time it is seen. This function returns
+    the id of the given name, assigning it the next free id (and storing a copy of the name) if the name has not been seen before.
+
+ RETURNS
+    The id of the identifier
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int Lexer::InternIdentifier(string_view a_name) {
+    unordered_map<string_view, int>::iterator it = m_identifierIds.find(a_name);
+    if(it != m_identifierIds.end()) {
+        return it->second;
+    }
+    int identifierId = static_cast<int>(m_identifierNames.size());
+    m_identifierNames.emplace_back(a_name);
+    m_identifierIds[m_identifierNames.back()] = identifierId;
+    return identifierId;
+}/** int Lexer::InternIdentifier(string_view a_name) **/
+
+
+
+/**/
+/*
+ int Lexer::GetLengthOfElement(string_view a_statement, int a_indexOfStartOfElement)
+
+ NAME
+    Lexer::GetLengthOfElement - Returns the length of an element starting at the given index from the given statement
+
+ SYNOPSIS
+    int Lexer::GetLengthOfElement(string_view a_statement, int a_indexOfStartOfElement)
+        a_statement --> The statement from which the element's length is to be calculated
+        a_indexOfStartOfElement --> The index from which the element starts
+
+ DESCRIPTION
+    Calculates the length of the element starting at a_indexOfStartOfElement from the given statement. A string runs up to its closing
+    '"', a syntactic character is one or two characters long, and any other element runs up to the next syntactic character.
+
+ RETURNS
+    The length of the next element
+
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+int Lexer::GetLengthOfElement(string_view a_statement, int a_indexOfStartOfElement) {
+    int statementLength = static_cast<int>(a_statement.length());
+
+    //if no element starting at index, return 0;
+    if(a_indexOfStartOfElement >= statementLength) {
+        return 0;
+    }
+
+    //First, check if the element is a string
+    char firstCharacter = a_statement[a_indexOfStartOfElement];
+    if(firstCharacter == '\"') {
+        //find the second '"' character marking the end of the string
+        size_t indexOfEndOfString = a_statement.find('\"', a_indexOfStartOfElement + 1);
+        //if not found, throw error
+        if(indexOfEndOfString == string_view::npos) {
+            throw DuckInterpreterException("Bad Syntax. End of string not defined. '\"' character is missing.");
+        }
+        return static_cast<int>(indexOfEndOfString) - a_indexOfStartOfElement + 1;
+    }
+
+    //If not a string, check if the element is a syntactic operator (like +, -, ;, ==, etc)
+    if(IsOfClass(firstCharacter, k_syntacticCharacter)) {
+        //if it is two character long operator (like ==, <=, etc), then the length is two
+        if(a_indexOfStartOfElement + 1 < statementLength && IsATwoCharacterOperator(firstCharacter, a_statement[a_indexOfStartOfElement + 1])) {
+            return 2;
+        }
+        return 1;
+    }
+
+    //If not a syntactic operator or a string, the element must either be a variable, a number, or a keyword (like goto, read, print, etc)
+    //It ends at the next syntactic character
+    int indexOfEndOfElement = a_indexOfStartOfElement + 1;
+    while(indexOfEndOfElement < statementLength && !IsOfClass(a_statement[indexOfEndOfElement], k_syntacticCharacter)) {
+        indexOfEndOfElement++;
+    }
+    return indexOfEndOfElement - a_indexOfStartOfElement;
+}/** int Lexer::GetLengthOfElement(string_view a_statement, int a_indexOfStartOfElement) **/
+
+
+
+/**/
+/*
+ bool Lexer::IsAValidVariableName(string_view a_variableName)
+
+ NAME
+    Lexer::IsAValidVariableName - Checks whether the given string is a valid variable name
+
+ SYNOPSIS
+    bool Lexer::IsAValidVariableName(string_view a_variableName)
+        a_variableName --> The string to be checked for validity
+
+ DESCRIPTION
+    This function checks whether the given string is a valid variable name according the variable naming rules of the Duck language. It checks whether the
+        first character of the string is a an alphabet, or an underscore, and whether the remaining characters are alphabets, digits, or underscores
+
+ RETURNS
+    True if the string is a valid variable name. False if not
+
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+bool Lexer::IsAValidVariableName(string_view a_variableName) {
+    //return if empty variable name
+    if(a_variableName.length() == 0) {
+        return false;
+    }
+
+    //reserved keywords are not allowed to be variable names
+    if(IsAReservedKeyword(a_variableName)) {
+        return false;
+    }
+
+    //now, check to see if the first character of the label is not an "_" or a letter
+    if(!IsOfClass(a_variableName[0], k_identifierStart)) {
+        return false;
+    }
+
+    //now, check to see if the rest of the characters of the label is not an "_", a letter, or a number
+    for(size_t i = 1; i < a_variableName.length(); i++) {
+        if(!IsOfClass(a_variableName[i], k_identifierCharacter)) {
+            return false;
+        }
+    }
+
+    return true;
+} /* bool Lexer::IsAValidVariableName(string_view a_variableName) */
+
+
+/**/
+/*
+ bool Lexer::IsAValidNumber(string_view a_number)
+
+ NAME
+    Lexer::IsAValidNumber - Checks whether the given string is a valid number
+
+ SYNOPSIS
+    bool Lexer::IsAValidNumber(string_view a_number)
+        a_number --> The string to be checked for validity
+
+ DESCRIPTION
+    This function checks whether the given string is a valid number: digits with at most one decimal point, optionally preceded by
+        a sign.
+
+ RETURNS
+    True if the string is a valid number. False if not
+
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+bool Lexer::IsAValidNumber(string_view a_number) {
+    //the numbers of a program are written as the values that are read (see DuckRuntimeCore.h)
+    return IsAValidDuckNumber(a_number);
+} /* bool Lexer::IsAValidNumber(string_view a_number) */
+
+
+
+/**/
+/*
+ bool Lexer::IsAnArithmeticOperation(string_view a_stringToCheck)
+
+ NAME
+    Lexer::IsAnArithmeticOperation - Checks whether the given string is an arithmetic operation
+
+ SYNOPSIS
+    bool Lexer::IsAnArithmeticOperation(string_view a_stringToCheck)
+        a_stringToCheck --> The string to be checked for being an arithmetic operation
+
+ DESCRIPTION
+    This function checks whether the given string is an arithmetic operation (such as ==, -, +, /, !, !=, <, etc)
+
+ RETURNS
+    True if the string is a valid arithmetic operation. False if not
+
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+bool Lexer::IsAnArithmeticOperation(string_view a_stringToCheck) {
+
+    //First, check for >=, <=, ==, != (i.e. all operators that are 2 characters long
+    if(a_stringToCheck.length() >= 2) {
+        if(IsATwoCharacterOperator(a_stringToCheck[0], a_stringToCheck[1])) {
+            return true;
+        }
+        string_view prefix = a_stringToCheck.substr(0, 6);
+        if(prefix == "unary+" || prefix == "unary-" || prefix == "unary!") {
+            return true;
+        }
+    }
+
+    //Now, check for 1 character long operators (namely: '!', '<', '>', '(', ')', '+', '-', '*' and '/')
+    if(a_stringToCheck.length() == 1) {
+        switch(a_stringToCheck[0]) {
+            case '<':
+            case '>':
+            case '!':
+            case ')':
+            case '(':
+            case '+':
+            case '-':
+            case '/':
+            case '*':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    return false;
+
+} /* bool Lexer::IsAnArithmeticOperation(string_view a_stringToCheck)  */
+
+
+/**/
+/*
+ bool Lexer::IsASyntacticCharacter(string_view a_stringToCheck)
+
+ NAME
+    Lexer::IsASyntacticCharacter - Checks whether the given string is a syntactic character
+
+ SYNOPSIS
+    bool Lexer::IsASyntacticCharacter(string_view a_stringToCheck)
+        a_stringToCheck --> The string to be checked for being a syntactic character
+
+ DESCRIPTION
+    This function checks whether the given string is an syntactic character (such as ' ', ';', '+', '=', etc)
+
+ RETURNS
+    True if the string is a valid syntactic character. False if not
+
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+bool Lexer::IsASyntacticCharacter(string_view a_stringToCheck) {
+    //single characters that mark the end of an element (namely: the arithmetic operators, ' ', '\t', '=', '"', ',', ';', '[' and ']')
+    if(a_stringToCheck.length() == 1) {
+        return IsOfClass(a_stringToCheck[0], k_syntacticCharacter);
+    }
+    return IsAnArithmeticOperation(a_stringToCheck);
+} /* bool Lexer::IsASyntacticCharacter(string_view a_stringToCheck) */
+
+/**/
+/*
+ bool Lexer::IsAReservedKeyword(string_view a_stringToCheck)
+
+ NAME
+    Lexer::IsAReservedKeyword - Checks whether the given string is a reserved keyword
+
+ SYNOPSIS
+    bool Lexer::IsAReservedKeyword(string_view a_stringToCheck)
+        a_stringToCheck --> The string to be checked for being a reserved keyword
+
+ DESCRIPTION
+    This function checks whether the given string is a reserved keyword (such as "goto", "print", "read", "dim", etc)
+
+ RETURNS
+    True if the string is a reserved keyword. False if not.
+
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+bool Lexer::IsAReservedKeyword(string_view a_stringToCheck) {
+    return FindKeyword(a_stringToCheck) != Keyword::None;
+} /* bool Lexer::IsAReservedKeyword(string_view a_stringToCheck) */
@@ -0,0 +1,92 @@
+/* Lexer.h
+ Lexer.h contains the Lexer class
+ Lexer is the class that breaks the statements of a Duck program into tokens. It is used by the Statement class to tokenize every
+ statement once when the program is recorded. It also interns the names of variables, arrays and labels so that each distinct
+ name is identified by a small integer id.
+ The lexer scans a statement in a single pass over a std::string_view, classifying characters with a lookup table, and does not
+ allocate while doing so (other than to store the tokens and the names of identifiers that have not been seen before).
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include "Token.h"
+#include "DuckInterpreterException.h"
+
+class Lexer
+{
+public:
+    Lexer() {}
+    ~Lexer() {}
+
+    //Breaks the given statement into tokens. If the statement cannot be fully tokenized, the tokens end with an Error token
+    //and the description of the error is stored in a_errorMessage
+    void Tokenize(std::string_view a_statement, TokenList &a_tokens, std::string &a_errorMessage);
+
+    /**/
+    /*
+    const std::string& GetIdentifierName(int a_identifierId) const
+
+    NAME
+        GetIdentifierName - Returns the name of the identifier with the given id
+
+    SYNOPSIS
+        const std::string& GetIdentifierName(int a_identifierId) const
+            a_identifierId --> The id that was assigned to the identifier when it was interned
+
+    DESCRIPTION
+        This function returns the variable, array or label name that corresponds to the given identifier id
+
+    RETURNS
+        The name of the identifier
+
+    AUTHOR
+        Duck interpreter contributors
+    */
+    /**/
+    const std::string& GetIdentifierName(int a_identifierId) const {
+        return m_identifierNames[a_identifierId];
+    }/*const std::string& GetIdentifierName(int a_identifierId) const*/
+
+    //Returns the number of distinct identifiers that have been interned
+    int GetIdentifierCount() const { return static_cast<int>(m_identifierNames.size()); }
+
+    //Returns the id of the given identifier name, assigning it a new id if it has not been seen before
+    int InternIdentifier(std::string_view a_name);
+
+    //Returns true if the given string is a legal variable name. Returns false otherwise
+    static bool IsAValidVariableName(std::string_view a_variableName);
+
+    //Returns true if the given string contains a valid number. Returns false otherwise
+    static bool IsAValidNumber(std::string_view a_number);
+
+    //Returns true if the given string contains an arithmetic operation like +, -, ==, <=, !, etc.
+    static bool IsAnArithmeticOperation(std::string_view a_stringToCheck);
+
+    //Returns true if the given string contains a syntactic character like ;, =, +, *, -, [, ], etc
+    static bool IsASyntacticCharacter(std::string_view a_stringToCheck);
+
+    //Returns true if the given string contains a reserved keyword that cannot taken as variable names, like goto, stop, end, etc.
+    static bool IsAReservedKeyword(std::string_view a_stringToCheck);
+
+private:
+    //container to map every interned identifier name to its id. The keys view the names stored in m_identifierNames
+    std::unordered_map<std::string_view, int> m_identifierIds;
+
+    //container to store the name of every interned identifier, indexed by the identifier's id. A deque never moves its
+    //elements when it grows, so the keys of m_identifierIds stay valid
+    std::deque<std::string> m_identifierNames;
+
+    //Gets the length of an element in a statement starting from the given index
+    int GetLengthOfElement(std::string_view a_statement, int a_indexOfStartOfElement);
+
+    //Builds the token for the given element, which starts at the given index of its statement
+    Token MakeToken(std::string_view a_element, int a_indexOfStartOfElement);
+
+    //Returns the keyword that the given element spells, or Keyword::None if it is not a reserved keyword
+    static Keyword FindKeyword(std::string_view a_element);
+
+};
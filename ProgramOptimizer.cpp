@@ -0,0 +1,625 @@
+#include "ProgramOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+
+/**/
+/*
+ void ProgramOptimizer::Optimize()
+
+ NAME
+    Optimize - Optimizes the recorded statements of the Duck program
+
+ SYNOPSIS
+    void ProgramOptimizer::Optimize()
+
+ DESCRIPTION
+    The unreachable statements are pruned first, so that only the statements that can be executed are folded. Only arithmetic statements
+    and if statements have subexpressions worth folding: the expressions of print statements and array declarations are evaluated once
+    per execution of a statement that is rarely in a loop. The loop invariant assignments are found last, once their expressions have
+    been folded. Folding does not change the gotos of the program, so the control flow graph is built only once.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::Optimize() {
+    ControlFlowGraph graph(m_statements);
+    PruneUnreachableStatements(graph);
+    for(int statementNum = 0; statementNum < m_statements.GetStatementCount(); statementNum++) {
+        StatementType type = m_statements.GetStatement(statementNum).m_type;
+        if(type == StatementType::ArithmeticStat || type == StatementType::IfStat) {
+            FoldStatement(statementNum);
+        }
+    }
+    FindLoopInvariantAssignments(graph);
+}/** void ProgramOptimizer::Optimize() **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::WriteReport(ostream &a_stream) const
+
+ NAME
+    WriteReport - Writes what the optimizer changed
+
+ SYNOPSIS
+    void ProgramOptimizer::WriteReport(ostream &a_stream) const
+        a_stream --> The stream to write the report to
+
+ DESCRIPTION
+    Every change is written on a line of its own, in the order of the statements, with the line number and the text of the statement
+    that it was made to, in the same form as the errors of the program. The totals follow.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::WriteReport(ostream &a_stream) const {
+    a_stream << "Optimization report:" << endl;
+    vector<pair<int, string>> changes = m_changes;
+    stable_sort(changes.begin(), changes.end(), [](const pair<int, string> &a_left, const pair<int, string> &a_right) {
+        return a_left.first < a_right.first;
+    });
+    for(const pair<int, string> &change : changes) {
+        a_stream << "  Line " << change.first + 1 << ": \"" << m_statements.GetStatement(change.first).m_text << "\": " << change.second << endl;
+    }
+    a_stream << "  " << m_foldCount << " constant subexpression" << (m_foldCount == 1 ? "" : "s") << " folded, " << m_unreachableCount
+             << " unreachable statement" << (m_unreachableCount == 1 ? "" : "s") << " removed, " << m_invariantCount
+             << " loop invariant assignment" << (m_invariantCount == 1 ? "" : "s") << " found" << endl;
+}/** void ProgramOptimizer::WriteReport(ostream &a_stream) const **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::PruneUnreachableStatements(const ControlFlowGraph &a_graph)
+
+ NAME
+    PruneUnreachableStatements - Marks the statements that can never be executed as Unreachable
+
+ SYNOPSIS
+    void ProgramOptimizer::PruneUnreachableStatements(const ControlFlowGraph &a_graph)
+        a_graph --> The control flow graph of the program
+
+ DESCRIPTION
+    Execution starts at the first statement, so every statement that is not in a block of the control flow graph (which only holds the
+    statements that can be reached from the first one) can never be executed. The unreachable statements keep their place and their
+    text, so the line numbers of the program do not change, but no engine spends any work on them.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::PruneUnreachableStatements(const ControlFlowGraph &a_graph) {
+    for(int statementNum = 0; statementNum < m_statements.GetStatementCount(); statementNum++) {
+        if(a_graph.GetBlockOfStatement(statementNum) < 0) {
+            m_statements.MarkUnreachable(statementNum);
+            m_changes.push_back(make_pair(statementNum, string("removed unreachable statement")));
+            m_unreachableCount++;
+        }
+    }
+}/** void ProgramOptimizer::PruneUnreachableStatements(const ControlFlowGraph &a_graph) **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::FoldStatement(int a_statementNum)
+
+ NAME
+    FoldStatement - Folds the constant subexpressions of an arithmetic statement or an if statement
+
+ SYNOPSIS
+    void ProgramOptimizer::FoldStatement(int a_statementNum)
+        a_statementNum --> The index of the statement
+
+ DESCRIPTION
+    The statement is walked as EvaluateArithmeticStatement or EvaluateIfStatement evaluates it. Only a statement that the walk finds
+    no syntax error in is folded: the errors that are left can only come from the values of variables and array elements, and those are
+    never part of a constant subexpression. Every largest constant subexpression (that is more than a single number) is replaced by one
+    number token that covers its text, which the engines evaluate to the very same number.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::FoldStatement(int a_statementNum) {
+    const CompiledStatement &statement = m_statements.GetStatement(a_statementNum);
+    if(!statement.m_lexErrorMessage.empty()) {
+        return;
+    }
+
+    vector<FoldedSpan> spans;
+    m_conditionParenthesis = -1;
+    //a walk that failed in the previous statement may have left operands behind
+    m_numberStack.clear();
+    try {
+        Token token;
+        int nextPos;
+        if(statement.m_type == StatementType::ArithmeticStat) {
+            //the variable, or the array and the index of the element, that is assigned
+            nextPos = statement.ParseNextElement(0, token);
+            if(token.m_type != TokenType::Identifier) {
+                return;
+            }
+            nextPos = statement.ParseNextElement(nextPos, token);
+            if(token.IsOperator(OperatorCode::OpenBracket)) {
+                AddFoldedSpans(FoldExpression(statement, nextPos), spans);
+                nextPos = statement.ParseNextElement(nextPos, token);
+                if(!token.IsOperator(OperatorCode::CloseBracket)) {
+                    return;
+                }
+                nextPos = statement.ParseNextElement(nextPos, token);
+            }
+            if(!token.IsOperator(OperatorCode::Assign)) {
+                return;
+            }
+
+            //the value, which must be followed by nothing but the semicolon
+            AddFoldedSpans(FoldExpression(statement, nextPos), spans);
+            nextPos = statement.ParseNextElement(nextPos, token);
+            if(nextPos >= 0) {
+                return;
+            }
+        } else {
+            //the condition, which must be followed by the well formed goto
+            if(statement.m_gotoPosition < 0) {
+                return;
+            }
+            nextPos = statement.ParseNextElement(0, token);
+            if(!token.IsKeyword(Keyword::If) || nextPos < 0 || !statement.m_tokens[nextPos].IsOperator(OperatorCode::OpenParenthesis)) {
+                return;
+            }
+            m_conditionParenthesis = nextPos;
+            AddFoldedSpans(FoldExpression(statement, nextPos), spans);
+            if(nextPos != statement.m_gotoPosition) {
+                return;
+            }
+        }
+    } catch(DuckInterpreterException &) {
+        return;
+    }
+    if(spans.empty()) {
+        return;
+    }
+
+    //the spans are in the order of their tokens, and never overlap
+    const TokenList &tokens = statement.m_tokens;
+    TokenList foldedTokens;
+    int gotoPosition = statement.m_gotoPosition;
+    size_t spanNum = 0;
+    for(int position = 0; position < static_cast<int>(tokens.size()); position++) {
+        if(spanNum == spans.size() || spans[spanNum].m_first != position) {
+            foldedTokens.push_back(tokens[position]);
+            continue;
+        }
+        const FoldedSpan &span = spans[spanNum++];
+        Token number;
+        number.m_type = TokenType::Number;
+        number.m_numValue = span.m_value;
+        number.m_start = tokens[span.m_first].m_start;
+        number.m_length = tokens[span.m_last].m_start + tokens[span.m_last].m_length - number.m_start;
+        foldedTokens.push_back(number);
+        if(gotoPosition > span.m_last) {
+            gotoPosition -= span.m_last - span.m_first;
+        }
+        //a negative number (-5) is folded too, but it is not worth reporting
+        string text(statement.m_text.substr(number.m_start, number.m_length));
+        if(text != NumberText(span.m_value)) {
+            m_changes.push_back(make_pair(a_statementNum, "folded " + text + " to " + NumberText(span.m_value)));
+            m_foldCount++;
+        }
+        position = span.m_last;
+    }
+    m_statements.ReplaceTokens(a_statementNum, foldedTokens, gotoPosition);
+}/** void ProgramOptimizer::FoldStatement(int a_statementNum) **/
+
+
+
+/**/
+/*
+ FoldOperand ProgramOptimizer::FoldExpression(const CompiledStatement &a_statement, int &a_nextPos)
+
+ NAME
+    FoldExpression - Walks an arithmetic expression and finds its constant subexpressions
+
+ SYNOPSIS
+    FoldOperand ProgramOptimizer::FoldExpression(const CompiledStatement &a_statement, int &a_nextPos)
+        a_statement --> The statement containing the expression
+        a_nextPos --> The position at which the expression starts. Set to the position of the element after the expression
+
+ DESCRIPTION
+    The ExpressionWalker walks the expression as it does for the ExpressionEvaluator, so it throws where the evaluation would throw, but
+    the operands that it hands over are values that may be unknown: numbers are constant, variables and array elements are not.
+
+ RETURNS
+    The expression as an operand
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+FoldOperand ProgramOptimizer::FoldExpression(const CompiledStatement &a_statement, int &a_nextPos) {
+    size_t numberBase = m_numberStack.size();
+    m_walker.Walk(a_statement, a_nextPos);
+    FoldOperand result = m_numberStack.back();
+    m_numberStack.resize(numberBase);
+    return result;
+}/** FoldOperand ProgramOptimizer::FoldExpression(const CompiledStatement &a_statement, int &a_nextPos) **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition)
+
+ NAME
+    WalkArrayElement - Replaces the index at the top of the number stack with the array element it indexes
+
+ SYNOPSIS
+    void ProgramOptimizer::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition)
+        a_array --> The token of the name of the array
+        a_position --> The position of the name of the array
+        a_closePosition --> The position of the ']' character after the index
+
+ DESCRIPTION
+    The value of an array element is never constant, but the constant subexpressions of its index are its parts.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition) {
+    FoldOperand element;
+    element.m_first = a_position;
+    element.m_last = a_closePosition;
+    element.m_isSingleToken = false;
+    AddFoldedSpans(m_numberStack.back(), element.m_parts);
+    m_numberStack.back() = element;
+}/** void ProgramOptimizer::WalkArrayElement(const Token &a_array, int a_position, int a_closePosition) **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount)
+
+ NAME
+    ApplyOperator - Applies an operator to the operands at the top of the number stack
+
+ SYNOPSIS
+    void ProgramOptimizer::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount)
+        a_operator --> The operator that the ExpressionWalker popped off its operator stack
+        a_position --> The position of the token of the operator
+        a_numberCount --> The number of operands that the expression has pushed
+
+ DESCRIPTION
+    This is ExpressionEvaluator::ApplyOperator with operands whose values may be unknown. The result is constant if all the operands are,
+    and covers the tokens of the operator and of its operands. If it is not constant, the constant subexpressions of its operands are its
+    parts. A parenthesis cannot be applied, so the statement is not folded.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount) {
+    //parentheses cannot be evaluated
+    if(a_operator == ExpressionOperator::OpenParenthesis || a_operator == ExpressionOperator::CloseParenthesis) {
+        throw DuckInterpreterException("Invalid Arithmetic Expression");
+    }
+
+    FoldOperand result;
+    result.m_isSingleToken = false;
+    if(OperatorArity(a_operator) == 1) {
+        const FoldOperand &operand = m_numberStack.back();
+        result.m_isConstant = operand.m_isConstant;
+        if(result.m_isConstant) {
+            EvaluateExpressionOperator(a_operator, result.m_value, operand.m_value);
+        }
+        result.m_first = a_position;
+        result.m_last = operand.m_last;
+        AddFoldedSpans(operand, result.m_parts);
+        m_numberStack.back() = result;
+        return;
+    }
+
+    const FoldOperand &left = m_numberStack[m_numberStack.size() - 2];
+    const FoldOperand &right = m_numberStack.back();
+    result.m_isConstant = left.m_isConstant && right.m_isConstant;
+    if(result.m_isConstant) {
+        EvaluateExpressionOperator(a_operator, result.m_value, left.m_value, right.m_value);
+    }
+    result.m_first = left.m_first;
+    result.m_last = right.m_last;
+    AddFoldedSpans(left, result.m_parts);
+    AddFoldedSpans(right, result.m_parts);
+    m_numberStack.pop_back();
+    m_numberStack.back() = result;
+}/** void ProgramOptimizer::ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount) **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::CloseParentheses(int a_openPosition, int a_closePosition)
+
+ NAME
+    CloseParentheses - Extends the operand at the top of the number stack over the parentheses around it
+
+ SYNOPSIS
+    void ProgramOptimizer::CloseParentheses(int a_openPosition, int a_closePosition)
+        a_openPosition --> The position of the '('
+        a_closePosition --> The position of the ')'
+
+ DESCRIPTION
+    A pair of parentheses turns the operand inside it into an operand that covers the parentheses too, so that a constant one is folded
+    along with its parentheses (a single number in parentheses is an error). Its parts are kept as they are, since the operand itself
+    is only folded along with the parentheses. The parentheses of the condition of an if statement are never folded.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::CloseParentheses(int a_openPosition, int a_closePosition) {
+    FoldOperand &inside = m_numberStack.back();
+    if(inside.m_first != a_openPosition + 1 || inside.m_last != a_closePosition - 1) {
+        throw DuckInterpreterException("Invalid arithmetic expression.");
+    }
+    if(inside.m_isConstant && a_openPosition == m_conditionParenthesis) {
+        inside.m_isConstant = false;
+    }
+    inside.m_first = a_openPosition;
+    inside.m_last = a_closePosition;
+    inside.m_isSingleToken = false;
+}/** void ProgramOptimizer::CloseParentheses(int a_openPosition, int a_closePosition) **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::AddFoldedSpans(const FoldOperand &a_operand, vector<FoldedSpan> &a_spans)
+
+ NAME
+    AddFoldedSpans - Adds the spans of an operand that are worth folding
+
+ SYNOPSIS
+    void ProgramOptimizer::AddFoldedSpans(const FoldOperand &a_operand, vector<FoldedSpan> &a_spans)
+        a_operand --> The operand
+        a_spans --> The spans that the spans of the operand are added to, in the order of their tokens
+
+ DESCRIPTION
+    A constant operand is folded as a whole, unless it is a single number already. Otherwise the constant subexpressions within it are.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::AddFoldedSpans(const FoldOperand &a_operand, vector<FoldedSpan> &a_spans) {
+    if(a_operand.m_isConstant) {
+        if(!a_operand.m_isSingleToken) {
+            a_spans.push_back({a_operand.m_first, a_operand.m_last, a_operand.m_value});
+        }
+        return;
+    }
+    a_spans.insert(a_spans.end(), a_operand.m_parts.begin(), a_operand.m_parts.end());
+}/** void ProgramOptimizer::AddFoldedSpans(const FoldOperand &a_operand, vector<FoldedSpan> &a_spans) **/
+
+
+
+/**/
+/*
+ void ProgramOptimizer::FindLoopInvariantAssignments(const ControlFlowGraph &a_graph)
+
+ NAME
+    FindLoopInvariantAssignments - Marks the assignments whose value does not change while a loop runs
+
+ SYNOPSIS
+    void ProgramOptimizer::FindLoopInvariantAssignments(const ControlFlowGraph &a_graph)
+        a_graph --> The control flow graph of the program
+
+ DESCRIPTION
+    An assignment of a variable in a natural loop is loop invariant (limit = n * n - 1;) if its expression is made of numbers and
+    variables only, and if no statement of the loop assigns any of those variables, or assigns the variable of the assignment but the
+    assignment itself. Every iteration of the loop then assigns the very same value. Array elements are never part of a loop invariant
+    expression, since the elements that a loop stores are not known before it runs.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void ProgramOptimizer::FindLoopInvariantAssignments(const ControlFlowGraph &a_graph) {
+    const vector<BasicBlock> &blocks = a_graph.GetBlocks();
+    for(const NaturalLoop &loop : a_graph.GetLoops()) {
+        //how many statements of the loop assign every variable
+        vector<int> assignmentCount(m_statements.GetIdentifierCount(), 0);
+        for(int blockNum : loop.m_blocks) {
+            for(int statementNum = blocks[blockNum].m_firstStatement; statementNum <= blocks[blockNum].m_lastStatement; statementNum++) {
+                for(int slot : GetAssignedVariables(m_statements.GetStatement(statementNum))) {
+                    assignmentCount[slot]++;
+                }
+            }
+        }
+
+        for(int blockNum : loop.m_blocks) {
+            for(int statementNum = blocks[blockNum].m_firstStatement; statementNum <= blocks[blockNum].m_lastStatement; statementNum++) {
+                const CompiledStatement &statement = m_statements.GetStatement(statementNum);
+                vector<int> operands;
+                if(statement.m_isLoopInvariant || !ReadVariableAssignment(statement, operands) ||
+                   assignmentCount[statement.m_tokens[0].m_identifierId] != 1) {
+                    continue;
+                }
+                bool isInvariant = true;
+                for(int slot : operands) {
+                    isInvariant = isInvariant && assignmentCount[slot] == 0;
+                }
+                if(isInvariant) {
+                    m_statements.MarkLoopInvariant(statementNum);
+                    int headerLine = blocks[loop.m_header].m_firstStatement + 1;
+                    m_changes.push_back(make_pair(statementNum, "loop invariant in the loop at line " + to_string(headerLine)));
+                    m_invariantCount++;
+                }
+            }
+        }
+    }
+}/** void ProgramOptimizer::FindLoopInvariantAssignments(const ControlFlowGraph &a_graph) **/
+
+
+
+/**/
+/*
+ vector<int> ProgramOptimizer::GetAssignedVariables(const CompiledStatement &a_statement)
+
+ NAME
+    GetAssignedVariables - Returns the variables that a statement assigns
+
+ SYNOPSIS
+    vector<int> ProgramOptimizer::GetAssignedVariables(const CompiledStatement &a_statement)
+        a_statement --> The statement
+
+ DESCRIPTION
+    An arithmetic statement assigns the variable at its start, unless it stores an array element. Every name in a read statement is
+    taken to be assigned (the names in the index of an array element are only read, but it does no harm to err on that side).
+
+ RETURNS
+    The identifier ids of the variables
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+vector<int> ProgramOptimizer::GetAssignedVariables(const CompiledStatement &a_statement) {
+    const TokenList &tokens = a_statement.m_tokens;
+    vector<int> variables;
+    if(a_statement.m_type == StatementType::ArithmeticStat) {
+        if(!tokens.empty() && tokens[0].m_type == TokenType::Identifier && (tokens.size() < 2 || !tokens[1].IsOperator(OperatorCode::OpenBracket))) {
+            variables.push_back(tokens[0].m_identifierId);
+        }
+    } else if(a_statement.m_type == StatementType::ReadStat) {
+        for(const Token &token : tokens) {
+            if(token.m_type == TokenType::Identifier) {
+                variables.push_back(token.m_identifierId);
+            }
+        }
+    }
+    return variables;
+}/** vector<int> ProgramOptimizer::GetAssignedVariables(const CompiledStatement &a_statement) **/
+
+
+
+/**/
+/*
+ bool ProgramOptimizer::ReadVariableAssignment(const CompiledStatement &a_statement, vector<int> &a_operands)
+
+ NAME
+    ReadVariableAssignment - Recognizes the assignment of an expression of numbers and variables to a variable
+
+ SYNOPSIS
+    bool ProgramOptimizer::ReadVariableAssignment(const CompiledStatement &a_statement, vector<int> &a_operands)
+        a_statement --> The statement
+        a_operands --> Set to the variables that the expression reads, each once
+
+ DESCRIPTION
+    The statement must be "<variable> = <expression>;", where the expression is made of numbers, variables and arithmetic operators
+    (parentheses included), and does not read the variable that it is assigned to.
+
+ RETURNS
+    True if the statement is such an assignment, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool ProgramOptimizer::ReadVariableAssignment(const CompiledStatement &a_statement, vector<int> &a_operands) {
+    const TokenList &tokens = a_statement.m_tokens;
+    int tokenCount = static_cast<int>(tokens.size());
+    if(a_statement.m_type != StatementType::ArithmeticStat || !a_statement.m_lexErrorMessage.empty() || tokenCount < 4 ||
+       tokens[0].m_type != TokenType::Identifier || !tokens[1].IsOperator(OperatorCode::Assign) ||
+       !tokens[tokenCount - 1].IsOperator(OperatorCode::Semicolon)) {
+        return false;
+    }
+    for(int position = 2; position < tokenCount - 1; position++) {
+        const Token &token = tokens[position];
+        if(token.m_type == TokenType::Identifier) {
+            if(token.m_identifierId == tokens[0].m_identifierId || tokens[position + 1].IsOperator(OperatorCode::OpenBracket)) {
+                return false;
+            }
+            if(find(a_operands.begin(), a_operands.end(), token.m_identifierId) == a_operands.end()) {
+                a_operands.push_back(token.m_identifierId);
+            }
+        } else if(token.m_type != TokenType::Number && !token.IsArithmeticOperator()) {
+            return false;
+        }
+    }
+    return true;
+}/** bool ProgramOptimizer::ReadVariableAssignment(const CompiledStatement &a_statement, vector<int> &a_operands) **/
+
+
+
+/**/
+/*
+ string ProgramOptimizer::NumberText(double a_number)
+
+ NAME
+    NumberText - Returns the shortest text of a number that reads back as the same number
+
+ SYNOPSIS
+    string ProgramOptimizer::NumberText(double a_number)
+        a_number --> The number
+
+ DESCRIPTION
+    Used to report the values that subexpressions are folded to. Whole numbers are written without an exponent
+
+ RETURNS
+    The text of the number
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+string ProgramOptimizer::NumberText(double a_number) {
+    char text[64];
+    if(a_number == floor(a_number) && fabs(a_number) < 1e15) {
+        snprintf(text, sizeof(text), "%.0f", a_number);
+        return text;
+    }
+    for(int precision = 1; precision <= 17; precision++) {
+        snprintf(text, sizeof(text), "%.*g", precision, a_number);
+        if(strtod(text, nullptr) == a_number) {
+            break;
+        }
+    }
+    return text;
+}/** string ProgramOptimizer::NumberText(double a_number) **/
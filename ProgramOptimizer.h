@@ -0,0 +1,139 @@
+/* ProgramOptimizer.h
+ ProgramOptimizer.h contains the ProgramOptimizer class
+ ProgramOptimizer is the class that optimizes the statements of a Duck program once they have been recorded, before any engine runs
+ them. It prunes the statements that no path through the program can reach (such as the statements after a goto or a stop that are
+ never labelled), folds the constant subexpressions of arithmetic statements and if conditions (x = 60 * 60 * 24;) into single
+ numbers, and marks the assignments in loops whose value does not change from one iteration to the next. Folding walks the tokens of
+ a statement exactly as the DuckInterpreter evaluates them, with the same ExpressionWalker, but with the values of the variables and
+ array elements unknown, and evaluates the operators with the same EvaluateExpressionOperator. A statement in which the walk finds a syntax error is left as it
+ is, so the errors of the program, and the lines they are reported against, do not change.
+*/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Statement.h"
+#include "Token.h"
+#include "ExpressionOperator.h"
+#include "ExpressionWalker.h"
+#include "ControlFlowGraph.h"
+
+//A constant subexpression of a statement that is folded into a single number
+struct FoldedSpan
+{
+    //the positions of the first and the last token of the subexpression
+    int m_first = 0;
+    int m_last = 0;
+
+    //the value of the subexpression
+    double m_value = 0;
+};
+
+//An operand on the number stack of the symbolic evaluation of an arithmetic expression
+struct FoldOperand
+{
+    //true if the value of the operand is known before the program runs
+    bool m_isConstant = false;
+    double m_value = 0;
+
+    //the positions of the first and the last token of the operand (parentheses around it included)
+    int m_first = 0;
+    int m_last = 0;
+
+    //true if the operand is a single number or variable, which there is nothing to gain from folding
+    bool m_isSingleToken = true;
+
+    //the constant subexpressions within the operand that can be folded if the operand itself is not constant
+    std::vector<FoldedSpan> m_parts;
+};
+
+class ProgramOptimizer
+{
+public:
+    ProgramOptimizer(Statement &a_statements) : m_statements(a_statements), m_walker(*this) {}
+    ~ProgramOptimizer() {}
+
+    //Prunes the unreachable statements, folds the constant subexpressions of the others and finds the loop invariant assignments
+    void Optimize();
+
+    //Writes what Optimize removed, folded and found, statement by statement
+    void WriteReport(std::ostream &a_stream) const;
+
+private:
+    //The walker hands the numbers, the variables and the operators of an expression to the optimizer
+    friend class ExpressionWalker<ProgramOptimizer>;
+
+    //The statements being optimized
+    Statement &m_statements;
+
+    //What was done to the statements, for the report: the statement and the description of the change
+    std::vector<std::pair<int, std::string>> m_changes;
+    int m_foldCount = 0;
+    int m_unreachableCount = 0;
+    int m_invariantCount = 0;
+
+    //The position of the parenthesis that encloses the condition of the if statement being folded, -1 for other statements. The
+    //condition as a whole is never folded, so that every if statement keeps its parentheses
+    int m_conditionParenthesis = -1;
+
+    //Walks the expressions that are folded, and the number stack of their symbolic evaluation
+    ExpressionWalker<ProgramOptimizer> m_walker;
+    std::vector<FoldOperand> m_numberStack;
+
+    //Marks every statement that no path from the first statement reaches as Unreachable
+    void PruneUnreachableStatements(const ControlFlowGraph &a_graph);
+
+    //Marks the assignments of variables in loops that assign the same value in every iteration
+    void FindLoopInvariantAssignments(const ControlFlowGraph &a_graph);
+
+    //Returns the variables that a statement assigns
+    static std::vector<int> GetAssignedVariables(const CompiledStatement &a_statement);
+
+    //Recognizes "<variable> = <expression of numbers and other variables>;". Sets a_operands to the variables of the expression
+    static bool ReadVariableAssignment(const CompiledStatement &a_statement, std::vector<int> &a_operands);
+
+    //Folds the constant subexpressions of an arithmetic statement or an if statement
+    void FoldStatement(int a_statementNum);
+
+    //Walks the arithmetic expression that starts at a_nextPos as EvaluateArithmeticExpression does, and returns it as an operand.
+    //Throws a DuckInterpreterException where the evaluation would find a syntax error
+    FoldOperand FoldExpression(const CompiledStatement &a_statement, int &a_nextPos);
+
+    //Retrieves the next element of a statement, for the ExpressionWalker
+    int ParseNextElement(const CompiledStatement &a_statement, int a_nextPos, Token &a_token) {
+        return a_statement.ParseNextElement(a_nextPos, a_token);
+    }
+
+    //Pushes a number, which is constant
+    void WalkNumber(const Token &a_number, int a_position) {
+        FoldOperand number;
+        number.m_isConstant = true;
+        number.m_value = a_number.m_numValue;
+        number.m_first = number.m_last = a_position;
+        m_numberStack.push_back(number);
+    }
+
+    //Pushes a variable, whose value is unknown
+    void WalkVariable(const Token &a_variable, int a_position) {
+        FoldOperand variable;
+        variable.m_first = variable.m_last = a_position;
+        m_numberStack.push_back(variable);
+    }
+
+    //Replaces the index at the top of the number stack with the array element it indexes
+    void WalkArrayElement(const Token &a_array, int a_position, int a_closePosition);
+
+    //Applies an operator to the operands at the top of the number stack as ExpressionEvaluator::ApplyOperator does
+    void ApplyOperator(ExpressionOperator a_operator, int a_position, int a_numberCount);
+
+    //Extends the operand at the top of the number stack over the parentheses around it
+    void CloseParentheses(int a_openPosition, int a_closePosition);
+
+    //Adds the spans of an operand that are worth folding: the operand itself if it is a constant subexpression, its parts otherwise
+    static void AddFoldedSpans(const FoldOperand &a_operand, std::vector<FoldedSpan> &a_spans);
+
+    //Returns the shortest text that reads back as the given number, for the report
+    static std::string NumberText(double a_number);
+};
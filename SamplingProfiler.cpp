@@ -0,0 +1,236 @@
+#include "SamplingProfiler.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+
+using namespace std;
+
+//The profiler whose samples are written when the program exits
+static SamplingProfiler *s_activeProfiler = nullptr;
+
+//The sample counts of the active profiler and the number of statements they are for, for the signal handler
+static uint32_t *s_sampleCounts = nullptr;
+static int s_statementCount = 0;
+
+//The names of the phases, as they appear in the folded stacks
+static const char *const k_phaseNames[k_executionPhaseCount] = {"interpreter", "lexing", "evaluation", "symbol_lookup", "array_access", "io"};
+
+//Writes the samples of the active profiler. Registered with atexit
+static void FinishActiveProfiler() {
+    if(s_activeProfiler != nullptr) {
+        s_activeProfiler->Finish();
+    }
+}
+
+//Returns the given statement as a folded stack frame: ';' separates frames, so the final ';' is dropped and any other is replaced, and
+//line breaks are removed
+static string ToFrame(string_view a_text) {
+    if(!a_text.empty() && a_text.back() == ';') {
+        a_text.remove_suffix(1);
+    }
+    string frame(a_text);
+    for(size_t i = 0; i < frame.length(); i++) {
+        if(frame[i] == ';') {
+            frame[i] = ',';
+        } else if(frame[i] == '\n' || frame[i] == '\r') {
+            frame[i] = ' ';
+        }
+    }
+    return frame;
+}
+
+
+/**/
+/*
+ SamplingProfiler::SamplingProfiler(const Statement &a_statements, const string &a_fileName)
+
+ NAME
+    SamplingProfiler::SamplingProfiler - Creates a sampling profiler for the statements of a Duck program
+
+ SYNOPSIS
+    SamplingProfiler::SamplingProfiler(const Statement &a_statements, const string &a_fileName)
+        a_statements --> The recorded statements of the program to be profiled
+        a_fileName --> The file that the folded stacks are to be written to
+
+ DESCRIPTION
+    Makes room for the sample counts of every statement and phase, so that the signal handler never has to allocate.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+SamplingProfiler::SamplingProfiler(const Statement &a_statements, const string &a_fileName)
+    : m_statements(a_statements), m_fileName(a_fileName), m_sampleCounts((a_statements.GetStatementCount() + 1) * k_executionPhaseCount) {
+}/** SamplingProfiler::SamplingProfiler(const Statement &a_statements, const string &a_fileName) **/
+
+
+
+/**/
+/*
+ void SamplingProfiler::Start()
+
+ NAME
+    SamplingProfiler::Start - Starts taking samples
+
+ SYNOPSIS
+    void SamplingProfiler::Start()
+
+ DESCRIPTION
+    Installs the SIGPROF handler and starts the profiling timer, and makes sure that the samples are written when the program exits,
+    however it exits. The handler restarts interrupted system calls, so the reads and writes of the program are not disturbed. If the
+    timer cannot be started, the program runs without being profiled.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SamplingProfiler::Start() {
+    s_activeProfiler = this;
+    s_sampleCounts = m_sampleCounts.data();
+    s_statementCount = m_statements.GetStatementCount();
+    atexit(FinishActiveProfiler);
+
+    struct sigaction action = {};
+    action.sa_handler = TakeSample;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    struct itimerval timer = {};
+    timer.it_interval.tv_usec = k_sampleIntervalMicroseconds;
+    timer.it_value.tv_usec = k_sampleIntervalMicroseconds;
+    if(sigaction(SIGPROF, &action, nullptr) != 0 || setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        cerr << "Could not start the sampling profiler" << endl;
+    }
+}/** void SamplingProfiler::Start() **/
+
+
+
+/**/
+/*
+ void SamplingProfiler::TakeSample(int a_signal)
+
+ NAME
+    SamplingProfiler::TakeSample - Counts a sample
+
+ SYNOPSIS
+    void SamplingProfiler::TakeSample(int a_signal)
+        a_signal --> The signal that was received (SIGPROF)
+
+ DESCRIPTION
+    The handler of SIGPROF. Counts a sample for the statement that the interpreter is executing and the phase that it is in. It only
+    reads the two volatile variables and increments a count that was allocated beforehand, so it is safe to run in a signal handler.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SamplingProfiler::TakeSample(int /*a_signal*/) {
+    int statementNum = s_currentStatement;
+    if(statementNum < 0 || statementNum >= s_statementCount) {
+        statementNum = s_statementCount;
+    }
+    s_sampleCounts[statementNum * k_executionPhaseCount + static_cast<int>(ExecutionPhaseScope::GetCurrentPhase())]++;
+}/** void SamplingProfiler::TakeSample(int a_signal) **/
+
+
+
+/**/
+/*
+ void SamplingProfiler::Finish()
+
+ NAME
+    SamplingProfiler::Finish - Stops taking samples and writes the folded stacks
+
+ SYNOPSIS
+    void SamplingProfiler::Finish()
+
+ DESCRIPTION
+    Stops the profiling timer, then writes one line for every statement and phase that was sampled: the frames of the statement, the
+    phase and the number of samples. Samples taken outside of any statement (such as while the output is written at exit) are written
+    under an "(interpreter)" frame.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SamplingProfiler::Finish() {
+    if(m_finished) {
+        return;
+    }
+    m_finished = true;
+    struct itimerval timer = {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    signal(SIGPROF, SIG_IGN);
+
+    ofstream file(m_fileName);
+    if(!file) {
+        cerr << "Could not write the profile to the file: " << m_fileName << endl;
+        return;
+    }
+    vector<string> frames = GetStatementFrames();
+    frames.push_back("(interpreter)");
+    for(size_t statementNum = 0; statementNum < frames.size(); statementNum++) {
+        for(int phase = 0; phase < k_executionPhaseCount; phase++) {
+            uint32_t count = m_sampleCounts[statementNum * k_executionPhaseCount + phase];
+            if(count != 0) {
+                file << frames[statementNum] << ";" << k_phaseNames[phase] << " " << count << "\n";
+            }
+        }
+    }
+}/** void SamplingProfiler::Finish() **/
+
+
+
+/**/
+/*
+ vector<string> SamplingProfiler::GetStatementFrames() const
+
+ NAME
+    SamplingProfiler::GetStatementFrames - Returns the folded stack frames of every statement
+
+ SYNOPSIS
+    vector<string> SamplingProfiler::GetStatementFrames() const
+
+ DESCRIPTION
+    A Duck program has no functions, so the closest thing to the caller of a statement is the label that it comes under: the last
+    label at or before the statement. The frames of a statement are that label ("(start)" before the first label) and the line number
+    and text of the statement.
+
+ RETURNS
+    The frames of every statement, separated by ';', indexed by line number
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+vector<string> SamplingProfiler::GetStatementFrames() const {
+    int statementCount = m_statements.GetStatementCount();
+    vector<string> labels(statementCount);
+    const map<string, int> &labelToStatement = m_statements.GetLabels();
+    for(map<string, int>::const_iterator it = labelToStatement.begin(); it != labelToStatement.end(); it++) {
+        labels[it->second] = it->first;
+    }
+
+    vector<string> frames(statementCount);
+    string enclosingLabel = "(start)";
+    for(int i = 0; i < statementCount; i++) {
+        if(!labels[i].empty()) {
+            enclosingLabel = labels[i];
+        }
+        frames[i] = enclosingLabel + ";" + to_string(i + 1) + ": " + ToFrame(m_statements.GetStatement(i).m_text);
+    }
+    return frames;
+}/** vector<string> SamplingProfiler::GetStatementFrames() const **/
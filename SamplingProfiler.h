@@ -0,0 +1,60 @@
+/* SamplingProfiler.h
+ SamplingProfiler.h contains the SamplingProfiler class
+ SamplingProfiler is the class that profiles a Duck program by sampling (with the --sample-profile option). A profiling timer
+ (setitimer with ITIMER_PROF) interrupts the program every millisecond of processor time, and the SIGPROF handler counts a sample
+ for the statement that the interpreter is executing and the phase that it is in (see ExecutionPhase.h). The interpreter only has to
+ store the number of every statement it executes, so a long run is barely slowed down.
+ When the program exits, the samples are written as folded stacks (one "frame;frame;frame count" line per distinct stack), which flame
+ graph tools read. The frames of a stack are the label that the statement comes under, the statement and the phase.
+*/
+
+#pragma once
+
+#include <csignal>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ExecutionPhase.h"
+#include "Statement.h"
+
+class SamplingProfiler
+{
+public:
+    SamplingProfiler(const Statement &a_statements, const std::string &a_fileName);
+    ~SamplingProfiler() {}
+
+    //Starts taking samples. The folded stacks are written when the program exits
+    void Start();
+
+    //Records the statement that the interpreter is about to execute
+    static void SetCurrentStatement(int a_statementNum) { s_currentStatement = a_statementNum; }
+
+    //Stops taking samples and writes the folded stacks
+    void Finish();
+
+private:
+    //The processor time between two samples
+    static const int k_sampleIntervalMicroseconds = 1000;
+
+    //The statement that the interpreter is executing, or -1 before the first statement
+    static inline volatile std::sig_atomic_t s_currentStatement = -1;
+
+    //The statements of the program being profiled
+    const Statement &m_statements;
+
+    //The file that the folded stacks are written to
+    std::string m_fileName;
+
+    //The number of samples for every statement and phase, k_executionPhaseCount per statement. The last k_executionPhaseCount
+    //counts are for the samples taken outside of any statement
+    std::vector<uint32_t> m_sampleCounts;
+
+    //Set once the folded stacks have been written
+    bool m_finished = false;
+
+    //Counts a sample for the current statement and phase. This is the handler of SIGPROF
+    static void TakeSample(int a_signal);
+
+    //Returns the folded stack frames of every statement: the label that it comes under and the statement itself
+    std::vector<std::string> GetStatementFrames() const;
+};
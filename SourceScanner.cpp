@@ -0,0 +1,449 @@
+#include "SourceScanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DUCK_X86_SIMD 1
+#endif
+
+using namespace std;
+
+//A function that sets one bit in each mask for every '"', '/', ':' and new line character (respectively) of a block of 64 characters
+typedef void (*BlockClassifier)(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines);
+
+
+/**/
+/*
+ static void ClassifyBlockScalar(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines)
+
+ NAME
+    ClassifyBlockScalar - Finds the scanned characters of a block one character at a time
+
+ SYNOPSIS
+    static void ClassifyBlockScalar(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines)
+        a_block --> The 64 characters to be classified
+        a_quotes --> Set to a mask of the '"' characters of the block
+        a_slashes --> Set to a mask of the '/' characters of the block
+        a_colons --> Set to a mask of the ':' characters of the block
+        a_newLines --> Set to a mask of the new line characters of the block
+
+ DESCRIPTION
+    This is the fallback for processors without SSE2. Bit i of every mask stands for character i of the block.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static void ClassifyBlockScalar(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines) {
+    a_quotes = a_slashes = a_colons = a_newLines = 0;
+    for(int i = 0; i < 64; i++) {
+        uint64_t bit = uint64_t(1) << i;
+        switch(a_block[i]) {
+            case '\"': a_quotes |= bit; break;
+            case '/': a_slashes |= bit; break;
+            case ':': a_colons |= bit; break;
+            case '\n': a_newLines |= bit; break;
+            default: break;
+        }
+    }
+}/** static void ClassifyBlockScalar(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines) **/
+
+
+#ifdef DUCK_X86_SIMD
+
+/**/
+/*
+ static void ClassifyBlockSse2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines)
+
+ NAME
+    ClassifyBlockSse2 - Finds the scanned characters of a block 16 characters at a time with SSE2 instructions
+
+ SYNOPSIS
+    static void ClassifyBlockSse2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines)
+        a_block --> The 64 characters to be classified
+        a_quotes --> Set to a mask of the '"' characters of the block
+        a_slashes --> Set to a mask of the '/' characters of the block
+        a_colons --> Set to a mask of the ':' characters of the block
+        a_newLines --> Set to a mask of the new line characters of the block
+
+ DESCRIPTION
+    Every 16 characters of the block are compared against each of the four characters at once, and the results of the comparisons
+    are gathered into the masks with movemask.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+__attribute__((target("sse2")))
+static void ClassifyBlockSse2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines) {
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i newLine = _mm_set1_epi8('\n');
+
+    a_quotes = a_slashes = a_colons = a_newLines = 0;
+    for(int part = 0; part < 4; part++) {
+        __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a_block + part * 16));
+        a_quotes |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(characters, quote)))) << (part * 16);
+        a_slashes |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(characters, slash)))) << (part * 16);
+        a_colons |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(characters, colon)))) << (part * 16);
+        a_newLines |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(characters, newLine)))) << (part * 16);
+    }
+}/** static void ClassifyBlockSse2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines) **/
+
+
+
+/**/
+/*
+ static void ClassifyBlockAvx2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines)
+
+ NAME
+    ClassifyBlockAvx2 - Finds the scanned characters of a block 32 characters at a time with AVX2 instructions
+
+ SYNOPSIS
+    static void ClassifyBlockAvx2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines)
+        a_block --> The 64 characters to be classified
+        a_quotes --> Set to a mask of the '"' characters of the block
+        a_slashes --> Set to a mask of the '/' characters of the block
+        a_colons --> Set to a mask of the ':' characters of the block
+        a_newLines --> Set to a mask of the new line characters of the block
+
+ DESCRIPTION
+    The same as ClassifyBlockSse2, but with two halves of 32 characters.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+__attribute__((target("avx2")))
+static void ClassifyBlockAvx2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines) {
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i newLine = _mm256_set1_epi8('\n');
+
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_block));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_block + 32));
+    a_quotes = uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, quote))))
+             | uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, quote)))) << 32;
+    a_slashes = uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, slash))))
+              | uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, slash)))) << 32;
+    a_colons = uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, colon))))
+             | uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, colon)))) << 32;
+    a_newLines = uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newLine))))
+               | uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newLine)))) << 32;
+}/** static void ClassifyBlockAvx2(const char *a_block, uint64_t &a_quotes, uint64_t &a_slashes, uint64_t &a_colons, uint64_t &a_newLines) **/
+
+#endif
+
+
+/**/
+/*
+ static BlockClassifier FindBlockClassifier(string_view a_instructionSet)
+
+ NAME
+    FindBlockClassifier - Returns the function that classifies a block with the given instruction set
+
+ SYNOPSIS
+    static BlockClassifier FindBlockClassifier(string_view a_instructionSet)
+        a_instructionSet --> "avx2", "sse2" or "scalar"
+
+ DESCRIPTION
+    Checks, at run time, that the processor supports the instruction set.
+
+ RETURNS
+    The function that uses the instruction set, or nullptr if the name is not one of the above or the processor does not support it
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static BlockClassifier FindBlockClassifier(string_view a_instructionSet) {
+#ifdef DUCK_X86_SIMD
+    __builtin_cpu_init();
+    if(a_instructionSet == "avx2") {
+        return __builtin_cpu_supports("avx2") ? ClassifyBlockAvx2 : nullptr;
+    }
+    if(a_instructionSet == "sse2") {
+        return __builtin_cpu_supports("sse2") ? ClassifyBlockSse2 : nullptr;
+    }
+#endif
+    if(a_instructionSet == "scalar") {
+        return ClassifyBlockScalar;
+    }
+    return nullptr;
+}/** static BlockClassifier FindBlockClassifier(string_view a_instructionSet) **/
+
+//The instruction sets, from the best to the worst
+static const char *const k_instructionSets[] = {"avx2", "sse2", "scalar"};
+
+//The name of the instruction set used by s_classifyBlock
+static const char *s_instructionSet = "scalar";
+
+//The function used to classify the blocks of the source. It is the one that uses the best instruction set of the processor, unless
+//SetInstructionSet chooses another one
+static BlockClassifier s_classifyBlock = ClassifyBlockScalar;
+
+
+
+/**/
+/*
+ static bool SelectBestInstructionSet()
+
+ NAME
+    SelectBestInstructionSet - Chooses the fastest way to classify a block on this processor
+
+ SYNOPSIS
+    static bool SelectBestInstructionSet()
+
+ DESCRIPTION
+    Sets s_classifyBlock to the function that uses the best instruction set that the processor supports. It is called once when the
+    program starts.
+
+ RETURNS
+    True
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static bool SelectBestInstructionSet() {
+    for(const char *instructionSet : k_instructionSets) {
+        if(SourceScanner::SetInstructionSet(instructionSet)) {
+            break;
+        }
+    }
+    return true;
+}/** static bool SelectBestInstructionSet() **/
+
+static const bool k_instructionSetSelected = SelectBestInstructionSet();
+
+//Returns a mask of the bits below the given bit
+static inline uint64_t BitsBelow(int a_bit) {
+    return (uint64_t(1) << a_bit) - 1;
+}
+
+
+
+/**/
+/*
+ const char *SourceScanner::GetInstructionSet()
+
+ NAME
+    SourceScanner::GetInstructionSet - Returns the name of the instruction set used to scan the source
+
+ SYNOPSIS
+    const char *SourceScanner::GetInstructionSet()
+
+ DESCRIPTION
+    Returns the name of the instruction set that was chosen for this processor when the program started, or by SetInstructionSet.
+
+ RETURNS
+    "avx2", "sse2" or "scalar"
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+const char *SourceScanner::GetInstructionSet() {
+    return s_instructionSet;
+}/** const char *SourceScanner::GetInstructionSet() **/
+
+
+
+/**/
+/*
+ bool SourceScanner::SetInstructionSet(std::string_view a_instructionSet)
+
+ NAME
+    SourceScanner::SetInstructionSet - Chooses the instruction set used to scan the source
+
+ SYNOPSIS
+    bool SourceScanner::SetInstructionSet(std::string_view a_instructionSet)
+        a_instructionSet --> "avx2", "sse2" or "scalar"
+
+ DESCRIPTION
+    Makes every scanner classify its blocks with the given instruction set instead of the best one of the processor, so that each of
+    the three ways of classifying a block can be tested on any processor that supports it. It must be called before the source is
+    scanned. Nothing is changed if the processor does not support the instruction set.
+
+ RETURNS
+    True if the instruction set is used from now on. False if the name is not one of the above or the processor does not support it
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SourceScanner::SetInstructionSet(string_view a_instructionSet) {
+    BlockClassifier classifyBlock = FindBlockClassifier(a_instructionSet);
+    if(classifyBlock == nullptr) {
+        return false;
+    }
+    for(const char *instructionSet : k_instructionSets) {
+        if(a_instructionSet == instructionSet) {
+            s_instructionSet = instructionSet;
+        }
+    }
+    s_classifyBlock = classifyBlock;
+    return true;
+}/** bool SourceScanner::SetInstructionSet(std::string_view a_instructionSet) **/
+
+
+
+/**/
+/*
+ void SourceScanner::LoadBlock(size_t a_blockStart)
+
+ NAME
+    SourceScanner::LoadBlock - Classifies the characters of a block of the source
+
+ SYNOPSIS
+    void SourceScanner::LoadBlock(size_t a_blockStart)
+        a_blockStart --> The position of the first character of the block
+
+ DESCRIPTION
+    Sets the masks of the scanner to those of the block that starts at the given position. Nothing is done if that block is already
+    the current one. The last block of the source is usually shorter than 64 characters, so it is copied into a block that is padded
+    with characters that are not scanned for.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SourceScanner::LoadBlock(size_t a_blockStart) {
+    if(a_blockStart == m_blockStart) {
+        return;
+    }
+    m_blockStart = a_blockStart;
+    if(a_blockStart + k_blockSize <= m_source.length()) {
+        s_classifyBlock(m_source.data() + a_blockStart, m_quoteMask, m_slashMask, m_colonMask, m_newLineMask);
+    } else {
+        char lastBlock[k_blockSize] = {};
+        m_source.copy(lastBlock, k_blockSize, a_blockStart);
+        s_classifyBlock(lastBlock, m_quoteMask, m_slashMask, m_colonMask, m_newLineMask);
+    }
+}/** void SourceScanner::LoadBlock(size_t a_blockStart) **/
+
+
+
+/**/
+/*
+ bool SourceScanner::NextLine(SourceLine &a_line)
+
+ NAME
+    SourceScanner::NextLine - Finds the next line of the source, along with its comment and its label
+
+ SYNOPSIS
+    bool SourceScanner::NextLine(SourceLine &a_line)
+        a_line --> The line that was found
+
+ DESCRIPTION
+    Goes through the blocks of the line, looking only at the masks of the characters of the line in each block. The end of the line
+    is the first new line character.
+    The comment of the line starts at a "//" pair (pairs are taken from left to right without overlapping) chosen the way Duck has
+    always chosen it: a running total of the number of '"' characters on the line before each pair is kept, and the comment starts at
+    the first pair for which the total is even. Only the parities are kept: the parity of the number of '"' characters before a pair
+    (a population count of the quote mask) is added to the parity of the total at every pair.
+    The label ends at the first ':' of the line before the comment, unless a '"' comes before that ':'.
+
+ RETURNS
+    True if a line was found. False if there are no more lines
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SourceScanner::NextLine(SourceLine &a_line) {
+    if(m_startOfLine >= m_source.length()) {
+        return false;
+    }
+    a_line.m_start = m_startOfLine;
+    a_line.m_end = m_source.length();
+    a_line.m_codeEnd = string_view::npos;
+    a_line.m_labelEnd = string_view::npos;
+
+    bool quoteFound = false;
+    bool colonFound = false;
+    //the parity of the number of '"' characters on the line before the current block, and the parity of the running total at the pairs
+    int quoteParity = 0;
+    int totalParity = 0;
+    //the position of the first '/' that can start a pair (the second '/' of a pair cannot start another one)
+    size_t firstPairStart = m_startOfLine;
+
+    size_t position = m_startOfLine;
+    while(true) {
+        size_t blockStart = position & ~(k_blockSize - 1);
+        LoadBlock(blockStart);
+        //the characters of the line in this block
+        uint64_t lineMask = ~BitsBelow(position - blockStart);
+        uint64_t newLines = m_newLineMask & lineMask;
+        if(newLines != 0) {
+            int endBit = __builtin_ctzll(newLines);
+            a_line.m_end = blockStart + endBit;
+            lineMask &= BitsBelow(endBit);
+        }
+
+        //look for the start of the comment
+        uint64_t quotes = m_quoteMask & lineMask;
+        uint64_t slashes = m_slashMask & lineMask;
+        while(slashes != 0) {
+            int slashBit = __builtin_ctzll(slashes);
+            slashes &= slashes - 1;
+            size_t slashPosition = blockStart + slashBit;
+            if(slashPosition < firstPairStart || slashPosition + 1 >= a_line.m_end || m_source[slashPosition + 1] != '/') {
+                continue;
+            }
+            firstPairStart = slashPosition + 2;
+            totalParity ^= quoteParity ^ (__builtin_popcountll(quotes & BitsBelow(slashBit)) & 1);
+            if(totalParity == 0) {
+                a_line.m_codeEnd = slashPosition;
+                lineMask &= BitsBelow(slashBit);
+                quotes &= lineMask;
+                break;
+            }
+        }
+
+        //look for the end of the label
+        uint64_t colons = m_colonMask & lineMask;
+        if(!colonFound && colons != 0) {
+            int colonBit = __builtin_ctzll(colons);
+            colonFound = true;
+            if(!quoteFound && (quotes & BitsBelow(colonBit)) == 0) {
+                a_line.m_labelEnd = blockStart + colonBit;
+            }
+        }
+
+        quoteFound = quoteFound || quotes != 0;
+        quoteParity ^= __builtin_popcountll(quotes) & 1;
+        if(newLines != 0 || a_line.m_codeEnd != string_view::npos) {
+            break;
+        }
+        position = blockStart + k_blockSize;
+        if(position >= m_source.length()) {
+            break;
+        }
+    }
+
+    //after the comment has started, only the end of the line matters
+    if(a_line.m_codeEnd == string_view::npos) {
+        a_line.m_codeEnd = a_line.m_end;
+    } else if(a_line.m_end == m_source.length()) {
+        size_t endOfLine = m_source.find('\n', a_line.m_codeEnd);
+        if(endOfLine != string_view::npos) {
+            a_line.m_end = endOfLine;
+        }
+    }
+    m_startOfLine = a_line.m_end + 1;
+    return true;
+}/** bool SourceScanner::NextLine(SourceLine &a_line) **/
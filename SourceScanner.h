@@ -0,0 +1,73 @@
+/* SourceScanner.h
+ SourceScanner.h contains the SourceScanner class
+ SourceScanner is the class that splits the source of a Duck program into lines and finds, for every line, where its comment starts
+ and where its label ends. It is used by the Statement class when the program is recorded.
+ The source is scanned in blocks of 64 characters. For every block, the only characters that matter to comments and labels ('"',
+ '/', ':' and the new line character) are found in bulk with SSE2 or AVX2 instructions (whichever the processor supports, with a
+ scalar fallback, or whichever one is chosen with SetInstructionSet) and turned into one bit mask per character. Lines, labels and comments are then found with bit operations on
+ these masks, so the characters of a line are never looked at one at a time unless the line contains a "//".
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//A line of the source of a Duck program. All positions are indices into the source
+struct SourceLine
+{
+    //the position of the first character of the line
+    size_t m_start = 0;
+
+    //the position one past the last character of the line (the position of the new line character, or the end of the source)
+    size_t m_end = 0;
+
+    //the position one past the last character of the line that is not part of a comment
+    size_t m_codeEnd = 0;
+
+    //the position of the ':' that ends the label of the line, or std::string_view::npos if the line has no label. The label ends at the
+    //first ':' of the line (before any comment), provided that there is no '"' before it
+    size_t m_labelEnd = std::string_view::npos;
+};
+
+class SourceScanner
+{
+public:
+    SourceScanner(std::string_view a_source) : m_source(a_source) {}
+    ~SourceScanner() {}
+
+    //Finds the next line of the source. Returns false if there are no more lines
+    bool NextLine(SourceLine &a_line);
+
+    //Returns the name of the instruction set that is used to find the characters ("avx2", "sse2" or "scalar")
+    static const char *GetInstructionSet();
+
+    //Makes the scanners find the characters with the given instruction set ("avx2", "sse2" or "scalar") instead of the best one that
+    //the processor supports. Returns false if the processor does not support it
+    static bool SetInstructionSet(std::string_view a_instructionSet);
+
+private:
+    //The number of characters that are classified at a time
+    static const size_t k_blockSize = 64;
+
+    //The source being scanned
+    std::string_view m_source;
+
+    //The position of the first character of the block whose masks are held below (always a multiple of k_blockSize), or
+    //std::string_view::npos if no block has been classified yet
+    size_t m_blockStart = std::string_view::npos;
+
+    //One bit per character of the current block (the lowest bit is the first character) for each of the characters '"', '/', ':'
+    //and new line. Characters past the end of the source have no bits set
+    uint64_t m_quoteMask = 0;
+    uint64_t m_slashMask = 0;
+    uint64_t m_colonMask = 0;
+    uint64_t m_newLineMask = 0;
+
+    //The position of the first character of the next line
+    size_t m_startOfLine = 0;
+
+    //Classifies the block that starts at the given position, unless it is already the current block
+    void LoadBlock(size_t a_blockStart);
+};
@@ -0,0 +1,1596 @@
+#include "SsaOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+using namespace std;
+
+
+/**/
+/*
+ BytecodeProgram SsaOptimizer::Optimize()
+
+ NAME
+    Optimize - Optimizes the program in SSA form
+
+ SYNOPSIS
+    BytecodeProgram SsaOptimizer::Optimize()
+
+ DESCRIPTION
+    The program is put into SSA form, its constants are propagated, its copies and common subexpressions are found, the values that are
+    always whole numbers are inferred, and the instructions that are still needed are written back as bytecode. A program that the
+    BytecodeCompiler did not leave with an empty stack of numbers between its blocks is returned as it is.
+
+ RETURNS
+    The optimized program
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+BytecodeProgram SsaOptimizer::Optimize() {
+    BuildBlocks();
+    FindDominanceFrontiers();
+    PlacePhis();
+    if(!RenameVariables()) {
+        return m_program;
+    }
+    RemoveTrivialPhis();
+    FindUndefinedValues();
+    PropagateConstants();
+    NumberValues();
+    InferWholeNumbers();
+    EliminateDeadCode();
+    return Lower();
+}/** BytecodeProgram SsaOptimizer::Optimize() **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::BuildBlocks()
+
+ NAME
+    BuildBlocks - Divides the instructions of the program into basic blocks
+
+ SYNOPSIS
+    void SsaOptimizer::BuildBlocks()
+
+ DESCRIPTION
+    A block starts at every instruction that is jumped to and after every jump, stop or error. Block 0 is an entry block with no
+    instructions that continues with the first instruction, so that the first block can have predecessors like any other. Only the
+    blocks that a path from the entry reaches are given to their instructions, and only their edges are kept as predecessors.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::BuildBlocks() {
+    const vector<Instruction> &instructions = m_program.m_instructions;
+    int instructionCount = static_cast<int>(instructions.size());
+    m_instructions.assign(instructionCount, SsaInstruction());
+
+    vector<bool> startsBlock(instructionCount + 1, false);
+    startsBlock[0] = true;
+    for(int instructionNum = 0; instructionNum < instructionCount; instructionNum++) {
+        const Instruction &instruction = instructions[instructionNum];
+        if(instruction.m_opCode == OpCode::Jump || instruction.m_opCode == OpCode::JumpIfFalse) {
+            startsBlock[instruction.m_operand] = true;
+        }
+        if(EndsBlock(instruction.m_opCode)) {
+            startsBlock[instructionNum + 1] = true;
+        }
+    }
+
+    m_blocks.assign(1, SsaBlock());
+    vector<int> blockOfInstruction(instructionCount, -1);
+    for(int instructionNum = 0; instructionNum < instructionCount; instructionNum++) {
+        if(startsBlock[instructionNum]) {
+            SsaBlock block;
+            block.m_first = instructionNum;
+            m_blocks.push_back(block);
+        }
+        m_blocks.back().m_last = instructionNum;
+        blockOfInstruction[instructionNum] = static_cast<int>(m_blocks.size()) - 1;
+    }
+    if(m_blocks.size() > 1) {
+        m_blocks[0].m_successors.push_back(1);
+    }
+
+    //the fall through successor of a conditional jump comes first, and the block that it jumps to second
+    for(size_t blockNum = 1; blockNum < m_blocks.size(); blockNum++) {
+        SsaBlock &block = m_blocks[blockNum];
+        const Instruction &last = instructions[block.m_last];
+        int next = block.m_last + 1 < instructionCount ? blockOfInstruction[block.m_last + 1] : -1;
+        if(last.m_opCode == OpCode::Jump) {
+            block.m_successors.push_back(blockOfInstruction[last.m_operand]);
+        } else if(last.m_opCode == OpCode::JumpIfFalse) {
+            block.m_successors.push_back(next);
+            if(blockOfInstruction[last.m_operand] != next) {
+                block.m_successors.push_back(blockOfInstruction[last.m_operand]);
+            }
+        } else if(!EndsBlock(last.m_opCode) && next >= 0) {
+            block.m_successors.push_back(next);
+        }
+    }
+
+    vector<int> pending(1, 0);
+    m_blocks[0].m_isReachable = true;
+    while(!pending.empty()) {
+        int blockNum = pending.back();
+        pending.pop_back();
+        for(int successor : m_blocks[blockNum].m_successors) {
+            m_blocks[successor].m_predecessors.push_back(blockNum);
+            if(!m_blocks[successor].m_isReachable) {
+                m_blocks[successor].m_isReachable = true;
+                pending.push_back(successor);
+            }
+        }
+    }
+    for(size_t blockNum = 1; blockNum < m_blocks.size(); blockNum++) {
+        SsaBlock &block = m_blocks[blockNum];
+        if(!block.m_isReachable) {
+            continue;
+        }
+        //the predecessors were added in the order the blocks were reached
+        sort(block.m_predecessors.begin(), block.m_predecessors.end());
+        for(int instructionNum = block.m_first; instructionNum <= block.m_last; instructionNum++) {
+            m_instructions[instructionNum].m_block = static_cast<int>(blockNum);
+        }
+    }
+}/** void SsaOptimizer::BuildBlocks() **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::FindDominanceFrontiers()
+
+ NAME
+    FindDominanceFrontiers - Finds the dominators and the dominance frontiers of the blocks
+
+ SYNOPSIS
+    void SsaOptimizer::FindDominanceFrontiers()
+
+ DESCRIPTION
+    The immediate dominators are found as they are for the ControlFlowGraph. A block where paths from several predecessors join is in
+    the dominance frontier of every block that dominates one of those predecessors but not the block itself (the method of Cooper,
+    Harvey and Kennedy).
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::FindDominanceFrontiers() {
+    vector<vector<int>> successors;
+    vector<vector<int>> predecessors;
+    for(const SsaBlock &block : m_blocks) {
+        successors.push_back(block.m_successors);
+        predecessors.push_back(block.m_predecessors);
+    }
+    vector<int> dominators = ControlFlowGraph::FindImmediateDominators(successors, predecessors);
+    for(size_t blockNum = 0; blockNum < m_blocks.size(); blockNum++) {
+        m_blocks[blockNum].m_immediateDominator = dominators[blockNum];
+        if(dominators[blockNum] >= 0) {
+            m_blocks[dominators[blockNum]].m_dominated.push_back(static_cast<int>(blockNum));
+        }
+    }
+
+    for(size_t blockNum = 0; blockNum < m_blocks.size(); blockNum++) {
+        const SsaBlock &block = m_blocks[blockNum];
+        if(block.m_predecessors.size() < 2) {
+            continue;
+        }
+        for(int predecessor : block.m_predecessors) {
+            for(int runner = predecessor; runner != block.m_immediateDominator; runner = m_blocks[runner].m_immediateDominator) {
+                vector<int> &frontier = m_blocks[runner].m_dominanceFrontier;
+                if(frontier.empty() || frontier.back() != static_cast<int>(blockNum)) {
+                    frontier.push_back(static_cast<int>(blockNum));
+                }
+            }
+        }
+    }
+}/** void SsaOptimizer::FindDominanceFrontiers() **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::PlacePhis()
+
+ NAME
+    PlacePhis - Places the phi versions of the variables
+
+ SYNOPSIS
+    void SsaOptimizer::PlacePhis()
+
+ DESCRIPTION
+    A variable that is stored into in a block needs a phi at every block of the dominance frontier of that block, and a phi is itself
+    a store that needs phis at the dominance frontier of its own block (the iterated dominance frontier of Cytron et al.).
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::PlacePhis() {
+    vector<vector<int>> storeBlocks(m_variableCount);
+    for(size_t instructionNum = 0; instructionNum < m_instructions.size(); instructionNum++) {
+        const Instruction &instruction = m_program.m_instructions[instructionNum];
+        int blockNum = m_instructions[instructionNum].m_block;
+        if(blockNum < 0 || instruction.m_opCode != OpCode::StoreVariable) {
+            continue;
+        }
+        vector<int> &blocks = storeBlocks[instruction.m_operand];
+        if(blocks.empty() || blocks.back() != blockNum) {
+            blocks.push_back(blockNum);
+        }
+    }
+
+    //the last variable that every block was given a phi for and was queued for
+    vector<int> phiVariable(m_blocks.size(), -1);
+    vector<int> queuedVariable(m_blocks.size(), -1);
+    for(int variable = 0; variable < m_variableCount; variable++) {
+        vector<int> pending = storeBlocks[variable];
+        for(int blockNum : pending) {
+            queuedVariable[blockNum] = variable;
+        }
+        while(!pending.empty()) {
+            int blockNum = pending.back();
+            pending.pop_back();
+            for(int frontier : m_blocks[blockNum].m_dominanceFrontier) {
+                if(phiVariable[frontier] == variable) {
+                    continue;
+                }
+                phiVariable[frontier] = variable;
+                int phi = AddVersion(SsaVersionKind::Phi, variable, frontier);
+                m_versions[phi].m_operands.assign(m_blocks[frontier].m_predecessors.size(), -1);
+                m_blocks[frontier].m_phis.push_back(phi);
+                if(queuedVariable[frontier] != variable) {
+                    queuedVariable[frontier] = variable;
+                    pending.push_back(frontier);
+                }
+            }
+        }
+    }
+}/** void SsaOptimizer::PlacePhis() **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::RenameVariables()
+
+ NAME
+    RenameVariables - Puts the instructions into SSA form
+
+ SYNOPSIS
+    bool SsaOptimizer::RenameVariables()
+
+ DESCRIPTION
+    The blocks are walked down the dominator tree, without recursion, keeping a stack of the versions of every variable. Within a
+    block, the stack of numbers is followed instruction by instruction to find which instruction pushed every number that an
+    instruction pops. A LoadVariable reads the version on top of the stack of its variable and a StoreVariable pushes a new one; the
+    number that a load pushes is the value of the version that it reads, so a copy of a variable into another is the same value. Once
+    a block is done, the phis of its successors are given the versions that reach them from it.
+
+ RETURNS
+    False if a block that continues with another leaves numbers on the stack, true otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::RenameVariables() {
+    const vector<Instruction> &instructions = m_program.m_instructions;
+    m_undefinedVersions.assign(m_variableCount, -1);
+    vector<vector<int>> versionStacks(m_variableCount);
+
+    //the variables whose versions were pushed, and how many there were when every block was entered
+    vector<int> pushedVariables;
+    vector<size_t> pushedMarks(m_blocks.size(), 0);
+
+    vector<pair<int, bool>> walk(1, make_pair(0, false));
+    while(!walk.empty()) {
+        int blockNum = walk.back().first;
+        bool isLeaving = walk.back().second;
+        walk.pop_back();
+        if(isLeaving) {
+            while(pushedVariables.size() > pushedMarks[blockNum]) {
+                versionStacks[pushedVariables.back()].pop_back();
+                pushedVariables.pop_back();
+            }
+            continue;
+        }
+
+        const SsaBlock &block = m_blocks[blockNum];
+        pushedMarks[blockNum] = pushedVariables.size();
+        for(int phi : block.m_phis) {
+            versionStacks[m_versions[phi].m_variable].push_back(phi);
+            pushedVariables.push_back(m_versions[phi].m_variable);
+        }
+
+        vector<int> stack;
+        for(int instructionNum = block.m_first; instructionNum <= block.m_last; instructionNum++) {
+            const Instruction &instruction = instructions[instructionNum];
+            SsaInstruction &ssa = m_instructions[instructionNum];
+            int popCount = PopCount(instruction);
+            if(static_cast<int>(stack.size()) < popCount) {
+                return false;
+            }
+            ssa.m_operandCount = popCount;
+            for(int operand = 0; operand < popCount; operand++) {
+                ssa.m_operands[operand] = stack[stack.size() - popCount + operand];
+                m_instructions[ssa.m_operands[operand]].m_consumer = instructionNum;
+            }
+            stack.resize(stack.size() - popCount);
+
+            if(instruction.m_opCode == OpCode::LoadVariable) {
+                ssa.m_version = TopVersion(versionStacks, instruction.m_operand);
+                ssa.m_value = m_versions[ssa.m_version].m_value;
+            } else if(instruction.m_opCode == OpCode::StoreVariable) {
+                ssa.m_version = AddVersion(SsaVersionKind::Store, instruction.m_operand, blockNum);
+                m_versions[ssa.m_version].m_instruction = instructionNum;
+                m_versions[ssa.m_version].m_value = m_instructions[ssa.m_operands[0]].m_value;
+                versionStacks[instruction.m_operand].push_back(ssa.m_version);
+                pushedVariables.push_back(instruction.m_operand);
+            } else if(Pushes(instruction.m_opCode)) {
+                ssa.m_value = AddValue(SsaValueKind::Instruction, instructionNum);
+            }
+            if(Pushes(instruction.m_opCode)) {
+                stack.push_back(instructionNum);
+            }
+        }
+        //an error may leave numbers on the stack, since nothing is executed after it
+        if(!stack.empty() && !block.m_successors.empty()) {
+            return false;
+        }
+
+        for(int successor : block.m_successors) {
+            const SsaBlock &successorBlock = m_blocks[successor];
+            size_t predecessorIndex = find(successorBlock.m_predecessors.begin(), successorBlock.m_predecessors.end(), blockNum) -
+                successorBlock.m_predecessors.begin();
+            for(int phi : successorBlock.m_phis) {
+                int version = TopVersion(versionStacks, m_versions[phi].m_variable);
+                m_versions[phi].m_operands[predecessorIndex] = version;
+            }
+        }
+
+        walk.push_back(make_pair(blockNum, true));
+        for(size_t dominated = block.m_dominated.size(); dominated > 0; dominated--) {
+            walk.push_back(make_pair(block.m_dominated[dominated - 1], false));
+        }
+    }
+    return true;
+}/** bool SsaOptimizer::RenameVariables() **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::RemoveTrivialPhis()
+
+ NAME
+    RemoveTrivialPhis - Makes the phis that merge a single value that value
+
+ SYNOPSIS
+    void SsaOptimizer::RemoveTrivialPhis()
+
+ DESCRIPTION
+    A phi whose operands are all the same value, or the phi itself (a variable that a loop does not change), is that value. Removing a
+    phi can make others trivial, so the phis are looked at until none is removed.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::RemoveTrivialPhis() {
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(const SsaVersion &phi : m_versions) {
+            if(phi.m_kind != SsaVersionKind::Phi || m_values[phi.m_value].m_sameAs >= 0) {
+                continue;
+            }
+            int sameValue = -1;
+            bool isTrivial = true;
+            for(int operand : phi.m_operands) {
+                int operandValue = Resolve(m_versions[operand].m_value);
+                if(operandValue == phi.m_value || operandValue == sameValue) {
+                    continue;
+                }
+                if(sameValue >= 0) {
+                    isTrivial = false;
+                    break;
+                }
+                sameValue = operandValue;
+            }
+            if(isTrivial && sameValue >= 0) {
+                m_values[phi.m_value].m_sameAs = sameValue;
+                changed = true;
+            }
+        }
+    }
+}/** void SsaOptimizer::RemoveTrivialPhis() **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::FindUndefinedValues()
+
+ NAME
+    FindUndefinedValues - Finds the values that may come from a variable that has not been assigned one
+
+ SYNOPSIS
+    void SsaOptimizer::FindUndefinedValues()
+
+ DESCRIPTION
+    The Undefined version of a variable has such a value, and so does every phi that has one as an operand. A load of such a value can
+    fail, so it is never removed. Every value is also given the variable that it is first stored into, which copy propagation and value
+    numbering read it back from.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::FindUndefinedValues() {
+    for(SsaValue &value : m_values) {
+        value.m_mayBeUndefined = value.m_kind == SsaValueKind::Undefined;
+    }
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(const SsaVersion &phi : m_versions) {
+            SsaValue &value = m_values[phi.m_value];
+            if(phi.m_kind != SsaVersionKind::Phi || value.m_sameAs >= 0 || value.m_mayBeUndefined) {
+                continue;
+            }
+            for(int operand : phi.m_operands) {
+                if(m_values[Resolve(m_versions[operand].m_value)].m_mayBeUndefined) {
+                    value.m_mayBeUndefined = true;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    //stores come before phis, so that a value is read back from the variable that it was computed for
+    for(const SsaVersion &version : m_versions) {
+        int value = Resolve(version.m_value);
+        if(version.m_kind == SsaVersionKind::Store && m_values[value].m_home < 0) {
+            m_values[value].m_home = version.m_variable;
+        }
+    }
+    for(const SsaVersion &version : m_versions) {
+        int value = Resolve(version.m_value);
+        if(version.m_kind == SsaVersionKind::Phi && m_values[value].m_home < 0) {
+            m_values[value].m_home = version.m_variable;
+        }
+    }
+}/** void SsaOptimizer::FindUndefinedValues() **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::PropagateConstants()
+
+ NAME
+    PropagateConstants - Finds the values that are always the same number, and the blocks that are executed
+
+ SYNOPSIS
+    void SsaOptimizer::PropagateConstants()
+
+ DESCRIPTION
+    This is the sparse conditional constant propagation of Wegman and Zadeck. A block is only looked at once an edge into it is found
+    to be taken, and a phi only merges the values that come in through the edges that are taken. A conditional jump whose condition is
+    a constant only takes one of its edges. Whenever what is known about a value changes, the instructions and phis that use it are
+    evaluated again. Array loads and reads vary, and so do variables that have not been assigned a value.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::PropagateConstants() {
+    //the instructions and the phis that use every value
+    vector<vector<int>> instructionUsers(m_values.size());
+    vector<vector<int>> phiUsers(m_values.size());
+    for(size_t instructionNum = 0; instructionNum < m_instructions.size(); instructionNum++) {
+        const SsaInstruction &ssa = m_instructions[instructionNum];
+        for(int operand = 0; operand < ssa.m_operandCount; operand++) {
+            instructionUsers[ValueOf(ssa.m_operands[operand])].push_back(static_cast<int>(instructionNum));
+        }
+    }
+    for(size_t version = 0; version < m_versions.size(); version++) {
+        const SsaVersion &phi = m_versions[version];
+        if(phi.m_kind != SsaVersionKind::Phi || m_values[phi.m_value].m_sameAs >= 0) {
+            continue;
+        }
+        for(int operand : phi.m_operands) {
+            phiUsers[Resolve(m_versions[operand].m_value)].push_back(static_cast<int>(version));
+        }
+    }
+    for(SsaBlock &block : m_blocks) {
+        block.m_executableEdges.assign(block.m_predecessors.size(), false);
+    }
+    for(SsaValue &value : m_values) {
+        if(value.m_kind == SsaValueKind::Undefined) {
+            value.m_lattice = SsaLattice::Varying;
+        }
+    }
+
+    vector<pair<int, int>> edgeWork;
+    vector<int> valueWork;
+    m_blocks[0].m_isExecutable = true;
+    for(int successor : m_blocks[0].m_successors) {
+        edgeWork.push_back(make_pair(0, successor));
+    }
+    while(!edgeWork.empty() || !valueWork.empty()) {
+        if(!edgeWork.empty()) {
+            int from = edgeWork.back().first;
+            int to = edgeWork.back().second;
+            edgeWork.pop_back();
+            SsaBlock &block = m_blocks[to];
+            size_t edge = find(block.m_predecessors.begin(), block.m_predecessors.end(), from) - block.m_predecessors.begin();
+            if(block.m_executableEdges[edge]) {
+                continue;
+            }
+            block.m_executableEdges[edge] = true;
+            for(int phi : block.m_phis) {
+                if(EvaluatePhi(phi)) {
+                    valueWork.push_back(m_versions[phi].m_value);
+                }
+            }
+            if(block.m_isExecutable) {
+                continue;
+            }
+            block.m_isExecutable = true;
+            for(int instructionNum = block.m_first; instructionNum <= block.m_last; instructionNum++) {
+                if(EvaluateInstruction(instructionNum, edgeWork)) {
+                    valueWork.push_back(ValueOf(instructionNum));
+                }
+            }
+            //conditional jumps take their edges as their conditions are found out, and the other blocks take their only one
+            OpCode last = m_program.m_instructions[block.m_last].m_opCode;
+            if(last != OpCode::JumpIfFalse && !block.m_successors.empty()) {
+                edgeWork.push_back(make_pair(to, block.m_successors[0]));
+            }
+            continue;
+        }
+
+        int value = valueWork.back();
+        valueWork.pop_back();
+        for(int user : instructionUsers[value]) {
+            if(m_blocks[m_instructions[user].m_block].m_isExecutable && EvaluateInstruction(user, edgeWork)) {
+                valueWork.push_back(ValueOf(user));
+            }
+        }
+        for(int phi : phiUsers[value]) {
+            if(EvaluatePhi(phi)) {
+                valueWork.push_back(m_versions[phi].m_value);
+            }
+        }
+    }
+}/** void SsaOptimizer::PropagateConstants() **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::EvaluateInstruction(int a_instruction, vector<pair<int, int>> &a_edgeWork)
+
+ NAME
+    EvaluateInstruction - Evaluates an instruction during constant propagation
+
+ SYNOPSIS
+    bool SsaOptimizer::EvaluateInstruction(int a_instruction, vector<pair<int, int>> &a_edgeWork)
+        a_instruction --> The instruction, in a block that is executed
+        a_edgeWork --> The edges found to be taken, to which those of a conditional jump are added
+
+ DESCRIPTION
+    An arithmetic, comparison or unary instruction is a constant if its operands are, and computes the same number as the DuckVM would.
+    It varies if one of its operands does, except that '!' between two operands only depends on the left one.
+
+ RETURNS
+    True if what is known about the value of the instruction changed, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::EvaluateInstruction(int a_instruction, vector<pair<int, int>> &a_edgeWork) {
+    const Instruction &instruction = m_program.m_instructions[a_instruction];
+    const SsaInstruction &ssa = m_instructions[a_instruction];
+    switch(instruction.m_opCode) {
+        case OpCode::PushNumber:
+            return LowerLattice(ssa.m_value, SsaLattice::Constant, m_program.m_numbers[instruction.m_operand]);
+        case OpCode::LoadArrayElement:
+        case OpCode::ReadNumber:
+            return LowerLattice(ssa.m_value, SsaLattice::Varying, 0);
+        case OpCode::JumpIfFalse: {
+            const SsaValue &condition = m_values[ValueOf(ssa.m_operands[0])];
+            const vector<int> &successors = m_blocks[ssa.m_block].m_successors;
+            if(condition.m_lattice != SsaLattice::Constant || condition.m_constant != 0) {
+                if(condition.m_lattice != SsaLattice::Unknown) {
+                    a_edgeWork.push_back(make_pair(ssa.m_block, successors.front()));
+                }
+            }
+            if(condition.m_lattice == SsaLattice::Varying || (condition.m_lattice == SsaLattice::Constant && condition.m_constant == 0)) {
+                a_edgeWork.push_back(make_pair(ssa.m_block, successors.back()));
+            }
+            return false;
+        }
+        default:
+            break;
+    }
+    if(!IsPure(instruction.m_opCode)) {
+        return false;
+    }
+
+    int operandCount = instruction.m_opCode == OpCode::BinaryNot ? 1 : ssa.m_operandCount;
+    SsaLattice lattice = SsaLattice::Constant;
+    double operands[2] = {0, 0};
+    for(int operand = 0; operand < operandCount; operand++) {
+        const SsaValue &value = m_values[ValueOf(ssa.m_operands[operand])];
+        if(value.m_lattice == SsaLattice::Varying) {
+            lattice = SsaLattice::Varying;
+        } else if(value.m_lattice == SsaLattice::Unknown && lattice == SsaLattice::Constant) {
+            lattice = SsaLattice::Unknown;
+        }
+        operands[operand] = value.m_constant;
+    }
+    double constant = lattice == SsaLattice::Constant ? Fold(instruction.m_opCode, operands[0], operands[1]) : 0;
+    return LowerLattice(ssa.m_value, lattice, constant);
+}/** bool SsaOptimizer::EvaluateInstruction(int a_instruction, vector<pair<int, int>> &a_edgeWork) **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::EvaluatePhi(int a_version)
+
+ NAME
+    EvaluatePhi - Evaluates a phi during constant propagation
+
+ SYNOPSIS
+    bool SsaOptimizer::EvaluatePhi(int a_version)
+        a_version --> The phi version
+
+ DESCRIPTION
+    A phi is a constant if all the values that come in through the edges that are taken are that same constant. A phi that was found
+    to be the same as another value is that value, and is not evaluated.
+
+ RETURNS
+    True if what is known about the value of the phi changed, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::EvaluatePhi(int a_version) {
+    const SsaVersion &phi = m_versions[a_version];
+    if(m_values[phi.m_value].m_sameAs >= 0) {
+        return false;
+    }
+    const SsaBlock &block = m_blocks[phi.m_block];
+    SsaLattice lattice = SsaLattice::Unknown;
+    double constant = 0;
+    for(size_t operand = 0; operand < phi.m_operands.size(); operand++) {
+        if(!block.m_executableEdges[operand]) {
+            continue;
+        }
+        const SsaValue &value = m_values[Resolve(m_versions[phi.m_operands[operand]].m_value)];
+        if(value.m_lattice == SsaLattice::Varying) {
+            return LowerLattice(phi.m_value, SsaLattice::Varying, 0);
+        }
+        if(value.m_lattice == SsaLattice::Constant) {
+            if(lattice == SsaLattice::Constant && memcmp(&constant, &value.m_constant, sizeof(double)) != 0) {
+                return LowerLattice(phi.m_value, SsaLattice::Varying, 0);
+            }
+            lattice = SsaLattice::Constant;
+            constant = value.m_constant;
+        }
+    }
+    return LowerLattice(phi.m_value, lattice, constant);
+}/** bool SsaOptimizer::EvaluatePhi(int a_version) **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::LowerLattice(int a_value, SsaLattice a_lattice, double a_constant)
+
+ NAME
+    LowerLattice - Records what is known about a value
+
+ SYNOPSIS
+    bool SsaOptimizer::LowerLattice(int a_value, SsaLattice a_lattice, double a_constant)
+        a_value --> The value
+        a_lattice --> What is now known about it
+        a_constant --> The constant, if it is one
+
+ DESCRIPTION
+    What is known about a value only ever goes from Unknown to Constant to Varying. A value that is found to be a second, different
+    constant varies. Constants are told apart by their bits, so that 0 and -0 (which print differently) are not the same.
+
+ RETURNS
+    True if what is known about the value changed, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::LowerLattice(int a_value, SsaLattice a_lattice, double a_constant) {
+    SsaValue &value = m_values[a_value];
+    if(value.m_lattice == SsaLattice::Varying || a_lattice == SsaLattice::Unknown) {
+        return false;
+    }
+    if(a_lattice == SsaLattice::Constant && value.m_lattice == SsaLattice::Constant) {
+        if(memcmp(&value.m_constant, &a_constant, sizeof(double)) == 0) {
+            return false;
+        }
+        a_lattice = SsaLattice::Varying;
+    }
+    value.m_lattice = a_lattice;
+    value.m_constant = a_constant;
+    return true;
+}/** bool SsaOptimizer::LowerLattice(int a_value, SsaLattice a_lattice, double a_constant) **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::NumberValues()
+
+ NAME
+    NumberValues - Decides how every instruction of the executed blocks is written back
+
+ SYNOPSIS
+    void SsaOptimizer::NumberValues()
+
+ DESCRIPTION
+    The executed blocks are walked down the dominator tree, keeping the stacks of versions of RenameVariables, so that at every
+    instruction it is known which value every variable holds.
+    A value that is a constant is pushed as a number. A load of a variable that holds a copy of another (or a value equal to one that
+    was computed before) is a load of the variable that the value was first stored into, if that variable still holds it (copy
+    propagation), which may leave the copy unread.
+    An arithmetic, comparison or unary instruction is numbered by its opcode and the numbers of its operands (global value numbering),
+    and equal constants are numbered alike.
+    If an instruction with the same number was met before, in the same block or in one that dominates it, it computed the same value,
+    which is loaded instead of being computed again: from the variable that it was stored into, if that variable still holds it, and
+    from a temporary slot otherwise. The table of numbers is kept for the blocks that are dominated and undone afterwards.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::NumberValues() {
+    const vector<Instruction> &instructions = m_program.m_instructions;
+    vector<vector<int>> versionStacks(m_variableCount);
+    vector<int> pushedVariables;
+    vector<size_t> pushedMarks(m_blocks.size(), 0);
+
+    //the first value of every opcode and value numbers of operands, and the keys added by every block, to remove them afterwards
+    map<tuple<int, int, int>, int> numbers;
+    vector<tuple<int, int, int>> addedKeys;
+    vector<size_t> addedMarks(m_blocks.size(), 0);
+
+    //the first value of every constant, by its bits
+    map<uint64_t, int> constants;
+
+    vector<pair<int, bool>> walk(1, make_pair(0, false));
+    while(!walk.empty()) {
+        int blockNum = walk.back().first;
+        bool isLeaving = walk.back().second;
+        walk.pop_back();
+        if(isLeaving) {
+            while(pushedVariables.size() > pushedMarks[blockNum]) {
+                versionStacks[pushedVariables.back()].pop_back();
+                pushedVariables.pop_back();
+            }
+            while(addedKeys.size() > addedMarks[blockNum]) {
+                numbers.erase(addedKeys.back());
+                addedKeys.pop_back();
+            }
+            continue;
+        }
+
+        const SsaBlock &block = m_blocks[blockNum];
+        pushedMarks[blockNum] = pushedVariables.size();
+        addedMarks[blockNum] = addedKeys.size();
+        for(int phi : block.m_phis) {
+            versionStacks[m_versions[phi].m_variable].push_back(phi);
+            pushedVariables.push_back(m_versions[phi].m_variable);
+        }
+
+        for(int instructionNum = block.m_first; instructionNum <= block.m_last; instructionNum++) {
+            const Instruction &instruction = instructions[instructionNum];
+            SsaInstruction &ssa = m_instructions[instructionNum];
+            if(instruction.m_opCode == OpCode::StoreVariable) {
+                versionStacks[instruction.m_operand].push_back(ssa.m_version);
+                pushedVariables.push_back(instruction.m_operand);
+                continue;
+            }
+            if(instruction.m_opCode == OpCode::JumpIfFalse) {
+                const SsaValue &condition = m_values[ValueOf(ssa.m_operands[0])];
+                if(condition.m_lattice == SsaLattice::Constant) {
+                    ssa.m_emission = condition.m_constant == 0 ? SsaEmission::AlwaysJump : SsaEmission::NeverJump;
+                }
+                continue;
+            }
+            if(instruction.m_opCode != OpCode::LoadVariable && !IsPure(instruction.m_opCode)) {
+                continue;
+            }
+
+            //equal constants have the same value number, wherever they are pushed
+            int value = ValueOf(instructionNum);
+            if(m_values[value].m_lattice == SsaLattice::Constant) {
+                uint64_t bits;
+                memcpy(&bits, &m_values[value].m_constant, sizeof(double));
+                m_values[value].m_valueNumber = constants.insert(make_pair(bits, value)).first->second;
+                if(instruction.m_opCode != OpCode::PushNumber) {
+                    ssa.m_emission = SsaEmission::Constant;
+                }
+                continue;
+            }
+            if(instruction.m_opCode == OpCode::LoadVariable) {
+                //the value that was loaded may have been found equal to one that was computed before
+                int leader = m_values[value].m_valueNumber;
+                int home = m_values[leader].m_home;
+                if(!m_values[value].m_mayBeUndefined && home >= 0 && home != instruction.m_operand) {
+                    int version = TopVersion(versionStacks, home);
+                    if(Resolve(m_versions[version].m_value) == leader) {
+                        ssa.m_emission = SsaEmission::Slot;
+                        ssa.m_slot = home;
+                        ssa.m_slotVersion = version;
+                    }
+                }
+                continue;
+            }
+
+            int secondOperand = ssa.m_operandCount > 1 ? m_values[ValueOf(ssa.m_operands[1])].m_valueNumber : -1;
+            tuple<int, int, int> key(static_cast<int>(instruction.m_opCode), m_values[ValueOf(ssa.m_operands[0])].m_valueNumber, secondOperand);
+            map<tuple<int, int, int>, int>::const_iterator found = numbers.find(key);
+            if(found == numbers.end()) {
+                numbers[key] = value;
+                addedKeys.push_back(key);
+                continue;
+            }
+            int leader = found->second;
+            m_values[value].m_valueNumber = leader;
+            ssa.m_emission = SsaEmission::Slot;
+            int home = m_values[leader].m_home;
+            if(home >= 0) {
+                int version = TopVersion(versionStacks, home);
+                if(Resolve(m_versions[version].m_value) == leader) {
+                    ssa.m_slot = home;
+                    ssa.m_slotVersion = version;
+                    continue;
+                }
+            }
+            ssa.m_leader = m_values[leader].m_definition;
+        }
+
+        walk.push_back(make_pair(blockNum, true));
+        for(size_t dominated = block.m_dominated.size(); dominated > 0; dominated--) {
+            if(m_blocks[block.m_dominated[dominated - 1]].m_isExecutable) {
+                walk.push_back(make_pair(block.m_dominated[dominated - 1], false));
+            }
+        }
+    }
+}/** void SsaOptimizer::NumberValues() **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::InferWholeNumbers()
+
+ NAME
+    InferWholeNumbers - Finds the values that are always whole numbers
+
+ SYNOPSIS
+    void SsaOptimizer::InferWholeNumbers()
+
+ DESCRIPTION
+    Every value starts out as a whole number, except for the values of variables that have not been assigned one, and a value is found
+    not to be one for as long as the instruction that computes it, or a phi that merges it through an edge that is taken, is not sure
+    to give one. Starting from whole numbers lets a loop counter be one: the phi at the top of the loop merges the number it starts
+    from with itself plus a whole number.
+    The sum, difference or product of whole numbers, and the negation of one, is a whole number (or overflows, which the DuckJit checks
+    for); comparisons and logical operators give 0 or 1. Divisions, reads and array elements are not known to be whole numbers.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::InferWholeNumbers() {
+    for(SsaValue &value : m_values) {
+        value.m_isWhole = value.m_kind != SsaValueKind::Undefined;
+    }
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(size_t instructionNum = 0; instructionNum < m_instructions.size(); instructionNum++) {
+            const SsaInstruction &ssa = m_instructions[instructionNum];
+            OpCode opCode = m_program.m_instructions[instructionNum].m_opCode;
+            //a load pushes the value that was stored, which is inferred where it is computed
+            if(ssa.m_value < 0 || opCode == OpCode::LoadVariable || !m_blocks[ssa.m_block].m_isExecutable) {
+                continue;
+            }
+            SsaValue &value = m_values[ValueOf(static_cast<int>(instructionNum))];
+            if(value.m_isWhole && !IsWholeResult(static_cast<int>(instructionNum))) {
+                value.m_isWhole = false;
+                changed = true;
+            }
+        }
+        for(const SsaVersion &phi : m_versions) {
+            if(phi.m_kind != SsaVersionKind::Phi || m_values[phi.m_value].m_sameAs >= 0 || !m_values[phi.m_value].m_isWhole) {
+                continue;
+            }
+            const SsaBlock &block = m_blocks[phi.m_block];
+            for(size_t operand = 0; operand < phi.m_operands.size(); operand++) {
+                if(block.m_executableEdges[operand] && !m_values[Resolve(m_versions[phi.m_operands[operand]].m_value)].m_isWhole) {
+                    m_values[phi.m_value].m_isWhole = false;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+}/** void SsaOptimizer::InferWholeNumbers() **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::IsWholeResult(int a_instruction) const
+
+ NAME
+    IsWholeResult - Finds out whether an instruction computes a whole number from the values of its operands
+
+ SYNOPSIS
+    bool SsaOptimizer::IsWholeResult(int a_instruction) const
+        a_instruction --> The instruction, which pushes a value
+
+ DESCRIPTION
+    A constant is a whole number if it is finite and has no fractional part. Otherwise, the operands of additions, subtractions,
+    multiplications and negations must be whole numbers, so far as InferWholeNumbers has found
+
+ RETURNS
+    True if the value of the instruction is a whole number, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::IsWholeResult(int a_instruction) const {
+    const SsaInstruction &ssa = m_instructions[a_instruction];
+    const SsaValue &value = m_values[ValueOf(a_instruction)];
+    if(value.m_lattice == SsaLattice::Constant) {
+        return isfinite(value.m_constant) && floor(value.m_constant) == value.m_constant;
+    }
+    switch(m_program.m_instructions[a_instruction].m_opCode) {
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Multiply:
+            return m_values[ValueOf(ssa.m_operands[0])].m_isWhole && m_values[ValueOf(ssa.m_operands[1])].m_isWhole;
+        case OpCode::Negate:
+            return m_values[ValueOf(ssa.m_operands[0])].m_isWhole;
+        case OpCode::Less:
+        case OpCode::Greater:
+        case OpCode::LessEqual:
+        case OpCode::GreaterEqual:
+        case OpCode::Equal:
+        case OpCode::NotEqual:
+        case OpCode::BinaryNot:
+        case OpCode::LogicalNot:
+            return true;
+        default:
+            return false;
+    }
+}/** bool SsaOptimizer::IsWholeResult(int a_instruction) const **/
+
+
+
+/**/
+/*
+ void SsaOptimizer::EliminateDeadCode()
+
+ NAME
+    EliminateDeadCode - Marks the instructions that are kept in the optimized program
+
+ SYNOPSIS
+    void SsaOptimizer::EliminateDeadCode()
+
+ DESCRIPTION
+    The instructions of the executed blocks that have side effects or can fail are kept: array loads and stores, reads, prints, jumps,
+    stops, errors and loads of variables that may not have been assigned. Every instruction that is kept as it is keeps the instructions
+    that push its operands, a load keeps the version that it reads, and a version keeps its store (or the versions that its phi merges
+    through the edges that are taken). A store that no kept load reads is therefore not kept (dead store elimination), and neither is
+    an instruction whose value is not used. An instruction whose value is loaded again from a temporary slot keeps that slot.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void SsaOptimizer::EliminateDeadCode() {
+    vector<int> instructionWork;
+    vector<int> versionWork;
+    for(size_t instructionNum = 0; instructionNum < m_instructions.size(); instructionNum++) {
+        const SsaInstruction &ssa = m_instructions[instructionNum];
+        OpCode opCode = m_program.m_instructions[instructionNum].m_opCode;
+        if(ssa.m_block < 0 || opCode == OpCode::StoreVariable || (IsPure(opCode) && opCode != OpCode::LoadVariable)) {
+            continue;
+        }
+        if(opCode == OpCode::LoadVariable && !m_values[ValueOf(static_cast<int>(instructionNum))].m_mayBeUndefined) {
+            continue;
+        }
+        if(ssa.m_emission != SsaEmission::NeverJump) {
+            instructionWork.push_back(static_cast<int>(instructionNum));
+        }
+    }
+
+    while(!instructionWork.empty() || !versionWork.empty()) {
+        if(!versionWork.empty()) {
+            SsaVersion &version = m_versions[versionWork.back()];
+            versionWork.pop_back();
+            if(version.m_isLive) {
+                continue;
+            }
+            version.m_isLive = true;
+            if(version.m_kind == SsaVersionKind::Store) {
+                instructionWork.push_back(version.m_instruction);
+            } else if(version.m_kind == SsaVersionKind::Phi) {
+                for(size_t operand = 0; operand < version.m_operands.size(); operand++) {
+                    if(m_blocks[version.m_block].m_executableEdges[operand]) {
+                        versionWork.push_back(version.m_operands[operand]);
+                    }
+                }
+            }
+            continue;
+        }
+
+        int instructionNum = instructionWork.back();
+        instructionWork.pop_back();
+        SsaInstruction &ssa = m_instructions[instructionNum];
+        if(ssa.m_isNeeded || ssa.m_block < 0 || !m_blocks[ssa.m_block].m_isExecutable) {
+            continue;
+        }
+        ssa.m_isNeeded = true;
+        if(ssa.m_emission == SsaEmission::Original) {
+            for(int operand = 0; operand < ssa.m_operandCount; operand++) {
+                instructionWork.push_back(ssa.m_operands[operand]);
+            }
+            if(m_program.m_instructions[instructionNum].m_opCode == OpCode::LoadVariable) {
+                versionWork.push_back(ssa.m_version);
+            }
+        } else if(ssa.m_emission == SsaEmission::Slot) {
+            if(ssa.m_slotVersion >= 0) {
+                versionWork.push_back(ssa.m_slotVersion);
+            } else {
+                SsaInstruction &leader = m_instructions[ssa.m_leader];
+                if(leader.m_temporary < 0) {
+                    leader.m_temporary = m_variableCount + m_temporaryCount++;
+                }
+                instructionWork.push_back(ssa.m_leader);
+            }
+        }
+    }
+}/** void SsaOptimizer::EliminateDeadCode() **/
+
+
+
+/**/
+/*
+ BytecodeProgram SsaOptimizer::Lower()
+
+ NAME
+    Lower - Writes the optimized program
+
+ SYNOPSIS
+    BytecodeProgram SsaOptimizer::Lower()
+
+ DESCRIPTION
+    The instructions that are kept are written in their original order, each as it was decided it would be, and every one belongs to
+    the statement of the instruction that it was written for. Since the operands of an instruction that is not kept are not kept either
+    unless they have side effects, the numbers on the stack are the same whenever a kept instruction pops them; a number that is pushed
+    for its side effects alone is popped right away, and a number that is kept in a temporary slot is stored into it (and loaded back if
+    it is used where it is). The stack is never deeper than in the original program. Jumps are pointed at the instruction that the first
+    instruction they jumped to became (or at the next one that is kept). The slots that only whole numbers are ever stored into are
+    listed for the DuckJit.
+
+ RETURNS
+    The optimized program
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+BytecodeProgram SsaOptimizer::Lower() {
+    const vector<Instruction> &instructions = m_program.m_instructions;
+    int instructionCount = static_cast<int>(instructions.size());
+    BytecodeProgram program;
+    program.m_numbers = m_program.m_numbers;
+    program.m_strings = m_program.m_strings;
+    program.m_maxStackDepth = m_program.m_maxStackDepth;
+    program.m_temporaryCount = m_temporaryCount;
+
+    //a slot holds whole numbers only if every store into it that is kept stores one
+    program.m_wholeSlots.assign(m_variableCount + m_temporaryCount, true);
+
+    //the index of the constants that are pushed in the numbers of the program, by their bits
+    map<uint64_t, int> constants;
+
+    //the instruction that every instruction became, or the next one that is kept
+    vector<int> newIndexes(instructionCount + 1, 0);
+    vector<int> jumps;
+    for(size_t blockNum = 1; blockNum < m_blocks.size(); blockNum++) {
+        const SsaBlock &block = m_blocks[blockNum];
+        for(int instructionNum = block.m_first; instructionNum <= block.m_last; instructionNum++) {
+            newIndexes[instructionNum] = static_cast<int>(program.m_instructions.size());
+            const SsaInstruction &ssa = m_instructions[instructionNum];
+            if(!ssa.m_isNeeded) {
+                continue;
+            }
+            Instruction instruction = instructions[instructionNum];
+            OpCode opCode = instruction.m_opCode;
+            switch(ssa.m_emission) {
+                case SsaEmission::Original:
+                    break;
+                case SsaEmission::Constant: {
+                    uint64_t bits;
+                    double constant = m_values[ValueOf(instructionNum)].m_constant;
+                    memcpy(&bits, &constant, sizeof(double));
+                    map<uint64_t, int>::const_iterator found = constants.find(bits);
+                    if(found == constants.end()) {
+                        program.m_numbers.push_back(constant);
+                        found = constants.insert(make_pair(bits, static_cast<int>(program.m_numbers.size()) - 1)).first;
+                    }
+                    instruction.m_opCode = OpCode::PushNumber;
+                    instruction.m_operand = found->second;
+                    break;
+                }
+                case SsaEmission::Slot:
+                    instruction.m_opCode = OpCode::LoadVariable;
+                    instruction.m_operand = ssa.m_slotVersion >= 0 ? ssa.m_slot : m_instructions[ssa.m_leader].m_temporary;
+                    break;
+                case SsaEmission::AlwaysJump:
+                    instruction.m_opCode = OpCode::Jump;
+                    break;
+                case SsaEmission::NeverJump:
+                    continue;
+            }
+            instruction.m_operand2 = instruction.m_opCode == OpCode::InvalidOperation ? instruction.m_operand2 : 0;
+            if(instruction.m_opCode == OpCode::Jump || instruction.m_opCode == OpCode::JumpIfFalse) {
+                jumps.push_back(static_cast<int>(program.m_instructions.size()));
+            }
+            if(instruction.m_opCode == OpCode::StoreVariable && !m_values[ValueOf(ssa.m_operands[0])].m_isWhole) {
+                program.m_wholeSlots[instruction.m_operand] = false;
+            }
+            int statementNum = m_program.m_statementOfInstruction[instructionNum];
+            program.m_instructions.push_back(instruction);
+            program.m_statementOfInstruction.push_back(statementNum);
+            if(!Pushes(opCode)) {
+                continue;
+            }
+
+            const SsaInstruction *consumer = ssa.m_consumer >= 0 ? &m_instructions[ssa.m_consumer] : nullptr;
+            bool isPopped = consumer != nullptr && consumer->m_isNeeded && consumer->m_emission == SsaEmission::Original;
+            if(ssa.m_temporary >= 0) {
+                if(!m_values[ValueOf(instructionNum)].m_isWhole) {
+                    program.m_wholeSlots[ssa.m_temporary] = false;
+                }
+                program.m_instructions.push_back(Instruction{OpCode::StoreVariable, ssa.m_temporary, 0});
+                program.m_statementOfInstruction.push_back(statementNum);
+            }
+            if(ssa.m_temporary >= 0 && isPopped) {
+                program.m_instructions.push_back(Instruction{OpCode::LoadVariable, ssa.m_temporary, 0});
+                program.m_statementOfInstruction.push_back(statementNum);
+            } else if(ssa.m_temporary < 0 && !isPopped) {
+                program.m_instructions.push_back(Instruction{OpCode::Pop, 0, 0});
+                program.m_statementOfInstruction.push_back(statementNum);
+            }
+        }
+    }
+    newIndexes[instructionCount] = static_cast<int>(program.m_instructions.size());
+
+    for(int jump : jumps) {
+        program.m_instructions[jump].m_operand = newIndexes[program.m_instructions[jump].m_operand];
+    }
+    for(int start : m_program.m_statementStart) {
+        program.m_statementStart.push_back(newIndexes[start]);
+    }
+    return program;
+}/** BytecodeProgram SsaOptimizer::Lower() **/
+
+
+
+/**/
+/*
+ int SsaOptimizer::Resolve(int a_value) const
+
+ NAME
+    Resolve - Returns the value that a value turned out to be the same as
+
+ SYNOPSIS
+    int SsaOptimizer::Resolve(int a_value) const
+        a_value --> The value
+
+ DESCRIPTION
+    Follows the phis that were found to be trivial to the value that they merge
+
+ RETURNS
+    The value, or the value that it is the same as
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int SsaOptimizer::Resolve(int a_value) const {
+    while(m_values[a_value].m_sameAs >= 0) {
+        a_value = m_values[a_value].m_sameAs;
+    }
+    return a_value;
+}/** int SsaOptimizer::Resolve(int a_value) const **/
+
+
+
+/**/
+/*
+ int SsaOptimizer::TopVersion(vector<vector<int>> &a_versionStacks, int a_variable)
+
+ NAME
+    TopVersion - Returns the version of a variable that reaches the instruction being walked
+
+ SYNOPSIS
+    int SsaOptimizer::TopVersion(vector<vector<int>> &a_versionStacks, int a_variable)
+        a_versionStacks --> The stacks of versions of every variable
+        a_variable --> The variable
+
+ DESCRIPTION
+    The version on top of the stack of the variable. A variable that has no version there has not been assigned a value, and has
+    its Undefined version, which is added the first time it is needed.
+
+ RETURNS
+    The version
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int SsaOptimizer::TopVersion(vector<vector<int>> &a_versionStacks, int a_variable) {
+    if(!a_versionStacks[a_variable].empty()) {
+        return a_versionStacks[a_variable].back();
+    }
+    if(m_undefinedVersions[a_variable] < 0) {
+        m_undefinedVersions[a_variable] = AddVersion(SsaVersionKind::Undefined, a_variable, -1);
+    }
+    return m_undefinedVersions[a_variable];
+}/** int SsaOptimizer::TopVersion(vector<vector<int>> &a_versionStacks, int a_variable) **/
+
+
+
+/**/
+/*
+ int SsaOptimizer::AddValue(SsaValueKind a_kind, int a_definition)
+
+ NAME
+    AddValue - Adds an SSA value
+
+ SYNOPSIS
+    int SsaOptimizer::AddValue(SsaValueKind a_kind, int a_definition)
+        a_kind --> What defines the value
+        a_definition --> The instruction or the version that defines it
+
+ DESCRIPTION
+    The value starts out with its own value number
+
+ RETURNS
+    The index of the value
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int SsaOptimizer::AddValue(SsaValueKind a_kind, int a_definition) {
+    SsaValue value;
+    value.m_kind = a_kind;
+    value.m_definition = a_definition;
+    value.m_valueNumber = static_cast<int>(m_values.size());
+    m_values.push_back(value);
+    return value.m_valueNumber;
+}/** int SsaOptimizer::AddValue(SsaValueKind a_kind, int a_definition) **/
+
+
+
+/**/
+/*
+ int SsaOptimizer::AddVersion(SsaVersionKind a_kind, int a_variable, int a_block)
+
+ NAME
+    AddVersion - Adds a version of a variable
+
+ SYNOPSIS
+    int SsaOptimizer::AddVersion(SsaVersionKind a_kind, int a_variable, int a_block)
+        a_kind --> What defines the version
+        a_variable --> The variable
+        a_block --> The block that defines it
+
+ DESCRIPTION
+    A phi and an Undefined version get a value of their own. The value of a store is the value that it pops, which the caller sets.
+
+ RETURNS
+    The index of the version
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int SsaOptimizer::AddVersion(SsaVersionKind a_kind, int a_variable, int a_block) {
+    int versionNum = static_cast<int>(m_versions.size());
+    SsaVersion version;
+    version.m_kind = a_kind;
+    version.m_variable = a_variable;
+    version.m_block = a_block;
+    if(a_kind == SsaVersionKind::Phi) {
+        version.m_value = AddValue(SsaValueKind::Phi, versionNum);
+    } else if(a_kind == SsaVersionKind::Undefined) {
+        version.m_value = AddValue(SsaValueKind::Undefined, versionNum);
+    }
+    m_versions.push_back(version);
+    return versionNum;
+}/** int SsaOptimizer::AddVersion(SsaVersionKind a_kind, int a_variable, int a_block) **/
+
+
+
+/**/
+/*
+ int SsaOptimizer::PopCount(const Instruction &a_instruction)
+
+ NAME
+    PopCount - Returns the number of values that an instruction pops
+
+ SYNOPSIS
+    int SsaOptimizer::PopCount(const Instruction &a_instruction)
+        a_instruction --> The instruction
+
+ DESCRIPTION
+    InvalidOperation does not pop its operands, but it looks at them to report the error, so they count as popped
+
+ RETURNS
+    The number of values
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+int SsaOptimizer::PopCount(const Instruction &a_instruction) {
+    switch(a_instruction.m_opCode) {
+        case OpCode::StoreVariable:
+        case OpCode::LoadArrayElement:
+        case OpCode::Pop:
+        case OpCode::Negate:
+        case OpCode::LogicalNot:
+        case OpCode::JumpIfFalse:
+        case OpCode::PrintNumber:
+        case OpCode::DeclareArray:
+            return 1;
+        case OpCode::StoreArrayElement:
+        case OpCode::StoreArrayElementValueFirst:
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Multiply:
+        case OpCode::Divide:
+        case OpCode::Less:
+        case OpCode::Greater:
+        case OpCode::LessEqual:
+        case OpCode::GreaterEqual:
+        case OpCode::Equal:
+        case OpCode::NotEqual:
+        case OpCode::BinaryNot:
+            return 2;
+        case OpCode::InvalidOperation:
+            return a_instruction.m_operand2;
+        default:
+            return 0;
+    }
+}/** int SsaOptimizer::PopCount(const Instruction &a_instruction) **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::Pushes(OpCode a_opCode)
+
+ NAME
+    Pushes - Finds out whether an instruction pushes a value
+
+ SYNOPSIS
+    bool SsaOptimizer::Pushes(OpCode a_opCode)
+        a_opCode --> The opcode of the instruction
+
+ DESCRIPTION
+    Every instruction pushes at most one value
+
+ RETURNS
+    True if the instruction pushes a value, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::Pushes(OpCode a_opCode) {
+    return a_opCode == OpCode::LoadVariable || a_opCode == OpCode::LoadArrayElement || a_opCode == OpCode::ReadNumber || IsPure(a_opCode);
+}/** bool SsaOptimizer::Pushes(OpCode a_opCode) **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::EndsBlock(OpCode a_opCode)
+
+ NAME
+    EndsBlock - Finds out whether an instruction ends its block
+
+ SYNOPSIS
+    bool SsaOptimizer::EndsBlock(OpCode a_opCode)
+        a_opCode --> The opcode of the instruction
+
+ DESCRIPTION
+    Jumps end their blocks, and so do the instructions that end the program or report an error, after which nothing is executed
+
+ RETURNS
+    True if the instruction ends its block, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::EndsBlock(OpCode a_opCode) {
+    switch(a_opCode) {
+        case OpCode::Jump:
+        case OpCode::JumpIfFalse:
+        case OpCode::InvalidOperation:
+        case OpCode::Stop:
+        case OpCode::End:
+        case OpCode::NoMoreLines:
+        case OpCode::RaiseError:
+            return true;
+        default:
+            return false;
+    }
+}/** bool SsaOptimizer::EndsBlock(OpCode a_opCode) **/
+
+
+
+/**/
+/*
+ bool SsaOptimizer::IsPure(OpCode a_opCode)
+
+ NAME
+    IsPure - Finds out whether an instruction only computes a value from its operands
+
+ SYNOPSIS
+    bool SsaOptimizer::IsPure(OpCode a_opCode)
+        a_opCode --> The opcode of the instruction
+
+ DESCRIPTION
+    Pushing a number and the arithmetic, comparison and unary operators cannot fail and have no side effects
+
+ RETURNS
+    True if the instruction is pure, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool SsaOptimizer::IsPure(OpCode a_opCode) {
+    switch(a_opCode) {
+        case OpCode::PushNumber:
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Multiply:
+        case OpCode::Divide:
+        case OpCode::Less:
+        case OpCode::Greater:
+        case OpCode::LessEqual:
+        case OpCode::GreaterEqual:
+        case OpCode::Equal:
+        case OpCode::NotEqual:
+        case OpCode::BinaryNot:
+        case OpCode::Negate:
+        case OpCode::LogicalNot:
+            return true;
+        default:
+            return false;
+    }
+}/** bool SsaOptimizer::IsPure(OpCode a_opCode) **/
+
+
+
+/**/
+/*
+ double SsaOptimizer::Fold(OpCode a_opCode, double a_left, double a_right)
+
+ NAME
+    Fold - Computes the value of an operator
+
+ SYNOPSIS
+    double SsaOptimizer::Fold(OpCode a_opCode, double a_left, double a_right)
+        a_opCode --> The arithmetic, comparison or unary instruction
+        a_left --> Its left (or only) operand
+        a_right --> Its right operand
+
+ DESCRIPTION
+    Every operator is computed with the same expression as in DuckVM::Run, so that the result has the same bits
+
+ RETURNS
+    The value
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+double SsaOptimizer::Fold(OpCode a_opCode, double a_left, double a_right) {
+    switch(a_opCode) {
+        case OpCode::Add:
+            return a_left + a_right;
+        case OpCode::Subtract:
+            return a_left - a_right;
+        case OpCode::Multiply:
+            return a_left * a_right;
+        case OpCode::Divide:
+            return a_left / a_right;
+        case OpCode::Less:
+            return a_left < a_right;
+        case OpCode::Greater:
+            return a_left > a_right;
+        case OpCode::LessEqual:
+            return a_left <= a_right;
+        case OpCode::GreaterEqual:
+            return a_left >= a_right;
+        case OpCode::Equal:
+            return a_left == a_right;
+        case OpCode::NotEqual:
+            return a_left != a_right;
+        case OpCode::BinaryNot:
+        case OpCode::LogicalNot:
+            return a_left != 0 ? 0 : 1;
+        case OpCode::Negate:
+            return -1 * a_left;
+        default:
+            return a_left;
+    }
+}/** double SsaOptimizer::Fold(OpCode a_opCode, double a_left, double a_right) **/
@@ -0,0 +1,275 @@
+/* SsaOptimizer.h
+ SsaOptimizer.h contains the SsaOptimizer class and the structs of the static single assignment (SSA) form that it works on
+ SsaOptimizer is the class that optimizes a BytecodeProgram before the DuckVM (and the DuckJit) runs it. The program is divided into
+ basic blocks of instructions and put into SSA form: every value that an instruction pushes on the stack of numbers, every store into a
+ variable and every merge of the stores that reach a block (a phi) is a value of its own, and every load of a variable reads one of
+ them. On that form it runs sparse conditional constant propagation (which also finds the branches that are never taken), copy
+ propagation (a variable that holds a copy of another is read from the variable it was copied from), global value numbering (an
+ arithmetic expression whose value was computed before, in a block that dominates it, is not computed again) and dead store
+ elimination (a store into a variable that is never read is dropped, along with the instructions that only computed its value). The
+ optimized program is then written back as bytecode, in the order of the original instructions, along with the variable slots that
+ type inference found only ever hold whole numbers (loop counters that start from a whole number and only ever have whole numbers added
+ to them, for example), which the DuckJit keeps in integer registers.
+ Only instructions that cannot fail are removed or replaced: array loads and stores (which can fail, and whose elements the arrays do
+ not tell apart), reads, prints, loads of variables that may not have been assigned yet and errors all stay where they are, so the
+ output and the errors of the program (and the lines that they are reported against) are the same.
+ Only the DuckVM and the DuckJit run the optimized program. The interpreter executes the statements themselves, and duck2cpp translates
+ the unoptimized bytecode for the C++ compiler to optimize. The blocks are built from the instructions here, not taken from the
+ ControlFlowGraph of the statements, which only has statement boundaries and does not split a statement at an InvalidOperation or a
+ RaiseError, so the two share only ControlFlowGraph::FindImmediateDominators.
+*/
+
+#pragma once
+
+#include <vector>
+#include "Bytecode.h"
+#include "ControlFlowGraph.h"
+
+//What is known about an SSA value while constants are propagated: nothing yet, that it is always the same number, or that it varies
+enum class SsaLattice : unsigned char
+{
+    Unknown,
+    Constant,
+    Varying,
+};
+
+//How an instruction is written back into the optimized program
+enum class SsaEmission : unsigned char
+{
+    //as it is
+    Original,
+    //as a push of the number that its value always is
+    Constant,
+    //as a load of the variable slot that already holds its value
+    Slot,
+    //a conditional jump whose condition is always 0, as a jump
+    AlwaysJump,
+    //a conditional jump whose condition is never 0 is dropped
+    NeverJump,
+};
+
+//A block of instructions that are always executed one after the other
+struct SsaBlock
+{
+    //the first and the last instruction of the block. The entry block that comes before the first instruction has none
+    int m_first = 0;
+    int m_last = -1;
+
+    std::vector<int> m_successors;
+    std::vector<int> m_predecessors;
+
+    //the block that dominates the block most closely (-1 for the entry block), and the blocks that it dominates most closely
+    int m_immediateDominator = -1;
+    std::vector<int> m_dominated;
+
+    //the blocks where the dominance of the block ends, where the stores in the block have to be merged with other stores
+    std::vector<int> m_dominanceFrontier;
+
+    //the phi versions of the variables at the start of the block
+    std::vector<int> m_phis;
+
+    //true if a path from the entry reaches the block, and true if constant propagation found that one is taken
+    bool m_isReachable = false;
+    bool m_isExecutable = false;
+
+    //true for the edge from every predecessor that constant propagation found is taken, in the order of m_predecessors
+    std::vector<bool> m_executableEdges;
+};
+
+//The kinds of versions of a variable
+enum class SsaVersionKind : unsigned char
+{
+    //the variable has not been assigned a value
+    Undefined,
+    //the value stored by a StoreVariable instruction
+    Store,
+    //the merge of the versions that reach a block from its predecessors
+    Phi,
+};
+
+//A version of a variable: the value that a variable holds from an assignment to the next
+struct SsaVersion
+{
+    SsaVersionKind m_kind = SsaVersionKind::Undefined;
+    int m_variable = 0;
+
+    //the SSA value that the variable holds
+    int m_value = -1;
+
+    //the StoreVariable instruction, for a store. The block and the version coming from each of its predecessors, for a phi
+    int m_instruction = -1;
+    int m_block = -1;
+    std::vector<int> m_operands;
+
+    //true if a load that is kept reads the version
+    bool m_isLive = false;
+};
+
+//The kinds of SSA values
+enum class SsaValueKind : unsigned char
+{
+    //the number pushed by an instruction
+    Instruction,
+    //the value of a phi version
+    Phi,
+    //the value of a variable that has not been assigned one
+    Undefined,
+};
+
+//A value of the SSA form
+struct SsaValue
+{
+    SsaValueKind m_kind = SsaValueKind::Instruction;
+
+    //the instruction that pushes the value, or the version whose value it is
+    int m_definition = -1;
+
+    //the value that this one turned out to be the same as (a phi whose operands are all the same value), -1 if none
+    int m_sameAs = -1;
+
+    //what constant propagation found about the value
+    SsaLattice m_lattice = SsaLattice::Unknown;
+    double m_constant = 0;
+
+    //true if the value may come from a variable that has not been assigned one
+    bool m_mayBeUndefined = false;
+
+    //the variable that the value was first stored into, -1 if none
+    int m_home = -1;
+
+    //the value that value numbering found this one to be equal to (itself if none)
+    int m_valueNumber = -1;
+
+    //true if type inference found that the value is always a whole number
+    bool m_isWhole = true;
+};
+
+//An instruction of the program with its operands and its result in SSA form
+struct SsaInstruction
+{
+    //the block of the instruction, -1 if no path reaches it
+    int m_block = -1;
+
+    //the instructions that pushed the numbers that the instruction pops (or, for InvalidOperation, looks at), in the order they were
+    //pushed, and the instruction that pops the number that this one pushes (-1 if none does)
+    int m_operands[2] = {-1, -1};
+    int m_operandCount = 0;
+    int m_consumer = -1;
+
+    //the value that the instruction pushes, -1 if it pushes none
+    int m_value = -1;
+
+    //the version that a LoadVariable reads or that a StoreVariable defines
+    int m_version = -1;
+
+    //how the instruction is written back. For a Slot, the slot that is loaded and the version of the variable that it holds (or the
+    //instruction whose value is kept in a temporary slot, when m_slotVersion is -1)
+    SsaEmission m_emission = SsaEmission::Original;
+    int m_slot = -1;
+    int m_slotVersion = -1;
+    int m_leader = -1;
+
+    //true if the instruction is kept in the optimized program
+    bool m_isNeeded = false;
+
+    //the temporary slot that the value is also stored into, for the instructions that compute it again to load, -1 if none
+    int m_temporary = -1;
+};
+
+class SsaOptimizer
+{
+public:
+    SsaOptimizer(const BytecodeProgram &a_program, int a_variableCount) : m_program(a_program), m_variableCount(a_variableCount) {}
+    ~SsaOptimizer() {}
+
+    //Returns the optimized program. Its temporary slots come after the a_variableCount slots of the variables
+    BytecodeProgram Optimize();
+
+private:
+    //The program being optimized, and the number of variable slots that it uses
+    const BytecodeProgram &m_program;
+    int m_variableCount;
+
+    //The SSA form of the program. The instructions are indexed like the instructions of the program
+    std::vector<SsaBlock> m_blocks;
+    std::vector<SsaInstruction> m_instructions;
+    std::vector<SsaVersion> m_versions;
+    std::vector<SsaValue> m_values;
+
+    //The Undefined version of every variable, -1 until it is needed
+    std::vector<int> m_undefinedVersions;
+
+    //The number of temporary slots that the values loaded again by value numbering are kept in
+    int m_temporaryCount = 0;
+
+    //Divides the instructions into blocks and finds the blocks that can be reached
+    void BuildBlocks();
+
+    //Finds the dominators and the dominance frontiers of the blocks
+    void FindDominanceFrontiers();
+
+    //Places the phi versions of every variable at the blocks where its stores merge
+    void PlacePhis();
+
+    //Walks the blocks down the dominator tree, giving every pushed number a value and every load the version it reads. Returns false
+    //if the stack of numbers is not empty where a block starts (the program is then left as it is)
+    bool RenameVariables();
+
+    //Makes every phi whose operands are all the same value that value
+    void RemoveTrivialPhis();
+
+    //Finds the values that may come from a variable that has not been assigned one, and the variable that every value is first stored into
+    void FindUndefinedValues();
+
+    //Sparse conditional constant propagation
+    void PropagateConstants();
+
+    //Copy propagation and global value numbering, down the dominator tree of the executable blocks
+    void NumberValues();
+
+    //Finds the values that are always whole numbers
+    void InferWholeNumbers();
+
+    //Returns true if the value that an instruction computes is a whole number whenever its operands are
+    bool IsWholeResult(int a_instruction) const;
+
+    //Marks the instructions that are kept, starting from the ones with side effects. Stores that are never read are not marked
+    void EliminateDeadCode();
+
+    //Writes the instructions that are kept back as bytecode
+    BytecodeProgram Lower();
+
+    //Returns the value that a value turned out to be the same as
+    int Resolve(int a_value) const;
+
+    //Returns the value of the number that an instruction pushes
+    int ValueOf(int a_instruction) const { return Resolve(m_instructions[a_instruction].m_value); }
+
+    //Returns the version of a variable on top of the stacks of versions of RenameVariables and NumberValues
+    int TopVersion(std::vector<std::vector<int>> &a_versionStacks, int a_variable);
+
+    //Adds a value or a version and returns its index
+    int AddValue(SsaValueKind a_kind, int a_definition);
+    int AddVersion(SsaVersionKind a_kind, int a_variable, int a_block);
+
+    //Evaluates the instruction that computes a value, or the phi, during constant propagation. Returns true if what is known about
+    //the value changed
+    bool EvaluateInstruction(int a_instruction, std::vector<std::pair<int, int>> &a_edgeWork);
+    bool EvaluatePhi(int a_version);
+
+    //Lowers what is known about a value. Returns true if it changed
+    bool LowerLattice(int a_value, SsaLattice a_lattice, double a_constant);
+
+    //Returns the numbers of values that an instruction pops and pushes
+    static int PopCount(const Instruction &a_instruction);
+    static bool Pushes(OpCode a_opCode);
+
+    //Returns true if no instruction after the given one in its block is executed
+    static bool EndsBlock(OpCode a_opCode);
+
+    //Returns true if the instruction computes its value from its operands alone, without any side effect
+    static bool IsPure(OpCode a_opCode);
+
+    //Computes the value of an arithmetic, comparison or unary instruction exactly as the DuckVM does
+    static double Fold(OpCode a_opCode, double a_left, double a_right);
+};
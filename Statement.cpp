@@ -1,17 +1,27 @@
 #include "Statement.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include "SourceScanner.h"
+
 using namespace std;
 
 
 /**/
 /*
- bool Statement::ValidLabelName(string a_labelName)
+ bool Statement::ValidLabelName(string_view a_labelName)
  
  NAME
     Statement::ValidLabelName - Checks if the given string is a valid candidate for a label name
  
  SYNOPSIS
-    bool Statement::ValidLabelName(string a_labelName)
+    bool Statement::ValidLabelName(string_view a_labelName)
         a_labelName --> The string to be checked
  
  DESCRIPTION
@@ -25,7 +35,7 @@ using namespace std;
     Biplab Thapa Magar
  */
 /**/
-bool Statement::ValidLabelName(string a_labelName) {
+bool Statement::ValidLabelName(string_view a_labelName) {
     //return if empty labelName
     if(a_labelName.length() == 0) {
         return false;
@@ -42,7 +52,7 @@ bool Statement::ValidLabelName(string a_labelName) {
     
     
     //now, check to see if the rest of the characters of the label is not an "_", a letter, or a number
-    for(int i = 1; i < a_labelName.length(); i++) {
+    for(size_t i = 1; i < a_labelName.length(); i++) {
         if(a_labelName[i] != '_') {
             if(a_labelName[i] < 'a' || a_labelName[i] > 'z') {
                 if(a_labelName[i] < 'A' || a_labelName[i] > 'Z') {
@@ -84,7 +94,99 @@ bool Statement::ValidLabelName(string a_labelName) {
     }
 
     return true;
-}/** bool Statement::ValidLabelName(string a_labelName) **/
+}/** bool Statement::ValidLabelName(string_view a_labelName) **/
+
+
+
+/**/
+/*
+ Statement::~Statement()
+ 
+ NAME
+    Statement::~Statement - Releases the source of the Duck program
+ 
+ SYNOPSIS
+    Statement::~Statement()
+ 
+ DESCRIPTION
+    Unmaps the source file if it was mapped into memory. The text of the statements cannot be used once the Statement is destroyed.
+ 
+ RETURNS
+    Nothing
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+Statement::~Statement() {
+    if(m_sourceIsMapped) {
+        munmap(const_cast<char *>(m_source), m_sourceLength);
+    }
+}/** Statement::~Statement() **/
+
+
+
+/**/
+/*
+ bool Statement::LoadSourceFile(const string &a_sourceFileName)
+ 
+ NAME
+    Statement::LoadSourceFile - Makes the contents of the source file available in a single buffer
+ 
+ SYNOPSIS
+    bool Statement::LoadSourceFile(const string &a_sourceFileName)
+        a_sourceFileName --> The name of the Duck program source file
+ 
+ DESCRIPTION
+    Maps the source file into memory, read only, so that the text of the statements can view the file without being copied. If the
+    file cannot be mapped (because it is empty, or it is not a regular file, such as a pipe), its contents are read into m_sourceCopy
+    instead. Either way, m_source and m_sourceLength describe the contents of the file.
+ 
+ RETURNS
+    True if the file was loaded. False if it could not be opened
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool Statement::LoadSourceFile(const string &a_sourceFileName) {
+    int fileDescriptor = open(a_sourceFileName.c_str(), O_RDONLY);
+    if(fileDescriptor < 0) {
+        return false;
+    }
+    
+    struct stat fileStatus;
+    if(fstat(fileDescriptor, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) && fileStatus.st_size > 0) {
+        void *mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if(mapping != MAP_FAILED) {
+            //the file is read from start to end once
+            madvise(mapping, fileStatus.st_size, MADV_SEQUENTIAL);
+            m_source = static_cast<const char *>(mapping);
+            m_sourceLength = fileStatus.st_size;
+            m_sourceIsMapped = true;
+            close(fileDescriptor);
+            return true;
+        }
+    }
+    
+    //the file cannot be mapped, so read it all
+    char block[64 * 1024];
+    while(true) {
+        ssize_t bytesRead = read(fileDescriptor, block, sizeof(block));
+        if(bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if(bytesRead <= 0) {
+            break;
+        }
+        m_sourceCopy.append(block, bytesRead);
+    }
+    close(fileDescriptor);
+    m_source = m_sourceCopy.data();
+    m_sourceLength = m_sourceCopy.length();
+    m_sourceIsMapped = false;
+    return true;
+}/** bool Statement::LoadSourceFile(const string &a_sourceFileName) **/
 
 
 
@@ -101,9 +203,16 @@ bool Statement::ValidLabelName(string a_labelName) {
  
  DESCRIPTION
     This function stores all the statements in the given source file. When storing the statments, it removes all comments and extracts
-    and records all the labels separately. The labels are stored along with the line number they correspond to. Furthermore, this function
-    also sees if there is at least one stop statement in the Duck program source file. Can throw multiple exceptions depending on validity of 
-    labels or the absence of stop statements.
+    and records all the labels separately. Every statement is also broken into tokens and classified here, once, so that it never has
+    to be lexed or classified again when it is executed. The labels are stored along with the line number they correspond to, and the
+    labels that goto and if statements jump to are resolved once all of them are known. The source file is mapped into memory, and
+    the text of every statement is a view of its line in the mapping. Furthermore, this function also sees if there
+    is at least one stop statement in the Duck program source file. Can throw multiple exceptions depending on validity of labels or
+    the absence of stop statements.
+    A large source is split into line-aligned chunks that are recorded by separate threads (see RecordChunk), one per processor unless
+    another number of threads was set with SetLoadThreadCount. The chunks are then
+    merged in order, so the statements, the identifier ids, the labels and the errors that are reported are exactly the same as if
+    the whole source had been recorded one line at a time.
  
  RETURNS
     void
@@ -113,21 +222,110 @@ bool Statement::ValidLabelName(string a_labelName) {
  */
 /**/
 void Statement::RecordStatements(string a_sourceFileName) {
-	ifstream inf(a_sourceFileName);
-	if (!inf)
-	{
+    if(!LoadSourceFile(a_sourceFileName)) {
         cerr << "Could not open the file: " << a_sourceFileName << endl;
 		exit(1);
 	}
+    string_view source(m_source, m_sourceLength);
+    
+    //use one chunk per processor (or per thread that was asked for), but only if every chunk would be large enough to be worth a thread
+    unsigned threadCount = m_loadThreadCount > 0 ? m_loadThreadCount : thread::hardware_concurrency();
+    size_t chunkCount = min<size_t>(threadCount, source.length() / k_minimumChunkLength);
+    if(chunkCount == 0) {
+        chunkCount = 1;
+    }
+    vector<StatementChunk> chunks(chunkCount);
+    size_t chunkStart = 0;
+    for(size_t i = 0; i < chunkCount; i++) {
+        size_t chunkEnd = source.length();
+        if(i + 1 < chunkCount) {
+            //end the chunk after the line that contains its share of the source
+            chunkEnd = source.find('\n', max(chunkStart, source.length() / chunkCount * (i + 1)));
+            chunkEnd = chunkEnd == string_view::npos ? source.length() : chunkEnd + 1;
+        }
+        chunks[i].m_source = source.substr(chunkStart, chunkEnd - chunkStart);
+        chunkStart = chunkEnd;
+    }
+    
+    //the first chunk is recorded on this thread, straight into the lexer of the program, and the others on threads of their own. If a
+    //thread cannot be started, its chunk is recorded here instead
+    vector<thread> workers;
+    for(size_t i = 1; i < chunkCount; i++) {
+        try {
+            workers.emplace_back(&Statement::RecordChunk, this, ref(chunks[i]), ref(chunks[i].m_lexer));
+        } catch(const system_error &) {
+            RecordChunk(chunks[i], chunks[i].m_lexer);
+        }
+    }
+    RecordChunk(chunks[0], m_lexer);
+    for(size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
     
     //To find errors caused by a lack of stop statements in the program
     int stopStatementCounter = 0;
+    size_t statementCount = 0;
+    for(size_t i = 0; i < chunkCount; i++) {
+        statementCount += chunks[i].m_statements.size();
+    }
+    m_statements.swap(chunks[0].m_statements);
+    m_statements.reserve(statementCount);
+    for(size_t i = 0; i < chunkCount; i++) {
+        MergeChunk(chunks[i], i == 0);
+        stopStatementCounter += chunks[i].m_stopStatementCount;
+    }
     
-	// Read through the file one line at a time.  Find labels and record them.
-    string nextLine = "";
-    string labelName = "";
-    while(getline(inf, nextLine)) {
-        RemoveComments(nextLine);
+    if(stopStatementCounter == 0) {
+        cerr << "Program Error: Missing stop statements." << endl;
+        exit(1);
+    }
+    
+    //now that all the labels are known, every goto can be pointed at the statement it jumps to
+    ResolveGotoTargets();
+}/** void Statement::RecordStatements(string a_sourceFileName) **/
+
+
+
+/**/
+/*
+ void Statement::RecordChunk(StatementChunk &a_chunk, Lexer &a_lexer)
+ 
+ NAME
+    Statement::RecordChunk - Records the statements of one chunk of the source
+ 
+ SYNOPSIS
+    void Statement::RecordChunk(StatementChunk &a_chunk, Lexer &a_lexer)
+        a_chunk --> The chunk whose lines are to be recorded. The statements, labels and errors of the chunk are stored in it
+        a_lexer --> The lexer used to tokenize the statements of the chunk
+ 
+ DESCRIPTION
+    Goes through the lines of the chunk one at a time: the comments, labels and surrounding white space are removed, and every
+    statement is tokenized and classified, exactly as for the statements of a whole source. Label names are checked, but duplicate
+    labels are left for MergeChunk, since a label may be repeated in another chunk. This function only touches the chunk and the
+    lexer, so chunks can be recorded on several threads at once. Instead of exiting on an error, it stores the error in the chunk and
+    stops, so that the error can be reported when the chunk is merged, in its place among the errors of the other chunks.
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void Statement::RecordChunk(StatementChunk &a_chunk, Lexer &a_lexer) {
+	// Go through the chunk one line at a time.  Find labels and record them.
+    string_view source = a_chunk.m_source;
+    //there is at most one statement per line
+    a_chunk.m_statements.reserve(count(source.begin(), source.end(), '\n') + 1);
+    //the scanner finds the comment and the label of every line in the same pass that finds the line
+    SourceScanner scanner(source);
+    SourceLine line;
+    string_view labelName;
+    //the tokens of every statement are first collected here, so that each statement keeps a list that is exactly as long as it needs
+    TokenList tokens;
+    while(scanner.NextLine(line)) {
+        //the line without its comment
+        string_view nextLine = source.substr(line.m_start, line.m_codeEnd - line.m_start);
         RemoveExtraneousWhiteSpace(nextLine);
         
         //ignore empty line
@@ -136,101 +334,436 @@ void Statement::RecordStatements(string a_sourceFileName) {
         }
         
         //Check for label and extract label
-        ExtractLabel(nextLine, labelName);
+        size_t labelEndIndex = string_view::npos;
+        if(line.m_labelEnd != string_view::npos) {
+            labelEndIndex = line.m_labelEnd - (nextLine.data() - source.data());
+        }
+        if(!ExtractLabel(nextLine, labelEndIndex, labelName)) {
+            a_chunk.m_error = LoadError::InvalidLabelName;
+            a_chunk.m_invalidLabelName = labelName;
+            return;
+        }
         
         //now, remove extraneous white space from the beginning of nextLine
         RemoveExtraneousWhiteSpace(nextLine);
         
         //check for possible syntax error
         if(nextLine.length() == 0) {
-            cerr <<  "Syntax Error: Line " << m_statements.size() << ": Labeled line has no adjoining statement." << endl;
-            exit(1);
+            a_chunk.m_error = LoadError::LabelWithoutStatement;
+            return;
         }
         
         //check if the statement is a stop statement
         if(nextLine.substr(0, 4) == "stop") {
-            stopStatementCounter++;
+            a_chunk.m_stopStatementCount++;
         }
         
-        //add statement to m_statements vector
-        m_statements.push_back(nextLine);
+        //add statement to the statements of the chunk, along with its tokens
+        CompiledStatement statement;
+        statement.m_text = nextLine;
+        a_lexer.Tokenize(statement.m_text, tokens, statement.m_lexErrorMessage);
+        statement.m_tokens.assign(tokens.begin(), tokens.end());
+        ClassifyStatement(statement);
+        a_chunk.m_statements.push_back(move(statement));
         
-        //add corresponding label to labelToStatement vector (if label exists) and if label is not duplicate
+        //remember the corresponding label (if label exists), to be checked for duplicates when the chunk is merged
         if(labelName.length() != 0) {
-            
-            //checking for duplicate
-            if(m_labelToStatement.count(labelName) > 0) {
-                map<string, int>::iterator it;
-                it = m_labelToStatement.find(labelName);
-                cerr << "Syntax Error: Lines " << it->second << " and " << m_statements.size() - 1<< ": Multiple labels with the same name" << endl;
-                exit(1);
+            a_chunk.m_labels.emplace_back(labelName, static_cast<int>(a_chunk.m_statements.size()) - 1);
+        }
+    }
+}/** void Statement::RecordChunk(StatementChunk &a_chunk, Lexer &a_lexer) **/
+
+
+
+/**/
+/*
+ void Statement::MergeChunk(StatementChunk &a_chunk, bool a_isFirstChunk)
+ 
+ NAME
+    Statement::MergeChunk - Adds the statements and labels of a recorded chunk to the program
+ 
+ SYNOPSIS
+    void Statement::MergeChunk(StatementChunk &a_chunk, bool a_isFirstChunk)
+        a_chunk --> The chunk to be merged. Its statements are moved out of it
+        a_isFirstChunk --> True for the first chunk of the source, whose statements have already been swapped into m_statements and
+                           whose identifiers were interned by the lexer of the program itself
+ 
+ DESCRIPTION
+    Chunks must be merged in order. The identifiers of the chunk are interned in the lexer of the program in the order that the chunk
+    first saw them, which gives them the ids they would have had if the whole source had been tokenized by one lexer, and the tokens
+    of the statements are given these ids as the statements are moved into m_statements. Then the labels of the chunk are checked for
+    duplicates and stored. Finally, if recording the chunk stopped at an error, the error is reported with the line number it would
+    have been reported with had the source been recorded one line at a time, and the program exits.
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void Statement::MergeChunk(StatementChunk &a_chunk, bool a_isFirstChunk) {
+    //the line number of the first statement of the chunk
+    size_t firstStatement = a_isFirstChunk ? 0 : m_statements.size();
+    if(!a_isFirstChunk) {
+        vector<int> identifierIds(a_chunk.m_lexer.GetIdentifierCount());
+        for(size_t i = 0; i < identifierIds.size(); i++) {
+            identifierIds[i] = m_lexer.InternIdentifier(a_chunk.m_lexer.GetIdentifierName(static_cast<int>(i)));
+        }
+        for(size_t i = 0; i < a_chunk.m_statements.size(); i++) {
+            CompiledStatement &statement = a_chunk.m_statements[i];
+            for(size_t j = 0; j < statement.m_tokens.size(); j++) {
+                if(statement.m_tokens[j].m_type == TokenType::Identifier) {
+                    statement.m_tokens[j].m_identifierId = identifierIds[statement.m_tokens[j].m_identifierId];
+                }
             }
-            m_labelToStatement.insert(pair<string, int>(labelName, m_statements.size() - 1));
+            m_statements.push_back(move(statement));
         }
+        //the moved-from statements are no longer needed
+        vector<CompiledStatement>().swap(a_chunk.m_statements);
     }
     
-    if(stopStatementCounter == 0) {
-        cerr << "Program Error: Missing stop statements." << endl;
+    //add corresponding labels to labelToStatement vector, if label is not duplicate
+    for(size_t i = 0; i < a_chunk.m_labels.size(); i++) {
+        string labelName(a_chunk.m_labels[i].first);
+        int statementNum = static_cast<int>(firstStatement) + a_chunk.m_labels[i].second;
+        
+        //checking for duplicate
+        map<string, int>::iterator it = m_labelToStatement.find(labelName);
+        if(it != m_labelToStatement.end()) {
+            cerr << "Syntax Error: Lines " << it->second << " and " << statementNum << ": Multiple labels with the same name" << endl;
+            exit(1);
+        }
+        m_labelToStatement.insert(pair<string, int>(labelName, statementNum));
+    }
+    
+    if(a_chunk.m_error == LoadError::InvalidLabelName) {
+        cerr << "Error: Line " << m_statements.size() << ": '" << a_chunk.m_invalidLabelName << "' is an invalid label name." << endl;
         exit(1);
     }
+    if(a_chunk.m_error == LoadError::LabelWithoutStatement) {
+        cerr <<  "Syntax Error: Line " << m_statements.size() << ": Labeled line has no adjoining statement." << endl;
+        exit(1);
+    }
+}/** void Statement::MergeChunk(StatementChunk &a_chunk, bool a_isFirstChunk) **/
+
+
+/**/
+/*
+ int CompiledStatement::ParseNextElement(int a_nextPos, Token &a_token) const
+ 
+ NAME
+    CompiledStatement::ParseNextElement - Retrieves the next element in the statement (whether it be a number or a word) 
+        and returns the index of the starting position of the next element
+ 
+ SYNOPSIS
+    int CompiledStatement::ParseNextElement(int a_nextPos, Token &a_token) const
+        a_nextPos --> The position of the token of the element to be parsed
+        a_token --> The token of the element that has been parsed
+ DESCRIPTION
+    This function retrieves the next element in the statement from the tokens that the statement was broken into when it was recorded.
+    If the statement could not be tokenized up to this element, the tokenization error is thrown now that the element has been reached.
+ 
+ RETURNS
+    The position of the next element in the statement. If there are no elements left, then it return -1.
+ 
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+int CompiledStatement::ParseNextElement(int a_nextPos, Token &a_token) const {
+    if(a_nextPos < 0) {
+        return -1;
+    }
     
-    inf.close();
-}/** void Statement::RecordStatements(string a_sourceFileName) **/
+    //If no element is left in the statement
+    // Note: This case should not occur because:
+    //      i)in a previous call to ParseNextElement, a_nextPos must have been set to -1 and the user of this function should not
+    //              be calling ParseNextElement if a_nextPos is -1.
+    //      ii)No statement stored in m_statements is entirely empty. So every statement has at least one token
+    int numTokens = static_cast<int>(m_tokens.size());
+    if(a_nextPos >= numTokens) {
+        return -2;
+    }
+    
+    //if the statement could not be tokenized up to this element, the element is in error
+    if(m_tokens[a_nextPos].m_type == TokenType::Error) {
+        throw DuckInterpreterException(m_lexErrorMessage);
+    }
+    a_token = m_tokens[a_nextPos];
+    
+    //If there is nothing after the current element
+    if(a_nextPos + 1 == numTokens) {
+        return -1;
+    }
+    return a_nextPos + 1;
+} /** int CompiledStatement::ParseNextElement(int a_nextPos, Token &a_token) const **/
+
+
+
+/**/
+/*
+ string CompiledStatement::GetElementString(const Token &a_token) const
+ 
+ NAME
+    CompiledStatement::GetElementString - Returns the text of a token the way it appears in the statement
+ 
+ SYNOPSIS
+    string CompiledStatement::GetElementString(const Token &a_token) const
+        a_token --> The token whose text is to be returned
+ 
+ DESCRIPTION
+    This function returns the text of the given token. Numbers are represented by their value, so an empty string is returned for them.
+    It is used to describe the elements of a statement in error messages.
+ 
+ RETURNS
+    The text of the token
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+string CompiledStatement::GetElementString(const Token &a_token) const {
+    if(a_token.m_type == TokenType::Number || a_token.m_type == TokenType::None) {
+        return "";
+    }
+    return string(m_text.substr(a_token.m_start, a_token.m_length));
+} /** string CompiledStatement::GetElementString(const Token &a_token) const **/
+
 
 
 /**/
 /*
- void Statement::ExtractLabel(string& a_statement, string &a_labelName)
+ void Statement::ClassifyStatement(CompiledStatement &a_statement)
+ 
+ NAME
+    Statement::ClassifyStatement - Determines the type of the given statement
+ 
+ SYNOPSIS
+    void Statement::ClassifyStatement(CompiledStatement &a_statement)
+        a_statement --> The statement whose type is to be determined
+ 
+ DESCRIPTION
+    It determines the type of the given statement and stores it in the statement. For arithmetic statements, it also checks that the
+    left hand side of the '=' is a variable or an array element. If the statement ends without a semi-colon, or if its type cannot be
+    determined, the type is Invalid and the error is stored so that it can be reported if and when the statement is executed.
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Biplab Thapa Magar
+ */
+/**/
+void Statement::ClassifyStatement(CompiledStatement &a_statement) {
+    string_view statementText = a_statement.m_text;
+    a_statement.m_type = StatementType::Invalid;
+    try {
+        //check if the statement ends with a semi-colon
+        if(statementText[statementText.length() - 1] != ';') {
+            throw DuckInterpreterException("';' is missing from end of statement");
+        }
+        
+        //checking for read statement
+        if(statementText.substr(0, 4) == "read") {
+            a_statement.m_type = StatementType::ReadStat;
+            return;
+        }
+        if(statementText.substr(0, 2) == "if") {
+            a_statement.m_type = StatementType::IfStat;
+            return;
+        }
+        if(statementText.substr(0, 5) == "print") {
+            a_statement.m_type = StatementType::PrintStat;
+            return;
+        }
+        if(statementText.substr(0, 4) == "stop") {
+            a_statement.m_type = StatementType::StopStat;
+            return;
+        }
+        if(statementText.substr(0, 3) == "end") {
+            a_statement.m_type = StatementType::EndStat;
+            return;
+        }
+        if(statementText.substr(0, 4) == "goto") {
+            a_statement.m_type = StatementType::gotoStat;
+            return;
+        }
+        if(statementText.substr(0, 3) == "dim") {
+            a_statement.m_type = StatementType::arrayDeclarationStat;
+            return;
+        }
+        
+        //checking for arithmetic statement
+        
+        //first, check for presence of '=' character
+        size_t positionOfEqualOperator = statementText.find('=');
+        if(positionOfEqualOperator == string_view::npos) {
+            throw DuckInterpreterException("Unable to determine statement type");
+        }
+        string_view variableName = statementText.substr(0, positionOfEqualOperator);
+        //check to see if the assignment operator is preceded by quotations.
+        if(variableName.find('\"') != string_view::npos) {
+            //It doesn't make sense for a non-Print statement and a non-Read statement to have a string
+            //It must be a statement with bad syntax
+            throw DuckInterpreterException("Invalid syntax.");
+        }
+        int nextPos = 0;
+        Token nextToken;
+        nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+        
+        if(nextToken.m_type != TokenType::Identifier) {
+            throw DuckInterpreterException("Invalid arithmetic statement. No proper variable or array to assign value to.");
+        }
+        
+        nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+        
+        //check to see if the variable is an array
+        if(nextToken.IsOperator(OperatorCode::OpenBracket)) {
+            nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+            //if there is nothing in between [], throw error
+            if(nextToken.IsOperator(OperatorCode::CloseBracket)) {
+                throw DuckInterpreterException("Array index unspecified");
+            }
+            //search for closing bracket
+            while(!nextToken.IsOperator(OperatorCode::CloseBracket) && nextPos != -1) {
+                nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+            }
+            if(nextPos < 0) {
+                if(!nextToken.IsOperator(OperatorCode::CloseBracket)) {
+                    throw DuckInterpreterException("Missing ']' character to end array expression.");
+                }
+                throw DuckInterpreterException("Invalid arithmetic statement.");
+            }
+            nextPos = a_statement.ParseNextElement(nextPos, nextToken);
+        }
+        
+        //if there are more characters after the variable or array but before the '=' operator, throw error
+        if(!nextToken.IsOperator(OperatorCode::Assign)) {
+            string message = string(variableName) + " is an invalid expression to which to assign a value.";
+            throw DuckInterpreterException(message);
+        }
+        a_statement.m_type = StatementType::ArithmeticStat;
+    } catch(DuckInterpreterException &e) {
+        a_statement.m_type = StatementType::Invalid;
+        a_statement.m_classificationError = e.what();
+    }
+}/** void Statement::ClassifyStatement(CompiledStatement &a_statement) **/
+
+
+/**/
+/*
+ void Statement::ResolveGotoTargets()
+ 
+ NAME
+    Statement::ResolveGotoTargets - Resolves the label of every goto to the index of the statement that it jumps to
+ 
+ SYNOPSIS
+    void Statement::ResolveGotoTargets()
+ 
+ DESCRIPTION
+    This function finds the goto of every goto statement and if statement. If the goto is followed by a label, the label is looked up
+    here, once, so that an undefined label is reported before the program starts running rather than when the branch is first taken.
+    If the goto part of the statement is well formed ("goto <label>;"), the position of the goto and the statement that it jumps to are
+    stored with the statement so that executing the goto does not have to parse it or look up the label again.
+ 
+ RETURNS
+    void
+ 
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void Statement::ResolveGotoTargets() {
+    for(int statementNum = 0; statementNum < static_cast<int>(m_statements.size()); statementNum++) {
+        CompiledStatement &statement = m_statements[statementNum];
+        const TokenList &tokens = statement.m_tokens;
+        int numTokens = static_cast<int>(tokens.size());
+        
+        //the goto of a goto statement is its first element. The goto of an if statement follows the condition
+        int gotoPosition = -1;
+        if(numTokens > 0 && tokens[0].IsKeyword(Keyword::Goto)) {
+            gotoPosition = 0;
+        } else if(numTokens > 0 && tokens[0].IsKeyword(Keyword::If)) {
+            for(int position = 1; position < numTokens; position++) {
+                if(tokens[position].IsKeyword(Keyword::Goto)) {
+                    gotoPosition = position;
+                    break;
+                }
+            }
+        }
+        if(gotoPosition < 0 || gotoPosition + 1 >= numTokens || tokens[gotoPosition + 1].m_type != TokenType::Identifier) {
+            continue;
+        }
+        
+        //report an undefined label the same way as an error found while executing the statement
+        const string &labelName = m_lexer.GetIdentifierName(tokens[gotoPosition + 1].m_identifierId);
+        map<string, int>::const_iterator label = m_labelToStatement.find(labelName);
+        if(label == m_labelToStatement.end()) {
+            cerr << endl;
+            cerr << "Error: Line " << statementNum + 1 << ": \"" << statement.m_text << "\": " << endl;
+            cerr << "      '" << labelName << "' is an undefined label" << endl << endl;
+            exit(1);
+        }
+        
+        //only a goto that is followed by nothing but the semicolon can be taken without checking its syntax again
+        if(gotoPosition + 3 == numTokens && tokens[gotoPosition + 2].IsOperator(OperatorCode::Semicolon)) {
+            statement.m_gotoPosition = gotoPosition;
+            statement.m_gotoTarget = label->second;
+        }
+    }
+}/** void Statement::ResolveGotoTargets() **/
+
+
+/**/
+/*
+ bool Statement::ExtractLabel(string_view& a_statement, size_t a_labelEndIndex, string_view &a_labelName)
  
  NAME
     Statement::ExtractLabel - Extracts a label from a given statement, stores the label, and removes the label from the original statement
  
  SYNOPSIS
-    void Statement::ExtractLabel(string& a_statement, string &a_labelName)
+    bool Statement::ExtractLabel(string_view& a_statement, size_t a_labelEndIndex, string_view &a_labelName)
     a_statement --> The statement from which to extract and remove the label
+    a_labelEndIndex --> The index in the statement of the ':' that ends the label, or string_view::npos if the statement has no label
     a_labelName --> The label that is extracted from the statement
  
  DESCRIPTION
     This function extracts the label from a given statement, stores the label, and removes the label from the original statement.
-    It also cleans up the label of any extraneous white space.
+    It also cleans up the label of any extraneous white space. Both the label and the statement are views of the source. The end of
+    the label (the first ':' of the statement, if it is not within an output string) has already been found by the SourceScanner.
  
  RETURNS
-    void
+    False if the statement has a label that is not a valid label name, true otherwise
  
  AUTHOR
     Biplab Thapa Magar
  */
 /**/
-void Statement::ExtractLabel(string& a_statement, string &a_labelName) {
-    size_t labelEndIndex = 0;
-    //Check for label and extract label
-    labelEndIndex = a_statement.find(':');
+bool Statement::ExtractLabel(string_view& a_statement, size_t a_labelEndIndex, string_view &a_labelName) {
     //if the statement contains a ':' character that is not within an output string
-    if(labelEndIndex != string::npos && (a_statement.substr(0, labelEndIndex)).find('\"') == string::npos) {
+    if(a_labelEndIndex != string_view::npos) {
         //isolate label name
-        a_labelName = a_statement.substr(0, labelEndIndex);
+        a_labelName = a_statement.substr(0, a_labelEndIndex);
         //remove label from statement
-        a_statement = a_statement.substr(labelEndIndex + 1);
+        a_statement = a_statement.substr(a_labelEndIndex + 1);
         RemoveExtraneousWhiteSpace(a_labelName);
-        if(!ValidLabelName(a_labelName)) {
-            cerr << "Error: Line " << m_statements.size() << ": '" << a_labelName + "' is an invalid label name." << endl;
-            exit(1);
-        };
-    } else {
-        a_labelName = "";
+        return ValidLabelName(a_labelName);
     }
-}/** void Statement::ExtractLabel(string& a_statement, string &a_labelName) **/
+    a_labelName = string_view();
+    return true;
+}/** bool Statement::ExtractLabel(string_view& a_statement, size_t a_labelEndIndex, string_view &a_labelName) **/
 
 
 /**/
 /*
- int Statement::GetLabelLocation(string a_string)
+ int Statement::GetLabelLocation(string a_string) const
  
  NAME
     Statement::GetLabelLocation - Retrieves the line that the given label corresponds to
  
  SYNOPSIS
-    int Statement::GetLabelLocation(string a_string)
+    int Statement::GetLabelLocation(string a_string) const
         a_labelName --> The name of the label
  
  DESCRIPTION
@@ -243,25 +776,25 @@ void Statement::ExtractLabel(string& a_statement, string &a_labelName) {
     Biplab Thapa Magar
  */
 /**/
-int Statement::GetLabelLocation(string a_labelName) {
+int Statement::GetLabelLocation(string a_labelName) const {
     if(m_labelToStatement.count(a_labelName) == 0) {
         string message = "'" + a_labelName + "' is an undefined label";
         throw DuckInterpreterException(message);
     }
-    return m_labelToStatement[a_labelName];
-} /** int Statement::GetLabelLocation(string a_string) **/
+    return m_labelToStatement.find(a_labelName)->second;
+} /** int Statement::GetLabelLocation(string a_string) const **/
 
 
 
 /**/
 /*
- void Statement::RemoveExtraneousWhiteSpace(string& a_string)
+ void Statement::RemoveExtraneousWhiteSpace(string_view& a_string)
  
  NAME
     Statement::RemoveExtraneousWhiteSpace - Removes all extraneous white space from the beginning and the end of the given string
  
  SYNOPSIS
-    void Statement::RemoveExtraneousWhiteSpace(string& a_string)
+    void Statement::RemoveExtraneousWhiteSpace(string_view& a_string)
         a_string --> The string from which extraneous white space is to be removed
  
  DESCRIPTION
@@ -274,76 +807,15 @@ int Statement::GetLabelLocation(string a_labelName) {
     Biplab Thapa Magar
  */
 /**/
-void Statement::RemoveExtraneousWhiteSpace(string& a_string) {
+void Statement::RemoveExtraneousWhiteSpace(string_view& a_string) {
     //remove extraneous white space from the beginning of nextLine
     while(a_string.length() != 0 && (a_string[0] == ' ' || a_string[0] == '\t')) {
-        a_string = a_string.substr(1);
+        a_string.remove_prefix(1);
     }
     //now, remove extraneous white space from the end of nextLine
     while(a_string.length() != 0 && (a_string[a_string.length() - 1] == ' ' || a_string[a_string.length() - 1] == '\t')) {
-        a_string = a_string.substr(0, a_string.length() - 1);
-    }
-}/** void Statement::RemoveExtraneousWhiteSpace(string& a_string) **/
-
-
-
-/**/
-/*
- void Statement::RemoveComments(string& a_string)
- 
- NAME
-    Statement::RemoveComments - Removes all comments the given statement
- 
- SYNOPSIS
-    void Statement::RemoveComments(string& a_string)
-        a_statement --> The statement from which to remove comments
- 
- DESCRIPTION
-    Removes the comments from a given statement. If the statement is entirely a comment, then the statement's value is assigned to an empty string
-    Ignores comment characters that occur within a string
- 
- RETURNS
-    void
- 
- AUTHOR
-    Biplab Thapa Magar
- */
-/**/
-void Statement::RemoveComments(string& a_statement) {
-    //if comment characters found
-    if(a_statement.find("//") != string::npos) {
-        size_t commentIndex = a_statement.find("//");
-        //if comment starts at the beginning of the line, then empty the whole line
-        if(commentIndex == 0) {
-            a_statement = "";
-            return;
-        }
-        
-        //if comment starts anywhere else then search further:
-
-        // here, quotationCharacterCounter is used to find out whether the comment characters occur within quotation marks
-        int quotationCharacterCounter = 0;
-        
-        //repeat process until no more commment characters are found or until end of string
-        while(commentIndex != string::npos && commentIndex < a_statement.length() - 1) {
-            //make sure the comment characters are not part of a string
-            //count the number of quotation marks that appear before the comment characters
-            for(int i = 0; i < commentIndex; i++) {
-                if(a_statement[i] == '\"') {
-                    quotationCharacterCounter++;
-                }
-            }
-            //if the comment characters are not part of a string (i.e. if there are an even number of quotation characters
-            //before the comment characters,, then a comment has been found and we can remove it
-            if((quotationCharacterCounter % 2) == 0) {
-                a_statement = a_statement.substr(0, commentIndex);
-                return;
-            } else {
-                //if the comment characters are part of a string, look for other comment characters later in the line
-                commentIndex = a_statement.find("//", commentIndex + 2);
-            }
-        }
+        a_string.remove_suffix(1);
     }
-} /** void Statement::RemoveComments(string& a_string) **/
+}/** void Statement::RemoveExtraneousWhiteSpace(string_view& a_string) **/
 
 
@@ -4,6 +4,8 @@
  the DuckInterpreter program to store all the lines of code from a Duck language source file and retreive statements in the given
  Duck code so that these statements can be executed by the DuckInterpreter class. Statement also stores all the labels in a Duck program
  source file and matches them to corresponding lines of code.
+ The source file is mapped into memory (or, if it cannot be mapped, read into a single buffer) and every statement is a view of its
+ line in that buffer: comments, labels and surrounding white space are stripped by narrowing the view rather than by copying the text.
 */
 
 #pragma once
@@ -13,31 +15,125 @@
 #include <map>
 #include <fstream>
 #include <vector>
+#include <string_view>
 #include "DuckInterpreterException.h"
+#include "Lexer.h"
+#include "Token.h"
+
+//The kinds of statements in the Duck language. Invalid is used for a statement whose type could not be determined, and Unreachable
+//for a statement that the ProgramOptimizer found that no path through the program can reach
+enum class StatementType : unsigned char
+{
+    ArithmeticStat,
+    IfStat,
+    ReadStat,
+    PrintStat,
+    StopStat,
+    EndStat,
+    gotoStat,
+    arrayDeclarationStat,
+    Invalid,
+    Unreachable,
+};
+
+//A single recorded statement of a Duck program, along with the tokens it was broken into when it was recorded
+struct CompiledStatement
+{
+    //the text of the statement, without its label, comments and surrounding white space. It views the source buffer of the Statement
+    std::string_view m_text;
+
+    //the tokens of the statement. These only change when the ProgramOptimizer optimizes the recorded program
+    TokenList m_tokens;
+
+    //if the statement could not be fully tokenized, the description of the error (its tokens then end with an Error token)
+    std::string m_lexErrorMessage;
+
+    //the position of the goto keyword of an if or goto statement whose goto part is well formed ("goto <label>;"), -1 otherwise
+    int m_gotoPosition = -1;
+
+    //the statement that the goto part jumps to, resolved once when the program is recorded (valid if m_gotoPosition is not -1)
+    int m_gotoTarget = -1;
+
+    //the type of the statement, determined once when the statement is recorded
+    StatementType m_type = StatementType::Invalid;
+
+    //if the type of the statement is Invalid, the description of the error that is reported when the statement is executed
+    std::string m_classificationError;
+
+    //true if the ProgramOptimizer found that the statement assigns the same value to its variable in every iteration of a loop
+    bool m_isLoopInvariant = false;
+
+    //Returns the next element (token) in the statement.  Returns the next location to be accessed.
+    int ParseNextElement(int a_nextPos, Token &a_token) const;
+
+    //Returns the text of the given token of the statement (empty for numbers), for use in error messages
+    std::string GetElementString(const Token &a_token) const;
+};
+
+//The errors that stop a Duck program from being recorded
+enum class LoadError : unsigned char
+{
+    None,
+    InvalidLabelName,
+    LabelWithoutStatement,
+};
+
+//The statements recorded from one line-aligned chunk of the source of a Duck program. The chunks of a large source are recorded by
+//separate threads, and then merged in order
+struct StatementChunk
+{
+    //the lines of the chunk
+    std::string_view m_source;
+    
+    //the statements of the chunk, in order
+    std::vector<CompiledStatement> m_statements;
+    
+    //the lexer that the statements of the chunk are tokenized with (except for the first chunk, which uses the lexer of the program).
+    //The identifier ids in the tokens of the statements are ids of this lexer until the chunk is merged
+    Lexer m_lexer;
+    
+    //the labels of the chunk, each with the index (within the chunk) of the statement that it labels
+    std::vector<std::pair<std::string_view, int>> m_labels;
+    
+    //the number of stop statements in the chunk
+    int m_stopStatementCount = 0;
+    
+    //the error that recording the chunk stopped at, if any
+    LoadError m_error = LoadError::None;
+    
+    //the label name, if the error is InvalidLabelName
+    std::string_view m_invalidLabelName;
+};
 
 class Statement
 {
 public:
     Statement(){}
-    ~Statement(){}
+    ~Statement();
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
 
     //This function stores all the statements in the Duck language source file
     void RecordStatements(std::string a_sourceFileName);
     
+    //Sets the most threads that record a large source. 0, the default, uses one thread per processor
+    void SetLoadThreadCount(unsigned a_threadCount) { m_loadThreadCount = a_threadCount; }
+    
     
     /**/
     /*
-     std::string GetStatement(int a_statementNum)
+     const CompiledStatement& GetStatement(int a_statementNum) const
      
     NAME
-        GetStatement - Records the statements that are in the specified file.
+        GetStatement - Retrieves a recorded statement along with its tokens
      
     SYNOPSIS
-        std::string GetStatement(int a_statementNum)
+        const CompiledStatement& GetStatement(int a_statementNum) const
             a_statementNum --> The line number of the statement to be returned
      
     DESCRIPTION
-        This function retreives the statement of the Duck program that corresponds to the given line
+        This function retreives the statement of the Duck program that corresponds to the given line. The caller must make sure
+        that the line exists (see GetStatementCount)
      
     RETURNS
         The statement that corresponds to the given line
@@ -46,32 +142,95 @@ public:
         Biplab Thapa Magar
      */
     /**/
-    std::string GetStatement(int a_statementNum) {
-        if(a_statementNum >= m_statements.size()) {
-            throw "Out of Lines.";
-        }
+    const CompiledStatement& GetStatement(int a_statementNum) const {
         return m_statements[a_statementNum];
-	}/*std::string GetStatement(int a_statementNum)*/
+	}/*const CompiledStatement& GetStatement(int a_statementNum) const*/
+    
+    //Returns the number of statements in the Duck program
+    int GetStatementCount() const { return static_cast<int>(m_statements.size()); }
+    
+    //Returns the name of the variable, array or label that has the given identifier id
+    const std::string& GetIdentifierName(int a_identifierId) const { return m_lexer.GetIdentifierName(a_identifierId); }
+    
+    //Returns the number of distinct identifiers in the program. Identifier ids range from 0 to this count - 1
+    int GetIdentifierCount() const { return m_lexer.GetIdentifierCount(); }
     
     //Returns the line that a label is correspondent to
-    int GetLabelLocation(std::string a_labelName);
+    int GetLabelLocation(std::string a_labelName) const;
+    
+    //Returns all the labels of the program, each with the line that it is correspondent to
+    const std::map<std::string, int>& GetLabels() const { return m_labelToStatement; }
+    
+    //Replaces the tokens of a statement with tokens that evaluate to the same values (the ProgramOptimizer folds constant
+    //subexpressions into single numbers this way). a_gotoPosition is the new position of the well formed goto, if the statement has one
+    void ReplaceTokens(int a_statementNum, TokenList a_tokens, int a_gotoPosition) {
+        m_statements[a_statementNum].m_tokens = std::move(a_tokens);
+        m_statements[a_statementNum].m_gotoPosition = a_gotoPosition;
+    }
+    
+    //Marks an assignment as loop invariant (used by the ProgramOptimizer)
+    void MarkLoopInvariant(int a_statementNum) { m_statements[a_statementNum].m_isLoopInvariant = true; }
+    
+    //Marks a statement that can never be executed as Unreachable and drops its tokens. Its text is kept for the reports
+    void MarkUnreachable(int a_statementNum) {
+        CompiledStatement &statement = m_statements[a_statementNum];
+        statement.m_type = StatementType::Unreachable;
+        statement.m_tokens = TokenList();
+        statement.m_gotoPosition = -1;
+        statement.m_gotoTarget = -1;
+    }
 
 private:
+    //the smallest chunk of the source that is worth recording on a thread of its own
+    static const size_t k_minimumChunkLength = 256 * 1024;
+    
+    //the most threads that record a large source, or 0 for one thread per processor
+    unsigned m_loadThreadCount = 0;
+    
     //container to store all the statements in a Duck language program
-    std::vector<std::string> m_statements;
+    std::vector<CompiledStatement> m_statements;
+    
+    //the text of the source file, which the text of every statement views
+    const char *m_source = nullptr;
+    
+    //the length of the source file
+    size_t m_sourceLength = 0;
+    
+    //true if m_source is a memory mapping of the source file, false if it points into m_sourceCopy
+    bool m_sourceIsMapped = false;
+    
+    //the contents of the source file, if it could not be mapped into memory
+    std::string m_sourceCopy;
+    
+    //the lexer used to break every statement into tokens. It also holds the names of all the identifiers in the program
+    Lexer m_lexer;
     
     //container to store all the labels paired with the lines they correspond to
     std::map<std::string, int> m_labelToStatement;
     
+    //Maps the source file into memory, or reads it if it cannot be mapped. Returns false if the file cannot be opened
+    bool LoadSourceFile(const std::string &a_sourceFileName);
+    
     //Returns true if a the string is a legal label name
-    bool ValidLabelName(std::string a_labelName);
+    bool ValidLabelName(std::string_view a_labelName);
     
     //Removes white space from the start and beginning of a string
-    void RemoveExtraneousWhiteSpace(std::string& a_line);
+    void RemoveExtraneousWhiteSpace(std::string_view& a_line);
+    
+    //Determines the type of the statement and validates the left hand side of assignments, storing the result in the statement
+    void ClassifyStatement(CompiledStatement &a_statement);
+    
+    //Resolves the label of every goto (in goto and if statements) to the statement it jumps to. Exits if a label is undefined
+    void ResolveGotoTargets();
+    
+    //Extracts and separates the label, which ends at the given index, from a given statement. Returns false if the label name is invalid
+    bool ExtractLabel(std::string_view& a_statement, size_t a_labelEndIndex, std::string_view &a_labelName);
     
-    //Removes the comments from the given statement
-    void RemoveComments(std::string& a_statement);
+    //Records the statements and labels of one chunk of the source, tokenizing them with the given lexer. Safe to call on several
+    //threads at once for different chunks
+    void RecordChunk(StatementChunk &a_chunk, Lexer &a_lexer);
     
-    //Extracts and separates the label from a given statement
-    void ExtractLabel(std::string& a_statement, std::string &a_labelName);
+    //Adds the statements and labels of a recorded chunk to the program. Chunks must be merged in order. Exits if a label is duplicated
+    //or if recording the chunk stopped at an error
+    void MergeChunk(StatementChunk &a_chunk, bool a_isFirstChunk);
 };
@@ -0,0 +1,209 @@
+#include "StatementFuser.h"
+#include <algorithm>
+
+using namespace std;
+
+
+/**/
+/*
+ vector<FusedStatement> StatementFuser::Fuse()
+
+ NAME
+    Fuse - Finds out how every recorded statement of the Duck program is to be executed
+
+ SYNOPSIS
+    vector<FusedStatement> StatementFuser::Fuse()
+
+ DESCRIPTION
+    Every statement is recognized on its own first. Then every assignment of a variable that is followed by a branch is fused with it,
+    so that the increment and the test at the end of a counted loop take a single step of the DuckInterpreter. The branch keeps its own
+    fused form as well, since it can also be reached by a goto.
+
+ RETURNS
+    How every statement is to be executed, by statement index
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+vector<FusedStatement> StatementFuser::Fuse() {
+    int statementCount = m_statements.GetStatementCount();
+    vector<FusedStatement> fusedStatements(statementCount);
+    for(int statementNum = 0; statementNum < statementCount; statementNum++) {
+        fusedStatements[statementNum] = FuseStatement(m_statements.GetStatement(statementNum));
+    }
+
+    for(int statementNum = 0; statementNum + 1 < statementCount; statementNum++) {
+        FusedStatement &assignment = fusedStatements[statementNum];
+        const FusedStatement &branch = fusedStatements[statementNum + 1];
+        if(assignment.m_kind == FusedKind::AssignVariable && branch.m_kind == FusedKind::Branch) {
+            assignment.m_kind = FusedKind::AssignAndBranch;
+            assignment.m_condition = branch.m_condition;
+            assignment.m_gotoTarget = branch.m_gotoTarget;
+        }
+    }
+    return fusedStatements;
+}/** vector<FusedStatement> StatementFuser::Fuse() **/
+
+
+
+/**/
+/*
+ FusedStatement StatementFuser::FuseStatement(const CompiledStatement &a_statement)
+
+ NAME
+    FuseStatement - Recognizes the shape of a single statement
+
+ SYNOPSIS
+    FusedStatement StatementFuser::FuseStatement(const CompiledStatement &a_statement)
+        a_statement --> The statement to be recognized
+
+ DESCRIPTION
+    The tokens of the statement must match one of the shapes exactly, up to the semicolon (or, for an if statement, up to the well formed
+    goto that was found when the statement was recorded). A loop invariant assignment of one of the other shapes keeps that shape, which
+    is cheaper to execute than to check. A statement that could not be fully tokenized is never fused, so that its
+    error is reported by the DuckInterpreter at the element that is in error.
+
+ RETURNS
+    The fused statement, of kind None if the statement has none of the shapes
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+FusedStatement StatementFuser::FuseStatement(const CompiledStatement &a_statement) {
+    FusedStatement fused;
+    if(!a_statement.m_lexErrorMessage.empty()) {
+        return fused;
+    }
+    const TokenList &tokens = a_statement.m_tokens;
+    int tokenCount = static_cast<int>(tokens.size());
+
+    if(a_statement.m_type == StatementType::ArithmeticStat && tokenCount >= 4 && tokens[0].m_type == TokenType::Identifier) {
+        //x = <value>;
+        if(tokens[1].IsOperator(OperatorCode::Assign) && tokens[tokenCount - 1].IsOperator(OperatorCode::Semicolon) &&
+           ReadValue(tokens, 2, tokenCount - 1, fused.m_value)) {
+            fused.m_kind = FusedKind::AssignVariable;
+            fused.m_slot = tokens[0].m_identifierId;
+            return fused;
+        }
+
+        //a[<operand>] = <value>; or a[<operand>] = <any expression>;
+        if(tokenCount >= 6 && tokens[1].IsOperator(OperatorCode::OpenBracket) && ReadOperand(tokens, 2, fused.m_index) &&
+           tokens[3].IsOperator(OperatorCode::CloseBracket) && tokens[4].IsOperator(OperatorCode::Assign)) {
+            fused.m_kind = FusedKind::StoreArrayElement;
+            fused.m_slot = tokens[0].m_identifierId;
+            if(!tokens[tokenCount - 1].IsOperator(OperatorCode::Semicolon) || !ReadValue(tokens, 5, tokenCount - 1, fused.m_value)) {
+                fused.m_valuePosition = 5;
+            }
+            return fused;
+        }
+    }
+
+    //if (<operand> <operator> <operand>) goto label; (a single operand in parentheses is an error in an arithmetic expression)
+    int gotoPosition = a_statement.m_gotoPosition;
+    if(a_statement.m_type == StatementType::IfStat && gotoPosition == 6 && tokens[0].IsKeyword(Keyword::If) &&
+       tokens[1].IsOperator(OperatorCode::OpenParenthesis) && tokens[5].IsOperator(OperatorCode::CloseParenthesis) &&
+       ReadValue(tokens, 2, 5, fused.m_condition)) {
+        fused.m_kind = FusedKind::Branch;
+        fused.m_gotoTarget = a_statement.m_gotoTarget;
+        return fused;
+    }
+
+    //a loop invariant x = <expression>; (the ProgramOptimizer made sure that it is made of numbers, variables and operators only)
+    if(a_statement.m_isLoopInvariant) {
+        fused.m_kind = FusedKind::InvariantAssignment;
+        fused.m_slot = tokens[0].m_identifierId;
+        for(int position = 2; position < tokenCount - 1; position++) {
+            int slot = tokens[position].m_identifierId;
+            if(tokens[position].m_type == TokenType::Identifier &&
+               find(fused.m_operandSlots.begin(), fused.m_operandSlots.end(), slot) == fused.m_operandSlots.end()) {
+                fused.m_operandSlots.push_back(slot);
+            }
+        }
+    }
+    return fused;
+}/** FusedStatement StatementFuser::FuseStatement(const CompiledStatement &a_statement) **/
+
+
+
+/**/
+/*
+ bool StatementFuser::ReadOperand(const TokenList &a_tokens, int a_position, FusedOperand &a_operand)
+
+ NAME
+    ReadOperand - Reads a variable or a number
+
+ SYNOPSIS
+    bool StatementFuser::ReadOperand(const TokenList &a_tokens, int a_position, FusedOperand &a_operand)
+        a_tokens --> The tokens of the statement
+        a_position --> The position of the token to be read
+        a_operand --> Set to the operand
+
+ DESCRIPTION
+    An identifier is read as a variable. The callers make sure that it is not followed by '[', which would make it an array.
+
+ RETURNS
+    True if the token is a variable or a number, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool StatementFuser::ReadOperand(const TokenList &a_tokens, int a_position, FusedOperand &a_operand) {
+    const Token &token = a_tokens[a_position];
+    if(token.m_type == TokenType::Number) {
+        a_operand.m_slot = -1;
+        a_operand.m_number = token.m_numValue;
+        return true;
+    }
+    if(token.m_type == TokenType::Identifier) {
+        a_operand.m_slot = token.m_identifierId;
+        return true;
+    }
+    return false;
+}/** bool StatementFuser::ReadOperand(const TokenList &a_tokens, int a_position, FusedOperand &a_operand) **/
+
+
+
+/**/
+/*
+ bool StatementFuser::ReadValue(const TokenList &a_tokens, int a_position, int a_endPosition, FusedValue &a_value)
+
+ NAME
+    ReadValue - Reads an operand, or a binary operator applied to two operands
+
+ SYNOPSIS
+    bool StatementFuser::ReadValue(const TokenList &a_tokens, int a_position, int a_endPosition, FusedValue &a_value)
+        a_tokens --> The tokens of the statement
+        a_position --> The position of the first token of the value
+        a_endPosition --> The position of the token after the value (a semicolon, ')' or the end of the statement)
+        a_value --> Set to the value
+
+ DESCRIPTION
+    The operator can be any binary arithmetic or comparison operator. The binary '!' is left to the DuckInterpreter.
+
+ RETURNS
+    True if the tokens are a value of one of the two shapes, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+bool StatementFuser::ReadValue(const TokenList &a_tokens, int a_position, int a_endPosition, FusedValue &a_value) {
+    if(a_endPosition - a_position == 1) {
+        a_value.m_isBinary = false;
+        return ReadOperand(a_tokens, a_position, a_value.m_left);
+    }
+    if(a_endPosition - a_position != 3) {
+        return false;
+    }
+    const Token &operatorToken = a_tokens[a_position + 1];
+    if(!operatorToken.IsArithmeticOperator() || operatorToken.m_operator == OperatorCode::Not ||
+       operatorToken.m_operator == OperatorCode::OpenParenthesis || operatorToken.m_operator == OperatorCode::CloseParenthesis) {
+        return false;
+    }
+    a_value.m_isBinary = true;
+    a_value.m_operator = ToExpressionOperator(operatorToken.m_operator, false);
+    return ReadOperand(a_tokens, a_position, a_value.m_left) && ReadOperand(a_tokens, a_position + 2, a_value.m_right);
+}/** bool StatementFuser::ReadValue(const TokenList &a_tokens, int a_position, int a_endPosition, FusedValue &a_value) **/
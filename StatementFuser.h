@@ -0,0 +1,115 @@
+/* StatementFuser.h
+ StatementFuser.h contains the StatementFuser class and the FusedStatement and InvariantSnapshot structs
+ StatementFuser is the class that looks for the statements of a Duck program that follow the most common simple shapes when the program
+ is recorded: assignments of a variable or a number, or of one operator applied to two of them (x = x + 1;), stores of such a value into
+ an array element with a simple index (a[i] = x;), and if statements whose condition is one operator applied to two variables or numbers
+ (if (i < n) goto top;). An assignment that is followed by such an if statement (the end of a counted loop) is fused with it into a
+ single operation. A loop invariant assignment (see ProgramOptimizer) that has none of these shapes is executed only when its variable
+ or the variables that it reads no longer hold the values that it last left them with. The DuckInterpreter executes a fused statement
+ with a handler of its own, which reads the variables straight from their slots instead of walking the tokens of the statement through
+ the shunting yard algorithm. The handlers evaluate the operands and the operators in the same order as the DuckInterpreter does, so the
+ results and the errors (and the line they are reported against) are the same.
+*/
+
+#pragma once
+
+#include <vector>
+#include "Statement.h"
+#include "Token.h"
+#include "ExpressionOperator.h"
+
+//The shapes of the statements (and pairs of statements) that are executed by a handler of their own
+enum class FusedKind : unsigned char
+{
+    //the statement is executed by the DuckInterpreter as usual
+    None,
+    //x = <value>;
+    AssignVariable,
+    //a[<operand>] = <value>; (the value may also be any expression, which is then evaluated as usual)
+    StoreArrayElement,
+    //if (<operand> <operator> <operand>) goto label;
+    Branch,
+    //x = <value>; followed by such an if statement on the next line
+    AssignAndBranch,
+    //x = <any expression of numbers and variables>; that is loop invariant
+    InvariantAssignment,
+};
+
+//An operand of a fused statement: a variable or a number
+struct FusedOperand
+{
+    //the slot of the variable, or -1 if the operand is a number
+    int m_slot = -1;
+
+    //the number, if the operand is a number
+    double m_number = 0;
+};
+
+//A value of a fused statement: a single operand, or a binary operator applied to two operands
+struct FusedValue
+{
+    FusedOperand m_left;
+    FusedOperand m_right;
+
+    //true if the value is m_left m_operator m_right, false if it is just m_left
+    bool m_isBinary = false;
+    ExpressionOperator m_operator = ExpressionOperator::Add;
+};
+
+//How a statement (or a pair of statements) is executed
+struct FusedStatement
+{
+    FusedKind m_kind = FusedKind::None;
+
+    //the slot of the variable or the array that is assigned, and the value assigned to it
+    int m_slot = -1;
+    FusedValue m_value;
+
+    //the index of the array element that is assigned
+    FusedOperand m_index;
+
+    //the position of the token at which the value assigned to the array element starts, if the value is not a FusedValue (-1 otherwise)
+    int m_valuePosition = -1;
+
+    //the condition of the branch, and the statement that the branch goes to if the condition is met
+    FusedValue m_condition;
+    int m_gotoTarget = -1;
+
+    //the slots of the variables that a loop invariant assignment reads, and the index of its InvariantSnapshot
+    std::vector<int> m_operandSlots;
+    int m_snapshot = -1;
+};
+
+//The values that a loop invariant assignment last left its variable and its operands with. Kept by the DuckInterpreter
+struct InvariantSnapshot
+{
+    //false until the assignment has been executed
+    bool m_isTaken = false;
+
+    //the value of the variable, followed by the values of the operands
+    std::vector<double> m_values;
+};
+
+class StatementFuser
+{
+public:
+    StatementFuser(const Statement &a_statements) : m_statements(a_statements) {}
+    ~StatementFuser() {}
+
+    //Returns how every recorded statement is to be executed, by statement index
+    std::vector<FusedStatement> Fuse();
+
+private:
+    //The statements being fused
+    const Statement &m_statements;
+
+    //Recognizes a single statement. Returns a FusedStatement of kind None if it has none of the shapes
+    FusedStatement FuseStatement(const CompiledStatement &a_statement);
+
+    //Reads the operand at the given token. Returns false if the token is not a variable or a number
+    static bool ReadOperand(const TokenList &a_tokens, int a_position, FusedOperand &a_operand);
+
+    //Reads the value that starts at the given token and ends at the given token. Returns false if it is not an operand or a binary
+    //operator applied to two operands
+    static bool ReadValue(const TokenList &a_tokens, int a_position, int a_endPosition, FusedValue &a_value);
+};
@@ -0,0 +1,292 @@
+#include "StatementProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+
+//The profiler whose report is written when the program exits
+static StatementProfiler *s_activeProfiler = nullptr;
+
+//Writes the report of the active profiler. Registered with atexit
+static void FinishActiveProfiler() {
+    if(s_activeProfiler != nullptr) {
+        s_activeProfiler->Finish();
+    }
+}
+
+//Returns the number of seconds in the given duration
+static double ToSeconds(chrono::steady_clock::duration a_duration) {
+    return chrono::duration<double>(a_duration).count();
+}
+
+//Writes the given text as a JSON string, with the characters that JSON does not allow in a string escaped
+static void WriteJsonString(ostream &a_stream, string_view a_text) {
+    a_stream << '\"';
+    for(char character : a_text) {
+        if(character == '\"' || character == '\\') {
+            a_stream << '\\' << character;
+        } else if(static_cast<unsigned char>(character) < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", character);
+            a_stream << escape;
+        } else {
+            a_stream << character;
+        }
+    }
+    a_stream << '\"';
+}
+
+
+/**/
+/*
+ StatementProfiler::StatementProfiler(const Statement &a_statements, const string &a_jsonFileName)
+
+ NAME
+    StatementProfiler::StatementProfiler - Creates a profiler for the statements of a Duck program
+
+ SYNOPSIS
+    StatementProfiler::StatementProfiler(const Statement &a_statements, const string &a_jsonFileName)
+        a_statements --> The recorded statements of the program to be profiled
+        a_jsonFileName --> The file that the report is to be written to as JSON, or an empty string
+
+ DESCRIPTION
+    Makes room for the profile of every statement of the program. The statements must have been recorded already.
+
+ RETURNS
+    Nothing
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+StatementProfiler::StatementProfiler(const Statement &a_statements, const string &a_jsonFileName)
+    : m_statements(a_statements), m_profiles(a_statements.GetStatementCount()), m_jsonFileName(a_jsonFileName) {
+}/** StatementProfiler::StatementProfiler(const Statement &a_statements, const string &a_jsonFileName) **/
+
+
+
+/**/
+/*
+ void StatementProfiler::Start()
+
+ NAME
+    StatementProfiler::Start - Starts the profile
+
+ SYNOPSIS
+    void StatementProfiler::Start()
+
+ DESCRIPTION
+    Records when the program started, and makes sure that the report is written when the program exits, however it exits.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void StatementProfiler::Start() {
+    s_activeProfiler = this;
+    atexit(FinishActiveProfiler);
+    m_startTime = chrono::steady_clock::now();
+}/** void StatementProfiler::Start() **/
+
+
+
+/**/
+/*
+ void StatementProfiler::Finish()
+
+ NAME
+    StatementProfiler::Finish - Ends the profile and writes the report
+
+ SYNOPSIS
+    void StatementProfiler::Finish()
+
+ DESCRIPTION
+    The statement that was being executed when the program exited (a stop statement, or the statement that caused an error) is
+    timed up to now. The statements that were executed are then sorted by the time spent executing them, and the report is written
+    to the standard error stream, after the output and the errors of the program, and as JSON to the report file, if there is one.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void StatementProfiler::Finish() {
+    if(m_finished) {
+        return;
+    }
+    m_finished = true;
+    if(m_currentStatement >= 0) {
+        EndStatement();
+    }
+    double totalSeconds = ToSeconds(chrono::steady_clock::now() - m_startTime);
+
+    vector<int> order;
+    for(int i = 0; i < static_cast<int>(m_profiles.size()); i++) {
+        if(m_profiles[i].m_count != 0) {
+            order.push_back(i);
+        }
+    }
+    //the most time consuming statements first. Statements that took the same time stay in program order
+    stable_sort(order.begin(), order.end(), [this](int a_left, int a_right) {
+        return m_profiles[a_left].m_time > m_profiles[a_right].m_time;
+    });
+
+    WriteReport(cerr, order, totalSeconds);
+    if(!m_jsonFileName.empty()) {
+        ofstream jsonFile(m_jsonFileName);
+        if(!jsonFile) {
+            cerr << "Could not write the profile to the file: " << m_jsonFileName << endl;
+            return;
+        }
+        WriteJsonReport(jsonFile, order, totalSeconds);
+    }
+}/** void StatementProfiler::Finish() **/
+
+
+
+/**/
+/*
+ vector<string> StatementProfiler::GetStatementLabels() const
+
+ NAME
+    StatementProfiler::GetStatementLabels - Returns the label of every statement
+
+ SYNOPSIS
+    vector<string> StatementProfiler::GetStatementLabels() const
+
+ DESCRIPTION
+    Turns the labels of the program, which map a label to its statement, around.
+
+ RETURNS
+    The label of every statement, indexed by line number. Statements without a label have an empty label
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+vector<string> StatementProfiler::GetStatementLabels() const {
+    vector<string> labels(m_profiles.size());
+    const map<string, int> &labelToStatement = m_statements.GetLabels();
+    for(map<string, int>::const_iterator it = labelToStatement.begin(); it != labelToStatement.end(); it++) {
+        labels[it->second] = it->first;
+    }
+    return labels;
+}/** vector<string> StatementProfiler::GetStatementLabels() const **/
+
+
+
+/**/
+/*
+ void StatementProfiler::WriteReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const
+
+ NAME
+    StatementProfiler::WriteReport - Writes the report as text
+
+ SYNOPSIS
+    void StatementProfiler::WriteReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const
+        a_stream --> The stream that the report is written to
+        a_order --> The statements to be reported, in the order that they are to be reported
+        a_totalSeconds --> The time that the program ran for
+
+ DESCRIPTION
+    Writes one row per statement: its line number (as errors report it), its label, the number of times it was executed, the time
+    spent executing it and the share of the running time of the program that this is, the number of times the goto of an if statement
+    was and was not taken, and the text of the statement.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void StatementProfiler::WriteReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const {
+    vector<string> labels = GetStatementLabels();
+    uint64_t executedCount = 0;
+    for(size_t i = 0; i < m_profiles.size(); i++) {
+        executedCount += m_profiles[i].m_count;
+    }
+
+    ios_base::fmtflags flags = a_stream.flags();
+    streamsize precision = a_stream.precision();
+    a_stream << endl << "Profile: " << executedCount << " statements executed in " << fixed << setprecision(3) << a_totalSeconds * 1000
+             << " ms" << endl;
+    a_stream << setw(6) << "Line" << "  " << left << setw(12) << "Label" << right << setw(12) << "Count" << setw(14) << "Time (ms)"
+             << setw(8) << "Time %" << setw(10) << "Taken" << setw(10) << "Not taken" << "  Statement" << endl;
+    for(size_t i = 0; i < a_order.size(); i++) {
+        int statementNum = a_order[i];
+        const StatementProfile &profile = m_profiles[statementNum];
+        double seconds = ToSeconds(profile.m_time);
+        a_stream << setw(6) << statementNum + 1 << "  " << left << setw(12) << labels[statementNum] << right << setw(12) << profile.m_count
+                 << setw(14) << setprecision(3) << seconds * 1000 << setw(7) << setprecision(1)
+                 << (a_totalSeconds > 0 ? seconds / a_totalSeconds * 100 : 0) << '%';
+        if(m_statements.GetStatement(statementNum).m_type == StatementType::IfStat) {
+            a_stream << setw(10) << profile.m_takenCount << setw(10) << profile.m_notTakenCount;
+        } else {
+            a_stream << setw(10) << "-" << setw(10) << "-";
+        }
+        a_stream << "  " << m_statements.GetStatement(statementNum).m_text << endl;
+    }
+    a_stream.flags(flags);
+    a_stream.precision(precision);
+}/** void StatementProfiler::WriteReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const **/
+
+
+
+/**/
+/*
+ void StatementProfiler::WriteJsonReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const
+
+ NAME
+    StatementProfiler::WriteJsonReport - Writes the report as JSON
+
+ SYNOPSIS
+    void StatementProfiler::WriteJsonReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const
+        a_stream --> The stream that the report is written to
+        a_order --> The statements to be reported, in the order that they are to be reported
+        a_totalSeconds --> The time that the program ran for
+
+ DESCRIPTION
+    Writes the same information as WriteReport, as a JSON object with the running time of the program and an array of statements.
+    Times are in seconds. The if statement counts are only written for if statements.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+void StatementProfiler::WriteJsonReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const {
+    vector<string> labels = GetStatementLabels();
+    a_stream << setprecision(9);
+    a_stream << "{" << endl;
+    a_stream << "  \"total_seconds\": " << a_totalSeconds << "," << endl;
+    a_stream << "  \"statements\": [";
+    for(size_t i = 0; i < a_order.size(); i++) {
+        int statementNum = a_order[i];
+        const StatementProfile &profile = m_profiles[statementNum];
+        const CompiledStatement &statement = m_statements.GetStatement(statementNum);
+        double seconds = ToSeconds(profile.m_time);
+        a_stream << (i == 0 ? "" : ",") << endl << "    {\"line\": " << statementNum + 1 << ", \"label\": ";
+        WriteJsonString(a_stream, labels[statementNum]);
+        a_stream << ", \"text\": ";
+        WriteJsonString(a_stream, statement.m_text);
+        a_stream << ", \"count\": " << profile.m_count << ", \"seconds\": " << seconds
+                 << ", \"share\": " << (a_totalSeconds > 0 ? seconds / a_totalSeconds : 0);
+        if(statement.m_type == StatementType::IfStat) {
+            a_stream << ", \"taken\": " << profile.m_takenCount << ", \"not_taken\": " << profile.m_notTakenCount;
+        }
+        a_stream << "}";
+    }
+    a_stream << endl << "  ]" << endl << "}" << endl;
+}/** void StatementProfiler::WriteJsonReport(ostream &a_stream, const vector<int> &a_order, double a_totalSeconds) const **/
@@ -0,0 +1,90 @@
+/* StatementProfiler.h
+ StatementProfiler.h contains the StatementProfiler class
+ StatementProfiler is the class that profiles a Duck program as the DuckInterpreter runs it (with the --profile option). For every
+ statement, it counts how many times the statement was executed and how much time was spent executing it, and for if statements, how
+ many times the goto was taken. When the program exits (a Duck program always ends with exit, after a stop statement or an error), the
+ statements are reported from the most to the least time consuming, and the report can also be written to a file as JSON.
+ The profiler is only called from a separate, instrumented copy of the interpreter's loop, so it costs nothing when it is not in use.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Statement.h"
+
+class StatementProfiler
+{
+public:
+    StatementProfiler(const Statement &a_statements, const std::string &a_jsonFileName);
+    ~StatementProfiler() {}
+
+    //Starts the profile. The report is written when the program exits
+    void Start();
+
+    //Counts an execution of the given statement and starts timing it
+    void StartStatement(int a_statementNum) {
+        m_profiles[a_statementNum].m_count++;
+        m_currentStatement = a_statementNum;
+        m_statementStartTime = std::chrono::steady_clock::now();
+    }
+
+    //Stops timing the statement that is being executed
+    void EndStatement() {
+        m_profiles[m_currentStatement].m_time += std::chrono::steady_clock::now() - m_statementStartTime;
+        m_currentStatement = -1;
+    }
+
+    //Counts whether the goto of the given if statement was taken
+    void CountIfOutcome(int a_statementNum, bool a_taken) {
+        if(a_taken) {
+            m_profiles[a_statementNum].m_takenCount++;
+        } else {
+            m_profiles[a_statementNum].m_notTakenCount++;
+        }
+    }
+
+    //Stops timing the statement that is being executed, if any, and writes the report
+    void Finish();
+
+private:
+    //What was recorded for a single statement
+    struct StatementProfile
+    {
+        uint64_t m_count = 0;
+        std::chrono::steady_clock::duration m_time = std::chrono::steady_clock::duration::zero();
+        uint64_t m_takenCount = 0;
+        uint64_t m_notTakenCount = 0;
+    };
+
+    //The statements of the program being profiled
+    const Statement &m_statements;
+
+    //What was recorded for every statement, indexed by line number
+    std::vector<StatementProfile> m_profiles;
+
+    //The file that the report is written to as JSON. Empty if the report is not to be written as JSON
+    std::string m_jsonFileName;
+
+    //The statement that is being executed, or -1 if none is
+    int m_currentStatement = -1;
+
+    //When the statement that is being executed started, and when the program started
+    std::chrono::steady_clock::time_point m_statementStartTime;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    //Set once the report has been written
+    bool m_finished = false;
+
+    //Returns the label of every statement (empty for statements without one)
+    std::vector<std::string> GetStatementLabels() const;
+
+    //Writes the report for the given statements, in the given order, as text
+    void WriteReport(std::ostream &a_stream, const std::vector<int> &a_order, double a_totalSeconds) const;
+
+    //Writes the report for the given statements, in the given order, as JSON
+    void WriteJsonReport(std::ostream &a_stream, const std::vector<int> &a_order, double a_totalSeconds) const;
+};
@@ -4,32 +4,28 @@ using namespace std;
 
 /**/
 /*
- bool SymbolTable::GetVariableValue(string a_variable, double &a_value)
+ void SymbolTable::SetSlotCount(int a_slotCount)
  
  NAME
- SymbolTable::GetVariableValue - Retrieves the value stored in the given variable
+ SymbolTable::SetSlotCount - Makes room for the given number of variable slots
  
  SYNOPSIS
-    bool SymbolTable::GetVariableValue(string a_variable, double &a_value)
-        a_variable --> The variable whose value is to be retrieved
-        a_value --> The value to be retrieved
+    void SymbolTable::SetSlotCount(int a_slotCount)
+        a_slotCount --> The number of slots (distinct identifiers) in the Duck program
  
  DESCRIPTION
-    Retrieves the value stored in the given variable. If no such variable exists, then returns False;
+    Sizes the value array and the assigned bitset so that every slot from 0 to a_slotCount - 1 can be accessed directly.
+    Slots that are added start out unassigned.
  
  RETURNS
-    True if the variable of which the value is to be retrieved exists. False otherwise
+    void
  
  AUTHOR
-    Biplab Thapa Magar
+    Duck interpreter contributors
  */
 /**/
-bool SymbolTable::GetVariableValue(string a_variable, double &a_value)
+void SymbolTable::SetSlotCount(int a_slotCount)
 {
-    if(m_SymbolTable.count(a_variable) == 0) {
-        return false;
-    } else {
-        a_value = m_SymbolTable.find(a_variable)->second;
-        return true;
-    }
-} /** bool SymbolTable::GetVariableValue(string a_variable, double &a_value) **/
+    m_values.resize(a_slotCount, 0);
+    m_assigned.resize(a_slotCount, false);
+} /** void SymbolTable::SetSlotCount(int a_slotCount) **/
@@ -2,13 +2,14 @@
  SymbolTable.h contains the SymbolTable class.
  SymbolTable is a class that represents a collection of variables and the values they store. It is utilized by the 
  DuckInterpreter program to store and retreive the values stored in variables.
+ Every variable is identified by a slot: the dense id that its name was given when the Duck program was tokenized. The values
+ are stored in a contiguous array indexed by slot, along with a bitset that records which slots have been assigned a value.
  */
 
 
 #pragma once
 
-#include <unordered_map>
-#include <string>
+#include <vector>
 
 // This class will provide a mapping between the variables and their associated data.
 class SymbolTable
@@ -17,16 +18,19 @@ public:
     SymbolTable(){}
     ~SymbolTable(){}
 
+    //Makes room for the given number of variable slots. All the slots start out unassigned
+    void SetSlotCount(int a_slotCount);
+
     /**/
     /*
-    void RecordVariableValue(std::string a_variable, double a_value)
+    void RecordVariableValue(int a_slot, double a_value)
      
     NAME
         RecordVariableValue - Assigns the given variable to the given value
      
     SYNOPSIS
-        void RecordVariableValue(std::string a_variable, double a_value)
-        a_variable --> The variable whose value is to be assigned the given value
+        void RecordVariableValue(int a_slot, double a_value)
+        a_slot --> The slot of the variable whose value is to be assigned the given value
         a_value --> The value that is to be assigned to the given variable
      
     DESCRIPTION
@@ -39,14 +43,52 @@ public:
         Biplab Thapa Magar
      */
     /**/
-    void RecordVariableValue(std::string a_variable, double a_value) {
-		m_SymbolTable[a_variable] = a_value;
-	}/*void RecordVariableValue(std::string a_variable, double a_value)*/
+    void RecordVariableValue(int a_slot, double a_value) {
+		m_values[a_slot] = a_value;
+        m_assigned[a_slot] = true;
+	}/*void RecordVariableValue(int a_slot, double a_value)*/
     
-	// Get the value of a variable.  Returns false if the variable does not exist.
-    bool GetVariableValue( std::string a_variable, double &a_value );
+    /**/
+    /*
+    bool GetVariableValue(int a_slot, double &a_value) const
+     
+    NAME
+        GetVariableValue - Retrieves the value stored in the given variable
+     
+    SYNOPSIS
+        bool GetVariableValue(int a_slot, double &a_value) const
+        a_slot --> The slot of the variable whose value is to be retrieved
+        a_value --> The value to be retrieved
+     
+    DESCRIPTION
+        Retrieves the value stored in the given variable. If the variable has not been assigned a value, then returns false
+     
+    RETURNS
+        True if the variable has been assigned a value. False otherwise
+     
+    AUTHOR
+        Biplab Thapa Magar
+     */
+    /**/
+    bool GetVariableValue(int a_slot, double &a_value) const {
+        if(!m_assigned[a_slot]) {
+            return false;
+        }
+        a_value = m_values[a_slot];
+        return true;
+    }/*bool GetVariableValue(int a_slot, double &a_value) const*/
+
+    //Returns true if the variable in the given slot has been assigned a value
+    bool IsAssigned(int a_slot) const { return m_assigned[a_slot]; }
+
+    //Returns the values of all the variables, indexed by slot. Code compiled by the DuckJit reads and writes the values of variables
+    //that have already been assigned through this array directly
+    double* GetValueArray() { return m_values.data(); }
 
 private:
-    //container to store all variables and the values they store as a key/value pair
-    std::unordered_map<std::string, double> m_SymbolTable;
+    //the values of all the variables, indexed by slot
+    std::vector<double> m_values;
+
+    //whether each slot has been assigned a value
+    std::vector<bool> m_assigned;
 };             
@@ -0,0 +1,101 @@
+/* Token.h
+ Token.h contains the Token struct and the enums used to describe it.
+ A Token is a single element of a Duck statement (a number, a variable name, a keyword, a string or a syntactic character such as
+ '+', '==' or ';'). Every statement is broken into tokens once, when the Duck program is recorded, so that the DuckInterpreter can walk
+ the tokens of a statement every time it is executed instead of lexing the statement's text again.
+*/
+
+#pragma once
+
+#include <vector>
+
+//The kind of element that a token represents
+enum class TokenType : unsigned char
+{
+    Number,
+    Identifier,
+    Keyword,
+    String,
+    Operator,
+    //marks the place in a statement where the statement could not be broken into tokens
+    Error,
+    //an empty token, used as the initial value of tokens that have not been parsed yet
+    None,
+};
+
+//The reserved keywords of the Duck language
+enum class Keyword : unsigned char
+{
+    Dim,
+    Read,
+    Goto,
+    If,
+    Print,
+    Stop,
+    End,
+    None,
+};
+
+//The syntactic characters of the Duck language. The arithmetic operators come first (up to and including CloseParenthesis)
+enum class OperatorCode : unsigned char
+{
+    Plus,
+    Minus,
+    Multiply,
+    Divide,
+    Not,
+    Less,
+    Greater,
+    LessEqual,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    OpenParenthesis,
+    CloseParenthesis,
+    OpenBracket,
+    CloseBracket,
+    Assign,
+    Semicolon,
+    Comma,
+    None,
+};
+
+struct Token
+{
+    //what kind of element the token is
+    TokenType m_type = TokenType::None;
+
+    //the operator or syntactic character, if the token is of type Operator
+    OperatorCode m_operator = OperatorCode::None;
+
+    //the keyword, if the token is of type Keyword
+    Keyword m_keyword = Keyword::None;
+
+    //the interned id of the variable, array or label name, if the token is of type Identifier
+    int m_identifierId = -1;
+
+    //the value of the number, if the token is of type Number
+    double m_numValue = 0;
+
+    //the position and the length of the token's text within its statement
+    int m_start = 0;
+    int m_length = 0;
+
+    //Returns true if the token is the given operator or syntactic character
+    bool IsOperator(OperatorCode a_operator) const {
+        return m_type == TokenType::Operator && m_operator == a_operator;
+    }
+
+    //Returns true if the token is an arithmetic operator (such as +, ==, ! or a parenthesis)
+    bool IsArithmeticOperator() const {
+        return m_type == TokenType::Operator && m_operator <= OperatorCode::CloseParenthesis;
+    }
+
+    //Returns true if the token is the given reserved keyword
+    bool IsKeyword(Keyword a_keyword) const {
+        return m_type == TokenType::Keyword && m_keyword == a_keyword;
+    }
+};
+
+//The tokens of a single statement, in the order that they appear in the statement
+typedef std::vector<Token> TokenList;
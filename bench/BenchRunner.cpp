@@ -0,0 +1,360 @@
+// BenchRunner.cpp : Runs the Duck programs of the benchmark suite and reports how fast the interpreter ran them.
+//
+// Usage: benchRunner <duckInterp> <bench directory> <runs> <results file> <baseline file | -> <tolerance %> [interpreter options]
+//
+// Every .duck program of the bench directory is run (with the .in file of the same name as its standard input, if there is one):
+// once with --profile to count the statements that it executes, once more to find how many times it must be run in a row to take
+// k_minimumSampleSeconds, then <runs> times that many times to be timed, the programs taking turns. The median and the minimum wall
+// time of one run, the statements executed per second and the peak resident set size of every program are written to the results
+// file as JSON, one benchmark per line.
+// If a baseline file (a results file saved earlier) exists, every program whose minimum wall time is both more than <tolerance> percent
+// and more than k_noiseFloorSeconds longer than in the baseline is reported as a regression, and the runner exits with status 1.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+//What was measured for one program of the suite
+struct BenchResult
+{
+    string m_name;
+    long long m_statements = 0;
+    double m_medianSeconds = 0;
+    double m_minimumSeconds = 0;
+    long m_peakRssKilobytes = 0;
+    int m_repeats = 1;
+};
+
+//How long one timed sample of a program lasts at least: a program that runs for less is run several times in a row for every sample, so
+//that the start of the process and the noise of the machine are small against what is measured
+const double k_minimumSampleSeconds = 0.5;
+
+//How much longer than in the baseline a run must be, whatever the tolerance, to be reported as a regression
+const double k_noiseFloorSeconds = 0.002;
+
+
+
+/**/
+/*
+ static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, double &a_seconds, long &a_peakRssKilobytes)
+
+ NAME
+    RunProgram - Runs a program and measures it
+
+ SYNOPSIS
+    static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, double &a_seconds, long &a_peakRssKilobytes)
+        a_arguments --> The program to be run, followed by its arguments
+        a_inputFileName --> The file to be used as the standard input of the program, or an empty string for /dev/null
+        a_seconds --> Set to the wall time that the program ran for
+        a_peakRssKilobytes --> Set to the peak resident set size of the program
+
+ DESCRIPTION
+    Runs the program with its standard output and standard error discarded, and waits for it with wait4, which also gives the resource
+    usage of the program (and nothing else).
+
+ RETURNS
+    True if the program exited with status 0, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, double &a_seconds, long &a_peakRssKilobytes) {
+    vector<char *> argv;
+    for(size_t i = 0; i < a_arguments.size(); i++) {
+        argv.push_back(const_cast<char *>(a_arguments[i].c_str()));
+    }
+    argv.push_back(nullptr);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    pid_t child = fork();
+    if(child < 0) {
+        return false;
+    }
+    if(child == 0) {
+        int input = open(a_inputFileName.empty() ? "/dev/null" : a_inputFileName.c_str(), O_RDONLY);
+        int output = open("/dev/null", O_WRONLY);
+        if(input < 0 || output < 0) {
+            _exit(127);
+        }
+        dup2(input, STDIN_FILENO);
+        dup2(output, STDOUT_FILENO);
+        dup2(output, STDERR_FILENO);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if(wait4(child, &status, 0, &usage) < 0) {
+        return false;
+    }
+    a_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    a_peakRssKilobytes = usage.ru_maxrss;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}/** static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, double &a_seconds, long &a_peakRssKilobytes) **/
+
+
+
+/**/
+/*
+ static long long CountStatements(const string &a_interpreter, const string &a_programFileName, const string &a_inputFileName)
+
+ NAME
+    CountStatements - Counts the statements that a Duck program executes
+
+ SYNOPSIS
+    static long long CountStatements(const string &a_interpreter, const string &a_programFileName, const string &a_inputFileName)
+        a_interpreter --> The Duck interpreter
+        a_programFileName --> The Duck program
+        a_inputFileName --> The standard input of the program, or an empty string
+
+ DESCRIPTION
+    Runs the program once with --profile, writing the profile to a temporary file as JSON, and adds up the execution counts of all
+    the statements in the profile.
+
+ RETURNS
+    The number of statements executed, or -1 if the program could not be profiled
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static long long CountStatements(const string &a_interpreter, const string &a_programFileName, const string &a_inputFileName) {
+    char profileFileName[] = "/tmp/duckBenchProfileXXXXXX";
+    int profileFile = mkstemp(profileFileName);
+    if(profileFile < 0) {
+        return -1;
+    }
+    close(profileFile);
+
+    double seconds;
+    long peakRssKilobytes;
+    vector<string> arguments = {a_interpreter, string("--profile=") + profileFileName, a_programFileName};
+    long long statements = -1;
+    if(RunProgram(arguments, a_inputFileName, seconds, peakRssKilobytes)) {
+        ifstream profile(profileFileName);
+        stringstream contents;
+        contents << profile.rdbuf();
+        string text = contents.str();
+        const string countKey = "\"count\": ";
+        statements = 0;
+        for(size_t position = text.find(countKey); position != string::npos; position = text.find(countKey, position + 1)) {
+            statements += atoll(text.c_str() + position + countKey.length());
+        }
+    }
+    unlink(profileFileName);
+    return statements;
+}/** static long long CountStatements(const string &a_interpreter, const string &a_programFileName, const string &a_inputFileName) **/
+
+
+
+/**/
+/*
+ static map<string, double> ReadBaseline(const string &a_baselineFileName)
+
+ NAME
+    ReadBaseline - Reads the minimum wall times of a saved results file
+
+ SYNOPSIS
+    static map<string, double> ReadBaseline(const string &a_baselineFileName)
+        a_baselineFileName --> A results file written by an earlier run
+
+ DESCRIPTION
+    The results file has one benchmark per line, so every line with a "name" is read for its "name" and its "min_wall_seconds" (or
+    its "wall_seconds", in a results file that has no minimum).
+
+ RETURNS
+    The minimum wall time of every benchmark in the baseline, by name. Empty if there is no baseline
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static map<string, double> ReadBaseline(const string &a_baselineFileName) {
+    map<string, double> baseline;
+    ifstream file(a_baselineFileName);
+    string line;
+    const string nameKey = "\"name\": \"";
+    const string wallKey = "\"wall_seconds\": ";
+    const string minimumKey = "\"min_wall_seconds\": ";
+    while(getline(file, line)) {
+        size_t name = line.find(nameKey);
+        size_t wall = line.find(minimumKey);
+        size_t keyLength = minimumKey.length();
+        if(wall == string::npos) {
+            wall = line.find(wallKey);
+            keyLength = wallKey.length();
+        }
+        if(name == string::npos || wall == string::npos) {
+            continue;
+        }
+        name += nameKey.length();
+        baseline[line.substr(name, line.find('\"', name) - name)] = atof(line.c_str() + wall + keyLength);
+    }
+    return baseline;
+}/** static map<string, double> ReadBaseline(const string &a_baselineFileName) **/
+
+
+
+int main(int argc, char *argv[])
+{
+    if(argc < 7) {
+        cerr << "Usage: benchRunner <duckInterp> <bench directory> <runs> <results file> <baseline file | -> <tolerance %> [interpreter options]" << endl;
+        return 2;
+    }
+    string interpreter = argv[1];
+    string benchDirectory = argv[2];
+    int runs = max(1, atoi(argv[3]));
+    string resultsFileName = argv[4];
+    string baselineFileName = argv[5];
+    double tolerance = atof(argv[6]);
+    vector<string> interpreterOptions(argv + 7, argv + argc);
+
+    //the programs of the suite, in alphabetical order
+    vector<string> names;
+    DIR *directory = opendir(benchDirectory.c_str());
+    if(directory == nullptr) {
+        cerr << "Could not open the bench directory: " << benchDirectory << endl;
+        return 2;
+    }
+    for(struct dirent *entry = readdir(directory); entry != nullptr; entry = readdir(directory)) {
+        string fileName = entry->d_name;
+        if(fileName.length() > 5 && fileName.substr(fileName.length() - 5) == ".duck") {
+            names.push_back(fileName.substr(0, fileName.length() - 5));
+        }
+    }
+    closedir(directory);
+    sort(names.begin(), names.end());
+
+    //the name column is as wide as the longest program name
+    int nameWidth = 0;
+    for(const string &name : names) {
+        nameWidth = max(nameWidth, static_cast<int>(name.length()));
+    }
+
+    //every program is profiled, then run once to find how many times it must be run in a row for every sample
+    vector<BenchResult> programs;
+    vector<vector<string>> programArguments;
+    vector<string> inputFileNames;
+    bool failed = false;
+    for(size_t i = 0; i < names.size(); i++) {
+        BenchResult result;
+        result.m_name = names[i];
+        string programFileName = benchDirectory + "/" + names[i] + ".duck";
+        string inputFileName = benchDirectory + "/" + names[i] + ".in";
+        if(access(inputFileName.c_str(), R_OK) != 0) {
+            inputFileName.clear();
+        }
+
+        result.m_statements = CountStatements(interpreter, programFileName, inputFileName);
+        vector<string> arguments = {interpreter};
+        arguments.insert(arguments.end(), interpreterOptions.begin(), interpreterOptions.end());
+        arguments.push_back(programFileName);
+        double seconds;
+        if(!RunProgram(arguments, inputFileName, seconds, result.m_peakRssKilobytes)) {
+            cerr << names[i] << ": the program failed" << endl;
+            failed = true;
+            continue;
+        }
+        result.m_repeats = static_cast<int>(max(1.0, ceil(k_minimumSampleSeconds / seconds)));
+        programs.push_back(result);
+        programArguments.push_back(arguments);
+        inputFileNames.push_back(inputFileName);
+    }
+
+    //the programs are sampled in turn rather than one after the other, so that a slow spell of the machine slows down one sample of
+    //many programs instead of every sample of one program. Every sample is the wall time of one run, averaged over the repeats
+    vector<vector<double>> times(programs.size());
+    vector<bool> programFailed(programs.size(), false);
+    for(int run = 0; run < runs; run++) {
+        for(size_t i = 0; i < programs.size(); i++) {
+            double sampleSeconds = 0;
+            for(int repeat = 0; repeat < programs[i].m_repeats && !programFailed[i]; repeat++) {
+                double seconds;
+                long peakRssKilobytes;
+                programFailed[i] = !RunProgram(programArguments[i], inputFileNames[i], seconds, peakRssKilobytes);
+                sampleSeconds += seconds;
+                programs[i].m_peakRssKilobytes = max(programs[i].m_peakRssKilobytes, peakRssKilobytes);
+            }
+            times[i].push_back(sampleSeconds / programs[i].m_repeats);
+        }
+    }
+
+    vector<BenchResult> results;
+    for(size_t i = 0; i < programs.size(); i++) {
+        BenchResult &result = programs[i];
+        if(programFailed[i]) {
+            cerr << result.m_name << ": the program failed" << endl;
+            failed = true;
+            continue;
+        }
+        sort(times[i].begin(), times[i].end());
+        result.m_medianSeconds = times[i][times[i].size() / 2];
+        result.m_minimumSeconds = times[i][0];
+        results.push_back(result);
+
+        fprintf(stderr, "%-*s %10.4f s %14.0f statements/s %8ld KB %6d repeats\n", nameWidth, result.m_name.c_str(), result.m_medianSeconds,
+                result.m_statements / result.m_medianSeconds, result.m_peakRssKilobytes, result.m_repeats);
+    }
+
+    //the baseline is read before the results are written, in case they are the same file
+    map<string, double> baseline;
+    if(baselineFileName != "-") {
+        baseline = ReadBaseline(baselineFileName);
+        if(baseline.empty()) {
+            cerr << "No baseline in " << baselineFileName << " to compare against (save one with make bench-baseline)" << endl;
+        }
+    }
+
+    ofstream resultsFile(resultsFileName);
+    resultsFile << "{" << endl;
+    resultsFile << "  \"runs\": " << runs << "," << endl;
+    resultsFile << "  \"benchmarks\": [" << endl;
+    for(size_t i = 0; i < results.size(); i++) {
+        const BenchResult &result = results[i];
+        char line[512];
+        snprintf(line, sizeof(line), "    {\"name\": \"%s\", \"statements\": %lld, \"wall_seconds\": %.6f, \"min_wall_seconds\": %.6f, "
+                 "\"statements_per_second\": %.0f, \"peak_rss_kb\": %ld, \"repeats\": %d}%s", result.m_name.c_str(), result.m_statements,
+                 result.m_medianSeconds, result.m_minimumSeconds, result.m_statements / result.m_medianSeconds, result.m_peakRssKilobytes,
+                 result.m_repeats, i + 1 < results.size() ? "," : "");
+        resultsFile << line << endl;
+    }
+    resultsFile << "  ]" << endl << "}" << endl;
+    if(!resultsFile) {
+        cerr << "Could not write the results to " << resultsFileName << endl;
+        return 2;
+    }
+
+    bool regressed = false;
+    for(size_t i = 0; i < results.size(); i++) {
+        map<string, double>::const_iterator it = baseline.find(results[i].m_name);
+        if(it == baseline.end() || it->second <= 0) {
+            continue;
+        }
+        //the fastest runs are compared, as the noise of the machine only ever makes a run slower
+        double change = (results[i].m_minimumSeconds / it->second - 1) * 100;
+        if(change > tolerance && results[i].m_minimumSeconds - it->second > k_noiseFloorSeconds) {
+            fprintf(stderr, "REGRESSION %s: %.4f s against %.4f s in the baseline (%+.1f%%)\n", results[i].m_name.c_str(),
+                    results[i].m_minimumSeconds, it->second, change);
+            regressed = true;
+        }
+    }
+    return failed || regressed ? 1 : 0;
+}
@@ -0,0 +1,417 @@
+// MicroBench.cpp : Times the components of the interpreter on their own, so that a change to one of them can be judged in isolation.
+//
+// Usage: microBench [filter]
+//
+// Every benchmark runs its operation until it has run for at least k_minimumSeconds, and reports the time and the number of heap
+// allocations per operation. Allocations are counted by replacing the global operator new. Only the benchmarks whose name contains
+// the filter are run.
+//
+//  - Statement/ParseNextElement: walking the tokens of representative statements, per token
+//  - Lexer/Tokenize: tokenizing the same statements, per statement
+//  - ExpressionEvaluator/EvaluateArithmeticExpression/depth=N: evaluating an expression nested N parentheses deep, per expression
+//  - SymbolTable/RecordVariableValue|GetVariableValue/variables=N: assigning and reading every one of N variables, per variable
+//  - ArrayTable/AddToArray|GetValue/sequential|random/size=N: assigning and reading every index of an array of N values, per index
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "../ArrayTable.h"
+#include "../ExpressionEvaluator.h"
+#include "../Lexer.h"
+#include "../Statement.h"
+#include "../SymbolTable.h"
+
+using namespace std;
+
+//The number of heap allocations made so far
+static uint64_t s_allocationCount = 0;
+
+void *operator new(size_t a_size) {
+    s_allocationCount++;
+    void *memory = malloc(a_size == 0 ? 1 : a_size);
+    if(memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *a_memory) noexcept {
+    free(a_memory);
+}
+
+void operator delete(void *a_memory, size_t) noexcept {
+    free(a_memory);
+}
+
+//The shortest time that a benchmark is measured over
+static const double k_minimumSeconds = 0.1;
+
+//Keeps the results of the benchmarked operations from being thrown away
+static volatile double s_sink = 0;
+
+//Runs the operation of a benchmark the given number of times. Returns the number of operations that were run
+typedef function<uint64_t(uint64_t a_repetitions)> BenchmarkBody;
+
+//Representative statements of a Duck program. The label makes the gotos valid
+static const char *const k_representativeStatements[] = {
+    "x = x + 1;",
+    "if i < n goto loop;",
+    "a[i] = a[i - 1] * 2 + b;",
+    "total = (total + a[j]) / (n - 1.5);",
+    "print \"value of x:\", x, a[i];",
+    "read x, y, z;",
+    "dim a[100];",
+    "loop: goto loop;",
+};
+
+
+
+/**/
+/*
+ static void RunBenchmark(const string &a_name, const string &a_filter, const BenchmarkBody &a_body)
+
+ NAME
+    RunBenchmark - Measures a benchmark and reports it
+
+ SYNOPSIS
+    static void RunBenchmark(const string &a_name, const string &a_filter, const BenchmarkBody &a_body)
+        a_name --> The name of the benchmark
+        a_filter --> The benchmark is only run if its name contains the filter
+        a_body --> Runs the operation of the benchmark
+
+ DESCRIPTION
+    Runs the benchmark with twice as many repetitions every time, until a run lasts at least k_minimumSeconds, and reports the time
+    and the allocations per operation of the last run.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static void RunBenchmark(const string &a_name, const string &a_filter, const BenchmarkBody &a_body) {
+    if(a_name.find(a_filter) == string::npos) {
+        return;
+    }
+    double seconds = 0;
+    uint64_t operations = 0;
+    uint64_t allocations = 0;
+    for(uint64_t repetitions = 1; seconds < k_minimumSeconds; repetitions *= 2) {
+        uint64_t allocationsBefore = s_allocationCount;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        operations = a_body(repetitions);
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        allocations = s_allocationCount - allocationsBefore;
+    }
+    printf("%-62s %12.1f ns/op %10.2f allocs/op\n", a_name.c_str(), seconds * 1e9 / operations,
+           static_cast<double>(allocations) / operations);
+    fflush(stdout);
+}/** static void RunBenchmark(const string &a_name, const string &a_filter, const BenchmarkBody &a_body) **/
+
+
+
+/**/
+/*
+ static string WriteTemporaryProgram(const string &a_program)
+
+ NAME
+    WriteTemporaryProgram - Writes a Duck program to a temporary file
+
+ SYNOPSIS
+    static string WriteTemporaryProgram(const string &a_program)
+        a_program --> The source of the program
+
+ DESCRIPTION
+    Statements can only be recorded from a file, so the programs that the benchmarks run are written to temporary files. The caller
+    removes the file once the program has been recorded.
+
+ RETURNS
+    The name of the file
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static string WriteTemporaryProgram(const string &a_program) {
+    char fileName[] = "/tmp/duckMicroBenchXXXXXX";
+    int file = mkstemp(fileName);
+    if(file < 0 || write(file, a_program.data(), a_program.size()) != static_cast<ssize_t>(a_program.size())) {
+        cerr << "Could not write a temporary program" << endl;
+        exit(1);
+    }
+    close(file);
+    return fileName;
+}/** static string WriteTemporaryProgram(const string &a_program) **/
+
+
+
+/**/
+/*
+ static void BenchmarkLexer(const string &a_filter)
+
+ NAME
+    BenchmarkLexer - Benchmarks walking and building the tokens of statements
+
+ SYNOPSIS
+    static void BenchmarkLexer(const string &a_filter)
+        a_filter --> Only the benchmarks whose name contains the filter are run
+
+ DESCRIPTION
+    Records the representative statements as a program and walks all their tokens with ParseNextElement, the way the interpreter
+    does, then tokenizes the same statements with a Lexer, the way they are recorded.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static void BenchmarkLexer(const string &a_filter) {
+    string program;
+    for(const char *statement : k_representativeStatements) {
+        program += string(statement) + "\n";
+    }
+    program += "stop;\nend;\n";
+    string fileName = WriteTemporaryProgram(program);
+    Statement statements;
+    statements.RecordStatements(fileName);
+    unlink(fileName.c_str());
+
+    RunBenchmark("Statement/ParseNextElement", a_filter, [&statements](uint64_t a_repetitions) {
+        uint64_t tokens = 0;
+        Token token;
+        for(uint64_t repetition = 0; repetition < a_repetitions; repetition++) {
+            for(int i = 0; i < statements.GetStatementCount(); i++) {
+                const CompiledStatement &statement = statements.GetStatement(i);
+                for(int nextPos = 0; nextPos >= 0; tokens++) {
+                    nextPos = statement.ParseNextElement(nextPos, token);
+                }
+            }
+        }
+        return tokens;
+    });
+
+    RunBenchmark("Lexer/Tokenize", a_filter, [](uint64_t a_repetitions) {
+        Lexer lexer;
+        string errorMessage;
+        uint64_t tokenized = 0;
+        for(uint64_t repetition = 0; repetition < a_repetitions; repetition++) {
+            for(const char *statement : k_representativeStatements) {
+                TokenList tokens;
+                lexer.Tokenize(statement, tokens, errorMessage);
+                tokenized++;
+            }
+        }
+        return tokenized;
+    });
+}/** static void BenchmarkLexer(const string &a_filter) **/
+
+
+
+/**/
+/*
+ static void BenchmarkEvaluator(const string &a_filter)
+
+ NAME
+    BenchmarkEvaluator - Benchmarks the evaluation of expressions of increasing depth
+
+ SYNOPSIS
+    static void BenchmarkEvaluator(const string &a_filter)
+        a_filter --> Only the benchmarks whose name contains the filter are run
+
+ DESCRIPTION
+    Records a program with one assignment for every depth, whose expression is nested that many parentheses deep and mixes
+    numbers, variables and operators of different precedences, gives every variable a value, and evaluates the expression of each
+    assignment with an ExpressionEvaluator over the statements and the symbol table, as the DuckInterpreter does.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static void BenchmarkEvaluator(const string &a_filter) {
+    static const int k_depths[] = {1, 2, 4, 8, 16, 32};
+    string program;
+    for(int depth : k_depths) {
+        string expression = "x";
+        for(int level = 0; level < depth; level++) {
+            expression = "(" + expression + " * 1.5 - y)";
+        }
+        program += "v = " + expression + " + 1;\n";
+    }
+    program += "stop;\nend;\n";
+    string fileName = WriteTemporaryProgram(program);
+    Statement statements;
+    statements.RecordStatements(fileName);
+    unlink(fileName.c_str());
+    SymbolTable symbolTable;
+    symbolTable.SetSlotCount(statements.GetIdentifierCount());
+    for(int slot = 0; slot < statements.GetIdentifierCount(); slot++) {
+        symbolTable.RecordVariableValue(slot, 1.0);
+    }
+    ArrayTable arrayTable;
+    arrayTable.SetSlotCount(statements.GetIdentifierCount());
+    ExpressionEvaluator evaluator(statements, symbolTable, arrayTable);
+
+    for(size_t i = 0; i < sizeof(k_depths) / sizeof(k_depths[0]); i++) {
+        int statementNum = static_cast<int>(i);
+        const CompiledStatement &statement = statements.GetStatement(statementNum);
+        RunBenchmark("ExpressionEvaluator/EvaluateArithmeticExpression/depth=" + to_string(k_depths[i]), a_filter,
+                     [&evaluator, &statement](uint64_t a_repetitions) {
+            for(uint64_t repetition = 0; repetition < a_repetitions; repetition++) {
+                //the expression starts after "v ="
+                int nextPos = 2;
+                s_sink = evaluator.EvaluateArithmeticExpression(statement, nextPos);
+            }
+            return a_repetitions;
+        });
+    }
+}/** static void BenchmarkEvaluator(const string &a_filter) **/
+
+
+
+/**/
+/*
+ static void BenchmarkSymbolTable(const string &a_filter)
+
+ NAME
+    BenchmarkSymbolTable - Benchmarks assigning and reading variables as the number of variables grows
+
+ SYNOPSIS
+    static void BenchmarkSymbolTable(const string &a_filter)
+        a_filter --> Only the benchmarks whose name contains the filter are run
+
+ DESCRIPTION
+    For every variable count, assigns every variable in turn, then reads every variable in turn.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static void BenchmarkSymbolTable(const string &a_filter) {
+    static const int k_variableCounts[] = {16, 1024, 65536, 1048576};
+    for(int variableCount : k_variableCounts) {
+        SymbolTable symbolTable;
+        symbolTable.SetSlotCount(variableCount);
+        RunBenchmark("SymbolTable/RecordVariableValue/variables=" + to_string(variableCount), a_filter,
+                     [&symbolTable, variableCount](uint64_t a_repetitions) {
+            for(uint64_t repetition = 0; repetition < a_repetitions; repetition++) {
+                for(int slot = 0; slot < variableCount; slot++) {
+                    symbolTable.RecordVariableValue(slot, slot);
+                }
+            }
+            return a_repetitions * variableCount;
+        });
+        RunBenchmark("SymbolTable/GetVariableValue/variables=" + to_string(variableCount), a_filter,
+                     [&symbolTable, variableCount](uint64_t a_repetitions) {
+            double value = 0;
+            double sum = 0;
+            for(uint64_t repetition = 0; repetition < a_repetitions; repetition++) {
+                for(int slot = 0; slot < variableCount; slot++) {
+                    symbolTable.GetVariableValue(slot, value);
+                    sum += value;
+                }
+            }
+            s_sink = sum;
+            return a_repetitions * variableCount;
+        });
+    }
+}/** static void BenchmarkSymbolTable(const string &a_filter) **/
+
+
+
+/**/
+/*
+ static void BenchmarkArrayTable(const string &a_filter)
+
+ NAME
+    BenchmarkArrayTable - Benchmarks assigning and reading array elements at sequential and random indexes
+
+ SYNOPSIS
+    static void BenchmarkArrayTable(const string &a_filter)
+        a_filter --> Only the benchmarks whose name contains the filter are run
+
+ DESCRIPTION
+    For every array size, assigns and then reads every index of the array, first in order and then in a random order (the same
+    order on every run). The indexes are worked out beforehand, so both orders do the same work apart from the accesses.
+
+ RETURNS
+    void
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static void BenchmarkArrayTable(const string &a_filter) {
+    static const int k_arraySizes[] = {1024, 1048576};
+    const string arrayName = "a";
+    for(int arraySize : k_arraySizes) {
+        ArrayTable arrayTable;
+        arrayTable.SetSlotCount(1);
+        arrayTable.AddNewArray(0, arraySize);
+
+        vector<double> sequentialIndexes(arraySize);
+        for(int i = 0; i < arraySize; i++) {
+            sequentialIndexes[i] = i;
+        }
+        vector<double> randomIndexes = sequentialIndexes;
+        shuffle(randomIndexes.begin(), randomIndexes.end(), mt19937(12345));
+
+        for(int order = 0; order < 2; order++) {
+            const vector<double> &indexes = order == 0 ? sequentialIndexes : randomIndexes;
+            string suffix = string(order == 0 ? "sequential" : "random") + "/size=" + to_string(arraySize);
+            RunBenchmark("ArrayTable/AddToArray/" + suffix, a_filter, [&arrayTable, &arrayName, &indexes](uint64_t a_repetitions) {
+                for(uint64_t repetition = 0; repetition < a_repetitions; repetition++) {
+                    for(size_t i = 0; i < indexes.size(); i++) {
+                        arrayTable.AddToArray(0, arrayName, indexes[i], indexes[i]);
+                    }
+                }
+                return a_repetitions * indexes.size();
+            });
+            RunBenchmark("ArrayTable/GetValue/" + suffix, a_filter, [&arrayTable, &arrayName, &indexes](uint64_t a_repetitions) {
+                double value = 0;
+                double sum = 0;
+                for(uint64_t repetition = 0; repetition < a_repetitions; repetition++) {
+                    for(size_t i = 0; i < indexes.size(); i++) {
+                        arrayTable.GetValue(0, arrayName, indexes[i], value);
+                        sum += value;
+                    }
+                }
+                s_sink = sum;
+                return a_repetitions * indexes.size();
+            });
+        }
+    }
+}/** static void BenchmarkArrayTable(const string &a_filter) **/
+
+
+
+int main(int argc, char *argv[])
+{
+    if(argc > 2) {
+        cerr << "Usage: microBench [filter]" << endl;
+        return 2;
+    }
+    string filter = argc == 2 ? argv[1] : "";
+
+    BenchmarkLexer(filter);
+    BenchmarkEvaluator(filter);
+    BenchmarkSymbolTable(filter);
+    BenchmarkArrayTable(filter);
+    return 0;
+}
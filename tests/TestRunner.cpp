@@ -0,0 +1,610 @@
+// TestRunner.cpp : Runs the Duck programs of the regression suite on every engine and checks what they print and how they exit.
+//
+// Usage: testRunner <duckInterp> <duck2cpp> <runtime include directory> <tests directory> <work directory>
+//
+// Every .duck program of the tests directory is run (with the .in file of the same name as its standard input, if there is one) with
+// --engine=interp, --engine=vm and --engine=jit, and is translated with duck2cpp, compiled with g++ and run. The standard output, the
+// standard error and the exit code of every run must be the ones in the .out, .err and .exit files of the program. When duck2cpp
+// cannot load the program, its own standard error and exit code are checked instead (it reports the same errors as the interpreter).
+//
+// A program with a .args file is run the ways listed in it instead, one run per line: the engine (interp, vm, jit or duck2cpp) followed
+// by the options that duckInterp, or the translated program, is run with. {file} in an option stands for a file of the work directory,
+// whose contents must then be the ones in the .file file of the program once the run is over. In the expected files, {*} stands for any
+// text (for the times that a profile reports, for example).
+//
+// A program too large to keep in the tests directory is described by a .gen file instead of a .duck file, and is generated into the work
+// directory before it is run (see GenerateProgram).
+//
+// The translated programs and their binaries are written to the work directory. Every failure is reported, and the runner exits with
+// status 1 if there was any.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+//The number of seconds that a program of the suite may run for before it is killed
+const int k_timeoutSeconds = 20;
+
+//The runs of a program that has no .args file
+const char *const k_defaultRuns[] = {"interp", "vm", "jit", "duck2cpp"};
+
+//The number of variables between two labeled statements of a generated chain program
+const int k_chainPartLength = 4000;
+
+//What stands for the file of the work directory in the options of a run, and for any text in an expected file
+const string k_filePlaceholder = "{file}";
+const string k_wildcard = "{*}";
+
+//What a program printed and how it exited
+struct RunResult
+{
+    string m_output;
+    string m_error;
+    int m_exitCode = 0;
+};
+
+//What became of the translation of a program by duck2cpp
+enum class Translation
+{
+    //the program has not been translated yet
+    NotDone,
+    //the translated program was compiled
+    Compiled,
+    //duck2cpp could not load the program, and reported why
+    LoadFailed,
+    //duck2cpp or g++ failed
+    Failed,
+};
+
+
+
+/**/
+/*
+ static string ReadFile(const string &a_fileName, bool &a_found)
+
+ NAME
+    ReadFile - Returns the contents of a file
+
+ SYNOPSIS
+    static string ReadFile(const string &a_fileName, bool &a_found)
+        a_fileName --> The name of the file
+        a_found --> Set to true if the file could be read, false otherwise
+
+ DESCRIPTION
+    Reads the whole file, byte for byte.
+
+ RETURNS
+    The contents of the file, or an empty string if it could not be read
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static string ReadFile(const string &a_fileName, bool &a_found) {
+    ifstream file(a_fileName, ios::binary);
+    a_found = static_cast<bool>(file);
+    stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}/** static string ReadFile(const string &a_fileName, bool &a_found) **/
+
+
+
+/**/
+/*
+ static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, const string &a_outputPrefix, bool a_limitTime,
+        RunResult &a_result)
+
+ NAME
+    RunProgram - Runs a program and collects what it printed and its exit code
+
+ SYNOPSIS
+    static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, const string &a_outputPrefix, bool a_limitTime,
+            RunResult &a_result)
+        a_arguments --> The program to be run, followed by its arguments. The program is looked up in the PATH if it has no slash
+        a_inputFileName --> The file to be used as the standard input of the program, or an empty string for /dev/null
+        a_outputPrefix --> The standard output and the standard error are written to this name followed by .stdout and .stderr
+        a_limitTime --> True if the program is killed after k_timeoutSeconds
+        a_result --> Set to what the program printed and to its exit code
+
+ DESCRIPTION
+    Runs the program with its standard output and standard error written to files, and waits for it. The time limit is an alarm set
+    just before the program is executed, which the program inherits. A program that is killed by a signal gets 128 plus the number of
+    the signal as its exit code, as in the shell.
+
+ RETURNS
+    True if the program could be run and was not killed for running too long, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, const string &a_outputPrefix, bool a_limitTime,
+        RunResult &a_result) {
+    vector<char *> argv;
+    for(size_t i = 0; i < a_arguments.size(); i++) {
+        argv.push_back(const_cast<char *>(a_arguments[i].c_str()));
+    }
+    argv.push_back(nullptr);
+
+    string outputFileName = a_outputPrefix + ".stdout";
+    string errorFileName = a_outputPrefix + ".stderr";
+    pid_t child = fork();
+    if(child < 0) {
+        return false;
+    }
+    if(child == 0) {
+        int input = open(a_inputFileName.empty() ? "/dev/null" : a_inputFileName.c_str(), O_RDONLY);
+        int output = open(outputFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int error = open(errorFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(input < 0 || output < 0 || error < 0) {
+            _exit(127);
+        }
+        dup2(input, STDIN_FILENO);
+        dup2(output, STDOUT_FILENO);
+        dup2(error, STDERR_FILENO);
+        if(a_limitTime) {
+            alarm(k_timeoutSeconds);
+        }
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status;
+    if(waitpid(child, &status, 0) < 0) {
+        return false;
+    }
+    bool found;
+    a_result.m_output = ReadFile(outputFileName, found);
+    a_result.m_error = ReadFile(errorFileName, found);
+    if(WIFSIGNALED(status)) {
+        a_result.m_exitCode = 128 + WTERMSIG(status);
+        return !(a_limitTime && WTERMSIG(status) == SIGALRM);
+    }
+    a_result.m_exitCode = WEXITSTATUS(status);
+    return true;
+}/** static bool RunProgram(const vector<string> &a_arguments, const string &a_inputFileName, const string &a_outputPrefix, bool a_limitTime,
+        RunResult &a_result) **/
+
+
+
+/**/
+/*
+ static bool MatchesExpected(const string &a_text, const string &a_expected)
+
+ NAME
+    MatchesExpected - Checks text against the expected text, in which {*} stands for any text
+
+ SYNOPSIS
+    static bool MatchesExpected(const string &a_text, const string &a_expected)
+        a_text --> The text to be checked
+        a_expected --> The expected text
+
+ DESCRIPTION
+    The parts of the expected text between the wildcards must appear in the text in order: the first at its start, the last at its
+    end, and every other at the first place after the part before it. Without a wildcard, the texts must be the same.
+
+ RETURNS
+    True if the text matches the expected text, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static bool MatchesExpected(const string &a_text, const string &a_expected) {
+    size_t wildcard = a_expected.find(k_wildcard);
+    if(wildcard == string::npos) {
+        return a_text == a_expected;
+    }
+    if(a_text.compare(0, wildcard, a_expected, 0, wildcard) != 0) {
+        return false;
+    }
+    size_t textPos = wildcard;
+    size_t partStart = wildcard + k_wildcard.length();
+    while(true) {
+        size_t partEnd = a_expected.find(k_wildcard, partStart);
+        if(partEnd == string::npos) {
+            //the last part must end the text
+            size_t partLength = a_expected.length() - partStart;
+            return a_text.length() >= textPos + partLength && a_text.compare(a_text.length() - partLength, partLength, a_expected, partStart, partLength) == 0;
+        }
+        size_t found = a_text.find(a_expected.substr(partStart, partEnd - partStart), textPos);
+        if(found == string::npos) {
+            return false;
+        }
+        textPos = found + (partEnd - partStart);
+        partStart = partEnd + k_wildcard.length();
+    }
+}/** static bool MatchesExpected(const string &a_text, const string &a_expected) **/
+
+
+
+/**/
+/*
+ static bool CheckText(const string &a_name, const string &a_run, const char *a_what, const string &a_text, const string &a_expected)
+
+ NAME
+    CheckText - Compares what a run of a program wrote with what was expected
+
+ SYNOPSIS
+    static bool CheckText(const string &a_name, const string &a_run, const char *a_what, const string &a_text, const string &a_expected)
+        a_name --> The name of the program
+        a_run --> How the program was run
+        a_what --> What the text is (the standard output, for example), for the report
+        a_text --> What the run wrote
+        a_expected --> What the run should have written
+
+ DESCRIPTION
+    A difference is reported on the standard error, with the first line that differs.
+
+ RETURNS
+    True if the text matches the expected text, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static bool CheckText(const string &a_name, const string &a_run, const char *a_what, const string &a_text, const string &a_expected) {
+    if(MatchesExpected(a_text, a_expected)) {
+        return true;
+    }
+    //the line that the first difference is on
+    size_t difference = mismatch(a_text.begin(), a_text.begin() + min(a_text.length(), a_expected.length()), a_expected.begin()).first - a_text.begin();
+    size_t lineStart = difference == 0 ? string::npos : a_text.rfind('\n', difference - 1);
+    lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+    int lineNumber = static_cast<int>(count(a_text.begin(), a_text.begin() + lineStart, '\n')) + 1;
+    cerr << "FAIL " << a_name << " (" << a_run << "): the " << a_what << " differs at line " << lineNumber << endl;
+    cerr << "    expected: " << a_expected.substr(lineStart, a_expected.find('\n', lineStart) - lineStart) << endl;
+    cerr << "    got:      " << a_text.substr(lineStart, a_text.find('\n', lineStart) - lineStart) << endl;
+    return false;
+}/** static bool CheckText(const string &a_name, const string &a_run, const char *a_what, const string &a_text, const string &a_expected) **/
+
+
+
+/**/
+/*
+ static bool CheckResult(const string &a_name, const string &a_run, const RunResult &a_result, const RunResult &a_expected)
+
+ NAME
+    CheckResult - Compares what a run of a program printed and its exit code with what was expected
+
+ SYNOPSIS
+    static bool CheckResult(const string &a_name, const string &a_run, const RunResult &a_result, const RunResult &a_expected)
+        a_name --> The name of the program
+        a_run --> How the program was run
+        a_result --> What the program printed and its exit code
+        a_expected --> What the program should have printed and its exit code
+
+ DESCRIPTION
+    Every difference is reported on the standard error.
+
+ RETURNS
+    True if the run printed what was expected and exited with the expected code, false otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static bool CheckResult(const string &a_name, const string &a_run, const RunResult &a_result, const RunResult &a_expected) {
+    bool passed = CheckText(a_name, a_run, "standard output", a_result.m_output, a_expected.m_output);
+    passed = CheckText(a_name, a_run, "standard error", a_result.m_error, a_expected.m_error) && passed;
+    if(a_result.m_exitCode != a_expected.m_exitCode) {
+        cerr << "FAIL " << a_name << " (" << a_run << "): exited with " << a_result.m_exitCode << " instead of " << a_expected.m_exitCode << endl;
+        passed = false;
+    }
+    return passed;
+}/** static bool CheckResult(const string &a_name, const string &a_run, const RunResult &a_result, const RunResult &a_expected) **/
+
+
+
+/**/
+/*
+ static vector<vector<string>> ReadRuns(const string &a_argsFileName)
+
+ NAME
+    ReadRuns - Returns the ways that a program is run
+
+ SYNOPSIS
+    static vector<vector<string>> ReadRuns(const string &a_argsFileName)
+        a_argsFileName --> The .args file of the program
+
+ DESCRIPTION
+    Every line of the file that is not empty is a run: the engine followed by the options, separated by white space. A program that
+    has no .args file is run with every engine and through duck2cpp, without options.
+
+ RETURNS
+    The runs, each one the engine followed by the options
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static vector<vector<string>> ReadRuns(const string &a_argsFileName) {
+    vector<vector<string>> runs;
+    ifstream file(a_argsFileName);
+    if(!file) {
+        for(const char *engine : k_defaultRuns) {
+            runs.push_back({engine});
+        }
+        return runs;
+    }
+    string line;
+    while(getline(file, line)) {
+        istringstream words(line);
+        vector<string> run;
+        string word;
+        while(words >> word) {
+            run.push_back(word);
+        }
+        if(!run.empty()) {
+            runs.push_back(run);
+        }
+    }
+    return runs;
+}/** static vector<vector<string>> ReadRuns(const string &a_argsFileName) **/
+
+
+
+/**/
+/*
+ static Translation Translate(const string &a_translator, const string &a_includeDirectory, const string &a_programFileName,
+        const string &a_workPrefix, RunResult &a_result)
+
+ NAME
+    Translate - Translates a program with duck2cpp and compiles it
+
+ SYNOPSIS
+    static Translation Translate(const string &a_translator, const string &a_includeDirectory, const string &a_programFileName,
+            const string &a_workPrefix, RunResult &a_result)
+        a_translator --> duck2cpp
+        a_includeDirectory --> The directory of DuckRuntime.h
+        a_programFileName --> The Duck program
+        a_workPrefix --> The translated program is written to this name followed by .cpp, and its binary to this name followed by .bin
+        a_result --> Set to what duck2cpp printed and to its exit code
+
+ DESCRIPTION
+    The translated program is compiled with g++ -O2, as the README says to. A failure of duck2cpp itself or of g++ is reported.
+
+ RETURNS
+    Compiled if the binary was built, LoadFailed if duck2cpp reported that it could not load the program, Failed otherwise
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static Translation Translate(const string &a_translator, const string &a_includeDirectory, const string &a_programFileName,
+        const string &a_workPrefix, RunResult &a_result) {
+    string cppFileName = a_workPrefix + ".cpp";
+    if(!RunProgram({a_translator, a_programFileName, cppFileName}, "", a_workPrefix, true, a_result)) {
+        cerr << "    duck2cpp did not finish within " << k_timeoutSeconds << " seconds" << endl;
+        return Translation::Failed;
+    }
+    if(a_result.m_exitCode != 0) {
+        return Translation::LoadFailed;
+    }
+    RunResult compilation;
+    if(!RunProgram({"g++", "-std=c++17", "-O2", "-I" + a_includeDirectory, cppFileName, "-o", a_workPrefix + ".bin"}, "", a_workPrefix, false,
+                   compilation) || compilation.m_exitCode != 0) {
+        cerr << "    the translated program does not compile" << endl << compilation.m_error;
+        return Translation::Failed;
+    }
+    return Translation::Compiled;
+}/** static Translation Translate(const string &a_translator, const string &a_includeDirectory, const string &a_programFileName,
+        const string &a_workPrefix, RunResult &a_result) **/
+
+
+
+/**/
+/*
+ static bool GenerateProgram(const string &a_generatorFileName, const string &a_programFileName)
+
+ NAME
+    GenerateProgram - Writes the Duck program that a .gen file describes
+
+ SYNOPSIS
+    static bool GenerateProgram(const string &a_generatorFileName, const string &a_programFileName)
+        a_generatorFileName --> The .gen file of the program
+        a_programFileName --> The file that the program is written to
+
+ DESCRIPTION
+    The .gen file holds a single line, "chain <variables>", optionally followed by "<label> <variable>". The program is a chain of
+    assignments (v1 = v0 + 1; v2 = v1 + 1; ...) of the given number of variables, which is jumped into from its end, with a comment and a
+    labeled statement that adds up the chain so far every k_chainPartLength variables, and prints the last variable and the total. With
+    a label and a variable, the statement "<label>: v<variable> = 0;" is put before the assignment of that variable, for a label that is
+    reported while the program is loaded. The number of variables sets how large the source is, so that it can be kept above the size
+    that Statement records on threads of its own.
+
+ RETURNS
+    True if the program was written, false if the .gen file is not valid or the program could not be written
+
+ AUTHOR
+    Duck interpreter contributors
+ */
+/**/
+static bool GenerateProgram(const string &a_generatorFileName, const string &a_programFileName) {
+    ifstream generatorFile(a_generatorFileName);
+    string kind;
+    int variableCount = 0;
+    string label;
+    int labeledVariable = -1;
+    if(!(generatorFile >> kind >> variableCount) || kind != "chain" || variableCount < 1) {
+        return false;
+    }
+    if(generatorFile >> label && !(generatorFile >> labeledVariable)) {
+        return false;
+    }
+
+    ofstream program(a_programFileName);
+    program << "total = 0;\n";
+    program << "goto last;\n";
+    program << "first: v0 = 1;\n";
+    for(int variable = 1; variable < variableCount; variable++) {
+        if(variable % k_chainPartLength == 0) {
+            program << "// part " << variable / k_chainPartLength << " of the chain\n";
+            program << "m" << variable << ": total = total + v" << variable - 1 << ";\n";
+        }
+        if(variable == labeledVariable) {
+            program << label << ": v" << variable << " = 0;\n";
+        }
+        program << "v" << variable << " = v" << variable - 1 << " + 1;\n";
+    }
+    program << "print v" << variableCount - 1 << ";\n";
+    program << "print total;\n";
+    program << "stop;\n";
+    program << "last: total = 7;\n";
+    program << "goto first;\n";
+    return static_cast<bool>(program);
+}/** static bool GenerateProgram(const string &a_generatorFileName, const string &a_programFileName) **/
+
+
+
+int main(int argc, char *argv[]) {
+    if(argc != 6) {
+        cerr << "Usage: testRunner <duckInterp> <duck2cpp> <runtime include directory> <tests directory> <work directory>" << endl;
+        return 2;
+    }
+    string interpreter = argv[1];
+    string translator = argv[2];
+    string includeDirectory = argv[3];
+    string testsDirectory = argv[4];
+    string workDirectory = argv[5];
+    mkdir(workDirectory.c_str(), 0755);
+
+    //the programs of the suite, in alphabetical order
+    vector<string> names;
+    DIR *directory = opendir(testsDirectory.c_str());
+    if(directory == nullptr) {
+        cerr << "Could not open the tests directory: " << testsDirectory << endl;
+        return 2;
+    }
+    for(struct dirent *entry = readdir(directory); entry != nullptr; entry = readdir(directory)) {
+        string fileName = entry->d_name;
+        if(fileName.length() > 5 && (fileName.substr(fileName.length() - 5) == ".duck" || fileName.substr(fileName.length() - 4) == ".gen")) {
+            names.push_back(fileName.substr(0, fileName.rfind('.')));
+        }
+    }
+    closedir(directory);
+    sort(names.begin(), names.end());
+
+    int failures = 0;
+    for(size_t i = 0; i < names.size(); i++) {
+        const string &name = names[i];
+        string testPrefix = testsDirectory + "/" + name;
+        string programFileName = testPrefix + ".duck";
+        string inputFileName = testPrefix + ".in";
+        if(access(inputFileName.c_str(), R_OK) != 0) {
+            inputFileName.clear();
+        }
+        string workPrefix = workDirectory + "/" + name;
+        if(access(programFileName.c_str(), R_OK) != 0) {
+            programFileName = workPrefix + ".duck";
+            if(!GenerateProgram(testPrefix + ".gen", programFileName)) {
+                cerr << "FAIL " << name << ": the program could not be generated from its .gen file" << endl;
+                failures++;
+                continue;
+            }
+        }
+
+        RunResult expected;
+        bool foundOutput, foundError, foundExitCode, foundFile;
+        expected.m_output = ReadFile(testPrefix + ".out", foundOutput);
+        expected.m_error = ReadFile(testPrefix + ".err", foundError);
+        expected.m_exitCode = atoi(ReadFile(testPrefix + ".exit", foundExitCode).c_str());
+        string expectedFile = ReadFile(testPrefix + ".file", foundFile);
+        if(!foundOutput || !foundError || !foundExitCode) {
+            cerr << "FAIL " << name << ": the .out, .err or .exit file is missing" << endl;
+            failures++;
+            continue;
+        }
+
+        bool passed = true;
+        Translation translation = Translation::NotDone;
+        RunResult translationResult;
+        for(const vector<string> &run : ReadRuns(testPrefix + ".args")) {
+            const string &engine = run[0];
+            string runName = engine;
+            vector<string> options;
+            bool writesFile = false;
+            for(size_t option = 1; option < run.size(); option++) {
+                runName += " " + run[option];
+                string argument = run[option];
+                size_t placeholder = argument.find(k_filePlaceholder);
+                if(placeholder != string::npos) {
+                    argument.replace(placeholder, k_filePlaceholder.length(), workPrefix + ".file");
+                    writesFile = true;
+                }
+                options.push_back(argument);
+            }
+            if(writesFile && !foundFile) {
+                cerr << "FAIL " << name << " (" << runName << "): the .file file is missing" << endl;
+                passed = false;
+                continue;
+            }
+            remove((workPrefix + ".file").c_str());
+
+            vector<string> arguments;
+            if(engine == "duck2cpp") {
+                //the program is translated and compiled once, for all its duck2cpp runs. A program that cannot be loaded is reported by
+                //duck2cpp itself, whatever the options of the run
+                if(translation == Translation::NotDone) {
+                    translation = Translate(translator, includeDirectory, programFileName, workPrefix, translationResult);
+                }
+                if(translation == Translation::Failed) {
+                    cerr << "FAIL " << name << " (" << runName << "): could not be translated" << endl;
+                    passed = false;
+                    continue;
+                }
+                if(translation == Translation::LoadFailed) {
+                    passed = CheckResult(name, runName, translationResult, expected) && passed;
+                    continue;
+                }
+                arguments.push_back(workPrefix + ".bin");
+                arguments.insert(arguments.end(), options.begin(), options.end());
+            } else {
+                arguments.push_back(interpreter);
+                arguments.push_back("--engine=" + engine);
+                arguments.insert(arguments.end(), options.begin(), options.end());
+                arguments.push_back(programFileName);
+            }
+
+            RunResult result;
+            if(!RunProgram(arguments, inputFileName, workPrefix, true, result)) {
+                cerr << "FAIL " << name << " (" << runName << "): did not finish within " << k_timeoutSeconds << " seconds" << endl;
+                passed = false;
+                continue;
+            }
+            passed = CheckResult(name, runName, result, expected) && passed;
+            if(writesFile) {
+                bool written;
+                string file = ReadFile(workPrefix + ".file", written);
+                if(!written) {
+                    cerr << "FAIL " << name << " (" << runName << "): did not write " << k_filePlaceholder << endl;
+                    passed = false;
+                } else {
+                    passed = CheckText(name, runName, "file", file, expectedFile) && passed;
+                }
+            }
+        }
+
+        if(passed) {
+            cerr << "ok   " << name << endl;
+        } else {
+            failures++;
+        }
+    }
+
+    cerr << names.size() - failures << " of " << names.size() << " programs passed" << endl;
+    return failures == 0 ? 0 : 1;
+}